@@ -61,6 +61,7 @@
 #include <mlpack/core/util/backtrace.cpp>
 #include <mlpack/core/util/io.cpp>
 #include <mlpack/core/util/log.cpp>
+#include <mlpack/core/util/params.cpp>
 #include <mlpack/core/util/prefixedoutstream.cpp>
 #include <mlpack/core/util/program_doc.cpp>
 #include <mlpack/core/util/singletons.cpp>
@@ -68,6 +69,7 @@
 #include <mlpack/core/util/version.cpp>
 #include <mlpack/methods/adaboost/adaboost_model.cpp>
 #include <mlpack/methods/block_krylov_svd/randomized_block_krylov_svd.cpp>
+#include <mlpack/methods/decision_tree/flat_decision_tree.cpp>
 #include <mlpack/methods/fastmks/fastmks_model.cpp>
 #include <mlpack/methods/gmm/diagonal_gmm.cpp>
 #include <mlpack/methods/gmm/gmm.cpp>
@@ -76,6 +78,7 @@
 #include <mlpack/methods/linear_regression/linear_regression.cpp>
 #include <mlpack/methods/local_coordinate_coding/lcc.cpp>
 #include <mlpack/methods/matrix_completion/matrix_completion.cpp>
+#include <mlpack/methods/neighbor_search/flat_knn_model.cpp>
 #include <mlpack/methods/neighbor_search/unmap.cpp>
 #include <mlpack/methods/quic_svd/quic_svd.cpp>
 #include <mlpack/methods/radical/radical.cpp>
@@ -9,33 +9,36 @@
 using namespace Rcpp;
 
 // adaboost_mlpackMain
-void adaboost_mlpackMain();
-RcppExport SEXP _RcppMLPACK_adaboost_mlpackMain() {
+void adaboost_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_adaboost_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    adaboost_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    adaboost_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamAdaBoostModelPtr
-SEXP IO_GetParamAdaBoostModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamAdaBoostModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamAdaBoostModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamAdaBoostModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamAdaBoostModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamAdaBoostModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamAdaBoostModelPtr
-void IO_SetParamAdaBoostModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamAdaBoostModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamAdaBoostModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamAdaBoostModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamAdaBoostModelPtr(paramName, ptr);
+    IO_SetParamAdaBoostModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -62,33 +65,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // approx_kfn_mlpackMain
-void approx_kfn_mlpackMain();
-RcppExport SEXP _RcppMLPACK_approx_kfn_mlpackMain() {
+void approx_kfn_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_approx_kfn_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    approx_kfn_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    approx_kfn_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamApproxKFNModelPtr
-SEXP IO_GetParamApproxKFNModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamApproxKFNModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamApproxKFNModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamApproxKFNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamApproxKFNModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamApproxKFNModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamApproxKFNModelPtr
-void IO_SetParamApproxKFNModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamApproxKFNModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamApproxKFNModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamApproxKFNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamApproxKFNModelPtr(paramName, ptr);
+    IO_SetParamApproxKFNModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -115,33 +121,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // cf_mlpackMain
-void cf_mlpackMain();
-RcppExport SEXP _RcppMLPACK_cf_mlpackMain() {
+void cf_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_cf_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    cf_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    cf_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamCFModelPtr
-SEXP IO_GetParamCFModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamCFModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamCFModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamCFModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamCFModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamCFModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamCFModelPtr
-void IO_SetParamCFModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamCFModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamCFModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamCFModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamCFModelPtr(paramName, ptr);
+    IO_SetParamCFModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -168,42 +177,46 @@ BEGIN_RCPP
 END_RCPP
 }
 // dbscan_mlpackMain
-void dbscan_mlpackMain();
-RcppExport SEXP _RcppMLPACK_dbscan_mlpackMain() {
+void dbscan_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_dbscan_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    dbscan_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    dbscan_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // decision_stump_mlpackMain
-void decision_stump_mlpackMain();
-RcppExport SEXP _RcppMLPACK_decision_stump_mlpackMain() {
+void decision_stump_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_decision_stump_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    decision_stump_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    decision_stump_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamDSModelPtr
-SEXP IO_GetParamDSModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamDSModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamDSModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamDSModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamDSModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamDSModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamDSModelPtr
-void IO_SetParamDSModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamDSModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamDSModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamDSModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamDSModelPtr(paramName, ptr);
+    IO_SetParamDSModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -230,33 +243,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // decision_tree_mlpackMain
-void decision_tree_mlpackMain();
-RcppExport SEXP _RcppMLPACK_decision_tree_mlpackMain() {
+void decision_tree_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_decision_tree_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    decision_tree_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    decision_tree_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamDecisionTreeModelPtr
-SEXP IO_GetParamDecisionTreeModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamDecisionTreeModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamDecisionTreeModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamDecisionTreeModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamDecisionTreeModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamDecisionTreeModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamDecisionTreeModelPtr
-void IO_SetParamDecisionTreeModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamDecisionTreeModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamDecisionTreeModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamDecisionTreeModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamDecisionTreeModelPtr(paramName, ptr);
+    IO_SetParamDecisionTreeModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -282,34 +298,71 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// SaveFlatDecisionTreeModelPtr
+void SaveFlatDecisionTreeModelPtr(SEXP ptr, const std::string& filename);
+RcppExport SEXP _RcppMLPACK_SaveFlatDecisionTreeModelPtr(SEXP ptrSEXP, SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    SaveFlatDecisionTreeModelPtr(ptr, filename);
+    return R_NilValue;
+END_RCPP
+}
+// LoadFlatDecisionTreeModelPtr
+SEXP LoadFlatDecisionTreeModelPtr(const std::string& filename);
+RcppExport SEXP _RcppMLPACK_LoadFlatDecisionTreeModelPtr(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(LoadFlatDecisionTreeModelPtr(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ClassifyFlatDecisionTreeModelPtr
+Rcpp::List ClassifyFlatDecisionTreeModelPtr(SEXP ptr, const Rcpp::NumericMatrix& test);
+RcppExport SEXP _RcppMLPACK_ClassifyFlatDecisionTreeModelPtr(SEXP ptrSEXP, SEXP testSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type test(testSEXP);
+    rcpp_result_gen = Rcpp::wrap(ClassifyFlatDecisionTreeModelPtr(ptr, test));
+    return rcpp_result_gen;
+END_RCPP
+}
 // det_mlpackMain
-void det_mlpackMain();
-RcppExport SEXP _RcppMLPACK_det_mlpackMain() {
+void det_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_det_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    det_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    det_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamDTreePtr
-SEXP IO_GetParamDTreePtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamDTreePtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamDTreePtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamDTreePtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamDTreePtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamDTreePtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamDTreePtr
-void IO_SetParamDTreePtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamDTreePtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamDTreePtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamDTreePtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamDTreePtr(paramName, ptr);
+    IO_SetParamDTreePtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -336,42 +389,46 @@ BEGIN_RCPP
 END_RCPP
 }
 // emst_mlpackMain
-void emst_mlpackMain();
-RcppExport SEXP _RcppMLPACK_emst_mlpackMain() {
+void emst_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_emst_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    emst_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    emst_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // fastmks_mlpackMain
-void fastmks_mlpackMain();
-RcppExport SEXP _RcppMLPACK_fastmks_mlpackMain() {
+void fastmks_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_fastmks_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    fastmks_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    fastmks_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamFastMKSModelPtr
-SEXP IO_GetParamFastMKSModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamFastMKSModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamFastMKSModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamFastMKSModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamFastMKSModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamFastMKSModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamFastMKSModelPtr
-void IO_SetParamFastMKSModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamFastMKSModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamFastMKSModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamFastMKSModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamFastMKSModelPtr(paramName, ptr);
+    IO_SetParamFastMKSModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -398,33 +455,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // gmm_generate_mlpackMain
-void gmm_generate_mlpackMain();
-RcppExport SEXP _RcppMLPACK_gmm_generate_mlpackMain() {
+void gmm_generate_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_gmm_generate_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    gmm_generate_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    gmm_generate_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamGMMPtr
-SEXP IO_GetParamGMMPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamGMMPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamGMMPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamGMMPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamGMMPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamGMMPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamGMMPtr
-void IO_SetParamGMMPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamGMMPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamGMMPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamGMMPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamGMMPtr(paramName, ptr);
+    IO_SetParamGMMPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -451,51 +511,56 @@ BEGIN_RCPP
 END_RCPP
 }
 // gmm_probability_mlpackMain
-void gmm_probability_mlpackMain();
-RcppExport SEXP _RcppMLPACK_gmm_probability_mlpackMain() {
+void gmm_probability_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_gmm_probability_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    gmm_probability_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    gmm_probability_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // gmm_train_mlpackMain
-void gmm_train_mlpackMain();
-RcppExport SEXP _RcppMLPACK_gmm_train_mlpackMain() {
+void gmm_train_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_gmm_train_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    gmm_train_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    gmm_train_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // hmm_generate_mlpackMain
-void hmm_generate_mlpackMain();
-RcppExport SEXP _RcppMLPACK_hmm_generate_mlpackMain() {
+void hmm_generate_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_hmm_generate_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    hmm_generate_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    hmm_generate_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamHMMModelPtr
-SEXP IO_GetParamHMMModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamHMMModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamHMMModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamHMMModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamHMMModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamHMMModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamHMMModelPtr
-void IO_SetParamHMMModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamHMMModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamHMMModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamHMMModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamHMMModelPtr(paramName, ptr);
+    IO_SetParamHMMModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -522,60 +587,66 @@ BEGIN_RCPP
 END_RCPP
 }
 // hmm_loglik_mlpackMain
-void hmm_loglik_mlpackMain();
-RcppExport SEXP _RcppMLPACK_hmm_loglik_mlpackMain() {
+void hmm_loglik_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_hmm_loglik_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    hmm_loglik_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    hmm_loglik_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // hmm_train_mlpackMain
-void hmm_train_mlpackMain();
-RcppExport SEXP _RcppMLPACK_hmm_train_mlpackMain() {
+void hmm_train_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_hmm_train_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    hmm_train_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    hmm_train_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // hmm_viterbi_mlpackMain
-void hmm_viterbi_mlpackMain();
-RcppExport SEXP _RcppMLPACK_hmm_viterbi_mlpackMain() {
+void hmm_viterbi_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_hmm_viterbi_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    hmm_viterbi_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    hmm_viterbi_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // hoeffding_tree_mlpackMain
-void hoeffding_tree_mlpackMain();
-RcppExport SEXP _RcppMLPACK_hoeffding_tree_mlpackMain() {
+void hoeffding_tree_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_hoeffding_tree_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    hoeffding_tree_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    hoeffding_tree_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamHoeffdingTreeModelPtr
-SEXP IO_GetParamHoeffdingTreeModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamHoeffdingTreeModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamHoeffdingTreeModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamHoeffdingTreeModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamHoeffdingTreeModelPtr
-void IO_SetParamHoeffdingTreeModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamHoeffdingTreeModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamHoeffdingTreeModelPtr(paramName, ptr);
+    IO_SetParamHoeffdingTreeModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -602,42 +673,46 @@ BEGIN_RCPP
 END_RCPP
 }
 // image_converter_mlpackMain
-void image_converter_mlpackMain();
-RcppExport SEXP _RcppMLPACK_image_converter_mlpackMain() {
+void image_converter_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_image_converter_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    image_converter_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    image_converter_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // kde_mlpackMain
-void kde_mlpackMain();
-RcppExport SEXP _RcppMLPACK_kde_mlpackMain() {
+void kde_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_kde_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    kde_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    kde_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamKDEModelPtr
-SEXP IO_GetParamKDEModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamKDEModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamKDEModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamKDEModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamKDEModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamKDEModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamKDEModelPtr
-void IO_SetParamKDEModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamKDEModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamKDEModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamKDEModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamKDEModelPtr(paramName, ptr);
+    IO_SetParamKDEModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -663,43 +738,59 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// EvaluateKDEModelPtr
+Rcpp::NumericVector EvaluateKDEModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query);
+RcppExport SEXP _RcppMLPACK_EvaluateKDEModelPtr(SEXP ptrSEXP, SEXP querySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    rcpp_result_gen = Rcpp::wrap(EvaluateKDEModelPtr(ptr, query));
+    return rcpp_result_gen;
+END_RCPP
+}
 // kernel_pca_mlpackMain
-void kernel_pca_mlpackMain();
-RcppExport SEXP _RcppMLPACK_kernel_pca_mlpackMain() {
+void kernel_pca_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_kernel_pca_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    kernel_pca_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    kernel_pca_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // kfn_mlpackMain
-void kfn_mlpackMain();
-RcppExport SEXP _RcppMLPACK_kfn_mlpackMain() {
+void kfn_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_kfn_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    kfn_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    kfn_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamKFNModelPtr
-SEXP IO_GetParamKFNModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamKFNModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamKFNModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamKFNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamKFNModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamKFNModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamKFNModelPtr
-void IO_SetParamKFNModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamKFNModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamKFNModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamKFNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamKFNModelPtr(paramName, ptr);
+    IO_SetParamKFNModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -725,43 +816,74 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// SearchKFNModelPtr
+Rcpp::List SearchKFNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k);
+RcppExport SEXP _RcppMLPACK_SearchKFNModelPtr(SEXP ptrSEXP, SEXP querySEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(SearchKFNModelPtr(ptr, query, k));
+    return rcpp_result_gen;
+END_RCPP
+}
 // kmeans_mlpackMain
-void kmeans_mlpackMain();
-RcppExport SEXP _RcppMLPACK_kmeans_mlpackMain() {
+void kmeans_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_kmeans_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    kmeans_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    kmeans_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
+// ClusterCSVStream
+Rcpp::NumericMatrix ClusterCSVStream(const std::string& filename, const Rcpp::NumericMatrix& centroids, int chunkSize, int batchSize);
+RcppExport SEXP _RcppMLPACK_ClusterCSVStream(SEXP filenameSEXP, SEXP centroidsSEXP, SEXP chunkSizeSEXP, SEXP batchSizeSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type centroids(centroidsSEXP);
+    Rcpp::traits::input_parameter< int >::type chunkSize(chunkSizeSEXP);
+    Rcpp::traits::input_parameter< int >::type batchSize(batchSizeSEXP);
+    rcpp_result_gen = Rcpp::wrap(ClusterCSVStream(filename, centroids, chunkSize, batchSize));
+    return rcpp_result_gen;
+END_RCPP
+}
 // knn_mlpackMain
-void knn_mlpackMain();
-RcppExport SEXP _RcppMLPACK_knn_mlpackMain() {
+void knn_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_knn_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    knn_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    knn_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamKNNModelPtr
-SEXP IO_GetParamKNNModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamKNNModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamKNNModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamKNNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamKNNModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamKNNModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamKNNModelPtr
-void IO_SetParamKNNModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamKNNModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamKNNModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamKNNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamKNNModelPtr(paramName, ptr);
+    IO_SetParamKNNModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -787,34 +909,124 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// SearchKNNModelPtr
+Rcpp::List SearchKNNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k);
+RcppExport SEXP _RcppMLPACK_SearchKNNModelPtr(SEXP ptrSEXP, SEXP querySEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(SearchKNNModelPtr(ptr, query, k));
+    return rcpp_result_gen;
+END_RCPP
+}
+// InsertKNNModelPtr
+Rcpp::NumericVector InsertKNNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& points);
+RcppExport SEXP _RcppMLPACK_InsertKNNModelPtr(SEXP ptrSEXP, SEXP pointsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type points(pointsSEXP);
+    rcpp_result_gen = Rcpp::wrap(InsertKNNModelPtr(ptr, points));
+    return rcpp_result_gen;
+END_RCPP
+}
+// RemoveKNNModelPtr
+void RemoveKNNModelPtr(SEXP ptr, SEXP ids);
+RcppExport SEXP _RcppMLPACK_RemoveKNNModelPtr(SEXP ptrSEXP, SEXP idsSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type ids(idsSEXP);
+    RemoveKNNModelPtr(ptr, ids);
+    return R_NilValue;
+END_RCPP
+}
+// SaveFlatKNNModelPtr
+void SaveFlatKNNModelPtr(SEXP ptr, const std::string& filename);
+RcppExport SEXP _RcppMLPACK_SaveFlatKNNModelPtr(SEXP ptrSEXP, SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    SaveFlatKNNModelPtr(ptr, filename);
+    return R_NilValue;
+END_RCPP
+}
+// LoadFlatKNNModelPtr
+SEXP LoadFlatKNNModelPtr(const std::string& filename);
+RcppExport SEXP _RcppMLPACK_LoadFlatKNNModelPtr(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(LoadFlatKNNModelPtr(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
+// SearchFlatKNNModelPtr
+Rcpp::List SearchFlatKNNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k);
+RcppExport SEXP _RcppMLPACK_SearchFlatKNNModelPtr(SEXP ptrSEXP, SEXP querySEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(SearchFlatKNNModelPtr(ptr, query, k));
+    return rcpp_result_gen;
+END_RCPP
+}
+// SearchUpdatedRectangleTree
+Rcpp::List SearchUpdatedRectangleTree(const std::string& treeType, const Rcpp::NumericMatrix& reference, int numBuilt, SEXP removed, const Rcpp::NumericMatrix& query, int k);
+RcppExport SEXP _RcppMLPACK_SearchUpdatedRectangleTree(SEXP treeTypeSEXP, SEXP referenceSEXP, SEXP numBuiltSEXP, SEXP removedSEXP, SEXP querySEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type treeType(treeTypeSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type reference(referenceSEXP);
+    Rcpp::traits::input_parameter< int >::type numBuilt(numBuiltSEXP);
+    Rcpp::traits::input_parameter< SEXP >::type removed(removedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(SearchUpdatedRectangleTree(treeType, reference, numBuilt, removed, query, k));
+    return rcpp_result_gen;
+END_RCPP
+}
 // krann_mlpackMain
-void krann_mlpackMain();
-RcppExport SEXP _RcppMLPACK_krann_mlpackMain() {
+void krann_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_krann_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    krann_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    krann_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamRANNModelPtr
-SEXP IO_GetParamRANNModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamRANNModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamRANNModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamRANNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamRANNModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamRANNModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamRANNModelPtr
-void IO_SetParamRANNModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamRANNModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamRANNModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamRANNModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamRANNModelPtr(paramName, ptr);
+    IO_SetParamRANNModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -840,34 +1052,50 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// SearchRANNModelPtr
+Rcpp::List SearchRANNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k);
+RcppExport SEXP _RcppMLPACK_SearchRANNModelPtr(SEXP ptrSEXP, SEXP querySEXP, SEXP kSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type query(querySEXP);
+    Rcpp::traits::input_parameter< int >::type k(kSEXP);
+    rcpp_result_gen = Rcpp::wrap(SearchRANNModelPtr(ptr, query, k));
+    return rcpp_result_gen;
+END_RCPP
+}
 // lars_mlpackMain
-void lars_mlpackMain();
-RcppExport SEXP _RcppMLPACK_lars_mlpackMain() {
+void lars_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_lars_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    lars_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    lars_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLARSPtr
-SEXP IO_GetParamLARSPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLARSPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLARSPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLARSPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLARSPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLARSPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLARSPtr
-void IO_SetParamLARSPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLARSPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLARSPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLARSPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLARSPtr(paramName, ptr);
+    IO_SetParamLARSPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -894,33 +1122,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // linear_regression_mlpackMain
-void linear_regression_mlpackMain();
-RcppExport SEXP _RcppMLPACK_linear_regression_mlpackMain() {
+void linear_regression_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_linear_regression_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    linear_regression_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    linear_regression_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLinearRegressionPtr
-SEXP IO_GetParamLinearRegressionPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLinearRegressionPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLinearRegressionPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLinearRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLinearRegressionPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLinearRegressionPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLinearRegressionPtr
-void IO_SetParamLinearRegressionPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLinearRegressionPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLinearRegressionPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLinearRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLinearRegressionPtr(paramName, ptr);
+    IO_SetParamLinearRegressionPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -947,33 +1178,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // linear_svm_mlpackMain
-void linear_svm_mlpackMain();
-RcppExport SEXP _RcppMLPACK_linear_svm_mlpackMain() {
+void linear_svm_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_linear_svm_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    linear_svm_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    linear_svm_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLinearSVMModelPtr
-SEXP IO_GetParamLinearSVMModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLinearSVMModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLinearSVMModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLinearSVMModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLinearSVMModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLinearSVMModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLinearSVMModelPtr
-void IO_SetParamLinearSVMModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLinearSVMModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLinearSVMModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLinearSVMModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLinearSVMModelPtr(paramName, ptr);
+    IO_SetParamLinearSVMModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1000,42 +1234,46 @@ BEGIN_RCPP
 END_RCPP
 }
 // lmnn_mlpackMain
-void lmnn_mlpackMain();
-RcppExport SEXP _RcppMLPACK_lmnn_mlpackMain() {
+void lmnn_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_lmnn_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    lmnn_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    lmnn_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // local_coordinate_coding_mlpackMain
-void local_coordinate_coding_mlpackMain();
-RcppExport SEXP _RcppMLPACK_local_coordinate_coding_mlpackMain() {
+void local_coordinate_coding_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_local_coordinate_coding_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    local_coordinate_coding_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    local_coordinate_coding_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLocalCoordinateCodingPtr
-SEXP IO_GetParamLocalCoordinateCodingPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLocalCoordinateCodingPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLocalCoordinateCodingPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLocalCoordinateCodingPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLocalCoordinateCodingPtr
-void IO_SetParamLocalCoordinateCodingPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLocalCoordinateCodingPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLocalCoordinateCodingPtr(paramName, ptr);
+    IO_SetParamLocalCoordinateCodingPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1062,33 +1300,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // logistic_regression_mlpackMain
-void logistic_regression_mlpackMain();
-RcppExport SEXP _RcppMLPACK_logistic_regression_mlpackMain() {
+void logistic_regression_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_logistic_regression_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    logistic_regression_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    logistic_regression_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLogisticRegressionPtr
-SEXP IO_GetParamLogisticRegressionPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLogisticRegressionPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLogisticRegressionPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLogisticRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLogisticRegressionPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLogisticRegressionPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLogisticRegressionPtr
-void IO_SetParamLogisticRegressionPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLogisticRegressionPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLogisticRegressionPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLogisticRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLogisticRegressionPtr(paramName, ptr);
+    IO_SetParamLogisticRegressionPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1115,33 +1356,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // lsh_mlpackMain
-void lsh_mlpackMain();
-RcppExport SEXP _RcppMLPACK_lsh_mlpackMain() {
+void lsh_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_lsh_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    lsh_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    lsh_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamLSHSearchPtr
-SEXP IO_GetParamLSHSearchPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamLSHSearchPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamLSHSearchPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamLSHSearchPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamLSHSearchPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamLSHSearchPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamLSHSearchPtr
-void IO_SetParamLSHSearchPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamLSHSearchPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamLSHSearchPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamLSHSearchPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamLSHSearchPtr(paramName, ptr);
+    IO_SetParamLSHSearchPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1168,42 +1412,46 @@ BEGIN_RCPP
 END_RCPP
 }
 // mean_shift_mlpackMain
-void mean_shift_mlpackMain();
-RcppExport SEXP _RcppMLPACK_mean_shift_mlpackMain() {
+void mean_shift_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_mean_shift_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    mean_shift_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    mean_shift_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // nbc_mlpackMain
-void nbc_mlpackMain();
-RcppExport SEXP _RcppMLPACK_nbc_mlpackMain() {
+void nbc_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_nbc_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    nbc_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    nbc_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamNBCModelPtr
-SEXP IO_GetParamNBCModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamNBCModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamNBCModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamNBCModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamNBCModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamNBCModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamNBCModelPtr
-void IO_SetParamNBCModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamNBCModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamNBCModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamNBCModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamNBCModelPtr(paramName, ptr);
+    IO_SetParamNBCModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1230,60 +1478,66 @@ BEGIN_RCPP
 END_RCPP
 }
 // nca_mlpackMain
-void nca_mlpackMain();
-RcppExport SEXP _RcppMLPACK_nca_mlpackMain() {
+void nca_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_nca_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    nca_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    nca_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // nmf_mlpackMain
-void nmf_mlpackMain();
-RcppExport SEXP _RcppMLPACK_nmf_mlpackMain() {
+void nmf_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_nmf_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    nmf_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    nmf_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // pca_mlpackMain
-void pca_mlpackMain();
-RcppExport SEXP _RcppMLPACK_pca_mlpackMain() {
+void pca_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_pca_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    pca_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    pca_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // perceptron_mlpackMain
-void perceptron_mlpackMain();
-RcppExport SEXP _RcppMLPACK_perceptron_mlpackMain() {
+void perceptron_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_perceptron_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    perceptron_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    perceptron_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamPerceptronModelPtr
-SEXP IO_GetParamPerceptronModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamPerceptronModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamPerceptronModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamPerceptronModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamPerceptronModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamPerceptronModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamPerceptronModelPtr
-void IO_SetParamPerceptronModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamPerceptronModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamPerceptronModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamPerceptronModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamPerceptronModelPtr(paramName, ptr);
+    IO_SetParamPerceptronModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1310,51 +1564,56 @@ BEGIN_RCPP
 END_RCPP
 }
 // preprocess_binarize_mlpackMain
-void preprocess_binarize_mlpackMain();
-RcppExport SEXP _RcppMLPACK_preprocess_binarize_mlpackMain() {
+void preprocess_binarize_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_preprocess_binarize_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    preprocess_binarize_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    preprocess_binarize_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // preprocess_describe_mlpackMain
-void preprocess_describe_mlpackMain();
-RcppExport SEXP _RcppMLPACK_preprocess_describe_mlpackMain() {
+void preprocess_describe_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_preprocess_describe_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    preprocess_describe_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    preprocess_describe_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // preprocess_scale_mlpackMain
-void preprocess_scale_mlpackMain();
-RcppExport SEXP _RcppMLPACK_preprocess_scale_mlpackMain() {
+void preprocess_scale_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_preprocess_scale_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    preprocess_scale_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    preprocess_scale_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamScalingModelPtr
-SEXP IO_GetParamScalingModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamScalingModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamScalingModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamScalingModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamScalingModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamScalingModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamScalingModelPtr
-void IO_SetParamScalingModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamScalingModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamScalingModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamScalingModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamScalingModelPtr(paramName, ptr);
+    IO_SetParamScalingModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1381,308 +1640,336 @@ BEGIN_RCPP
 END_RCPP
 }
 // preprocess_split_mlpackMain
-void preprocess_split_mlpackMain();
-RcppExport SEXP _RcppMLPACK_preprocess_split_mlpackMain() {
+void preprocess_split_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_preprocess_split_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    preprocess_split_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    preprocess_split_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
-// IO_RestoreSettings
-void IO_RestoreSettings(const std::string& programName);
-RcppExport SEXP _RcppMLPACK_IO_RestoreSettings(SEXP programNameSEXP) {
+// IO_MakeParams
+SEXP IO_MakeParams(const std::string& programName);
+RcppExport SEXP _RcppMLPACK_IO_MakeParams(SEXP programNameSEXP) {
 BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const std::string& >::type programName(programNameSEXP);
-    IO_RestoreSettings(programName);
-    return R_NilValue;
+    rcpp_result_gen = Rcpp::wrap(IO_MakeParams(programName));
+    return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamInt
-void IO_SetParamInt(const std::string& paramName, int paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamInt(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamInt(SEXP params, const std::string& paramName, int paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamInt(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< int >::type paramValue(paramValueSEXP);
-    IO_SetParamInt(paramName, paramValue);
+    IO_SetParamInt(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamDouble
-void IO_SetParamDouble(const std::string& paramName, double paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamDouble(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamDouble(SEXP params, const std::string& paramName, double paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamDouble(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< double >::type paramValue(paramValueSEXP);
-    IO_SetParamDouble(paramName, paramValue);
+    IO_SetParamDouble(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamString
-void IO_SetParamString(const std::string& paramName, std::string& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamString(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamString(SEXP params, const std::string& paramName, std::string& paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamString(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< std::string& >::type paramValue(paramValueSEXP);
-    IO_SetParamString(paramName, paramValue);
+    IO_SetParamString(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamBool
-void IO_SetParamBool(const std::string& paramName, bool paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamBool(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamBool(SEXP params, const std::string& paramName, bool paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamBool(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< bool >::type paramValue(paramValueSEXP);
-    IO_SetParamBool(paramName, paramValue);
+    IO_SetParamBool(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamVecString
-void IO_SetParamVecString(const std::string& paramName, const std::vector<std::string>& str);
-RcppExport SEXP _RcppMLPACK_IO_SetParamVecString(SEXP paramNameSEXP, SEXP strSEXP) {
+void IO_SetParamVecString(SEXP params, const std::string& paramName, const std::vector<std::string>& str);
+RcppExport SEXP _RcppMLPACK_IO_SetParamVecString(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP strSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< const std::vector<std::string>& >::type str(strSEXP);
-    IO_SetParamVecString(paramName, str);
+    IO_SetParamVecString(params, paramName, str);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamVecInt
-void IO_SetParamVecInt(const std::string& paramName, const std::vector<int>& ints);
-RcppExport SEXP _RcppMLPACK_IO_SetParamVecInt(SEXP paramNameSEXP, SEXP intsSEXP) {
+void IO_SetParamVecInt(SEXP params, const std::string& paramName, const std::vector<int>& ints);
+RcppExport SEXP _RcppMLPACK_IO_SetParamVecInt(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP intsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< const std::vector<int>& >::type ints(intsSEXP);
-    IO_SetParamVecInt(paramName, ints);
+    IO_SetParamVecInt(params, paramName, ints);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamMat
-void IO_SetParamMat(const std::string& paramName, const arma::mat& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamMat(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamMat(SEXP params, const std::string& paramName, const NumericMatrix& paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamMat(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    Rcpp::traits::input_parameter< const arma::mat& >::type paramValue(paramValueSEXP);
-    IO_SetParamMat(paramName, paramValue);
+    Rcpp::traits::input_parameter< const NumericMatrix& >::type paramValue(paramValueSEXP);
+    IO_SetParamMat(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamUMat
-void IO_SetParamUMat(const std::string& paramName, const arma::Mat<size_t>& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamUMat(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamUMat(SEXP params, const std::string& paramName, SEXP paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamUMat(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    Rcpp::traits::input_parameter< const arma::Mat<size_t>& >::type paramValue(paramValueSEXP);
-    IO_SetParamUMat(paramName, paramValue);
+    Rcpp::traits::input_parameter< SEXP >::type paramValue(paramValueSEXP);
+    IO_SetParamUMat(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamRow
-void IO_SetParamRow(const std::string& paramName, const arma::rowvec& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamRow(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamRow(SEXP params, const std::string& paramName, const arma::rowvec& paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamRow(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< const arma::rowvec& >::type paramValue(paramValueSEXP);
-    IO_SetParamRow(paramName, paramValue);
+    IO_SetParamRow(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamURow
-void IO_SetParamURow(const std::string& paramName, const arma::Row<size_t>& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamURow(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamURow(SEXP params, const std::string& paramName, SEXP paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamURow(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    Rcpp::traits::input_parameter< const arma::Row<size_t>& >::type paramValue(paramValueSEXP);
-    IO_SetParamURow(paramName, paramValue);
+    Rcpp::traits::input_parameter< SEXP >::type paramValue(paramValueSEXP);
+    IO_SetParamURow(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamCol
-void IO_SetParamCol(const std::string& paramName, const arma::vec& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamCol(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamCol(SEXP params, const std::string& paramName, const arma::vec& paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamCol(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< const arma::vec& >::type paramValue(paramValueSEXP);
-    IO_SetParamCol(paramName, paramValue);
+    IO_SetParamCol(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamUCol
-void IO_SetParamUCol(const std::string& paramName, const arma::Col<size_t>& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamUCol(SEXP paramNameSEXP, SEXP paramValueSEXP) {
+void IO_SetParamUCol(SEXP params, const std::string& paramName, SEXP paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamUCol(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    Rcpp::traits::input_parameter< const arma::Col<size_t>& >::type paramValue(paramValueSEXP);
-    IO_SetParamUCol(paramName, paramValue);
+    Rcpp::traits::input_parameter< SEXP >::type paramValue(paramValueSEXP);
+    IO_SetParamUCol(params, paramName, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_SetParamMatWithInfo
-void IO_SetParamMatWithInfo(const std::string& paramName, const LogicalVector& dimensions, const arma::mat& paramValue);
-RcppExport SEXP _RcppMLPACK_IO_SetParamMatWithInfo(SEXP paramNameSEXP, SEXP dimensionsSEXP, SEXP paramValueSEXP) {
+void IO_SetParamMatWithInfo(SEXP params, const std::string& paramName, const LogicalVector& dimensions, const arma::mat& paramValue);
+RcppExport SEXP _RcppMLPACK_IO_SetParamMatWithInfo(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP dimensionsSEXP, SEXP paramValueSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< const LogicalVector& >::type dimensions(dimensionsSEXP);
     Rcpp::traits::input_parameter< const arma::mat& >::type paramValue(paramValueSEXP);
-    IO_SetParamMatWithInfo(paramName, dimensions, paramValue);
+    IO_SetParamMatWithInfo(params, paramName, dimensions, paramValue);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamInt
-int IO_GetParamInt(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamInt(SEXP paramNameSEXP) {
+int IO_GetParamInt(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamInt(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamInt(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamInt(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamDouble
-double IO_GetParamDouble(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamDouble(SEXP paramNameSEXP) {
+double IO_GetParamDouble(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamDouble(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamDouble(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamDouble(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamString
-std::string& IO_GetParamString(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamString(SEXP paramNameSEXP) {
+std::string& IO_GetParamString(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamString(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamString(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamString(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamBool
-bool IO_GetParamBool(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamBool(SEXP paramNameSEXP) {
+bool IO_GetParamBool(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamBool(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamBool(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamBool(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamVecString
-const std::vector<std::string>& IO_GetParamVecString(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamVecString(SEXP paramNameSEXP) {
+const std::vector<std::string>& IO_GetParamVecString(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamVecString(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamVecString(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamVecString(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamVecInt
-const std::vector<int>& IO_GetParamVecInt(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamVecInt(SEXP paramNameSEXP) {
+const std::vector<int>& IO_GetParamVecInt(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamVecInt(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamVecInt(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamVecInt(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamMat
-const arma::mat& IO_GetParamMat(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamMat(SEXP paramNameSEXP) {
+NumericMatrix IO_GetParamMat(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamMat(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamMat(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamMat(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamUMat
-const arma::Mat<size_t>& IO_GetParamUMat(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamUMat(SEXP paramNameSEXP) {
+SEXP IO_GetParamUMat(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamUMat(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamUMat(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamUMat(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamRow
-const arma::vec IO_GetParamRow(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamRow(SEXP paramNameSEXP) {
+const arma::vec IO_GetParamRow(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamRow(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamRow(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamRow(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamURow
-const arma::Col<size_t> IO_GetParamURow(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamURow(SEXP paramNameSEXP) {
+SEXP IO_GetParamURow(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamURow(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamURow(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamURow(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamCol
-const arma::rowvec IO_GetParamCol(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamCol(SEXP paramNameSEXP) {
+const arma::rowvec IO_GetParamCol(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamCol(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamCol(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamCol(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamUCol
-const arma::Row<size_t> IO_GetParamUCol(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamUCol(SEXP paramNameSEXP) {
+SEXP IO_GetParamUCol(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamUCol(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamUCol(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamUCol(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_GetParamMatWithInfo
-List IO_GetParamMatWithInfo(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamMatWithInfo(SEXP paramNameSEXP) {
+List IO_GetParamMatWithInfo(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamMatWithInfo(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamMatWithInfo(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamMatWithInfo(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1713,62 +2000,131 @@ BEGIN_RCPP
     return R_NilValue;
 END_RCPP
 }
+// IO_EnableTiming
+void IO_EnableTiming();
+RcppExport SEXP _RcppMLPACK_IO_EnableTiming() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    IO_EnableTiming();
+    return R_NilValue;
+END_RCPP
+}
+// IO_DisableTiming
+void IO_DisableTiming();
+RcppExport SEXP _RcppMLPACK_IO_DisableTiming() {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    IO_DisableTiming();
+    return R_NilValue;
+END_RCPP
+}
+// IO_GetTimers
+Rcpp::NumericVector IO_GetTimers();
+RcppExport SEXP _RcppMLPACK_IO_GetTimers() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(IO_GetTimers());
+    return rcpp_result_gen;
+END_RCPP
+}
+// IO_SaveDataset
+void IO_SaveDataset(const Rcpp::NumericMatrix& x, const std::string& filename);
+RcppExport SEXP _RcppMLPACK_IO_SaveDataset(SEXP xSEXP, SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    IO_SaveDataset(x, filename);
+    return R_NilValue;
+END_RCPP
+}
+// IO_LoadDataset
+Rcpp::NumericMatrix IO_LoadDataset(const std::string& filename, const bool colMajor);
+RcppExport SEXP _RcppMLPACK_IO_LoadDataset(SEXP filenameSEXP, SEXP colMajorSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    Rcpp::traits::input_parameter< const bool >::type colMajor(colMajorSEXP);
+    rcpp_result_gen = Rcpp::wrap(IO_LoadDataset(filename, colMajor));
+    return rcpp_result_gen;
+END_RCPP
+}
+// IO_LoadCSV
+List IO_LoadCSV(const std::string& filename, int maxPoints);
+RcppExport SEXP _RcppMLPACK_IO_LoadCSV(SEXP filenameSEXP, SEXP maxPointsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    Rcpp::traits::input_parameter< int >::type maxPoints(maxPointsSEXP);
+    rcpp_result_gen = Rcpp::wrap(IO_LoadCSV(filename, maxPoints));
+    return rcpp_result_gen;
+END_RCPP
+}
 // IO_SetPassed
-void IO_SetPassed(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_SetPassed(SEXP paramNameSEXP) {
+void IO_SetPassed(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_SetPassed(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    IO_SetPassed(paramName);
+    IO_SetPassed(params, paramName);
     return R_NilValue;
 END_RCPP
 }
 // IO_ClearSettings
-void IO_ClearSettings();
-RcppExport SEXP _RcppMLPACK_IO_ClearSettings() {
+void IO_ClearSettings(SEXP params);
+RcppExport SEXP _RcppMLPACK_IO_ClearSettings(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    IO_ClearSettings();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    IO_ClearSettings(params);
     return R_NilValue;
 END_RCPP
 }
 // radical_mlpackMain
-void radical_mlpackMain();
-RcppExport SEXP _RcppMLPACK_radical_mlpackMain() {
+void radical_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_radical_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    radical_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    radical_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // random_forest_mlpackMain
-void random_forest_mlpackMain();
-RcppExport SEXP _RcppMLPACK_random_forest_mlpackMain() {
+void random_forest_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_random_forest_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    random_forest_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    random_forest_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamRandomForestModelPtr
-SEXP IO_GetParamRandomForestModelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamRandomForestModelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamRandomForestModelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamRandomForestModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamRandomForestModelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamRandomForestModelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamRandomForestModelPtr
-void IO_SetParamRandomForestModelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamRandomForestModelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamRandomForestModelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamRandomForestModelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamRandomForestModelPtr(paramName, ptr);
+    IO_SetParamRandomForestModelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1794,34 +2150,71 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// SaveFlatRandomForestModelPtr
+void SaveFlatRandomForestModelPtr(SEXP ptr, const std::string& filename);
+RcppExport SEXP _RcppMLPACK_SaveFlatRandomForestModelPtr(SEXP ptrSEXP, SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    SaveFlatRandomForestModelPtr(ptr, filename);
+    return R_NilValue;
+END_RCPP
+}
+// LoadFlatRandomForestModelPtr
+SEXP LoadFlatRandomForestModelPtr(const std::string& filename);
+RcppExport SEXP _RcppMLPACK_LoadFlatRandomForestModelPtr(SEXP filenameSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const std::string& >::type filename(filenameSEXP);
+    rcpp_result_gen = Rcpp::wrap(LoadFlatRandomForestModelPtr(filename));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ClassifyFlatRandomForestModelPtr
+Rcpp::List ClassifyFlatRandomForestModelPtr(SEXP ptr, const Rcpp::NumericMatrix& test);
+RcppExport SEXP _RcppMLPACK_ClassifyFlatRandomForestModelPtr(SEXP ptrSEXP, SEXP testSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type test(testSEXP);
+    rcpp_result_gen = Rcpp::wrap(ClassifyFlatRandomForestModelPtr(ptr, test));
+    return rcpp_result_gen;
+END_RCPP
+}
 // softmax_regression_mlpackMain
-void softmax_regression_mlpackMain();
-RcppExport SEXP _RcppMLPACK_softmax_regression_mlpackMain() {
+void softmax_regression_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_softmax_regression_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    softmax_regression_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    softmax_regression_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamSoftmaxRegressionPtr
-SEXP IO_GetParamSoftmaxRegressionPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamSoftmaxRegressionPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamSoftmaxRegressionPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamSoftmaxRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamSoftmaxRegressionPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamSoftmaxRegressionPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamSoftmaxRegressionPtr
-void IO_SetParamSoftmaxRegressionPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamSoftmaxRegressionPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamSoftmaxRegressionPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamSoftmaxRegressionPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamSoftmaxRegressionPtr(paramName, ptr);
+    IO_SetParamSoftmaxRegressionPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1848,33 +2241,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // sparse_coding_mlpackMain
-void sparse_coding_mlpackMain();
-RcppExport SEXP _RcppMLPACK_sparse_coding_mlpackMain() {
+void sparse_coding_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_sparse_coding_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    sparse_coding_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    sparse_coding_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamSparseCodingPtr
-SEXP IO_GetParamSparseCodingPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamSparseCodingPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamSparseCodingPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamSparseCodingPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamSparseCodingPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamSparseCodingPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamSparseCodingPtr
-void IO_SetParamSparseCodingPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamSparseCodingPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamSparseCodingPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamSparseCodingPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamSparseCodingPtr(paramName, ptr);
+    IO_SetParamSparseCodingPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1901,33 +2297,36 @@ BEGIN_RCPP
 END_RCPP
 }
 // test_r_binding_mlpackMain
-void test_r_binding_mlpackMain();
-RcppExport SEXP _RcppMLPACK_test_r_binding_mlpackMain() {
+void test_r_binding_mlpackMain(SEXP params);
+RcppExport SEXP _RcppMLPACK_test_r_binding_mlpackMain(SEXP paramsSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
-    test_r_binding_mlpackMain();
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
+    test_r_binding_mlpackMain(params);
     return R_NilValue;
 END_RCPP
 }
 // IO_GetParamGaussianKernelPtr
-SEXP IO_GetParamGaussianKernelPtr(const std::string& paramName);
-RcppExport SEXP _RcppMLPACK_IO_GetParamGaussianKernelPtr(SEXP paramNameSEXP) {
+SEXP IO_GetParamGaussianKernelPtr(SEXP params, const std::string& paramName);
+RcppExport SEXP _RcppMLPACK_IO_GetParamGaussianKernelPtr(SEXP paramsSEXP, SEXP paramNameSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
-    rcpp_result_gen = Rcpp::wrap(IO_GetParamGaussianKernelPtr(paramName));
+    rcpp_result_gen = Rcpp::wrap(IO_GetParamGaussianKernelPtr(params, paramName));
     return rcpp_result_gen;
 END_RCPP
 }
 // IO_SetParamGaussianKernelPtr
-void IO_SetParamGaussianKernelPtr(const std::string& paramName, SEXP ptr);
-RcppExport SEXP _RcppMLPACK_IO_SetParamGaussianKernelPtr(SEXP paramNameSEXP, SEXP ptrSEXP) {
+void IO_SetParamGaussianKernelPtr(SEXP params, const std::string& paramName, SEXP ptr);
+RcppExport SEXP _RcppMLPACK_IO_SetParamGaussianKernelPtr(SEXP paramsSEXP, SEXP paramNameSEXP, SEXP ptrSEXP) {
 BEGIN_RCPP
     Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< SEXP >::type params(paramsSEXP);
     Rcpp::traits::input_parameter< const std::string& >::type paramName(paramNameSEXP);
     Rcpp::traits::input_parameter< SEXP >::type ptr(ptrSEXP);
-    IO_SetParamGaussianKernelPtr(paramName, ptr);
+    IO_SetParamGaussianKernelPtr(params, paramName, ptr);
     return R_NilValue;
 END_RCPP
 }
@@ -1955,190 +2354,213 @@ END_RCPP
 }
 
 static const R_CallMethodDef CallEntries[] = {
-    {"_RcppMLPACK_adaboost_mlpackMain", (DL_FUNC) &_RcppMLPACK_adaboost_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamAdaBoostModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamAdaBoostModelPtr, 2},
+    {"_RcppMLPACK_adaboost_mlpackMain", (DL_FUNC) &_RcppMLPACK_adaboost_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamAdaBoostModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamAdaBoostModelPtr, 3},
     {"_RcppMLPACK_SerializeAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeAdaBoostModelPtr, 1},
     {"_RcppMLPACK_DeserializeAdaBoostModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeAdaBoostModelPtr, 1},
-    {"_RcppMLPACK_approx_kfn_mlpackMain", (DL_FUNC) &_RcppMLPACK_approx_kfn_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamApproxKFNModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamApproxKFNModelPtr, 2},
+    {"_RcppMLPACK_approx_kfn_mlpackMain", (DL_FUNC) &_RcppMLPACK_approx_kfn_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamApproxKFNModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamApproxKFNModelPtr, 3},
     {"_RcppMLPACK_SerializeApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeApproxKFNModelPtr, 1},
     {"_RcppMLPACK_DeserializeApproxKFNModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeApproxKFNModelPtr, 1},
-    {"_RcppMLPACK_cf_mlpackMain", (DL_FUNC) &_RcppMLPACK_cf_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamCFModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamCFModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamCFModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamCFModelPtr, 2},
+    {"_RcppMLPACK_cf_mlpackMain", (DL_FUNC) &_RcppMLPACK_cf_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamCFModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamCFModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamCFModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamCFModelPtr, 3},
     {"_RcppMLPACK_SerializeCFModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeCFModelPtr, 1},
     {"_RcppMLPACK_DeserializeCFModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeCFModelPtr, 1},
-    {"_RcppMLPACK_dbscan_mlpackMain", (DL_FUNC) &_RcppMLPACK_dbscan_mlpackMain, 0},
-    {"_RcppMLPACK_decision_stump_mlpackMain", (DL_FUNC) &_RcppMLPACK_decision_stump_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamDSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDSModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamDSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDSModelPtr, 2},
+    {"_RcppMLPACK_dbscan_mlpackMain", (DL_FUNC) &_RcppMLPACK_dbscan_mlpackMain, 1},
+    {"_RcppMLPACK_decision_stump_mlpackMain", (DL_FUNC) &_RcppMLPACK_decision_stump_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamDSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDSModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamDSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDSModelPtr, 3},
     {"_RcppMLPACK_SerializeDSModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeDSModelPtr, 1},
     {"_RcppMLPACK_DeserializeDSModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeDSModelPtr, 1},
-    {"_RcppMLPACK_decision_tree_mlpackMain", (DL_FUNC) &_RcppMLPACK_decision_tree_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDecisionTreeModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDecisionTreeModelPtr, 2},
+    {"_RcppMLPACK_decision_tree_mlpackMain", (DL_FUNC) &_RcppMLPACK_decision_tree_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDecisionTreeModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDecisionTreeModelPtr, 3},
     {"_RcppMLPACK_SerializeDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeDecisionTreeModelPtr, 1},
     {"_RcppMLPACK_DeserializeDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeDecisionTreeModelPtr, 1},
-    {"_RcppMLPACK_det_mlpackMain", (DL_FUNC) &_RcppMLPACK_det_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamDTreePtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDTreePtr, 1},
-    {"_RcppMLPACK_IO_SetParamDTreePtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDTreePtr, 2},
+    {"_RcppMLPACK_SaveFlatDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_SaveFlatDecisionTreeModelPtr, 2},
+    {"_RcppMLPACK_LoadFlatDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_LoadFlatDecisionTreeModelPtr, 1},
+    {"_RcppMLPACK_ClassifyFlatDecisionTreeModelPtr", (DL_FUNC) &_RcppMLPACK_ClassifyFlatDecisionTreeModelPtr, 2},
+    {"_RcppMLPACK_det_mlpackMain", (DL_FUNC) &_RcppMLPACK_det_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamDTreePtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamDTreePtr, 2},
+    {"_RcppMLPACK_IO_SetParamDTreePtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamDTreePtr, 3},
     {"_RcppMLPACK_SerializeDTreePtr", (DL_FUNC) &_RcppMLPACK_SerializeDTreePtr, 1},
     {"_RcppMLPACK_DeserializeDTreePtr", (DL_FUNC) &_RcppMLPACK_DeserializeDTreePtr, 1},
-    {"_RcppMLPACK_emst_mlpackMain", (DL_FUNC) &_RcppMLPACK_emst_mlpackMain, 0},
-    {"_RcppMLPACK_fastmks_mlpackMain", (DL_FUNC) &_RcppMLPACK_fastmks_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamFastMKSModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamFastMKSModelPtr, 2},
+    {"_RcppMLPACK_emst_mlpackMain", (DL_FUNC) &_RcppMLPACK_emst_mlpackMain, 1},
+    {"_RcppMLPACK_fastmks_mlpackMain", (DL_FUNC) &_RcppMLPACK_fastmks_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamFastMKSModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamFastMKSModelPtr, 3},
     {"_RcppMLPACK_SerializeFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeFastMKSModelPtr, 1},
     {"_RcppMLPACK_DeserializeFastMKSModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeFastMKSModelPtr, 1},
-    {"_RcppMLPACK_gmm_generate_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_generate_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamGMMPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamGMMPtr, 1},
-    {"_RcppMLPACK_IO_SetParamGMMPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamGMMPtr, 2},
+    {"_RcppMLPACK_gmm_generate_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_generate_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamGMMPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamGMMPtr, 2},
+    {"_RcppMLPACK_IO_SetParamGMMPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamGMMPtr, 3},
     {"_RcppMLPACK_SerializeGMMPtr", (DL_FUNC) &_RcppMLPACK_SerializeGMMPtr, 1},
     {"_RcppMLPACK_DeserializeGMMPtr", (DL_FUNC) &_RcppMLPACK_DeserializeGMMPtr, 1},
-    {"_RcppMLPACK_gmm_probability_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_probability_mlpackMain, 0},
-    {"_RcppMLPACK_gmm_train_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_train_mlpackMain, 0},
-    {"_RcppMLPACK_hmm_generate_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_generate_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamHMMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamHMMModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamHMMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamHMMModelPtr, 2},
+    {"_RcppMLPACK_gmm_probability_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_probability_mlpackMain, 1},
+    {"_RcppMLPACK_gmm_train_mlpackMain", (DL_FUNC) &_RcppMLPACK_gmm_train_mlpackMain, 1},
+    {"_RcppMLPACK_hmm_generate_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_generate_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamHMMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamHMMModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamHMMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamHMMModelPtr, 3},
     {"_RcppMLPACK_SerializeHMMModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeHMMModelPtr, 1},
     {"_RcppMLPACK_DeserializeHMMModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeHMMModelPtr, 1},
-    {"_RcppMLPACK_hmm_loglik_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_loglik_mlpackMain, 0},
-    {"_RcppMLPACK_hmm_train_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_train_mlpackMain, 0},
-    {"_RcppMLPACK_hmm_viterbi_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_viterbi_mlpackMain, 0},
-    {"_RcppMLPACK_hoeffding_tree_mlpackMain", (DL_FUNC) &_RcppMLPACK_hoeffding_tree_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr, 2},
+    {"_RcppMLPACK_hmm_loglik_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_loglik_mlpackMain, 1},
+    {"_RcppMLPACK_hmm_train_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_train_mlpackMain, 1},
+    {"_RcppMLPACK_hmm_viterbi_mlpackMain", (DL_FUNC) &_RcppMLPACK_hmm_viterbi_mlpackMain, 1},
+    {"_RcppMLPACK_hoeffding_tree_mlpackMain", (DL_FUNC) &_RcppMLPACK_hoeffding_tree_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamHoeffdingTreeModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamHoeffdingTreeModelPtr, 3},
     {"_RcppMLPACK_SerializeHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeHoeffdingTreeModelPtr, 1},
     {"_RcppMLPACK_DeserializeHoeffdingTreeModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeHoeffdingTreeModelPtr, 1},
-    {"_RcppMLPACK_image_converter_mlpackMain", (DL_FUNC) &_RcppMLPACK_image_converter_mlpackMain, 0},
-    {"_RcppMLPACK_kde_mlpackMain", (DL_FUNC) &_RcppMLPACK_kde_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamKDEModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKDEModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamKDEModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKDEModelPtr, 2},
+    {"_RcppMLPACK_image_converter_mlpackMain", (DL_FUNC) &_RcppMLPACK_image_converter_mlpackMain, 1},
+    {"_RcppMLPACK_kde_mlpackMain", (DL_FUNC) &_RcppMLPACK_kde_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamKDEModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKDEModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamKDEModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKDEModelPtr, 3},
     {"_RcppMLPACK_SerializeKDEModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeKDEModelPtr, 1},
     {"_RcppMLPACK_DeserializeKDEModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeKDEModelPtr, 1},
-    {"_RcppMLPACK_kernel_pca_mlpackMain", (DL_FUNC) &_RcppMLPACK_kernel_pca_mlpackMain, 0},
-    {"_RcppMLPACK_kfn_mlpackMain", (DL_FUNC) &_RcppMLPACK_kfn_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKFNModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKFNModelPtr, 2},
+    {"_RcppMLPACK_EvaluateKDEModelPtr", (DL_FUNC) &_RcppMLPACK_EvaluateKDEModelPtr, 2},
+    {"_RcppMLPACK_kernel_pca_mlpackMain", (DL_FUNC) &_RcppMLPACK_kernel_pca_mlpackMain, 1},
+    {"_RcppMLPACK_kfn_mlpackMain", (DL_FUNC) &_RcppMLPACK_kfn_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKFNModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamKFNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKFNModelPtr, 3},
     {"_RcppMLPACK_SerializeKFNModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeKFNModelPtr, 1},
     {"_RcppMLPACK_DeserializeKFNModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeKFNModelPtr, 1},
-    {"_RcppMLPACK_kmeans_mlpackMain", (DL_FUNC) &_RcppMLPACK_kmeans_mlpackMain, 0},
-    {"_RcppMLPACK_knn_mlpackMain", (DL_FUNC) &_RcppMLPACK_knn_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamKNNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKNNModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamKNNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKNNModelPtr, 2},
+    {"_RcppMLPACK_SearchKFNModelPtr", (DL_FUNC) &_RcppMLPACK_SearchKFNModelPtr, 3},
+    {"_RcppMLPACK_kmeans_mlpackMain", (DL_FUNC) &_RcppMLPACK_kmeans_mlpackMain, 1},
+    {"_RcppMLPACK_ClusterCSVStream", (DL_FUNC) &_RcppMLPACK_ClusterCSVStream, 4},
+    {"_RcppMLPACK_knn_mlpackMain", (DL_FUNC) &_RcppMLPACK_knn_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamKNNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamKNNModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamKNNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamKNNModelPtr, 3},
     {"_RcppMLPACK_SerializeKNNModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeKNNModelPtr, 1},
     {"_RcppMLPACK_DeserializeKNNModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeKNNModelPtr, 1},
-    {"_RcppMLPACK_krann_mlpackMain", (DL_FUNC) &_RcppMLPACK_krann_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamRANNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamRANNModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamRANNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamRANNModelPtr, 2},
+    {"_RcppMLPACK_SearchKNNModelPtr", (DL_FUNC) &_RcppMLPACK_SearchKNNModelPtr, 3},
+    {"_RcppMLPACK_InsertKNNModelPtr", (DL_FUNC) &_RcppMLPACK_InsertKNNModelPtr, 2},
+    {"_RcppMLPACK_RemoveKNNModelPtr", (DL_FUNC) &_RcppMLPACK_RemoveKNNModelPtr, 2},
+    {"_RcppMLPACK_SaveFlatKNNModelPtr", (DL_FUNC) &_RcppMLPACK_SaveFlatKNNModelPtr, 2},
+    {"_RcppMLPACK_LoadFlatKNNModelPtr", (DL_FUNC) &_RcppMLPACK_LoadFlatKNNModelPtr, 1},
+    {"_RcppMLPACK_SearchFlatKNNModelPtr", (DL_FUNC) &_RcppMLPACK_SearchFlatKNNModelPtr, 3},
+    {"_RcppMLPACK_SearchUpdatedRectangleTree", (DL_FUNC) &_RcppMLPACK_SearchUpdatedRectangleTree, 6},
+    {"_RcppMLPACK_krann_mlpackMain", (DL_FUNC) &_RcppMLPACK_krann_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamRANNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamRANNModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamRANNModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamRANNModelPtr, 3},
     {"_RcppMLPACK_SerializeRANNModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeRANNModelPtr, 1},
     {"_RcppMLPACK_DeserializeRANNModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeRANNModelPtr, 1},
-    {"_RcppMLPACK_lars_mlpackMain", (DL_FUNC) &_RcppMLPACK_lars_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLARSPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLARSPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLARSPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLARSPtr, 2},
+    {"_RcppMLPACK_SearchRANNModelPtr", (DL_FUNC) &_RcppMLPACK_SearchRANNModelPtr, 3},
+    {"_RcppMLPACK_lars_mlpackMain", (DL_FUNC) &_RcppMLPACK_lars_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLARSPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLARSPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLARSPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLARSPtr, 3},
     {"_RcppMLPACK_SerializeLARSPtr", (DL_FUNC) &_RcppMLPACK_SerializeLARSPtr, 1},
     {"_RcppMLPACK_DeserializeLARSPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLARSPtr, 1},
-    {"_RcppMLPACK_linear_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_linear_regression_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLinearRegressionPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLinearRegressionPtr, 2},
+    {"_RcppMLPACK_linear_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_linear_regression_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLinearRegressionPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLinearRegressionPtr, 3},
     {"_RcppMLPACK_SerializeLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_SerializeLinearRegressionPtr, 1},
     {"_RcppMLPACK_DeserializeLinearRegressionPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLinearRegressionPtr, 1},
-    {"_RcppMLPACK_linear_svm_mlpackMain", (DL_FUNC) &_RcppMLPACK_linear_svm_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLinearSVMModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLinearSVMModelPtr, 2},
+    {"_RcppMLPACK_linear_svm_mlpackMain", (DL_FUNC) &_RcppMLPACK_linear_svm_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLinearSVMModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLinearSVMModelPtr, 3},
     {"_RcppMLPACK_SerializeLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeLinearSVMModelPtr, 1},
     {"_RcppMLPACK_DeserializeLinearSVMModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLinearSVMModelPtr, 1},
-    {"_RcppMLPACK_lmnn_mlpackMain", (DL_FUNC) &_RcppMLPACK_lmnn_mlpackMain, 0},
-    {"_RcppMLPACK_local_coordinate_coding_mlpackMain", (DL_FUNC) &_RcppMLPACK_local_coordinate_coding_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr, 2},
+    {"_RcppMLPACK_lmnn_mlpackMain", (DL_FUNC) &_RcppMLPACK_lmnn_mlpackMain, 1},
+    {"_RcppMLPACK_local_coordinate_coding_mlpackMain", (DL_FUNC) &_RcppMLPACK_local_coordinate_coding_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLocalCoordinateCodingPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLocalCoordinateCodingPtr, 3},
     {"_RcppMLPACK_SerializeLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_SerializeLocalCoordinateCodingPtr, 1},
     {"_RcppMLPACK_DeserializeLocalCoordinateCodingPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLocalCoordinateCodingPtr, 1},
-    {"_RcppMLPACK_logistic_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_logistic_regression_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLogisticRegressionPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLogisticRegressionPtr, 2},
+    {"_RcppMLPACK_logistic_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_logistic_regression_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLogisticRegressionPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLogisticRegressionPtr, 3},
     {"_RcppMLPACK_SerializeLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_SerializeLogisticRegressionPtr, 1},
     {"_RcppMLPACK_DeserializeLogisticRegressionPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLogisticRegressionPtr, 1},
-    {"_RcppMLPACK_lsh_mlpackMain", (DL_FUNC) &_RcppMLPACK_lsh_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLSHSearchPtr, 1},
-    {"_RcppMLPACK_IO_SetParamLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLSHSearchPtr, 2},
+    {"_RcppMLPACK_lsh_mlpackMain", (DL_FUNC) &_RcppMLPACK_lsh_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamLSHSearchPtr, 2},
+    {"_RcppMLPACK_IO_SetParamLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamLSHSearchPtr, 3},
     {"_RcppMLPACK_SerializeLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_SerializeLSHSearchPtr, 1},
     {"_RcppMLPACK_DeserializeLSHSearchPtr", (DL_FUNC) &_RcppMLPACK_DeserializeLSHSearchPtr, 1},
-    {"_RcppMLPACK_mean_shift_mlpackMain", (DL_FUNC) &_RcppMLPACK_mean_shift_mlpackMain, 0},
-    {"_RcppMLPACK_nbc_mlpackMain", (DL_FUNC) &_RcppMLPACK_nbc_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamNBCModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamNBCModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamNBCModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamNBCModelPtr, 2},
+    {"_RcppMLPACK_mean_shift_mlpackMain", (DL_FUNC) &_RcppMLPACK_mean_shift_mlpackMain, 1},
+    {"_RcppMLPACK_nbc_mlpackMain", (DL_FUNC) &_RcppMLPACK_nbc_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamNBCModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamNBCModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamNBCModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamNBCModelPtr, 3},
     {"_RcppMLPACK_SerializeNBCModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeNBCModelPtr, 1},
     {"_RcppMLPACK_DeserializeNBCModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeNBCModelPtr, 1},
-    {"_RcppMLPACK_nca_mlpackMain", (DL_FUNC) &_RcppMLPACK_nca_mlpackMain, 0},
-    {"_RcppMLPACK_nmf_mlpackMain", (DL_FUNC) &_RcppMLPACK_nmf_mlpackMain, 0},
-    {"_RcppMLPACK_pca_mlpackMain", (DL_FUNC) &_RcppMLPACK_pca_mlpackMain, 0},
-    {"_RcppMLPACK_perceptron_mlpackMain", (DL_FUNC) &_RcppMLPACK_perceptron_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamPerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamPerceptronModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamPerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamPerceptronModelPtr, 2},
+    {"_RcppMLPACK_nca_mlpackMain", (DL_FUNC) &_RcppMLPACK_nca_mlpackMain, 1},
+    {"_RcppMLPACK_nmf_mlpackMain", (DL_FUNC) &_RcppMLPACK_nmf_mlpackMain, 1},
+    {"_RcppMLPACK_pca_mlpackMain", (DL_FUNC) &_RcppMLPACK_pca_mlpackMain, 1},
+    {"_RcppMLPACK_perceptron_mlpackMain", (DL_FUNC) &_RcppMLPACK_perceptron_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamPerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamPerceptronModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamPerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamPerceptronModelPtr, 3},
     {"_RcppMLPACK_SerializePerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_SerializePerceptronModelPtr, 1},
     {"_RcppMLPACK_DeserializePerceptronModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializePerceptronModelPtr, 1},
-    {"_RcppMLPACK_preprocess_binarize_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_binarize_mlpackMain, 0},
-    {"_RcppMLPACK_preprocess_describe_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_describe_mlpackMain, 0},
-    {"_RcppMLPACK_preprocess_scale_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_scale_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamScalingModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamScalingModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamScalingModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamScalingModelPtr, 2},
+    {"_RcppMLPACK_preprocess_binarize_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_binarize_mlpackMain, 1},
+    {"_RcppMLPACK_preprocess_describe_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_describe_mlpackMain, 1},
+    {"_RcppMLPACK_preprocess_scale_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_scale_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamScalingModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamScalingModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamScalingModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamScalingModelPtr, 3},
     {"_RcppMLPACK_SerializeScalingModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeScalingModelPtr, 1},
     {"_RcppMLPACK_DeserializeScalingModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeScalingModelPtr, 1},
-    {"_RcppMLPACK_preprocess_split_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_split_mlpackMain, 0},
-    {"_RcppMLPACK_IO_RestoreSettings", (DL_FUNC) &_RcppMLPACK_IO_RestoreSettings, 1},
-    {"_RcppMLPACK_IO_SetParamInt", (DL_FUNC) &_RcppMLPACK_IO_SetParamInt, 2},
-    {"_RcppMLPACK_IO_SetParamDouble", (DL_FUNC) &_RcppMLPACK_IO_SetParamDouble, 2},
-    {"_RcppMLPACK_IO_SetParamString", (DL_FUNC) &_RcppMLPACK_IO_SetParamString, 2},
-    {"_RcppMLPACK_IO_SetParamBool", (DL_FUNC) &_RcppMLPACK_IO_SetParamBool, 2},
-    {"_RcppMLPACK_IO_SetParamVecString", (DL_FUNC) &_RcppMLPACK_IO_SetParamVecString, 2},
-    {"_RcppMLPACK_IO_SetParamVecInt", (DL_FUNC) &_RcppMLPACK_IO_SetParamVecInt, 2},
-    {"_RcppMLPACK_IO_SetParamMat", (DL_FUNC) &_RcppMLPACK_IO_SetParamMat, 2},
-    {"_RcppMLPACK_IO_SetParamUMat", (DL_FUNC) &_RcppMLPACK_IO_SetParamUMat, 2},
-    {"_RcppMLPACK_IO_SetParamRow", (DL_FUNC) &_RcppMLPACK_IO_SetParamRow, 2},
-    {"_RcppMLPACK_IO_SetParamURow", (DL_FUNC) &_RcppMLPACK_IO_SetParamURow, 2},
-    {"_RcppMLPACK_IO_SetParamCol", (DL_FUNC) &_RcppMLPACK_IO_SetParamCol, 2},
-    {"_RcppMLPACK_IO_SetParamUCol", (DL_FUNC) &_RcppMLPACK_IO_SetParamUCol, 2},
-    {"_RcppMLPACK_IO_SetParamMatWithInfo", (DL_FUNC) &_RcppMLPACK_IO_SetParamMatWithInfo, 3},
-    {"_RcppMLPACK_IO_GetParamInt", (DL_FUNC) &_RcppMLPACK_IO_GetParamInt, 1},
-    {"_RcppMLPACK_IO_GetParamDouble", (DL_FUNC) &_RcppMLPACK_IO_GetParamDouble, 1},
-    {"_RcppMLPACK_IO_GetParamString", (DL_FUNC) &_RcppMLPACK_IO_GetParamString, 1},
-    {"_RcppMLPACK_IO_GetParamBool", (DL_FUNC) &_RcppMLPACK_IO_GetParamBool, 1},
-    {"_RcppMLPACK_IO_GetParamVecString", (DL_FUNC) &_RcppMLPACK_IO_GetParamVecString, 1},
-    {"_RcppMLPACK_IO_GetParamVecInt", (DL_FUNC) &_RcppMLPACK_IO_GetParamVecInt, 1},
-    {"_RcppMLPACK_IO_GetParamMat", (DL_FUNC) &_RcppMLPACK_IO_GetParamMat, 1},
-    {"_RcppMLPACK_IO_GetParamUMat", (DL_FUNC) &_RcppMLPACK_IO_GetParamUMat, 1},
-    {"_RcppMLPACK_IO_GetParamRow", (DL_FUNC) &_RcppMLPACK_IO_GetParamRow, 1},
-    {"_RcppMLPACK_IO_GetParamURow", (DL_FUNC) &_RcppMLPACK_IO_GetParamURow, 1},
-    {"_RcppMLPACK_IO_GetParamCol", (DL_FUNC) &_RcppMLPACK_IO_GetParamCol, 1},
-    {"_RcppMLPACK_IO_GetParamUCol", (DL_FUNC) &_RcppMLPACK_IO_GetParamUCol, 1},
-    {"_RcppMLPACK_IO_GetParamMatWithInfo", (DL_FUNC) &_RcppMLPACK_IO_GetParamMatWithInfo, 1},
+    {"_RcppMLPACK_preprocess_split_mlpackMain", (DL_FUNC) &_RcppMLPACK_preprocess_split_mlpackMain, 1},
+    {"_RcppMLPACK_IO_MakeParams", (DL_FUNC) &_RcppMLPACK_IO_MakeParams, 1},
+    {"_RcppMLPACK_IO_SetParamInt", (DL_FUNC) &_RcppMLPACK_IO_SetParamInt, 3},
+    {"_RcppMLPACK_IO_SetParamDouble", (DL_FUNC) &_RcppMLPACK_IO_SetParamDouble, 3},
+    {"_RcppMLPACK_IO_SetParamString", (DL_FUNC) &_RcppMLPACK_IO_SetParamString, 3},
+    {"_RcppMLPACK_IO_SetParamBool", (DL_FUNC) &_RcppMLPACK_IO_SetParamBool, 3},
+    {"_RcppMLPACK_IO_SetParamVecString", (DL_FUNC) &_RcppMLPACK_IO_SetParamVecString, 3},
+    {"_RcppMLPACK_IO_SetParamVecInt", (DL_FUNC) &_RcppMLPACK_IO_SetParamVecInt, 3},
+    {"_RcppMLPACK_IO_SetParamMat", (DL_FUNC) &_RcppMLPACK_IO_SetParamMat, 3},
+    {"_RcppMLPACK_IO_SetParamUMat", (DL_FUNC) &_RcppMLPACK_IO_SetParamUMat, 3},
+    {"_RcppMLPACK_IO_SetParamRow", (DL_FUNC) &_RcppMLPACK_IO_SetParamRow, 3},
+    {"_RcppMLPACK_IO_SetParamURow", (DL_FUNC) &_RcppMLPACK_IO_SetParamURow, 3},
+    {"_RcppMLPACK_IO_SetParamCol", (DL_FUNC) &_RcppMLPACK_IO_SetParamCol, 3},
+    {"_RcppMLPACK_IO_SetParamUCol", (DL_FUNC) &_RcppMLPACK_IO_SetParamUCol, 3},
+    {"_RcppMLPACK_IO_SetParamMatWithInfo", (DL_FUNC) &_RcppMLPACK_IO_SetParamMatWithInfo, 4},
+    {"_RcppMLPACK_IO_GetParamInt", (DL_FUNC) &_RcppMLPACK_IO_GetParamInt, 2},
+    {"_RcppMLPACK_IO_GetParamDouble", (DL_FUNC) &_RcppMLPACK_IO_GetParamDouble, 2},
+    {"_RcppMLPACK_IO_GetParamString", (DL_FUNC) &_RcppMLPACK_IO_GetParamString, 2},
+    {"_RcppMLPACK_IO_GetParamBool", (DL_FUNC) &_RcppMLPACK_IO_GetParamBool, 2},
+    {"_RcppMLPACK_IO_GetParamVecString", (DL_FUNC) &_RcppMLPACK_IO_GetParamVecString, 2},
+    {"_RcppMLPACK_IO_GetParamVecInt", (DL_FUNC) &_RcppMLPACK_IO_GetParamVecInt, 2},
+    {"_RcppMLPACK_IO_GetParamMat", (DL_FUNC) &_RcppMLPACK_IO_GetParamMat, 2},
+    {"_RcppMLPACK_IO_GetParamUMat", (DL_FUNC) &_RcppMLPACK_IO_GetParamUMat, 2},
+    {"_RcppMLPACK_IO_GetParamRow", (DL_FUNC) &_RcppMLPACK_IO_GetParamRow, 2},
+    {"_RcppMLPACK_IO_GetParamURow", (DL_FUNC) &_RcppMLPACK_IO_GetParamURow, 2},
+    {"_RcppMLPACK_IO_GetParamCol", (DL_FUNC) &_RcppMLPACK_IO_GetParamCol, 2},
+    {"_RcppMLPACK_IO_GetParamUCol", (DL_FUNC) &_RcppMLPACK_IO_GetParamUCol, 2},
+    {"_RcppMLPACK_IO_GetParamMatWithInfo", (DL_FUNC) &_RcppMLPACK_IO_GetParamMatWithInfo, 2},
     {"_RcppMLPACK_IO_EnableVerbose", (DL_FUNC) &_RcppMLPACK_IO_EnableVerbose, 0},
     {"_RcppMLPACK_IO_DisableVerbose", (DL_FUNC) &_RcppMLPACK_IO_DisableVerbose, 0},
     {"_RcppMLPACK_IO_ResetTimers", (DL_FUNC) &_RcppMLPACK_IO_ResetTimers, 0},
-    {"_RcppMLPACK_IO_SetPassed", (DL_FUNC) &_RcppMLPACK_IO_SetPassed, 1},
-    {"_RcppMLPACK_IO_ClearSettings", (DL_FUNC) &_RcppMLPACK_IO_ClearSettings, 0},
-    {"_RcppMLPACK_radical_mlpackMain", (DL_FUNC) &_RcppMLPACK_radical_mlpackMain, 0},
-    {"_RcppMLPACK_random_forest_mlpackMain", (DL_FUNC) &_RcppMLPACK_random_forest_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamRandomForestModelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamRandomForestModelPtr, 2},
+    {"_RcppMLPACK_IO_EnableTiming", (DL_FUNC) &_RcppMLPACK_IO_EnableTiming, 0},
+    {"_RcppMLPACK_IO_DisableTiming", (DL_FUNC) &_RcppMLPACK_IO_DisableTiming, 0},
+    {"_RcppMLPACK_IO_GetTimers", (DL_FUNC) &_RcppMLPACK_IO_GetTimers, 0},
+    {"_RcppMLPACK_IO_SaveDataset", (DL_FUNC) &_RcppMLPACK_IO_SaveDataset, 2},
+    {"_RcppMLPACK_IO_LoadDataset", (DL_FUNC) &_RcppMLPACK_IO_LoadDataset, 2},
+    {"_RcppMLPACK_IO_LoadCSV", (DL_FUNC) &_RcppMLPACK_IO_LoadCSV, 2},
+    {"_RcppMLPACK_IO_SetPassed", (DL_FUNC) &_RcppMLPACK_IO_SetPassed, 2},
+    {"_RcppMLPACK_IO_ClearSettings", (DL_FUNC) &_RcppMLPACK_IO_ClearSettings, 1},
+    {"_RcppMLPACK_radical_mlpackMain", (DL_FUNC) &_RcppMLPACK_radical_mlpackMain, 1},
+    {"_RcppMLPACK_random_forest_mlpackMain", (DL_FUNC) &_RcppMLPACK_random_forest_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamRandomForestModelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamRandomForestModelPtr, 3},
     {"_RcppMLPACK_SerializeRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_SerializeRandomForestModelPtr, 1},
     {"_RcppMLPACK_DeserializeRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeRandomForestModelPtr, 1},
-    {"_RcppMLPACK_softmax_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_softmax_regression_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamSoftmaxRegressionPtr, 1},
-    {"_RcppMLPACK_IO_SetParamSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamSoftmaxRegressionPtr, 2},
+    {"_RcppMLPACK_SaveFlatRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_SaveFlatRandomForestModelPtr, 2},
+    {"_RcppMLPACK_LoadFlatRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_LoadFlatRandomForestModelPtr, 1},
+    {"_RcppMLPACK_ClassifyFlatRandomForestModelPtr", (DL_FUNC) &_RcppMLPACK_ClassifyFlatRandomForestModelPtr, 2},
+    {"_RcppMLPACK_softmax_regression_mlpackMain", (DL_FUNC) &_RcppMLPACK_softmax_regression_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamSoftmaxRegressionPtr, 2},
+    {"_RcppMLPACK_IO_SetParamSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamSoftmaxRegressionPtr, 3},
     {"_RcppMLPACK_SerializeSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_SerializeSoftmaxRegressionPtr, 1},
     {"_RcppMLPACK_DeserializeSoftmaxRegressionPtr", (DL_FUNC) &_RcppMLPACK_DeserializeSoftmaxRegressionPtr, 1},
-    {"_RcppMLPACK_sparse_coding_mlpackMain", (DL_FUNC) &_RcppMLPACK_sparse_coding_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamSparseCodingPtr, 1},
-    {"_RcppMLPACK_IO_SetParamSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamSparseCodingPtr, 2},
+    {"_RcppMLPACK_sparse_coding_mlpackMain", (DL_FUNC) &_RcppMLPACK_sparse_coding_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamSparseCodingPtr, 2},
+    {"_RcppMLPACK_IO_SetParamSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamSparseCodingPtr, 3},
     {"_RcppMLPACK_SerializeSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_SerializeSparseCodingPtr, 1},
     {"_RcppMLPACK_DeserializeSparseCodingPtr", (DL_FUNC) &_RcppMLPACK_DeserializeSparseCodingPtr, 1},
-    {"_RcppMLPACK_test_r_binding_mlpackMain", (DL_FUNC) &_RcppMLPACK_test_r_binding_mlpackMain, 0},
-    {"_RcppMLPACK_IO_GetParamGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamGaussianKernelPtr, 1},
-    {"_RcppMLPACK_IO_SetParamGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamGaussianKernelPtr, 2},
+    {"_RcppMLPACK_test_r_binding_mlpackMain", (DL_FUNC) &_RcppMLPACK_test_r_binding_mlpackMain, 1},
+    {"_RcppMLPACK_IO_GetParamGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_IO_GetParamGaussianKernelPtr, 2},
+    {"_RcppMLPACK_IO_SetParamGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_IO_SetParamGaussianKernelPtr, 3},
     {"_RcppMLPACK_SerializeGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_SerializeGaussianKernelPtr, 1},
     {"_RcppMLPACK_DeserializeGaussianKernelPtr", (DL_FUNC) &_RcppMLPACK_DeserializeGaussianKernelPtr, 1},
     {NULL, NULL, 0}
@@ -9,8 +9,10 @@
 #include <mlpack/methods/cf/cf_main.cpp>
 
 // [[Rcpp::export]]
-void cf_mlpackMain()
+void cf_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void cf_mlpackMain()
 
 // Get the pointer to a CFModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamCFModelPtr(const std::string& paramName)
+SEXP IO_GetParamCFModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<CFModel>) IO::GetParam<CFModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<CFModel>(params, paramName);
 }
 
 // Set the pointer to a CFModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamCFModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamCFModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<CFModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<CFModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<CFModel>(params, paramName, ptr);
 }
 
 // Serialize a CFModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeCFModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("CFModel",
-          *Rcpp::as<Rcpp::XPtr<CFModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "CFModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<CFModel>>(ptr), "CFModel");
 }
 
 // Deserialize a CFModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeCFModelPtr(Rcpp::RawVector str)
 {
-  CFModel* ptr = new CFModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("CFModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<CFModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<CFModel>(str, "CFModel");
 }
 
 
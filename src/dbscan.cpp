@@ -9,8 +9,10 @@
 #include <mlpack/methods/dbscan/dbscan_main.cpp>
 
 // [[Rcpp::export]]
-void dbscan_mlpackMain()
+void dbscan_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
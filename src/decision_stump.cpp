@@ -9,8 +9,10 @@
 #include <mlpack/methods/decision_stump/decision_stump_main.cpp>
 
 // [[Rcpp::export]]
-void decision_stump_mlpackMain()
+void decision_stump_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void decision_stump_mlpackMain()
 
 // Get the pointer to a DSModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamDSModelPtr(const std::string& paramName)
+SEXP IO_GetParamDSModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<DSModel>) IO::GetParam<DSModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<DSModel>(params, paramName);
 }
 
 // Set the pointer to a DSModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamDSModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamDSModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<DSModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<DSModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<DSModel>(params, paramName, ptr);
 }
 
 // Serialize a DSModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeDSModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("DSModel",
-          *Rcpp::as<Rcpp::XPtr<DSModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "DSModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<DSModel>>(ptr), "DSModel");
 }
 
 // Deserialize a DSModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeDSModelPtr(Rcpp::RawVector str)
 {
-  DSModel* ptr = new DSModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("DSModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<DSModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<DSModel>(str, "DSModel");
 }
 
 
@@ -7,10 +7,14 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/decision_tree/decision_tree_main.cpp>
+#include <mlpack/methods/decision_tree/flat_decision_tree.hpp>
+#include <mlpack/bindings/R/r_search.hpp>
 
 // [[Rcpp::export]]
-void decision_tree_mlpackMain()
+void decision_tree_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +23,59 @@ void decision_tree_mlpackMain()
 
 // Get the pointer to a DecisionTreeModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamDecisionTreeModelPtr(const std::string& paramName)
+SEXP IO_GetParamDecisionTreeModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<DecisionTreeModel>) IO::GetParam<DecisionTreeModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<DecisionTreeModel>(params, paramName);
 }
 
 // Set the pointer to a DecisionTreeModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamDecisionTreeModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamDecisionTreeModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<DecisionTreeModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<DecisionTreeModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<DecisionTreeModel>(params, paramName, ptr);
 }
 
 // Serialize a DecisionTreeModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeDecisionTreeModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("DecisionTreeModel",
-          *Rcpp::as<Rcpp::XPtr<DecisionTreeModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "DecisionTreeModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<DecisionTreeModel>>(ptr), "DecisionTreeModel");
 }
 
 // Deserialize a DecisionTreeModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeDecisionTreeModelPtr(Rcpp::RawVector str)
 {
-  DecisionTreeModel* ptr = new DecisionTreeModel();
+  // R will be responsible for freeing this.
+  return mlpack::bindings::r::DeserializeModel<DecisionTreeModel>(str,
+      "DecisionTreeModel");
+}
 
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("DecisionTreeModel", *ptr);
-  }
+// Save a DecisionTreeModel pointer as a flat model file.
+// [[Rcpp::export]]
+void SaveFlatDecisionTreeModelPtr(SEXP ptr, const std::string& filename)
+{
+  const std::vector<const DecisionTree<>*> trees(1,
+      &Rcpp::as<Rcpp::XPtr<DecisionTreeModel>>(ptr)->tree);
+  FlatDecisionForest::Save(trees, filename, "DecisionTreeModel");
+}
 
+// Map a flat model file saved from a DecisionTreeModel.
+// [[Rcpp::export]]
+SEXP LoadFlatDecisionTreeModelPtr(const std::string& filename)
+{
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<DecisionTreeModel>)ptr);
+  return Rcpp::XPtr<FlatDecisionForest>(new FlatDecisionForest(filename,
+      "DecisionTreeModel"));
 }
 
-
+// Classify the test points with a mapped flat DecisionTreeModel.
+// [[Rcpp::export]]
+Rcpp::List ClassifyFlatDecisionTreeModelPtr(SEXP ptr,
+                                            const Rcpp::NumericMatrix& test)
+{
+  return mlpack::bindings::r::ClassifyModel(
+      *Rcpp::as<Rcpp::XPtr<FlatDecisionForest>>(ptr), test);
+}
@@ -9,8 +9,10 @@
 #include <mlpack/methods/det/det_main.cpp>
 
 // [[Rcpp::export]]
-void det_mlpackMain()
+void det_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void det_mlpackMain()
 
 // Get the pointer to a DTree<> parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamDTreePtr(const std::string& paramName)
+SEXP IO_GetParamDTreePtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<DTree<>>) IO::GetParam<DTree<>*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<DTree<>>(params, paramName);
 }
 
 // Set the pointer to a DTree<> parameter.
 // [[Rcpp::export]]
-void IO_SetParamDTreePtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamDTreePtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<DTree<>*>(paramName) =  Rcpp::as<Rcpp::XPtr<DTree<>>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<DTree<>>(params, paramName, ptr);
 }
 
 // Serialize a DTree<> pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeDTreePtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("DTree",
-          *Rcpp::as<Rcpp::XPtr<DTree<>>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "DTree";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<DTree<>>>(ptr), "DTree");
 }
 
 // Deserialize a DTree<> pointer.
 // [[Rcpp::export]]
 SEXP DeserializeDTreePtr(Rcpp::RawVector str)
 {
-  DTree<>* ptr = new DTree<>();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("DTree", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<DTree<>>)ptr);
+  return mlpack::bindings::r::DeserializeModel<DTree<>>(str, "DTree");
 }
 
 
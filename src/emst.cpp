@@ -9,8 +9,10 @@
 #include <mlpack/methods/emst/emst_main.cpp>
 
 // [[Rcpp::export]]
-void emst_mlpackMain()
+void emst_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/fastmks/fastmks_main.cpp>
 
 // [[Rcpp::export]]
-void fastmks_mlpackMain()
+void fastmks_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void fastmks_mlpackMain()
 
 // Get the pointer to a FastMKSModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamFastMKSModelPtr(const std::string& paramName)
+SEXP IO_GetParamFastMKSModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<FastMKSModel>) IO::GetParam<FastMKSModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<FastMKSModel>(params, paramName);
 }
 
 // Set the pointer to a FastMKSModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamFastMKSModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamFastMKSModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<FastMKSModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<FastMKSModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<FastMKSModel>(params, paramName, ptr);
 }
 
 // Serialize a FastMKSModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeFastMKSModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("FastMKSModel",
-          *Rcpp::as<Rcpp::XPtr<FastMKSModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "FastMKSModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<FastMKSModel>>(ptr), "FastMKSModel");
 }
 
 // Deserialize a FastMKSModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeFastMKSModelPtr(Rcpp::RawVector str)
 {
-  FastMKSModel* ptr = new FastMKSModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("FastMKSModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<FastMKSModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<FastMKSModel>(str,
+      "FastMKSModel");
 }
 
 
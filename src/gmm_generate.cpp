@@ -9,8 +9,10 @@
 #include <mlpack/methods/gmm/gmm_generate_main.cpp>
 
 // [[Rcpp::export]]
-void gmm_generate_mlpackMain()
+void gmm_generate_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void gmm_generate_mlpackMain()
 
 // Get the pointer to a GMM parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamGMMPtr(const std::string& paramName)
+SEXP IO_GetParamGMMPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<GMM>) IO::GetParam<GMM*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<GMM>(params, paramName);
 }
 
 // Set the pointer to a GMM parameter.
 // [[Rcpp::export]]
-void IO_SetParamGMMPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamGMMPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<GMM*>(paramName) =  Rcpp::as<Rcpp::XPtr<GMM>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<GMM>(params, paramName, ptr);
 }
 
 // Serialize a GMM pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeGMMPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("GMM",
-          *Rcpp::as<Rcpp::XPtr<GMM>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "GMM";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<GMM>>(ptr), "GMM");
 }
 
 // Deserialize a GMM pointer.
 // [[Rcpp::export]]
 SEXP DeserializeGMMPtr(Rcpp::RawVector str)
 {
-  GMM* ptr = new GMM();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("GMM", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<GMM>)ptr);
+  return mlpack::bindings::r::DeserializeModel<GMM>(str, "GMM");
 }
 
 
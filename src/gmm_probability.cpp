@@ -9,8 +9,10 @@
 #include <mlpack/methods/gmm/gmm_probability_main.cpp>
 
 // [[Rcpp::export]]
-void gmm_probability_mlpackMain()
+void gmm_probability_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/gmm/gmm_train_main.cpp>
 
 // [[Rcpp::export]]
-void gmm_train_mlpackMain()
+void gmm_train_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/hmm/hmm_generate_main.cpp>
 
 // [[Rcpp::export]]
-void hmm_generate_mlpackMain()
+void hmm_generate_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void hmm_generate_mlpackMain()
 
 // Get the pointer to a HMMModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamHMMModelPtr(const std::string& paramName)
+SEXP IO_GetParamHMMModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<HMMModel>) IO::GetParam<HMMModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<HMMModel>(params, paramName);
 }
 
 // Set the pointer to a HMMModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamHMMModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamHMMModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<HMMModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<HMMModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<HMMModel>(params, paramName, ptr);
 }
 
 // Serialize a HMMModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeHMMModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("HMMModel",
-          *Rcpp::as<Rcpp::XPtr<HMMModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "HMMModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<HMMModel>>(ptr), "HMMModel");
 }
 
 // Deserialize a HMMModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeHMMModelPtr(Rcpp::RawVector str)
 {
-  HMMModel* ptr = new HMMModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("HMMModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<HMMModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<HMMModel>(str, "HMMModel");
 }
 
 
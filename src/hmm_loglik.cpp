@@ -9,8 +9,10 @@
 #include <mlpack/methods/hmm/hmm_loglik_main.cpp>
 
 // [[Rcpp::export]]
-void hmm_loglik_mlpackMain()
+void hmm_loglik_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
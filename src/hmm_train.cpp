@@ -9,8 +9,10 @@
 #include <mlpack/methods/hmm/hmm_train_main.cpp>
 
 // [[Rcpp::export]]
-void hmm_train_mlpackMain()
+void hmm_train_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/hoeffding_trees/hoeffding_tree_main.cpp>
 
 // [[Rcpp::export]]
-void hoeffding_tree_mlpackMain()
+void hoeffding_tree_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,35 @@ void hoeffding_tree_mlpackMain()
 
 // Get the pointer to a HoeffdingTreeModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamHoeffdingTreeModelPtr(const std::string& paramName)
+SEXP IO_GetParamHoeffdingTreeModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<HoeffdingTreeModel>) IO::GetParam<HoeffdingTreeModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<HoeffdingTreeModel>(params,
+      paramName);
 }
 
 // Set the pointer to a HoeffdingTreeModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamHoeffdingTreeModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamHoeffdingTreeModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<HoeffdingTreeModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<HoeffdingTreeModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<HoeffdingTreeModel>(params, paramName, ptr);
 }
 
 // Serialize a HoeffdingTreeModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeHoeffdingTreeModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("HoeffdingTreeModel",
-          *Rcpp::as<Rcpp::XPtr<HoeffdingTreeModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "HoeffdingTreeModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<HoeffdingTreeModel>>(ptr), "HoeffdingTreeModel");
 }
 
 // Deserialize a HoeffdingTreeModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeHoeffdingTreeModelPtr(Rcpp::RawVector str)
 {
-  HoeffdingTreeModel* ptr = new HoeffdingTreeModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("HoeffdingTreeModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<HoeffdingTreeModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<HoeffdingTreeModel>(str,
+      "HoeffdingTreeModel");
 }
 
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/preprocess/image_converter_main.cpp>
 
 // [[Rcpp::export]]
-void image_converter_mlpackMain()
+void image_converter_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -7,10 +7,13 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/kde/kde_main.cpp>
+#include <mlpack/bindings/R/r_matrix.hpp>
 
 // [[Rcpp::export]]
-void kde_mlpackMain()
+void kde_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +22,51 @@ void kde_mlpackMain()
 
 // Get the pointer to a KDEModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamKDEModelPtr(const std::string& paramName)
+SEXP IO_GetParamKDEModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<KDEModel>) IO::GetParam<KDEModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<KDEModel>(params, paramName);
 }
 
 // Set the pointer to a KDEModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamKDEModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamKDEModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<KDEModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<KDEModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<KDEModel>(params, paramName, ptr);
 }
 
 // Serialize a KDEModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeKDEModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("KDEModel",
-          *Rcpp::as<Rcpp::XPtr<KDEModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "KDEModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<KDEModel>>(ptr), "KDEModel");
 }
 
 // Deserialize a KDEModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeKDEModelPtr(Rcpp::RawVector str)
 {
-  KDEModel* ptr = new KDEModel();
+  // R will be responsible for freeing this.
+  return mlpack::bindings::r::DeserializeModel<KDEModel>(str, "KDEModel");
+}
 
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
+// Estimate the density at the query points with a KDEModel pointer, without
+// going through the parameters of the binding.
+// [[Rcpp::export]]
+Rcpp::NumericVector EvaluateKDEModelPtr(SEXP ptr,
+                                        const Rcpp::NumericMatrix& query)
+{
+  KDEModel& model = *Rcpp::as<Rcpp::XPtr<KDEModel>>(ptr);
+  arma::mat querySet = mlpack::bindings::r::ToArmaMatrix(query);
+  if (querySet.n_rows != model.Dimensionality())
   {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("KDEModel", *ptr);
+    Log::Fatal << "Query has invalid dimensions(" << querySet.n_rows
+        << "); should be " << model.Dimensionality() << "!" << std::endl;
   }
 
-  // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<KDEModel>)ptr);
-}
-
+  arma::vec estimations;
+  model.Evaluate(std::move(querySet), estimations);
 
+  return Rcpp::NumericVector(estimations.begin(), estimations.end());
+}
@@ -9,8 +9,10 @@
 #include <mlpack/methods/kernel_pca/kernel_pca_main.cpp>
 
 // [[Rcpp::export]]
-void kernel_pca_mlpackMain()
+void kernel_pca_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -7,10 +7,13 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/neighbor_search/kfn_main.cpp>
+#include <mlpack/bindings/R/r_search.hpp>
 
 // [[Rcpp::export]]
-void kfn_mlpackMain()
+void kfn_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +22,40 @@ void kfn_mlpackMain()
 
 // Get the pointer to a KFNModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamKFNModelPtr(const std::string& paramName)
+SEXP IO_GetParamKFNModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<KFNModel>) IO::GetParam<KFNModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<KFNModel>(params, paramName);
 }
 
 // Set the pointer to a KFNModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamKFNModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamKFNModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<KFNModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<KFNModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<KFNModel>(params, paramName, ptr);
 }
 
 // Serialize a KFNModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeKFNModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("KFNModel",
-          *Rcpp::as<Rcpp::XPtr<KFNModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "KFNModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<KFNModel>>(ptr), "KFNModel");
 }
 
 // Deserialize a KFNModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeKFNModelPtr(Rcpp::RawVector str)
 {
-  KFNModel* ptr = new KFNModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("KFNModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<KFNModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<KFNModel>(str, "KFNModel");
 }
 
-
+// Search for the k furthest neighbors of the query points with a KFNModel
+// pointer, without going through the parameters of the binding.
+// [[Rcpp::export]]
+Rcpp::List SearchKFNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k)
+{
+  return mlpack::bindings::r::SearchModel(*Rcpp::as<Rcpp::XPtr<KFNModel>>(ptr),
+      query, k);
+}
@@ -7,14 +7,33 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/kmeans/kmeans_main.cpp>
+#include <mlpack/core/data/load_csv.hpp>
+#include <mlpack/bindings/R/r_matrix.hpp>
 
 // [[Rcpp::export]]
-void kmeans_mlpackMain()
+void kmeans_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
 // Any implementations of methods for dealing with model pointers will be put
 // below this comment, if needed.
 
-
+// Cluster the points of a CSV file with KMeans::ClusterStream(), reading the
+// file in chunks of at most chunkSize points, starting from the given
+// centroids (one per row).  The centroids are returned one per row.  No
+// binding streams its input, so this is only used by the tests.
+// [[Rcpp::export]]
+Rcpp::NumericMatrix ClusterCSVStream(const std::string& filename,
+                                     const Rcpp::NumericMatrix& centroids,
+                                     int chunkSize,
+                                     int batchSize)
+{
+  arma::mat result = mlpack::bindings::r::ToArmaMatrix(centroids);
+  mlpack::data::CSVChunkSource<> source(filename, (size_t) chunkSize);
+  KMeans<> k;
+  k.ClusterStream(source, result.n_cols, result, true, (size_t) batchSize);
+  return mlpack::bindings::r::ToRMatrix(result, false);
+}
@@ -7,10 +7,14 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/neighbor_search/knn_main.cpp>
+#include <mlpack/methods/neighbor_search/flat_knn_model.hpp>
+#include <mlpack/bindings/R/r_search.hpp>
 
 // [[Rcpp::export]]
-void knn_mlpackMain()
+void knn_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +23,189 @@ void knn_mlpackMain()
 
 // Get the pointer to a KNNModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamKNNModelPtr(const std::string& paramName)
+SEXP IO_GetParamKNNModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<KNNModel>) IO::GetParam<KNNModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<KNNModel>(params, paramName);
 }
 
 // Set the pointer to a KNNModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamKNNModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamKNNModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<KNNModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<KNNModel>(params, paramName, ptr);
 }
 
 // Serialize a KNNModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeKNNModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("KNNModel",
-          *Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "KNNModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr), "KNNModel");
 }
 
 // Deserialize a KNNModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeKNNModelPtr(Rcpp::RawVector str)
 {
-  KNNModel* ptr = new KNNModel();
+  // R will be responsible for freeing this.
+  return mlpack::bindings::r::DeserializeModel<KNNModel>(str, "KNNModel");
+}
+
+// Search for the k nearest neighbors of the query points with a KNNModel
+// pointer, without going through the parameters of the binding.
+// [[Rcpp::export]]
+Rcpp::List SearchKNNModelPtr(SEXP ptr, const Rcpp::NumericMatrix& query, int k)
+{
+  return mlpack::bindings::r::SearchModel(*Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr),
+      query, k);
+}
+
+// Add points to a KNNModel pointer, and return their ids.
+// [[Rcpp::export]]
+Rcpp::NumericVector InsertKNNModelPtr(SEXP ptr,
+                                      const Rcpp::NumericMatrix& points)
+{
+  KNNModel& model = *Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr);
+  arma::mat pointSet = mlpack::bindings::r::ToArmaMatrix(points);
+  const size_t numPoints = pointSet.n_cols;
+  const size_t firstId = model.Insert(std::move(pointSet));
+
+  Rcpp::NumericVector ids(numPoints);
+  for (size_t i = 0; i < numPoints; ++i)
+    ids[i] = (double) (firstId + i);
+  return ids;
+}
+
+// Remove the points with the given ids from a KNNModel pointer.
+// [[Rcpp::export]]
+void RemoveKNNModelPtr(SEXP ptr, SEXP ids)
+{
+  arma::Col<size_t> pointIds(Rf_xlength(ids));
+  mlpack::bindings::r::ToArmaIndices(ids, false, pointIds.memptr());
+  Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr)->Remove(pointIds);
+}
+
+// Save a KNNModel pointer as a flat model file.  Inserted and removed points
+// are merged into its tree first.
+// [[Rcpp::export]]
+void SaveFlatKNNModelPtr(SEXP ptr, const std::string& filename)
+{
+  KNNModel& model = *Rcpp::as<Rcpp::XPtr<KNNModel>>(ptr);
+  model.Compact();
+  mlpack::neighbor::FlatKNNModel::Save(model, filename);
+}
+
+// Map a flat model file saved from a KNNModel.
+// [[Rcpp::export]]
+SEXP LoadFlatKNNModelPtr(const std::string& filename)
+{
+  // R will be responsible for freeing this.
+  return Rcpp::XPtr<mlpack::neighbor::FlatKNNModel>(
+      new mlpack::neighbor::FlatKNNModel(filename));
+}
+
+// Search for the k nearest neighbors of the query points with a mapped flat
+// KNNModel.
+// [[Rcpp::export]]
+Rcpp::List SearchFlatKNNModelPtr(SEXP ptr,
+                                 const Rcpp::NumericMatrix& query,
+                                 int k)
+{
+  return mlpack::bindings::r::SearchModel(
+      *Rcpp::as<Rcpp::XPtr<mlpack::neighbor::FlatKNNModel>>(ptr), query, k);
+}
 
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
+// Build a tree of the given type on the first numBuilt reference points, add
+// the rest with InsertPoint(), delete the given points with DeletePoint(), and
+// search the updated tree for the k nearest neighbors of the query points.
+template<template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+Rcpp::List SearchUpdatedTree(const arma::mat& reference,
+                             const size_t numBuilt,
+                             const arma::Col<size_t>& removed,
+                             arma::mat&& query,
+                             const size_t k)
+{
+  typedef NSType<NearestNeighborSort, TreeType> KNNType;
+  arma::mat built = reference.head_cols(numBuilt);
+  typename KNNType::Tree tree(std::move(built));
+  tree.Dataset().insert_cols(numBuilt,
+      reference.tail_cols(reference.n_cols - numBuilt));
+  for (size_t i = numBuilt; i < reference.n_cols; ++i)
+    tree.InsertPoint(i);
+  for (size_t i = 0; i < removed.n_elem; ++i)
   {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("KNNModel", *ptr);
+    if (!tree.DeletePoint(removed[i]))
+      Log::Fatal << "Point " << removed[i] << " is not in the tree!" << endl;
   }
 
-  // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<KNNModel>)ptr);
+  KNNType knn(std::move(tree));
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  knn.Search(std::move(query), k, neighbors, distances);
+
+  return Rcpp::List::create(
+      Rcpp::Named("distances") = mlpack::bindings::r::ToRMatrix(distances,
+          false),
+      Rcpp::Named("neighbors") = mlpack::bindings::r::ToRIndices(neighbors,
+          false));
 }
 
+// Check that rectangle trees stay exact when points are inserted into and
+// deleted from them after they are bulk loaded.  No binding updates these
+// trees point by point, so this is only used by the tests.
+// [[Rcpp::export]]
+Rcpp::List SearchUpdatedRectangleTree(const std::string& treeType,
+                                      const Rcpp::NumericMatrix& reference,
+                                      int numBuilt,
+                                      SEXP removed,
+                                      const Rcpp::NumericMatrix& query,
+                                      int k)
+{
+  const arma::mat referenceSet = mlpack::bindings::r::ToArmaMatrix(reference);
+  arma::mat querySet = mlpack::bindings::r::ToArmaMatrix(query);
+  arma::Col<size_t> removedIds(Rf_xlength(removed));
+  mlpack::bindings::r::ToArmaIndices(removed, false, removedIds.memptr());
 
+  if (numBuilt <= 0 || (size_t) numBuilt > referenceSet.n_cols)
+  {
+    Log::Fatal << "Invalid number of points to build on: " << numBuilt
+        << "!" << endl;
+  }
+
+  if (treeType == "r")
+  {
+    return SearchUpdatedTree<RTree>(referenceSet, numBuilt, removedIds,
+        std::move(querySet), k);
+  }
+  else if (treeType == "r-star")
+  {
+    return SearchUpdatedTree<RStarTree>(referenceSet, numBuilt, removedIds,
+        std::move(querySet), k);
+  }
+  else if (treeType == "x")
+  {
+    return SearchUpdatedTree<XTree>(referenceSet, numBuilt, removedIds,
+        std::move(querySet), k);
+  }
+  else if (treeType == "hilbert-r")
+  {
+    return SearchUpdatedTree<HilbertRTree>(referenceSet, numBuilt, removedIds,
+        std::move(querySet), k);
+  }
+  else if (treeType == "r-plus")
+  {
+    return SearchUpdatedTree<RPlusTree>(referenceSet, numBuilt, removedIds,
+        std::move(querySet), k);
+  }
+  else if (treeType == "r-plus-plus")
+  {
+    return SearchUpdatedTree<RPlusPlusTree>(referenceSet, numBuilt,
+        removedIds, std::move(querySet), k);
+  }
+
+  Log::Fatal << "Unknown rectangle tree type '" << treeType << "'!" << endl;
+  return Rcpp::List();
+}
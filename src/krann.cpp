@@ -7,10 +7,13 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/rann/krann_main.cpp>
+#include <mlpack/bindings/R/r_search.hpp>
 
 // [[Rcpp::export]]
-void krann_mlpackMain()
+void krann_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +22,42 @@ void krann_mlpackMain()
 
 // Get the pointer to a RANNModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamRANNModelPtr(const std::string& paramName)
+SEXP IO_GetParamRANNModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<RANNModel>) IO::GetParam<RANNModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<RANNModel>(params, paramName);
 }
 
 // Set the pointer to a RANNModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamRANNModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamRANNModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<RANNModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<RANNModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<RANNModel>(params, paramName, ptr);
 }
 
 // Serialize a RANNModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeRANNModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("RANNModel",
-          *Rcpp::as<Rcpp::XPtr<RANNModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "RANNModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<RANNModel>>(ptr), "RANNModel");
 }
 
 // Deserialize a RANNModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeRANNModelPtr(Rcpp::RawVector str)
 {
-  RANNModel* ptr = new RANNModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("RANNModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<RANNModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<RANNModel>(str, "RANNModel");
 }
 
-
+// Search for the k rank-approximate nearest neighbors of the query points with
+// a RANNModel pointer, without going through the parameters of the binding.
+// [[Rcpp::export]]
+Rcpp::List SearchRANNModelPtr(SEXP ptr,
+                              const Rcpp::NumericMatrix& query,
+                              int k)
+{
+  return mlpack::bindings::r::SearchModel(
+      *Rcpp::as<Rcpp::XPtr<RANNModel>>(ptr), query, k);
+}
@@ -9,8 +9,10 @@
 #include <mlpack/methods/lars/lars_main.cpp>
 
 // [[Rcpp::export]]
-void lars_mlpackMain()
+void lars_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void lars_mlpackMain()
 
 // Get the pointer to a LARS parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamLARSPtr(const std::string& paramName)
+SEXP IO_GetParamLARSPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<LARS>) IO::GetParam<LARS*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<LARS>(params, paramName);
 }
 
 // Set the pointer to a LARS parameter.
 // [[Rcpp::export]]
-void IO_SetParamLARSPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamLARSPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<LARS*>(paramName) =  Rcpp::as<Rcpp::XPtr<LARS>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<LARS>(params, paramName, ptr);
 }
 
 // Serialize a LARS pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeLARSPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("LARS",
-          *Rcpp::as<Rcpp::XPtr<LARS>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "LARS";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<LARS>>(ptr), "LARS");
 }
 
 // Deserialize a LARS pointer.
 // [[Rcpp::export]]
 SEXP DeserializeLARSPtr(Rcpp::RawVector str)
 {
-  LARS* ptr = new LARS();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("LARS", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<LARS>)ptr);
+  return mlpack::bindings::r::DeserializeModel<LARS>(str, "LARS");
 }
 
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/linear_svm/linear_svm_main.cpp>
 
 // [[Rcpp::export]]
-void linear_svm_mlpackMain()
+void linear_svm_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void linear_svm_mlpackMain()
 
 // Get the pointer to a LinearSVMModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamLinearSVMModelPtr(const std::string& paramName)
+SEXP IO_GetParamLinearSVMModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<LinearSVMModel>) IO::GetParam<LinearSVMModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<LinearSVMModel>(params, paramName);
 }
 
 // Set the pointer to a LinearSVMModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamLinearSVMModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamLinearSVMModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<LinearSVMModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<LinearSVMModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<LinearSVMModel>(params, paramName, ptr);
 }
 
 // Serialize a LinearSVMModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeLinearSVMModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("LinearSVMModel",
-          *Rcpp::as<Rcpp::XPtr<LinearSVMModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "LinearSVMModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<LinearSVMModel>>(ptr), "LinearSVMModel");
 }
 
 // Deserialize a LinearSVMModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeLinearSVMModelPtr(Rcpp::RawVector str)
 {
-  LinearSVMModel* ptr = new LinearSVMModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("LinearSVMModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<LinearSVMModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<LinearSVMModel>(str,
+      "LinearSVMModel");
 }
 
 
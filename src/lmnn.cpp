@@ -9,8 +9,10 @@
 #include <mlpack/methods/lmnn/lmnn_main.cpp>
 
 // [[Rcpp::export]]
-void lmnn_mlpackMain()
+void lmnn_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/local_coordinate_coding/local_coordinate_coding_main.cpp>
 
 // [[Rcpp::export]]
-void local_coordinate_coding_mlpackMain()
+void local_coordinate_coding_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,37 @@ void local_coordinate_coding_mlpackMain()
 
 // Get the pointer to a LocalCoordinateCoding parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamLocalCoordinateCodingPtr(const std::string& paramName)
+SEXP IO_GetParamLocalCoordinateCodingPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<LocalCoordinateCoding>) IO::GetParam<LocalCoordinateCoding*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<LocalCoordinateCoding>(params,
+      paramName);
 }
 
 // Set the pointer to a LocalCoordinateCoding parameter.
 // [[Rcpp::export]]
-void IO_SetParamLocalCoordinateCodingPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamLocalCoordinateCodingPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<LocalCoordinateCoding*>(paramName) =  Rcpp::as<Rcpp::XPtr<LocalCoordinateCoding>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<LocalCoordinateCoding>(params,
+      paramName, ptr);
 }
 
 // Serialize a LocalCoordinateCoding pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeLocalCoordinateCodingPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("LocalCoordinateCoding",
-          *Rcpp::as<Rcpp::XPtr<LocalCoordinateCoding>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "LocalCoordinateCoding";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<LocalCoordinateCoding>>(ptr),
+      "LocalCoordinateCoding");
 }
 
 // Deserialize a LocalCoordinateCoding pointer.
 // [[Rcpp::export]]
 SEXP DeserializeLocalCoordinateCodingPtr(Rcpp::RawVector str)
 {
-  LocalCoordinateCoding* ptr = new LocalCoordinateCoding();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("LocalCoordinateCoding", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<LocalCoordinateCoding>)ptr);
+  return mlpack::bindings::r::DeserializeModel<LocalCoordinateCoding>(str,
+      "LocalCoordinateCoding");
 }
 
 
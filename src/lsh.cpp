@@ -9,8 +9,10 @@
 #include <mlpack/methods/lsh/lsh_main.cpp>
 
 // [[Rcpp::export]]
-void lsh_mlpackMain()
+void lsh_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void lsh_mlpackMain()
 
 // Get the pointer to a LSHSearch<> parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamLSHSearchPtr(const std::string& paramName)
+SEXP IO_GetParamLSHSearchPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<LSHSearch<>>) IO::GetParam<LSHSearch<>*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<LSHSearch<>>(params, paramName);
 }
 
 // Set the pointer to a LSHSearch<> parameter.
 // [[Rcpp::export]]
-void IO_SetParamLSHSearchPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamLSHSearchPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<LSHSearch<>*>(paramName) =  Rcpp::as<Rcpp::XPtr<LSHSearch<>>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<LSHSearch<>>(params, paramName, ptr);
 }
 
 // Serialize a LSHSearch<> pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeLSHSearchPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("LSHSearch",
-          *Rcpp::as<Rcpp::XPtr<LSHSearch<>>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "LSHSearch";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<LSHSearch<>>>(ptr), "LSHSearch");
 }
 
 // Deserialize a LSHSearch<> pointer.
 // [[Rcpp::export]]
 SEXP DeserializeLSHSearchPtr(Rcpp::RawVector str)
 {
-  LSHSearch<>* ptr = new LSHSearch<>();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("LSHSearch", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<LSHSearch<>>)ptr);
+  return mlpack::bindings::r::DeserializeModel<LSHSearch<>>(str, "LSHSearch");
 }
 
 
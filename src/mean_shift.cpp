@@ -9,8 +9,10 @@
 #include <mlpack/methods/mean_shift/mean_shift_main.cpp>
 
 // [[Rcpp::export]]
-void mean_shift_mlpackMain()
+void mean_shift_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
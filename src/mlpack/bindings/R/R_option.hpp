@@ -19,6 +19,8 @@
 #include "print_output_processing.hpp"
 #include "print_doc.hpp"
 #include "print_serialize_util.hpp"
+#include "r_params.hpp"
+#include "r_serialize.hpp"
 
 namespace mlpack {
 namespace bindings {
@@ -67,6 +69,7 @@ class ROption
     data.alias = alias[0];
     data.wasPassed = false;
     data.noTranspose = noTranspose;
+    data.colMajor = false;
     data.required = required;
     data.input = input;
     data.loaded = false;
@@ -89,19 +92,19 @@ class ROption
     // pointers will be used by both the program that generates the R, and
     // also the binding itself.  (The binding itself will only use GetParam,
     // GetPrintableParam, and GetRawParam.)
-    IO::GetSingleton().functionMap[data.tname]["GetParam"] = &GetParam<T>;
-    IO::GetSingleton().functionMap[data.tname]["GetPrintableParam"] =
+    IO::FunctionMap()[data.tname]["GetParam"] = &GetParam<T>;
+    IO::FunctionMap()[data.tname]["GetPrintableParam"] =
         &GetPrintableParam<T>;
 
     // These are used by the R generator.
-    IO::GetSingleton().functionMap[data.tname]["PrintDoc"] = &PrintDoc<T>;
-    IO::GetSingleton().functionMap[data.tname]["PrintInputParam"] =
+    IO::FunctionMap()[data.tname]["PrintDoc"] = &PrintDoc<T>;
+    IO::FunctionMap()[data.tname]["PrintInputParam"] =
         &PrintInputParam<T>;
-    IO::GetSingleton().functionMap[data.tname]["PrintOutputProcessing"] =
+    IO::FunctionMap()[data.tname]["PrintOutputProcessing"] =
         &PrintOutputProcessing<T>;
-    IO::GetSingleton().functionMap[data.tname]["PrintInputProcessing"] =
+    IO::FunctionMap()[data.tname]["PrintInputProcessing"] =
         &PrintInputProcessing<T>;
-    IO::GetSingleton().functionMap[data.tname]["PrintSerializeUtil"] =
+    IO::FunctionMap()[data.tname]["PrintSerializeUtil"] =
         &PrintSerializeUtil<T>;
 
     // Add the ParamData object, then store.  This is necessary because we may
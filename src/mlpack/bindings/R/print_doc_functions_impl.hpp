@@ -79,7 +79,7 @@ inline std::string PrintDefault(const std::string& paramName)
   util::ParamData& d = IO::Parameters()[paramName];
 
   std::string defaultValue;
-  IO::GetSingleton().functionMap[d.tname]["DefaultParam"](d, NULL,
+  IO::FunctionMap()[d.tname]["DefaultParam"](d, NULL,
       (void*) &defaultValue);
 
   return defaultValue;
@@ -276,7 +276,7 @@ inline std::string ProgramCall(const std::string& programName)
     oss << it->second.name << "=";
 
     std::string value;
-    IO::GetSingleton().functionMap[it->second.tname]["DefaultParam"](
+    IO::FunctionMap()[it->second.tname]["DefaultParam"](
         it->second, NULL, (void*) &value);
     oss << value;
   }
@@ -37,7 +37,7 @@ void PrintInputProcessing(
      * This gives us code like:
      *
      *  if (!identical(<param_name>, NA)) {
-     *     IO_SetParam<type>("<param_name>", <param_name>)
+     *     IO_SetParam<type>(p, "<param_name>", <param_name>)
      *  }
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name ;
@@ -49,7 +49,7 @@ void PrintInputProcessing(
     {
       MLPACK_COUT_STREAM << ", NA)) {" << std::endl;
     }
-    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(p, \""
         << d.name << "\", " << d.name << ")" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
@@ -58,9 +58,9 @@ void PrintInputProcessing(
     /**
      * This gives us code like:
      *
-     *     IO_SetParam<type>("<param_name>", <param_name>)
+     *     IO_SetParam<type>(p, "<param_name>", <param_name>)
      */
-    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(p, \""
               << d.name << "\", " << d.name << ")" << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
@@ -80,12 +80,12 @@ void PrintInputProcessing(
      * This gives us code like:
      *
      *  if (!identical(<param_name>, NA)) {
-     *     IO_SetParam<type>("<param_name>", to_matrix(<param_name>))
+     *     IO_SetParam<type>(p, "<param_name>", to_matrix(<param_name>))
      *  }
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name << ", NA)) {"
         << std::endl;
-    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(p, \""
         << d.name << "\", to_matrix(" << d.name << "))" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
@@ -94,9 +94,9 @@ void PrintInputProcessing(
     /**
      * This gives us code like:
      *
-     *     IO_SetParam<type>("<param_name>", to_matrix(<param_name>))
+     *     IO_SetParam<type>(p, "<param_name>", to_matrix(<param_name>))
      */
-    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(p, \""
         << d.name << "\", to_matrix(" << d.name << "))" << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
@@ -118,7 +118,7 @@ void PrintInputProcessing(
      *
      *  if (!identical(<param_name>, NA)) {
      *     <param_name> = to_matrix_with_info(<param_name>)
-     *     IO_SetParam<type>("<param_name>", <param_name>$info,
+     *     IO_SetParam<type>(p, "<param_name>", <param_name>$info,
      *                         <param_name>$data)
      *  }
      */
@@ -126,7 +126,7 @@ void PrintInputProcessing(
         << std::endl;
     MLPACK_COUT_STREAM << "    " << d.name << " <- to_matrix_with_info("
         << d.name << ")" << std::endl;
-    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "    IO_SetParam" << GetType<T>(d) << "(p, \""
         << d.name << "\", " << d.name << "$info, " << d.name
         << "$data)" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
@@ -137,12 +137,12 @@ void PrintInputProcessing(
      * This gives us code like:
      *
      *     <param_name> = to_matrix_with_info(<param_name>)
-     *     IO_SetParam<type>("<param_name>", <param_name>$info,
+     *     IO_SetParam<type>(p, "<param_name>", <param_name>$info,
      *                         <param_name>$data)
      */
     MLPACK_COUT_STREAM << "  " << d.name << " <- to_matrix_with_info("
         << d.name << ")" << std::endl;
-    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(\""
+    MLPACK_COUT_STREAM << "  IO_SetParam" << GetType<T>(d) << "(p, \""
         << d.name << "\", " << d.name << "$info, " << d.name
         << "$data)" << std::endl;
   }
@@ -164,12 +164,12 @@ void PrintInputProcessing(
      * This gives us code like:
      *
      *  if (!identical(<param_name>, NA)) {
-     *     IO_SetParam<ModelType>Ptr("<param_name>", <param_name>)
+     *     IO_SetParam<ModelType>Ptr(p, "<param_name>", <param_name>)
      *  }
      */
     MLPACK_COUT_STREAM << "  if (!identical(" << d.name << ", NA)) {"
         << std::endl;
-    MLPACK_COUT_STREAM << "    IO_SetParam" << util::StripType(d.cppType) << "Ptr(\""
+    MLPACK_COUT_STREAM << "    IO_SetParam" << util::StripType(d.cppType) << "Ptr(p, \""
         << d.name << "\", " << d.name << ")" << std::endl;
     MLPACK_COUT_STREAM << "  }" << std::endl; // Closing brace.
   }
@@ -178,9 +178,9 @@ void PrintInputProcessing(
     /**
      * This gives us code like:
      *
-     *     IO_SetParam<ModelType>Ptr("<param_name>", <param_name>)
+     *     IO_SetParam<ModelType>Ptr(p, "<param_name>", <param_name>)
      */
-    MLPACK_COUT_STREAM << "  IO_SetParam" << util::StripType(d.cppType) << "Ptr(\""
+    MLPACK_COUT_STREAM << "  IO_SetParam" << util::StripType(d.cppType) << "Ptr(p, \""
               << d.name << "\", " << d.name << ")" << std::endl;
   }
   MLPACK_COUT_STREAM << std::endl; // Extra line is to clear up the code a bit.
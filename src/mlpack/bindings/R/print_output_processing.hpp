@@ -34,12 +34,12 @@ void PrintOutputProcessing(
   /**
    * This gives us code like:
    *
-   *  "<paramName>" = IO_GetParam<Type>("paramName")
+   *  "<paramName>" = IO_GetParam<Type>(p, "paramName")
    *
    */
 
   MLPACK_COUT_STREAM << "  \"" << d.name << "\" = IO_GetParam" << GetType<T>(d)
-            << "(\"" << d.name << "\")";
+            << "(p, \"" << d.name << "\")";
 }
 
 /**
@@ -55,12 +55,12 @@ void PrintOutputProcessing(
   /**
    * This gives us code like:
    *
-   *  "<paramName>" = IO_GetParam<Type>("paramName")
+   *  "<paramName>" = IO_GetParam<Type>(p, "paramName")
    *
    */
 
   MLPACK_COUT_STREAM << "  \"" << d.name << "\" = IO_GetParam" << GetType<T>(d)
-            << "(\"" << d.name << "\")";
+            << "(p, \"" << d.name << "\")";
 }
 
 /**
@@ -75,12 +75,12 @@ void PrintOutputProcessing(
   /**
    * This gives us code like:
    *
-   *  "<paramName>" = IO_GetParam<Type>("paramName")
+   *  "<paramName>" = IO_GetParam<Type>(p, "paramName")
    *
    */
 
   MLPACK_COUT_STREAM << "  \"" << d.name << "\" = IO_GetParam" << GetType<T>(d)
-            << "(\"" << d.name << "\")";
+            << "(p, \"" << d.name << "\")";
 }
 
 /**
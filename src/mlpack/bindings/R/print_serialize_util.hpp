@@ -54,12 +54,12 @@ void PrintSerializeUtil(
   /**
    * This gives us code like:
    *
-   *  <paramName> <- IO_GetParam<ModelType>Ptr("<paramName>")
+   *  <paramName> <- IO_GetParam<ModelType>Ptr(p, "<paramName>")
    *  attr(<paramName>, "type") <- "<ModelType>"
    *
    */
   MLPACK_COUT_STREAM << "  " << d.name << " <- IO_GetParam"
-      << util::StripType(d.cppType) << "Ptr(\"" << d.name << "\")";
+      << util::StripType(d.cppType) << "Ptr(p, \"" << d.name << "\")";
   MLPACK_COUT_STREAM << std::endl;
   MLPACK_COUT_STREAM << "  attr(" << d.name << ", \"type\") <- \""
       << util::StripType(d.cppType) << "\"";
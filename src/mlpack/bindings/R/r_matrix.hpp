@@ -0,0 +1,181 @@
+/**
+ * @file bindings/R/r_matrix.hpp
+ *
+ * Conversions between R matrices and Armadillo matrices for code that talks to
+ * R directly instead of through the parameters of a binding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_R_R_MATRIX_HPP
+#define MLPACK_BINDINGS_R_R_MATRIX_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace r {
+
+/**
+ * Copy an R matrix into a new Armadillo matrix with one point per column.  The
+ * R matrix holds one point per row, unless it has been marked with
+ * col_major().
+ *
+ * @param m R matrix to copy.
+ */
+inline arma::mat ToArmaMatrix(const Rcpp::NumericMatrix& m)
+{
+  const arma::mat alias((double*) REAL(m), m.nrow(), m.ncol(), false, true);
+  if (m.hasAttribute("col_major"))
+    return alias;
+
+  return alias.t();
+}
+
+/**
+ * Write a matrix into a newly allocated R matrix.  Unless the caller works
+ * with column-major matrices, the result is transposed so that it holds one
+ * point per row.
+ *
+ * @param m Matrix to write.
+ * @param colMajor Whether to keep one point per column.
+ */
+inline Rcpp::NumericMatrix ToRMatrix(const arma::mat& m, const bool colMajor)
+{
+  if (colMajor)
+  {
+    Rcpp::NumericMatrix out(m.n_rows, m.n_cols);
+    std::copy(m.begin(), m.end(), out.begin());
+    out.attr("col_major") = true;
+    return out;
+  }
+
+  Rcpp::NumericMatrix out(m.n_cols, m.n_rows);
+  arma::mat outMat(out.begin(), m.n_cols, m.n_rows, false, true);
+  outMat = m.t();
+  return out;
+}
+
+/**
+ * Same as above, for matrices of indices.
+ *
+ * @param m Matrix to write.
+ * @param colMajor Whether to keep one point per column.
+ */
+inline Rcpp::NumericMatrix ToRMatrix(const arma::Mat<size_t>& m,
+                                     const bool colMajor)
+{
+  if (colMajor)
+  {
+    Rcpp::NumericMatrix out(m.n_rows, m.n_cols);
+    std::copy(m.begin(), m.end(), out.begin());
+    out.attr("col_major") = true;
+    return out;
+  }
+
+  Rcpp::NumericMatrix out(m.n_cols, m.n_rows);
+  for (size_t j = 0; j < m.n_cols; ++j)
+    for (size_t i = 0; i < m.n_rows; ++i)
+      out(j, i) = m(i, j);
+  return out;
+}
+
+/**
+ * Whether matrices of indices and labels should be handed to R as 32-bit
+ * integers instead of doubles.  This is the default; doubles can be requested
+ * with options(RcppMLPACK.integer_output = FALSE).
+ */
+inline bool IntegerOutput()
+{
+  SEXP option = Rf_GetOption1(Rf_install("RcppMLPACK.integer_output"));
+  return (option == R_NilValue || Rf_asLogical(option) != FALSE);
+}
+
+/**
+ * Write a matrix of indices into a newly allocated R matrix, which holds
+ * integers if IntegerOutput() is true (the default) and doubles otherwise.
+ * Indices that do not fit in an R integer, such as the SIZE_MAX marking a
+ * missing neighbor, become NA.
+ *
+ * @param m Matrix to write.
+ * @param colMajor Whether to keep one point per column.
+ */
+inline SEXP ToRIndices(const arma::Mat<size_t>& m, const bool colMajor)
+{
+  if (!IntegerOutput())
+    return ToRMatrix(m, colMajor);
+
+  Rcpp::IntegerMatrix out(colMajor ? m.n_rows : m.n_cols,
+                          colMajor ? m.n_cols : m.n_rows);
+  for (size_t j = 0; j < m.n_cols; ++j)
+  {
+    for (size_t i = 0; i < m.n_rows; ++i)
+    {
+      const int value = (m(i, j) > (size_t) INT_MAX) ? NA_INTEGER :
+          (int) m(i, j);
+      if (colMajor)
+        out(i, j) = value;
+      else
+        out(j, i) = value;
+    }
+  }
+
+  if (colMajor)
+    out.attr("col_major") = true;
+  return out;
+}
+
+//! Convert indices stored with R element type eT; see ToArmaIndices().
+template<typename eT>
+inline void CopyRIndices(const eT* in,
+                         const size_t rows,
+                         const size_t cols,
+                         const bool transpose,
+                         size_t* out)
+{
+  for (size_t j = 0; j < cols; ++j)
+  {
+    for (size_t i = 0; i < rows; ++i)
+    {
+      const eT value = in[i + j * rows];
+      // This also catches NA and NaN.
+      if (!(value >= 0))
+      {
+        Log::Fatal << "Indices and labels must be non-negative (got "
+            << value << ")!" << std::endl;
+      }
+
+      out[transpose ? (j + i * cols) : (i + j * rows)] = (size_t) value;
+    }
+  }
+}
+
+/**
+ * Copy an R vector or matrix of indices or labels, held as either integers or
+ * doubles, into the given memory in a single pass.  Integer input is never
+ * widened to double on the way.
+ *
+ * @param x R vector or matrix.
+ * @param transpose Whether to write the transpose of the matrix.
+ * @param out Memory to write Rf_xlength(x) indices to.
+ */
+inline void ToArmaIndices(SEXP x, const bool transpose, size_t* out)
+{
+  const size_t rows = Rf_isMatrix(x) ? Rf_nrows(x) : Rf_xlength(x);
+  const size_t cols = Rf_isMatrix(x) ? Rf_ncols(x) : 1;
+
+  if (TYPEOF(x) == INTSXP)
+    CopyRIndices(INTEGER(x), rows, cols, transpose, out);
+  else if (TYPEOF(x) == REALSXP)
+    CopyRIndices(REAL(x), rows, cols, transpose, out);
+  else
+    Log::Fatal << "Indices and labels must be integer or numeric!" << std::endl;
+}
+
+} // namespace r
+} // namespace bindings
+} // namespace mlpack
+
+#endif
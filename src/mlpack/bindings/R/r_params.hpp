@@ -0,0 +1,104 @@
+/**
+ * @file bindings/R/r_params.hpp
+ *
+ * Access to the per-call util::Params objects that the R bindings hand around
+ * as external pointers.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_R_R_PARAMS_HPP
+#define MLPACK_BINDINGS_R_R_PARAMS_HPP
+
+#include <mlpack/core/util/params.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace r {
+
+/**
+ * Get the util::Params object held by an R external pointer, as created by
+ * IO_MakeParams().
+ *
+ * @param params External pointer to the parameters.
+ */
+inline util::Params& GetParams(SEXP params)
+{
+  return *((util::Params*) R_ExternalPtrAddr(params));
+}
+
+/**
+ * Keep an R object alive for as long as the given parameters, and any model
+ * pointer returned from them, may use its memory.
+ *
+ * @param params External pointer to the parameters.
+ * @param x R object to keep alive.
+ */
+inline void KeepAlive(SEXP params, SEXP x)
+{
+  R_SetExternalPtrProtected(params, Rf_cons(x,
+      R_ExternalPtrProtected(params)));
+}
+
+/**
+ * Set a model pointer parameter from the R external pointer holding it.
+ *
+ * @param params External pointer to the parameters.
+ * @param paramName Name of the parameter.
+ * @param ptr External pointer to the model.
+ */
+template<typename T>
+void SetParamPtr(SEXP params, const std::string& paramName, SEXP ptr)
+{
+  util::Params& p = GetParams(params);
+  p.Get<T*>(paramName) = (T*) R_ExternalPtrAddr(ptr);
+  p.SetPassed(paramName);
+
+  // This also lets GetParamPtr() find the external pointer again.
+  KeepAlive(params, ptr);
+}
+
+/**
+ * Get a model pointer parameter as an R external pointer.  R frees the model
+ * once the pointer is garbage collected.
+ *
+ * @param params External pointer to the parameters.
+ * @param paramName Name of the parameter.
+ */
+template<typename T>
+SEXP GetParamPtr(SEXP params, const std::string& paramName)
+{
+  T* modelPtr = GetParams(params).Get<T*>(paramName);
+
+  // Bindings often hand an input model back as the output model; that model
+  // is already owned by its own external pointer, so return that one instead
+  // of one that would free the model a second time.
+  for (SEXP it = R_ExternalPtrProtected(params); it != R_NilValue;
+       it = CDR(it))
+  {
+    if (TYPEOF(CAR(it)) == EXTPTRSXP && R_ExternalPtrAddr(CAR(it)) == modelPtr)
+      return CAR(it);
+  }
+
+  // The model may use the memory of column-major inputs of this call, so they
+  // are kept alive along with it.  The input models of the call are not: the
+  // new model does not refer to them, and keeping them would hold on to their
+  // memory for as long as the new model lives.
+  Rcpp::RObject inputs;
+  for (SEXP it = R_ExternalPtrProtected(params); it != R_NilValue;
+       it = CDR(it))
+  {
+    if (TYPEOF(CAR(it)) != EXTPTRSXP)
+      inputs = Rf_cons(CAR(it), inputs);
+  }
+
+  return Rcpp::XPtr<T>(modelPtr, true, R_NilValue, inputs);
+}
+
+} // namespace r
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,118 @@
+/**
+ * @file bindings/R/r_search.hpp
+ *
+ * Direct queries on trained models held by R external pointers.  These skip
+ * the parameter handling of the bindings entirely, which matters when many
+ * small batches of queries are answered with one model.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_R_R_SEARCH_HPP
+#define MLPACK_BINDINGS_R_R_SEARCH_HPP
+
+#include <mlpack/prereqs.hpp>
+#include "r_matrix.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+template<typename SortPolicy>
+class NSModel;
+
+} // namespace neighbor
+
+namespace bindings {
+namespace r {
+
+//! Get the number of points the given model searches among.
+template<typename ModelType>
+size_t NumReferencePoints(const ModelType& model)
+{
+  return model.Dataset().n_cols;
+}
+
+//! Points may have been inserted into or removed from an NSModel.
+template<typename SortPolicy>
+size_t NumReferencePoints(const neighbor::NSModel<SortPolicy>& model)
+{
+  return model.NumPoints();
+}
+
+/**
+ * Search for the k neighbors of each query point with the given model (an
+ * NSModel or RAModel), and return a list holding the "distances" and
+ * "neighbors" matrices, in the same layout as the query matrix.
+ *
+ * @param model Trained model to search with.
+ * @param query R matrix of query points.
+ * @param k Number of neighbors to search for.
+ */
+template<typename ModelType>
+Rcpp::List SearchModel(ModelType& model,
+                       const Rcpp::NumericMatrix& query,
+                       const int k)
+{
+  // The search reorders the query set, so it always gets its own copy.
+  arma::mat querySet = ToArmaMatrix(query);
+  if (querySet.n_rows != model.Dataset().n_rows)
+  {
+    Log::Fatal << "Query has invalid dimensions(" << querySet.n_rows
+        << "); should be " << model.Dataset().n_rows << "!" << std::endl;
+  }
+
+  const size_t referencePoints = NumReferencePoints(model);
+  if (k <= 0 || (size_t) k > referencePoints)
+  {
+    Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
+        << "than or equal to the number of reference points ("
+        << referencePoints << ")." << std::endl;
+  }
+
+  arma::Mat<size_t> neighbors;
+  arma::mat distances;
+  model.Search(std::move(querySet), (size_t) k, neighbors, distances);
+
+  const bool colMajor = query.hasAttribute("col_major");
+  return Rcpp::List::create(
+      Rcpp::Named("distances") = ToRMatrix(distances, colMajor),
+      Rcpp::Named("neighbors") = ToRIndices(neighbors, colMajor));
+}
+
+/**
+ * Classify each test point with the given model (a FlatDecisionForest), and
+ * return a list holding the "predictions" and the "probabilities" matrix, in
+ * the same layout as the test matrix.
+ *
+ * @param model Trained model to classify with.
+ * @param test R matrix of test points.
+ */
+template<typename ModelType>
+Rcpp::List ClassifyModel(const ModelType& model,
+                         const Rcpp::NumericMatrix& test)
+{
+  const arma::mat testSet = ToArmaMatrix(test);
+  if (testSet.n_rows != model.Dimensionality())
+  {
+    Log::Fatal << "Test points have invalid dimensions(" << testSet.n_rows
+        << "); should be " << model.Dimensionality() << "!" << std::endl;
+  }
+
+  arma::Row<size_t> predictions;
+  arma::mat probabilities;
+  model.Classify(testSet, predictions, probabilities);
+
+  const bool colMajor = test.hasAttribute("col_major");
+  return Rcpp::List::create(
+      Rcpp::Named("predictions") = Rcpp::NumericVector(predictions.begin(),
+          predictions.end()),
+      Rcpp::Named("probabilities") = ToRMatrix(probabilities, colMajor));
+}
+
+} // namespace r
+} // namespace bindings
+} // namespace mlpack
+
+#endif
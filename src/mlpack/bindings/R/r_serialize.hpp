@@ -0,0 +1,143 @@
+/**
+ * @file bindings/R/r_serialize.hpp
+ *
+ * Serialization of models to and from R raw vectors.  The boost archive is
+ * written straight into the raw vector and read straight out of it, so no
+ * intermediate copy of the serialized model is ever made.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_BINDINGS_R_R_SERIALIZE_HPP
+#define MLPACK_BINDINGS_R_R_SERIALIZE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+namespace mlpack {
+namespace bindings {
+namespace r {
+
+/**
+ * An output stream buffer that discards everything written to it, and only
+ * counts the number of bytes.
+ */
+class CountingBuffer : public std::streambuf
+{
+ public:
+  CountingBuffer() : count(0) { }
+
+  //! Get the number of bytes written so far.
+  std::streamsize Count() const { return count; }
+
+ protected:
+  std::streamsize xsputn(const char* /* s */, std::streamsize n)
+  {
+    count += n;
+    return n;
+  }
+
+  int_type overflow(int_type c)
+  {
+    if (!traits_type::eq_int_type(c, traits_type::eof()))
+      ++count;
+    return traits_type::not_eof(c);
+  }
+
+ private:
+  //! The number of bytes written so far.
+  std::streamsize count;
+};
+
+/**
+ * A stream buffer over a fixed range of memory that is not owned by it.  It
+ * can be used for reading, or for writing up to the end of the range.
+ */
+class MemoryBuffer : public std::streambuf
+{
+ public:
+  MemoryBuffer(char* begin, char* end)
+  {
+    setg(begin, begin, end);
+    setp(begin, end);
+  }
+
+  //! Get the position that the next character would be written to.
+  char* WritePosition() const { return pptr(); }
+};
+
+/**
+ * Serialize a model into a new raw vector that has the given name as its
+ * "type" attribute.
+ *
+ * The archive is written twice: once only to measure its size, and once into
+ * a raw vector of exactly that size.  This keeps the memory needed at the size
+ * of the serialized model, but every model is serialized twice, which doubles
+ * the time taken to save large models such as those holding trees.  If the
+ * second archive is not exactly as long as the first, a std::runtime_error is
+ * thrown.
+ *
+ * @param model Model to serialize.
+ * @param name Name of the model type.
+ */
+template<typename T>
+Rcpp::RawVector SerializeModel(T& model, const std::string& name)
+{
+  CountingBuffer counter;
+  {
+    std::ostream os(&counter);
+    boost::archive::binary_oarchive oa(os);
+    oa << boost::serialization::make_nvp(name.c_str(), model);
+  }
+
+  Rcpp::RawVector rawVec(counter.Count());
+  char* begin = (char*) RAW(rawVec);
+  MemoryBuffer buffer(begin, begin + rawVec.size());
+  {
+    std::ostream os(&buffer);
+    boost::archive::binary_oarchive oa(os);
+    oa << boost::serialization::make_nvp(name.c_str(), model);
+  }
+
+  if (buffer.WritePosition() != begin + rawVec.size())
+  {
+    Log::Fatal << "Serialized " << name << " has "
+        << (buffer.WritePosition() - begin) << " bytes, but "
+        << rawVec.size() << " were counted!" << std::endl;
+  }
+
+  rawVec.attr("type") = name;
+  return rawVec;
+}
+
+/**
+ * Deserialize a model from a raw vector made by SerializeModel(), and return
+ * an external pointer to it.  R will be responsible for freeing the model.
+ *
+ * @param rawVec Raw vector holding the serialized model.
+ * @param name Name of the model type.
+ */
+template<typename T>
+SEXP DeserializeModel(const Rcpp::RawVector& rawVec, const std::string& name)
+{
+  std::unique_ptr<T> model(new T());
+
+  char* begin = (char*) RAW(rawVec);
+  MemoryBuffer buffer(begin, begin + rawVec.size());
+  {
+    std::istream is(&buffer);
+    boost::archive::binary_iarchive ia(is);
+    ia >> boost::serialization::make_nvp(name.c_str(), *model);
+  }
+
+  return Rcpp::XPtr<T>(model.release());
+}
+
+} // namespace r
+} // namespace bindings
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,187 @@
+/**
+ * @file core/data/binary_dataset.hpp
+ *
+ * The binary dataset format of mlpack (.mlpd files), which holds a matrix and
+ * the mappings of its categorical dimensions, laid out so that the matrix can
+ * be used straight from a memory mapping of the file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_DATASET_HPP
+#define MLPACK_CORE_DATA_BINARY_DATASET_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/mapped_file.hpp>
+
+#include "dataset_mapper.hpp"
+
+namespace mlpack {
+namespace data {
+
+/**
+ * The header at the start of a binary dataset file.  It is followed by the
+ * serialized DatasetMapper of the dataset, if there is one, and then by the
+ * matrix, in column-major order, starting at a multiple of
+ * BinaryDatasetAlignment bytes.  The matrix holds one point per column, as
+ * mlpack uses it, so that it needs no transposition or conversion when it is
+ * loaded.
+ */
+struct BinaryDatasetHeader
+{
+  //! Always "MLPKDATA".
+  char magic[8];
+  //! Always 0x0102030405060708, to detect files from another architecture.
+  uint64_t byteOrder;
+  //! Version of the format.
+  uint64_t version;
+  //! Number of rows of the matrix.
+  uint64_t rows;
+  //! Number of columns of the matrix.
+  uint64_t cols;
+  //! Size in bytes of each element of the matrix.
+  uint64_t elemSize;
+  //! Kind of element: 'f' (floating point), 'i' (signed integer) or 'u'
+  //! (unsigned integer).
+  uint64_t elemKind;
+  //! Offset of the serialized DatasetMapper.
+  uint64_t infoOffset;
+  //! Size of the serialized DatasetMapper, or 0 if there is none.
+  uint64_t infoSize;
+  //! Offset of the matrix.
+  uint64_t dataOffset;
+};
+
+//! Alignment of the matrix in a binary dataset file: the size of a page on
+//! most systems.
+static const size_t BinaryDatasetAlignment = 4096;
+
+/**
+ * The error thrown when a binary dataset file is mapped as a matrix of another
+ * element type than the one it holds.  Such a file can still be read, and
+ * converted, with LoadBinaryDataset().
+ */
+class BinaryDatasetTypeError : public std::runtime_error
+{
+ public:
+  BinaryDatasetTypeError(const std::string& what) : std::runtime_error(what) { }
+};
+
+/**
+ * Write a matrix to a binary dataset file.  A std::runtime_error is thrown on
+ * failure.
+ *
+ * @param filename Name of the file to write.
+ * @param matrix Matrix to write, with one point per column.
+ * @param info Serialized DatasetMapper of the matrix (see SerializeInfo()), or
+ *     an empty string.
+ */
+template<typename eT>
+void SaveBinaryDataset(const std::string& filename,
+                       const arma::Mat<eT>& matrix,
+                       const std::string& info = "");
+
+/**
+ * Read a binary dataset file into the given matrix, converting its elements
+ * if they are not of type eT.  A std::runtime_error is thrown on failure.
+ *
+ * @param filename Name of the file to read.
+ * @param matrix Matrix to read into.
+ * @param info String to store the serialized DatasetMapper into; NULL if it is
+ *     not needed.
+ */
+template<typename eT>
+void LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       std::string* info = NULL);
+
+//! Serialize a DatasetMapper so it can be stored in a binary dataset file.
+template<typename PolicyType>
+std::string SerializeInfo(const DatasetMapper<PolicyType>& info);
+
+//! Restore a DatasetMapper from its serialized form.
+template<typename PolicyType>
+void DeserializeInfo(const std::string& serialized,
+                     DatasetMapper<PolicyType>& info);
+
+/**
+ * A binary dataset file mapped into memory.  The matrix is backed by the
+ * mapping, so it is ready at once whatever its size, pages are only read from
+ * disk when they are used, and unmodified pages are shared with every other
+ * process that maps the file.  The matrix may be modified; modified pages are
+ * copied, and the file itself never changes.  The matrix is only valid as long
+ * as the MappedMatrix exists.
+ *
+ * The elements of the file must be of type eT.
+ */
+template<typename eT>
+class MappedMatrix
+{
+ public:
+  //! Create an empty MappedMatrix; use Map() to map a file.
+  MappedMatrix() : matrix(new arma::Mat<eT>()) { }
+
+  /**
+   * Map the given binary dataset file.  A std::runtime_error is thrown on
+   * failure.
+   *
+   * @param filename Name of the file to map.
+   */
+  MappedMatrix(const std::string& filename) { Map(filename); }
+
+  /**
+   * Map the given binary dataset file, replacing the current one.  A
+   * BinaryDatasetTypeError is thrown if the file does not hold elements of
+   * type eT, and a std::runtime_error on any other failure.
+   *
+   * @param filename Name of the file to map.
+   */
+  void Map(const std::string& filename);
+
+  //! Get the matrix.
+  const arma::Mat<eT>& Matrix() const { return *matrix; }
+  //! Modify the matrix.
+  arma::Mat<eT>& Matrix() { return *matrix; }
+
+  //! Restore the DatasetMapper stored with the matrix, if there is one.
+  template<typename PolicyType>
+  void Info(DatasetMapper<PolicyType>& info) const;
+
+ private:
+  //! The mapping of the file.
+  std::unique_ptr<util::MappedFile> file;
+  //! The matrix, which uses the memory of the mapping.
+  std::unique_ptr<arma::Mat<eT>> matrix;
+  //! The serialized DatasetMapper.
+  std::string info;
+
+  // Copying would leave two matrices on the same mapping.
+  MappedMatrix(const MappedMatrix&);
+  MappedMatrix& operator=(const MappedMatrix&);
+};
+
+/**
+ * Map a binary dataset file (.mlpd) into memory.  The matrix of the
+ * MappedMatrix then uses the memory of the mapping; see MappedMatrix.  If the
+ * parameter 'fatal' is set to true, a std::runtime_error exception will be
+ * thrown if the file cannot be mapped.
+ *
+ * @param filename Name of file to map.
+ * @param matrix MappedMatrix to map the file with.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @return Boolean value indicating success or failure of load.
+ */
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedMatrix<eT>& matrix,
+          const bool fatal = false);
+
+} // namespace data
+} // namespace mlpack
+
+// Include implementation.
+#include "binary_dataset_impl.hpp"
+
+#endif
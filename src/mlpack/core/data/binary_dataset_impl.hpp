@@ -0,0 +1,273 @@
+/**
+ * @file core/data/binary_dataset_impl.hpp
+ *
+ * Implementation of the binary dataset format.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_BINARY_DATASET_IMPL_HPP
+#define MLPACK_CORE_DATA_BINARY_DATASET_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "binary_dataset.hpp"
+
+#include <boost/archive/binary_iarchive.hpp>
+#include <boost/archive/binary_oarchive.hpp>
+
+namespace mlpack {
+namespace data {
+
+//! Get the kind of element stored for type eT (see BinaryDatasetHeader).
+template<typename eT>
+uint64_t BinaryDatasetKind()
+{
+  if (std::is_floating_point<eT>::value)
+    return 'f';
+  else if (std::is_signed<eT>::value)
+    return 'i';
+  else
+    return 'u';
+}
+
+/**
+ * Store a * b in result and return true, or return false if the product does
+ * not fit in 64 bits.
+ */
+inline bool CheckedMultiply(const uint64_t a,
+                            const uint64_t b,
+                            uint64_t& result)
+{
+  if (a != 0 && b > std::numeric_limits<uint64_t>::max() / a)
+    return false;
+
+  result = a * b;
+  return true;
+}
+
+/**
+ * Check that the given mapped file is a binary dataset file, and return its
+ * header.  A std::runtime_error is thrown if it is not.
+ */
+inline const BinaryDatasetHeader& CheckBinaryDatasetHeader(
+    const util::MappedFile& file)
+{
+  const BinaryDatasetHeader& header = *((const BinaryDatasetHeader*)
+      file.Data());
+  if (file.Size() < sizeof(BinaryDatasetHeader) ||
+      memcmp(header.magic, "MLPKDATA", 8) != 0)
+  {
+    std::ostringstream oss;
+    oss << "'" << file.Filename() << "' is not a binary dataset file!";
+    throw std::runtime_error(oss.str());
+  }
+
+  if (header.byteOrder != 0x0102030405060708ULL || header.version != 1)
+  {
+    std::ostringstream oss;
+    oss << "'" << file.Filename() << "' was written on another architecture "
+        << "or by another version of mlpack!";
+    throw std::runtime_error(oss.str());
+  }
+
+  // The sizes in the header may be anything, so they are checked without
+  // letting them overflow.
+  const uint64_t size = file.Size();
+  uint64_t dataSize = 0;
+  if (header.infoOffset > size || header.infoSize > size - header.infoOffset ||
+      header.dataOffset > size ||
+      !CheckedMultiply(header.rows, header.cols, dataSize) ||
+      !CheckedMultiply(dataSize, header.elemSize, dataSize) ||
+      dataSize > size - header.dataOffset)
+  {
+    std::ostringstream oss;
+    oss << "'" << file.Filename() << "' is truncated!";
+    throw std::runtime_error(oss.str());
+  }
+
+  return header;
+}
+
+template<typename eT>
+void SaveBinaryDataset(const std::string& filename,
+                       const arma::Mat<eT>& matrix,
+                       const std::string& info)
+{
+  std::ofstream stream(filename.c_str(), std::ios::out | std::ios::binary);
+  if (!stream.is_open())
+  {
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "' for writing.";
+    throw std::runtime_error(oss.str());
+  }
+
+  BinaryDatasetHeader header;
+  memset(&header, 0, sizeof(BinaryDatasetHeader));
+  memcpy(header.magic, "MLPKDATA", 8);
+  header.byteOrder = 0x0102030405060708ULL;
+  header.version = 1;
+  header.rows = matrix.n_rows;
+  header.cols = matrix.n_cols;
+  header.elemSize = sizeof(eT);
+  header.elemKind = BinaryDatasetKind<eT>();
+  header.infoOffset = sizeof(BinaryDatasetHeader);
+  header.infoSize = info.size();
+  header.dataOffset = ((header.infoOffset + header.infoSize +
+      BinaryDatasetAlignment - 1) / BinaryDatasetAlignment) *
+      BinaryDatasetAlignment;
+
+  stream.write((const char*) &header, sizeof(BinaryDatasetHeader));
+  stream.write(info.data(), info.size());
+  const std::vector<char> padding(header.dataOffset - header.infoOffset -
+      header.infoSize, 0);
+  stream.write(padding.data(), padding.size());
+  stream.write((const char*) matrix.memptr(), matrix.n_elem * sizeof(eT));
+
+  if (!stream.good())
+  {
+    std::ostringstream oss;
+    oss << "Writing to '" << filename << "' failed.";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+//! Convert the elements of a mapped matrix of type FileT to type eT.
+template<typename eT, typename FileT>
+void ConvertBinaryDataset(const char* data,
+                          const size_t rows,
+                          const size_t cols,
+                          arma::Mat<eT>& matrix)
+{
+  const arma::Mat<FileT> alias((FileT*) data, rows, cols, false, true);
+  matrix = arma::conv_to<arma::Mat<eT>>::from(alias);
+}
+
+template<typename eT>
+void LoadBinaryDataset(const std::string& filename,
+                       arma::Mat<eT>& matrix,
+                       std::string* info)
+{
+  util::MappedFile file(filename);
+  const BinaryDatasetHeader& header = CheckBinaryDatasetHeader(file);
+  if (info)
+    info->assign(file.Data() + header.infoOffset, header.infoSize);
+
+  const char* data = file.Data() + header.dataOffset;
+  const size_t rows = (size_t) header.rows;
+  const size_t cols = (size_t) header.cols;
+  if (header.elemSize == sizeof(eT) &&
+      header.elemKind == BinaryDatasetKind<eT>())
+  {
+    matrix.set_size(rows, cols);
+    memcpy(matrix.memptr(), data, matrix.n_elem * sizeof(eT));
+  }
+  else if (header.elemKind == 'f' && header.elemSize == 8)
+    ConvertBinaryDataset<eT, double>(data, rows, cols, matrix);
+  else if (header.elemKind == 'f' && header.elemSize == 4)
+    ConvertBinaryDataset<eT, float>(data, rows, cols, matrix);
+  else if (header.elemKind == 'i' && header.elemSize == 8)
+    ConvertBinaryDataset<eT, int64_t>(data, rows, cols, matrix);
+  else if (header.elemKind == 'i' && header.elemSize == 4)
+    ConvertBinaryDataset<eT, int32_t>(data, rows, cols, matrix);
+  else if (header.elemKind == 'u' && header.elemSize == 8)
+    ConvertBinaryDataset<eT, uint64_t>(data, rows, cols, matrix);
+  else if (header.elemKind == 'u' && header.elemSize == 4)
+    ConvertBinaryDataset<eT, uint32_t>(data, rows, cols, matrix);
+  else
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' holds elements of an unknown type!";
+    throw std::runtime_error(oss.str());
+  }
+}
+
+template<typename PolicyType>
+std::string SerializeInfo(const DatasetMapper<PolicyType>& info)
+{
+  std::ostringstream oss;
+  {
+    boost::archive::binary_oarchive ar(oss);
+    ar << info;
+  }
+  return oss.str();
+}
+
+template<typename PolicyType>
+void DeserializeInfo(const std::string& serialized,
+                     DatasetMapper<PolicyType>& info)
+{
+  std::istringstream iss(serialized);
+  boost::archive::binary_iarchive ar(iss);
+  ar >> info;
+}
+
+template<typename eT>
+void MappedMatrix<eT>::Map(const std::string& filename)
+{
+  // Release the current mapping first.
+  matrix.reset(new arma::Mat<eT>());
+  file.reset();
+  info.clear();
+
+  std::unique_ptr<util::MappedFile> newFile(new util::MappedFile(filename,
+      true));
+  const BinaryDatasetHeader& header = CheckBinaryDatasetHeader(*newFile);
+  if (header.elemSize != sizeof(eT) ||
+      header.elemKind != BinaryDatasetKind<eT>())
+  {
+    std::ostringstream oss;
+    oss << "'" << filename << "' does not hold elements of the requested type;"
+        << " load it into a matrix instead to convert them.";
+    throw BinaryDatasetTypeError(oss.str());
+  }
+
+  info.assign(newFile->Data() + header.infoOffset, header.infoSize);
+  matrix.reset(new arma::Mat<eT>((eT*) (newFile->Data() + header.dataOffset),
+      header.rows, header.cols, false, true));
+  file = std::move(newFile);
+}
+
+template<typename eT>
+template<typename PolicyType>
+void MappedMatrix<eT>::Info(DatasetMapper<PolicyType>& info) const
+{
+  if (this->info.empty())
+    info = DatasetMapper<PolicyType>(matrix->n_rows);
+  else
+    DeserializeInfo(this->info, info);
+}
+
+template<typename eT>
+bool Load(const std::string& filename,
+          MappedMatrix<eT>& matrix,
+          const bool fatal)
+{
+  Timer::Start("loading_data");
+  try
+  {
+    matrix.Map(filename);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("loading_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Log::Info << "Mapped '" << filename << "'; size is "
+      << matrix.Matrix().n_cols << " x " << matrix.Matrix().n_rows << ".\n";
+  Timer::Stop("loading_data");
+
+  return true;
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -21,6 +21,7 @@
 #include "format.hpp"
 #include "dataset_mapper.hpp"
 #include "image_info.hpp"
+#include "binary_dataset.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices and models. */ {
@@ -41,6 +42,7 @@ namespace data /** Functions to load and save matrices and models. */ {
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
  *  - HDF5, denoted by .hdf, .hdf5, .h5, or .he5
+ *  - mlpack binary dataset, denoted by .mlpd (see BinaryDatasetHeader)
  *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
@@ -51,7 +53,9 @@ namespace data /** Functions to load and save matrices and models. */ {
  * 'transpose' controls whether or not the matrix is transposed after loading.
  * In most cases, because data is generally stored in a row-major format and
  * mlpack requires column-major matrices, this should be left at its default
- * value of 'true'.
+ * value of 'true'.  (Binary datasets already hold one point per column, so with
+ * 'transpose' set to true they are loaded as they are.)  To use a binary
+ * dataset without reading it into memory at all, load it into a MappedMatrix.
  *
  * @param filename Name of file to load.
  * @param matrix Matrix to load contents of file into.
@@ -247,6 +251,9 @@ bool Load(const std::string& filename,
  * - TSV (raw_ascii), denoted by .tsv, .csv, or .txt
  * - ASCII (raw_ascii), denoted by .txt
  *
+ * ARFF files (.arff) and mlpack binary datasets (.mlpd) can be loaded too; the
+ * mappings of a binary dataset are those it was saved with.
+ *
  * If the file extension is not one of those types, an error will be given.
  * This is preferable to Armadillo's default behavior of loading an unknown
  * filetype as raw_binary, which can have very confusing effects.
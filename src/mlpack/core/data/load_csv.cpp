@@ -3,7 +3,8 @@
  * @author Tham Ngap Wei
  * @author Mehul Kumar Nirala
  *
- * A CSV reader that uses boost::spirit.
+ * The non-template parts of LoadCSV: splitting the file into blocks and lines,
+ * tokenizing lines, and the fast number parser.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -12,75 +13,378 @@
  */
 #include "load_csv.hpp"
 
-using namespace boost::spirit;
-
 namespace mlpack {
 namespace data {
 
 LoadCSV::LoadCSV(const std::string& file) :
-  extension(Extension(file)),
-  filename(file),
-  inFile(file)
+    extension(Extension(file)),
+    filename(file),
+    delimiter(extension == "csv" ? ',' : (extension == "txt" ? ' ' : '\t')),
+    fields(0),
+    chunkPosition(0),
+    chunkPoint(0),
+    chunksStarted(false)
 {
-  // Attempt to open stream.
-  CheckOpen();
-
-  //! Spirit rule for parsing quoted string.
-  boost::spirit::qi::rule<std::string::iterator, iter_type()> quotedRule;
-  // Match quoted strings as: "string" or 'string'
-  quotedRule = qi::raw[(qi::char_("'") >> *((qi::char_ - "'") |
-                               "'" >> qi::char_("'")) >> "'") |
-                       (qi::char_('"') >> *((qi::char_ - '"') |
-                               '"' >> qi::char_('"')) >> '"') ];
-
-  // Set rules.
-  if (extension == "csv")
-  {
-    // Match all characters that are not ',', '\r', or '\n'.
-    stringRule = quotedRule.copy() | qi::raw[*~qi::char_(",\r\n")];
-  }
-  else if (extension == "txt")
+  std::ifstream stream(file, std::ios::in | std::ios::binary | std::ios::ate);
+  if (!stream.is_open())
   {
-    // Match all characters that are not ' ', ',', '\r', or '\n'.
-    stringRule = quotedRule.copy() | qi::raw[*~qi::char_(" ,\r\n")];
+    std::ostringstream oss;
+    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    throw std::runtime_error(oss.str());
   }
-  else // TSV.
+
+  // An empty file cannot be mapped, but there is nothing to read in it anyway.
+  if (stream.tellg() > 0)
+    mapping.reset(new util::MappedFile(filename));
+}
+
+std::vector<LoadCSV::Block> LoadCSV::SplitBlocks(const char* begin,
+                                                 const char* end,
+                                                 const size_t firstLine) const
+{
+  std::vector<Block> blocks;
+  const char* p = begin;
+  while (p < end)
   {
-    // Match all characters that are not '\t', '\r', or '\n'.
-    stringRule = quotedRule.copy() | qi::raw[*~qi::char_("\t\r\n")];
+    // Extend the block to the end of the line it stops in.
+    const char* blockEnd = end;
+    if ((size_t) (end - p) > BlockSize)
+    {
+      const char* newline = (const char*) memchr(p + BlockSize - 1, '\n',
+          end - (p + BlockSize - 1));
+      if (newline != NULL)
+        blockEnd = newline + 1;
+    }
+
+    Block block;
+    block.begin = p;
+    block.end = blockEnd;
+    block.firstLine = firstLine;
+    block.lines = 0;
+    blocks.push_back(block);
+
+    p = blockEnd;
   }
 
-  if (extension == "csv")
+  // Count the lines of each block, and find where each block starts.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) blocks.size(); ++i)
   {
-    // Extract a single comma as the delimiter, catching whitespace on either
-    // side.
-    delimiterRule = qi::raw[(*qi::char_(" ") >> qi::char_(",") >>
-        *qi::char_(" "))];
+    const char* p = blocks[i].begin;
+    Range line;
+    while (NextLine(p, blocks[i].end, line))
+      ++blocks[i].lines;
   }
-  else if (extension == "txt")
+
+  for (size_t i = 1; i < blocks.size(); ++i)
+    blocks[i].firstLine = blocks[i - 1].firstLine + blocks[i - 1].lines;
+
+  return blocks;
+}
+
+bool LoadCSV::Tokenize(const char* begin,
+                       const char* end,
+                       std::vector<Range>& tokens) const
+{
+  tokens.clear();
+
+  const char* p = begin;
+  while (true)
   {
-    // This one is a little more difficult, we need to catch any number of
-    // spaces more than one.
-    delimiterRule = qi::raw[+qi::char_(" ")];
+    Range token;
+    token.begin = p;
+
+    // A token may be a string quoted with ' or ", in which a doubled quote
+    // stands for the quote itself.  If the quote is not closed, the token is
+    // read as a normal one.
+    bool quoted = false;
+    if (p != end && (*p == '"' || *p == '\''))
+    {
+      const char quote = *p;
+      const char* q = p + 1;
+      while (q != end)
+      {
+        if (*q == quote)
+        {
+          if (q + 1 != end && *(q + 1) == quote)
+          {
+            q += 2;
+            continue;
+          }
+
+          quoted = true;
+          p = q + 1;
+          break;
+        }
+
+        ++q;
+      }
+    }
+
+    // Otherwise the token runs until the delimiter.  In txt files, commas are
+    // not allowed in unquoted tokens.
+    if (!quoted)
+    {
+      while (p != end && *p != delimiter && *p != '\r' &&
+          !(delimiter == ' ' && *p == ','))
+        ++p;
+    }
+
+    token.end = p;
+    Trim(token);
+    tokens.push_back(token);
+
+    if (p == end)
+      return true;
+
+    // Now skip the delimiter.  Spaces around a comma or a tab are ignored; in
+    // txt files, the delimiter is a run of spaces.
+    while (p != end && *p == ' ' && delimiter != ' ')
+      ++p;
+    if (p == end || *p != delimiter)
+      return false;
+    ++p;
+    while (p != end && *p == ' ')
+      ++p;
   }
-  else // TSV.
+}
+
+size_t LoadCSV::CountFields() const
+{
+  if (!mapping)
+    return 0;
+
+  const char* p = mapping->Data();
+  Range line;
+  if (!NextLine(p, mapping->Data() + mapping->Size(), line))
+    return 0;
+
+  std::vector<Range> tokens;
+  if (!Tokenize(line.begin, line.end, tokens))
   {
-    // Catch a tab character, possibly with whitespace on either side.
-    delimiterRule = qi::raw[(*qi::char_(" ") >> qi::char_("\t") >>
-        *qi::char_(" "))];
+    std::ostringstream oss;
+    oss << "LoadCSV::Load(): parsing error on line 0!";
+    throw std::runtime_error(oss.str());
   }
+
+  return tokens.size();
 }
 
-void LoadCSV::CheckOpen()
+bool LoadCSV::TokenizeLine(const Range& line,
+                           const size_t index,
+                           std::vector<Range>& tokens,
+                           BlockError& error) const
 {
-  if (!inFile.is_open())
+  const bool parsed = Tokenize(line.begin, line.end, tokens);
+  if (parsed && tokens.size() == fields)
+    return true;
+
+  error.line = index;
+  error.tokens = tokens.size();
+  error.parseError = !parsed;
+  return false;
+}
+
+void LoadCSV::CheckErrors(const std::vector<BlockError>& errors) const
+{
+  // The blocks are in the order of the file, so the first error found is the
+  // first one in the file.
+  for (size_t i = 0; i < errors.size(); ++i)
   {
+    if (errors[i].line == SIZE_MAX)
+      continue;
+
     std::ostringstream oss;
-    oss << "Cannot open file '" << filename << "'. " << std::endl;
+    if (errors[i].parseError)
+    {
+      oss << "LoadCSV::Load(): parsing error on line " << errors[i].line
+          << "!";
+    }
+    else
+    {
+      oss << "LoadCSV::Load(): wrong number of dimensions ("
+          << errors[i].tokens << ") on line " << errors[i].line
+          << "; should be " << fields << " dimensions.";
+    }
     throw std::runtime_error(oss.str());
   }
+}
+
+namespace {
+
+//! Powers of ten that are exact in double precision.
+const double exactDoublePowers[] = { 1e0, 1e1, 1e2, 1e3, 1e4, 1e5, 1e6, 1e7,
+    1e8, 1e9, 1e10, 1e11, 1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20,
+    1e21, 1e22 };
+
+//! Powers of ten that are exact in single precision.
+const float exactFloatPowers[] = { 1e0f, 1e1f, 1e2f, 1e3f, 1e4f, 1e5f, 1e6f,
+    1e7f, 1e8f, 1e9f, 1e10f };
+
+/**
+ * Read a number with at most 19 significant digits as mantissa * 10^exponent.
+ * Returns false if the range does not hold a number, or if the number has too
+ * many digits for the mantissa (in which case exact is set to false).
+ */
+bool ReadDecimal(const char* begin,
+                 const char* end,
+                 bool& negative,
+                 uint64_t& mantissa,
+                 int& exponent,
+                 bool& exact)
+{
+  const char* p = begin;
+  negative = false;
+  mantissa = 0;
+  exponent = 0;
+  exact = true;
+
+  if (p != end && (*p == '+' || *p == '-'))
+  {
+    negative = (*p == '-');
+    ++p;
+  }
+
+  // Leading zeros are not significant digits.
+  int digits = 0;
+  bool anyDigits = false;
+  while (p != end && *p >= '0' && *p <= '9')
+  {
+    anyDigits = true;
+    if (digits < 19)
+    {
+      mantissa = 10 * mantissa + (*p - '0');
+      if (mantissa != 0)
+        ++digits;
+    }
+    else
+    {
+      exact = false;
+    }
+    ++p;
+  }
+
+  if (p != end && *p == '.')
+  {
+    ++p;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+      anyDigits = true;
+      if (digits < 19)
+      {
+        mantissa = 10 * mantissa + (*p - '0');
+        if (mantissa != 0)
+          ++digits;
+        --exponent;
+      }
+      else
+      {
+        exact = false;
+      }
+      ++p;
+    }
+  }
+
+  if (!anyDigits)
+    return false;
+
+  if (p != end && (*p == 'e' || *p == 'E'))
+  {
+    ++p;
+    bool negativeExponent = false;
+    if (p != end && (*p == '+' || *p == '-'))
+    {
+      negativeExponent = (*p == '-');
+      ++p;
+    }
+
+    if (p == end || *p < '0' || *p > '9')
+      return false;
+
+    // Huge exponents are clamped; they are left to std::strtod() anyway.
+    int explicitExponent = 0;
+    while (p != end && *p >= '0' && *p <= '9')
+    {
+      if (explicitExponent < 100000)
+        explicitExponent = 10 * explicitExponent + (*p - '0');
+      ++p;
+    }
+
+    exponent += (negativeExponent ? -explicitExponent : explicitExponent);
+  }
+
+  return (p == end);
+}
+
+/**
+ * Parse a number that ReadDecimal() accepted with std::strtod() or
+ * std::strtof().  Out-of-range numbers are rejected, as a stringstream would.
+ */
+template<typename T>
+bool ParseSlow(const char* begin, const char* end, T& value)
+{
+  const std::string token(begin, end);
+  errno = 0;
+  if (std::is_same<T, float>::value)
+    value = std::strtof(token.c_str(), NULL);
+  else
+    value = std::strtod(token.c_str(), NULL);
+
+  return (errno != ERANGE);
+}
+
+/**
+ * Parse a number, using a single multiplication or division by an exact power
+ * of ten when the mantissa is small enough to be exact, which gives the
+ * correctly rounded result.
+ */
+template<typename T>
+bool ParseFast(const char* begin,
+               const char* end,
+               T& value,
+               const T* exactPowers,
+               const int maxExactPower)
+{
+  bool negative, exact;
+  uint64_t mantissa;
+  int exponent;
+  if (!ReadDecimal(begin, end, negative, mantissa, exponent, exact))
+    return false;
+
+  const uint64_t maxExactMantissa =
+      (uint64_t(1) << std::numeric_limits<T>::digits);
+  if (mantissa == 0)
+  {
+    value = (negative ? -T(0) : T(0));
+    return true;
+  }
+  else if (!exact || mantissa > maxExactMantissa ||
+      exponent < -maxExactPower || exponent > maxExactPower)
+  {
+    return ParseSlow(begin, end, value);
+  }
+
+  value = T(mantissa);
+  if (exponent < 0)
+    value /= exactPowers[-exponent];
+  else
+    value *= exactPowers[exponent];
+  if (negative)
+    value = -value;
+
+  return true;
+}
 
-  inFile.unsetf(std::ios::skipws);
+} // namespace
+
+bool ParseCSVNumber(const char* begin, const char* end, double& value)
+{
+  return ParseFast(begin, end, value, exactDoublePowers, 22);
+}
+
+bool ParseCSVNumber(const char* begin, const char* end, float& value)
+{
+  return ParseFast(begin, end, value, exactFloatPowers, 10);
 }
 
 } // namespace data
@@ -2,7 +2,8 @@
  * @file core/data/load_csv.hpp
  * @author ThamNgapWei
  *
- * This is a csv parsers which use to parse the csv file format
+ * A loader for csv, tsv and txt files that works on a memory mapping of the
+ * file and parses it in parallel.
  *
  * mlpack is free software; you may redistribute it and/or modify it under the
  * terms of the 3-clause BSD license.  You should have received a copy of the
@@ -12,11 +13,9 @@
 #ifndef MLPACK_CORE_DATA_LOAD_CSV_HPP
 #define MLPACK_CORE_DATA_LOAD_CSV_HPP
 
-#include <boost/spirit/include/qi.hpp>
-#include <boost/algorithm/string/trim.hpp>
-
 #include <mlpack/core.hpp>
 #include <mlpack/core/util/log.hpp>
+#include <mlpack/core/util/mapped_file.hpp>
 
 #include <set>
 #include <string>
@@ -29,16 +28,50 @@ namespace mlpack {
 namespace data {
 
 /**
- *Load the csv file.This class use boost::spirit
- *to implement the parser, please refer to following link
- *http://theboostcpplibraries.com/boost.spirit for quick review.
+ * Whether the given policy maps every token that can be read as a number to
+ * that number, and ignores such tokens during its first pass, as long as it
+ * has not made the dimension of the token categorical.  LoadCSV then only
+ * passes the tokens of a dimension to the policy if some token of that
+ * dimension cannot be read as a number; otherwise every token is passed to
+ * the policy, in the order of the file, which is always correct but slower.
+ */
+template<typename PolicyType>
+struct CSVNumericPassthrough
+{
+  static bool Value(const PolicyType& /* policy */) { return false; }
+};
+
+//! IncrementPolicy only maps numbers when it is told to map everything.
+template<>
+struct CSVNumericPassthrough<IncrementPolicy>
+{
+  static bool Value(const IncrementPolicy& policy)
+  {
+    return !policy.ForceAllMappings();
+  }
+};
+
+/**
+ * Load a csv, tsv or txt file.  The file is mapped into memory and split into
+ * blocks of whole lines, which are tokenized and parsed in parallel with
+ * OpenMP; numbers are read with a fast parser that gives the same result as
+ * std::strtod().  Only the tokens of dimensions that turn out not to be
+ * numeric are passed to the DatasetMapper, in the order of the file, so that
+ * categorical mappings are the same as those of a sequential load.  Blank
+ * lines are skipped.  The fast parser only exists for float and double
+ * matrices; for other element types every token goes through the
+ * DatasetMapper serially, and a warning says so.
+ *
+ * The file can either be loaded at once with Load(), or read a chunk of points
+ * at a time with NextChunk(), so that files that do not fit in memory can be
+ * processed.
  */
 class LoadCSV
 {
  public:
   /**
-   * Construct the LoadCSV object on the given file.  This will construct the
-   * rules necessary for loading and attempt to open the file.
+   * Construct the LoadCSV object on the given file, and map the file into
+   * memory.  A std::runtime_error is thrown if the file cannot be opened.
    */
   LoadCSV(const std::string& file);
 
@@ -52,325 +85,301 @@ class LoadCSV
    *     (default).
    */
   template<typename T, typename PolicyType>
-  void Load(arma::Mat<T> &inout,
-            DatasetMapper<PolicyType> &infoSet,
-            const bool transpose = true)
+  void Load(arma::Mat<T>& inout,
+            DatasetMapper<PolicyType>& infoSet,
+            const bool transpose = true);
+
+  /**
+   * Read the next chunk of at most maxPoints points of the file, one point per
+   * line, into the given matrix (one point per column, as with a transposed
+   * Load()).  On the first call the DatasetMapper is initialized with the
+   * dimensionality of the file and, if its policy needs it, a first pass is
+   * taken over the whole file, without storing it; the same DatasetMapper
+   * must be given to every later call.  Throws exceptions on errors.
+   *
+   * @param chunk Matrix to load the chunk into.
+   * @param infoSet DatasetMapper to use while loading.
+   * @param maxPoints Maximum number of points to read.
+   * @return false if there were no points left to read, true otherwise.
+   */
+  template<typename T, typename PolicyType>
+  bool NextChunk(arma::Mat<T>& chunk,
+                 DatasetMapper<PolicyType>& infoSet,
+                 const size_t maxPoints);
+
+  //! Start reading chunks from the start of the file again.  The first pass
+  //! over the file is not taken again.
+  void ResetChunks() { chunkPosition = 0; chunkPoint = 0; }
+
+  //! Get the number of points read by NextChunk() so far.
+  size_t ChunkPoint() const { return chunkPoint; }
+
+  //! Get the size of the file in bytes.
+  size_t Size() const { return (mapping ? mapping->Size() : 0); }
+
+ private:
+  //! A range of characters of the file.
+  struct Range
   {
-    CheckOpen();
+    const char* begin;
+    const char* end;
+  };
 
-    if (transpose)
-      TransposeParse(inout, infoSet);
-    else
-      NonTransposeParse(inout, infoSet);
-  }
+  //! A range of whole lines of the file.
+  struct Block
+  {
+    //! Start of the first line.
+    const char* begin;
+    //! End of the last line.
+    const char* end;
+    //! Index of the first non-blank line of the block among all those parsed.
+    size_t firstLine;
+    //! Number of non-blank lines in the block.
+    size_t lines;
+  };
+
+  //! Which tokens of a dimension go through the DatasetMapper.
+  enum MapMode : char
+  {
+    //! None of them.
+    MapNone = 0,
+    //! All of them.
+    MapAll = 1,
+    //! Only those that cannot be read as numbers.
+    MapNonNumeric = 2
+  };
+
+  //! A token that must go through the DatasetMapper.
+  struct MappedToken
+  {
+    //! The token itself.
+    Range token;
+    //! Index of the line of the token.
+    size_t line;
+    //! Index of the token on its line.
+    size_t field;
+  };
+
+  //! What went wrong while parsing a block, if anything.
+  struct BlockError
+  {
+    //! Index of the bad line, or SIZE_MAX if the block has no error.
+    size_t line;
+    //! Number of tokens on the bad line.
+    size_t tokens;
+    //! Whether the line could not be tokenized at all.
+    bool parseError;
+  };
+
+  //! Remove whitespace from either side of the given range.
+  static void Trim(Range& range);
+
+  /**
+   * Find the next non-blank line of [p, end), trimmed, and move p past it.
+   * Returns false if there is no such line.
+   */
+  static bool NextLine(const char*& p, const char* end, Range& line);
 
   /**
-   * Peek at the file to determine the number of rows and columns in the matrix,
-   * assuming a non-transposed matrix.  This will also take a first pass over
-   * the data for DatasetMapper, if MapPolicy::NeedsFirstPass is true.  The info
-   * object will be re-initialized with the correct dimensionality.
+   * Split the given range of the file into blocks of whole lines of about
+   * BlockSize bytes each, and count the non-blank lines in each block.
    *
-   * @param rows Variable to be filled with the number of rows.
-   * @param cols Variable to be filled with the number of columns.
-   * @param info DatasetMapper object to use for first pass.
+   * @param begin Start of the range; must be the start of a line.
+   * @param end End of the range.
+   * @param firstLine Index of the first non-blank line of the range.
    */
-  template<typename T, typename MapPolicy>
-  void GetMatrixSize(size_t& rows, size_t& cols, DatasetMapper<MapPolicy>& info)
-  {
-    using namespace boost::spirit;
-
-    // Take a pass through the file.  If the DatasetMapper policy requires it,
-    // we will pass everything string through MapString().  This might be useful
-    // if, e.g., the MapPolicy needs to find which dimensions are numeric or
-    // categorical.
-
-    // Reset to the start of the file.
-    inFile.clear();
-    inFile.seekg(0, std::ios::beg);
-    rows = 0;
-    cols = 0;
-
-    // First, count the number of rows in the file (this is the dimensionality).
-    std::string line;
-    while (std::getline(inFile, line))
-    {
-      ++rows;
-    }
-    info = DatasetMapper<MapPolicy>(rows);
-
-    // Now, jump back to the beginning of the file.
-    inFile.clear();
-    inFile.seekg(0, std::ios::beg);
-    rows = 0;
-
-    while (std::getline(inFile, line))
-    {
-      ++rows;
-      // Remove whitespace from either side.
-      boost::trim(line);
-
-      if (rows == 1)
-      {
-        // Extract the number of columns.
-        auto findColSize = [&cols](iter_type) { ++cols; };
-        qi::parse(line.begin(), line.end(),
-            stringRule[findColSize] % delimiterRule);
-      }
-
-      // I guess this is technically a second pass, but that's ok... still the
-      // same idea...
-      if (MapPolicy::NeedsFirstPass)
-      {
-        // In this case we must pass everything we parse to the MapPolicy.
-        auto firstPassMap = [&](const iter_type& iter)
-        {
-          std::string str(iter.begin(), iter.end());
-          boost::trim(str);
-
-          info.template MapFirstPass<T>(std::move(str), rows - 1);
-        };
-
-        // Now parse the line.
-        qi::parse(line.begin(), line.end(),
-            stringRule[firstPassMap] % delimiterRule);
-      }
-    }
-  }
+  std::vector<Block> SplitBlocks(const char* begin,
+                                 const char* end,
+                                 const size_t firstLine) const;
 
   /**
-   * Peek at the file to determine the number of rows and columns in the matrix,
-   * assuming a transposed matrix.  This will also take a first pass over the
-   * data for DatasetMapper, if MapPolicy::NeedsFirstPass is true.  The info
-   * object will be re-initialized with the correct dimensionality.
+   * Split the given line into tokens, which are trimmed.  Returns false if
+   * the line cannot be tokenized.
    *
-   * @param rows Variable to be filled with the number of rows.
-   * @param cols Variable to be filled with the number of columns.
-   * @param info DatasetMapper object to use for first pass.
+   * @param begin Start of the line.
+   * @param end End of the line.
+   * @param tokens Vector to store the tokens into; it is cleared first.
    */
-  template<typename T, typename MapPolicy>
-  void GetTransposeMatrixSize(size_t& rows,
-                              size_t& cols,
-                              DatasetMapper<MapPolicy>& info)
-  {
-    using namespace boost::spirit;
-
-    // Take a pass through the file.  If the DatasetMapper policy requires it,
-    // we will pass everything string through MapString().  This might be useful
-    // if, e.g., the MapPolicy needs to find which dimensions are numeric or
-    // categorical.
-
-    // Reset to the start of the file.
-    inFile.clear();
-    inFile.seekg(0, std::ios::beg);
-    rows = 0;
-    cols = 0;
-
-    std::string line;
-    while (std::getline(inFile, line))
-    {
-      ++cols;
-      // Remove whitespace from either side.
-      boost::trim(line);
-
-      if (cols == 1)
-      {
-        // Extract the number of dimensions.
-        auto findRowSize = [&rows](iter_type) { ++rows; };
-        qi::parse(line.begin(), line.end(),
-            stringRule[findRowSize] % delimiterRule);
-
-        // Now that we know the dimensionality, initialize the DatasetMapper.
-        info.SetDimensionality(rows);
-      }
-
-      // If we need to do a first pass for the DatasetMapper, do it.
-      if (MapPolicy::NeedsFirstPass)
-      {
-        size_t dim = 0;
-
-        // In this case we must pass everything we parse to the MapPolicy.
-        auto firstPassMap = [&](const iter_type& iter)
-        {
-          std::string str(iter.begin(), iter.end());
-          boost::trim(str);
-
-          info.template MapFirstPass<T>(std::move(str), dim++);
-        };
-
-        // Now parse the line.
-        qi::parse(line.begin(), line.end(),
-            stringRule[firstPassMap] % delimiterRule);
-      }
-    }
-  }
+  bool Tokenize(const char* begin,
+                const char* end,
+                std::vector<Range>& tokens) const;
 
- private:
-  using iter_type = boost::iterator_range<std::string::iterator>;
+  /**
+   * Find the number of tokens on the first non-blank line of the file.  A
+   * std::runtime_error is thrown if it cannot be tokenized.
+   */
+  size_t CountFields() const;
 
   /**
-   * Check whether or not the file has successfully opened; throw an exception
-   * if not.
+   * Split the given line into tokens, and check that it has the right number
+   * of them; otherwise, fill the given error and return false.
+   *
+   * @param line Line to split.
+   * @param index Index of the line, for the error.
+   * @param tokens Vector to store the tokens into.
+   * @param error Error to fill.
    */
-  void CheckOpen();
+  bool TokenizeLine(const Range& line,
+                    const size_t index,
+                    std::vector<Range>& tokens,
+                    BlockError& error) const;
 
   /**
-   * Parse a non-transposed matrix.
+   * Throw a std::runtime_error describing the first error among the given
+   * blocks, if there is one.
+   */
+  void CheckErrors(const std::vector<BlockError>& errors) const;
+
+  /**
+   * Parse the given blocks into the output matrix, using the fast number
+   * parser where possible and the DatasetMapper for everything else.  The
+   * DatasetMapper must already have the right dimensionality.
    *
-   * @param inout Matrix to load into.
-   * @param infoSet DatasetMapper object to load with.
+   * @param blocks Blocks to parse; the first line of the first block is the
+   *     first point of the output.
+   * @param out Output matrix; it must already have the right size.
+   * @param info DatasetMapper to use.
+   * @param transpose Whether each line is a column of the output (true), or
+   *     a row (false).
+   * @param firstPass Whether to take the first pass of the DatasetMapper over
+   *     the blocks before mapping them.
    */
   template<typename T, typename PolicyType>
-  void NonTransposeParse(arma::Mat<T>& inout,
-                         DatasetMapper<PolicyType>& infoSet)
-  {
-    using namespace boost::spirit;
-
-    // Get the size of the matrix.
-    size_t rows, cols;
-    GetMatrixSize<T>(rows, cols, infoSet);
-
-    // Set up output matrix.
-    inout.set_size(rows, cols);
-    size_t row = 0;
-    size_t col = 0;
-
-    // Reset file position.
-    std::string line;
-    inFile.clear();
-    inFile.seekg(0, std::ios::beg);
-
-    auto setCharClass = [&](iter_type const &iter)
-    {
-      std::string str(iter.begin(), iter.end());
-      if (str == "\t")
-      {
-        str.clear();
-      }
-      boost::trim(str);
-
-      inout(row, col++) = infoSet.template MapString<T>(std::move(str), row);
-    };
-
-    while (std::getline(inFile, line))
-    {
-      // Remove whitespace from either side.
-      boost::trim(line);
-
-      // Parse the numbers from a line (ex: 1,2,3,4); if the parser finds a
-      // number it will execute the setNum function.
-      const bool canParse = qi::parse(line.begin(), line.end(),
-          stringRule[setCharClass] % delimiterRule);
-
-      // Make sure we got the right number of rows.
-      if (col != cols)
-      {
-        std::ostringstream oss;
-        oss << "LoadCSV::NonTransposeParse(): wrong number of dimensions ("
-            << col << ") on line " << row << "; should be " << cols
-            << " dimensions.";
-        throw std::runtime_error(oss.str());
-      }
-
-      if (!canParse)
-      {
-        std::ostringstream oss;
-        oss << "LoadCSV::NonTransposeParse(): parsing error on line " << col
-            << "!";
-        throw std::runtime_error(oss.str());
-      }
-
-      ++row; col = 0;
-    }
-  }
+  void ParseBlocks(const std::vector<Block>& blocks,
+                   arma::Mat<T>& out,
+                   DatasetMapper<PolicyType>& info,
+                   const bool transpose,
+                   const bool firstPass);
 
   /**
-   * Parse a transposed matrix.
-   *
-   * @param inout Matrix to load into.
-   * @param infoSet DatasetMapper to load with.
+   * Take the first pass of the DatasetMapper over the given blocks, passing
+   * it the tokens selected by the MapMode of each dimension in the given
+   * mask.  Errors in the blocks are thrown.
    */
   template<typename T, typename PolicyType>
-  void TransposeParse(arma::Mat<T>& inout, DatasetMapper<PolicyType>& infoSet)
-  {
-    using namespace boost::spirit;
-
-    // Get matrix size.  This also initializes infoSet correctly.
-    size_t rows, cols;
-    GetTransposeMatrixSize<T>(rows, cols, infoSet);
-
-    // Set the matrix size.
-    inout.set_size(rows, cols);
-
-    // Initialize auxiliary variables.
-    size_t row = 0;
-    size_t col = 0;
-    std::string line;
-    inFile.clear();
-    inFile.seekg(0, std::ios::beg);
-
-    /**
-     * This is the parse rule for strings.  When we get a string we have to pass
-     * it to the DatasetMapper.
-     */
-    auto parseString = [&](iter_type const &iter)
-    {
-      // All parsed values must be mapped.
-      std::string str(iter.begin(), iter.end());
-      boost::trim(str);
-
-      inout(row, col) = infoSet.template MapString<T>(std::move(str), row);
-      ++row;
-    };
-
-    while (std::getline(inFile, line))
-    {
-      // Remove whitespace from either side.
-      boost::trim(line);
-
-      // Reset the row we are looking at.  (Remember this is transposed.)
-      row = 0;
-
-      // Now use boost::spirit to parse the characters of the line;
-      // parseString() will be called when a token is detected.
-      const bool canParse = qi::parse(line.begin(), line.end(),
-          stringRule[parseString] % delimiterRule);
-
-      // Make sure we got the right number of rows.
-      if (row != rows)
-      {
-        std::ostringstream oss;
-        oss << "LoadCSV::TransposeParse(): wrong number of dimensions (" << row
-            << ") on line " << col << "; should be " << rows << " dimensions.";
-        throw std::runtime_error(oss.str());
-      }
-
-      if (!canParse)
-      {
-        std::ostringstream oss;
-        oss << "LoadCSV::TransposeParse(): parsing error on line " << col
-            << "!";
-        throw std::runtime_error(oss.str());
-      }
-
-      // Increment the column index.
-      ++col;
-    }
-  }
+  void MapFirstPass(const std::vector<Block>& blocks,
+                    DatasetMapper<PolicyType>& info,
+                    const std::vector<char>& mask,
+                    const bool transpose);
+
+  /**
+   * Collect the tokens of the given block that are selected by the MapMode of
+   * each dimension in the given mask, in the order of the file.  Collection
+   * stops at the first error in the block, which is stored.
+   */
+  template<typename T>
+  void CollectTokens(const Block& block,
+                     const std::vector<char>& mask,
+                     const bool transpose,
+                     std::vector<MappedToken>& tokens,
+                     BlockError& error) const;
+
+  /**
+   * Warn that matrices of the element type T cannot use the fast number
+   * parser, so that every token goes through the DatasetMapper serially.
+   */
+  template<typename T>
+  void CheckElemType() const;
 
-  //! Spirit rule for parsing.
-  boost::spirit::qi::rule<std::string::iterator, iter_type()> stringRule;
-  //! Spirit rule for delimiters (i.e. ',' for CSVs).
-  boost::spirit::qi::rule<std::string::iterator, iter_type()> delimiterRule;
+  //! Number of bytes in each block that is parsed by a single thread.
+  static const size_t BlockSize = 4 * 1024 * 1024;
+  //! Number of blocks whose mapped tokens are collected before they are given
+  //! to the DatasetMapper, to bound the memory used for them.
+  static const size_t BlocksPerGroup = 64;
 
   //! Extension (type) of file.
   std::string extension;
   //! Name of file.
   std::string filename;
-  //! Opened stream for reading.
-  std::ifstream inFile;
+  //! The delimiter of the file: ',', ' ' or '\t'.
+  char delimiter;
+  //! The mapping of the file; NULL if the file is empty.
+  std::unique_ptr<util::MappedFile> mapping;
+
+  //! Number of tokens on each line, once it is known.
+  size_t fields;
+  //! Offset of the next chunk in the file.
+  size_t chunkPosition;
+  //! Index of the first point of the next chunk.
+  size_t chunkPoint;
+  //! Whether NextChunk() has initialized the DatasetMapper yet.
+  bool chunksStarted;
+};
+
+/**
+ * A source of chunks of the points of a csv, tsv or txt file, for
+ * kmeans::KMeans::ClusterStream() or anything else that takes its points with
+ * a 'bool Next(MatType& chunk)' method (see kmeans::ColumnChunkSource).  The
+ * file is read with LoadCSV::NextChunk(), so it is never held in memory as a
+ * whole; categorical dimensions are mapped with the DatasetInfo of the source.
+ *
+ * @tparam eT Element type of the chunks.
+ */
+template<typename eT = double>
+class CSVChunkSource
+{
+ public:
+  /**
+   * Create a source of chunks of the given file.  A std::runtime_error is
+   * thrown if the file cannot be opened.
+   *
+   * @param filename Name of the file to read.
+   * @param chunkSize Maximum number of points in each chunk.
+   */
+  CSVChunkSource(const std::string& filename,
+                 const size_t chunkSize = 65536) :
+      loader(filename),
+      chunkSize(std::max(chunkSize, (size_t) 1))
+  { }
+
+  /**
+   * Fill the given matrix with the next chunk of points, one per column, and
+   * return false if there are none left.  Throws exceptions on errors.
+   *
+   * @param chunk Matrix to fill with the next chunk.
+   */
+  bool Next(arma::Mat<eT>& chunk)
+  {
+    return loader.NextChunk(chunk, info, chunkSize);
+  }
+
+  //! Start again from the first point of the file.
+  void Reset() { loader.ResetChunks(); }
+
+  //! Get the DatasetInfo of the file, once the first chunk has been read.
+  const DatasetInfo& Info() const { return info; }
+
+ private:
+  //! The loader that reads the chunks.
+  LoadCSV loader;
+  //! The mappings of the categorical dimensions of the file.
+  DatasetInfo info;
+  //! The maximum number of points in each chunk.
+  size_t chunkSize;
 };
 
+/**
+ * Parse a number in the format [+-]digits[.digits][(e|E)[+-]digits] (where
+ * either the integer or the fractional part may be empty, but not both).
+ * Returns false if the range does not hold such a number; otherwise the
+ * result is exactly the one std::strtod() (or std::strtof()) would give.
+ */
+bool ParseCSVNumber(const char* begin, const char* end, double& value);
+bool ParseCSVNumber(const char* begin, const char* end, float& value);
+
+//! No fast parser exists for other types; the DatasetMapper reads those.
+template<typename T>
+bool ParseCSVNumber(const char* /* begin */,
+                    const char* /* end */,
+                    T& /* value */)
+{
+  return false;
+}
+
 } // namespace data
 } // namespace mlpack
 
+// Include implementation.
+#include "load_csv_impl.hpp"
+
 #endif
@@ -0,0 +1,353 @@
+/**
+ * @file core/data/load_csv_impl.hpp
+ *
+ * Implementation of the templated parts of LoadCSV.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_DATA_LOAD_CSV_IMPL_HPP
+#define MLPACK_CORE_DATA_LOAD_CSV_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "load_csv.hpp"
+
+namespace mlpack {
+namespace data {
+
+inline void LoadCSV::Trim(Range& range)
+{
+  while (range.begin != range.end && std::isspace((unsigned char) *range.begin))
+    ++range.begin;
+  while (range.end != range.begin &&
+      std::isspace((unsigned char) *(range.end - 1)))
+    --range.end;
+}
+
+inline bool LoadCSV::NextLine(const char*& p, const char* end, Range& line)
+{
+  while (p < end)
+  {
+    const char* lineEnd = (const char*) memchr(p, '\n', end - p);
+    if (lineEnd == NULL)
+      lineEnd = end;
+
+    line.begin = p;
+    line.end = lineEnd;
+    p = (lineEnd == end) ? end : lineEnd + 1;
+
+    Trim(line);
+    if (line.begin != line.end)
+      return true;
+  }
+
+  return false;
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::Load(arma::Mat<T>& inout,
+                   DatasetMapper<PolicyType>& infoSet,
+                   const bool transpose)
+{
+  CheckElemType<T>();
+  fields = CountFields();
+
+  std::vector<Block> blocks;
+  if (mapping)
+  {
+    blocks = SplitBlocks(mapping->Data(), mapping->Data() + mapping->Size(),
+        0);
+  }
+  const size_t lines = blocks.empty() ? 0 :
+      blocks.back().firstLine + blocks.back().lines;
+
+  // If the matrix is not transposed, each line is a dimension.
+  if (transpose)
+  {
+    infoSet.SetDimensionality(fields);
+    inout.set_size(fields, lines);
+  }
+  else
+  {
+    infoSet.SetDimensionality(lines);
+    inout.set_size(lines, fields);
+  }
+
+  ParseBlocks(blocks, inout, infoSet, transpose, true);
+}
+
+template<typename T, typename PolicyType>
+bool LoadCSV::NextChunk(arma::Mat<T>& chunk,
+                        DatasetMapper<PolicyType>& infoSet,
+                        const size_t maxPoints)
+{
+  if (!chunksStarted)
+  {
+    CheckElemType<T>();
+    fields = CountFields();
+    infoSet.SetDimensionality(fields);
+
+    // The types of the dimensions must be known before the first chunk is
+    // mapped, so the first pass is taken over the whole file now.  After it,
+    // the tokens of dimensions that are still numeric and can be read as
+    // numbers never reach the DatasetMapper, so no dimension can become
+    // categorical after its earlier chunks have been handed out.
+    if (PolicyType::NeedsFirstPass && mapping)
+    {
+      const std::vector<Block> blocks = SplitBlocks(mapping->Data(),
+          mapping->Data() + mapping->Size(), 0);
+      const std::vector<char> mask(fields,
+          CSVNumericPassthrough<PolicyType>::Value(infoSet.Policy()) ?
+          MapNonNumeric : MapAll);
+      MapFirstPass<T>(blocks, infoSet, mask, true);
+    }
+
+    chunksStarted = true;
+  }
+
+  if (!mapping)
+  {
+    chunk.set_size(fields, 0);
+    return false;
+  }
+
+  // Find the end of the chunk.
+  const char* begin = mapping->Data() + chunkPosition;
+  const char* end = mapping->Data() + mapping->Size();
+  const char* p = begin;
+  Range line;
+  size_t points = 0;
+  while (points < maxPoints && NextLine(p, end, line))
+    ++points;
+
+  chunkPosition = p - mapping->Data();
+  chunk.set_size(fields, points);
+  if (points == 0)
+    return false;
+
+  const std::vector<Block> blocks = SplitBlocks(begin, p, chunkPoint);
+  ParseBlocks(blocks, chunk, infoSet, true, false);
+  chunkPoint += points;
+
+  return true;
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::ParseBlocks(const std::vector<Block>& blocks,
+                          arma::Mat<T>& out,
+                          DatasetMapper<PolicyType>& info,
+                          const bool transpose,
+                          const bool firstPass)
+{
+  if (blocks.empty())
+    return;
+
+  const size_t firstLine = blocks.front().firstLine;
+
+  // Read every token that is a number straight into the matrix, and note the
+  // dimensions that have tokens that are not.
+  std::vector<BlockError> errors(blocks.size());
+  std::vector<char> nonNumeric(info.Dimensionality(), 0);
+  #pragma omp parallel
+  {
+    std::vector<Range> tokens;
+    std::vector<char> localNonNumeric(transpose ? fields : 0, 0);
+
+    #pragma omp for
+    for (omp_size_t b = 0; b < (omp_size_t) blocks.size(); ++b)
+    {
+      errors[b].line = SIZE_MAX;
+
+      const char* p = blocks[b].begin;
+      Range line;
+      size_t l = blocks[b].firstLine;
+      while (NextLine(p, blocks[b].end, line))
+      {
+        if (!TokenizeLine(line, l, tokens, errors[b]))
+          break;
+
+        const size_t point = l - firstLine;
+        for (size_t f = 0; f < fields; ++f)
+        {
+          T& value = transpose ? out(f, point) : out(point, f);
+          if (!ParseCSVNumber(tokens[f].begin, tokens[f].end, value))
+          {
+            // Each line is only seen by one thread.
+            if (transpose)
+              localNonNumeric[f] = 1;
+            else
+              nonNumeric[point] = 1;
+          }
+        }
+
+        ++l;
+      }
+    }
+
+    if (transpose)
+    {
+      #pragma omp critical
+      for (size_t f = 0; f < fields; ++f)
+        nonNumeric[f] |= localNonNumeric[f];
+    }
+  }
+
+  CheckErrors(errors);
+
+  // Find the tokens that must go through the DatasetMapper: all of those of
+  // categorical dimensions (and of every dimension, if the policy may map
+  // numbers), and only those that are not numbers for the other dimensions.
+  const bool passthrough =
+      CSVNumericPassthrough<PolicyType>::Value(info.Policy());
+  std::vector<char> mapped(info.Dimensionality(), MapNone);
+  bool anyMapped = false;
+  for (size_t d = 0; d < info.Dimensionality(); ++d)
+  {
+    if (!passthrough || info.Type(d) == Datatype::categorical)
+      mapped[d] = MapAll;
+    else if (nonNumeric[d])
+      mapped[d] = MapNonNumeric;
+    anyMapped |= (mapped[d] != MapNone);
+  }
+
+  if (!anyMapped)
+    return;
+
+  if (firstPass && PolicyType::NeedsFirstPass)
+  {
+    MapFirstPass<T>(blocks, info, mapped, transpose);
+
+    // The numbers of dimensions that turned out to be categorical are mapped
+    // too.
+    for (size_t d = 0; d < info.Dimensionality(); ++d)
+    {
+      if (mapped[d] == MapNonNumeric && info.Type(d) == Datatype::categorical)
+        mapped[d] = MapAll;
+    }
+  }
+
+  // Now map the tokens, a group of blocks at a time: the tokens are collected
+  // in parallel, and then mapped in the order of the file.
+  std::vector<std::vector<MappedToken>> groupTokens(BlocksPerGroup);
+  for (size_t group = 0; group < blocks.size(); group += BlocksPerGroup)
+  {
+    const size_t groupEnd = std::min(blocks.size(), group + BlocksPerGroup);
+
+    #pragma omp parallel for
+    for (omp_size_t b = group; b < (omp_size_t) groupEnd; ++b)
+    {
+      CollectTokens<T>(blocks[b], mapped, transpose, groupTokens[b - group],
+          errors[b]);
+    }
+
+    for (size_t b = group; b < groupEnd; ++b)
+    {
+      for (const MappedToken& t : groupTokens[b - group])
+      {
+        const size_t point = t.line - firstLine;
+        T& value = transpose ? out(t.field, point) : out(point, t.field);
+        value = info.template MapString<T>(
+            std::string(t.token.begin, t.token.end),
+            transpose ? t.field : t.line);
+      }
+    }
+  }
+}
+
+template<typename T, typename PolicyType>
+void LoadCSV::MapFirstPass(const std::vector<Block>& blocks,
+                           DatasetMapper<PolicyType>& info,
+                           const std::vector<char>& mask,
+                           const bool transpose)
+{
+  std::vector<BlockError> errors(blocks.size());
+  std::vector<std::vector<MappedToken>> groupTokens(BlocksPerGroup);
+  for (size_t group = 0; group < blocks.size(); group += BlocksPerGroup)
+  {
+    const size_t groupEnd = std::min(blocks.size(), group + BlocksPerGroup);
+
+    #pragma omp parallel for
+    for (omp_size_t b = group; b < (omp_size_t) groupEnd; ++b)
+    {
+      CollectTokens<T>(blocks[b], mask, transpose, groupTokens[b - group],
+          errors[b]);
+    }
+
+    CheckErrors(errors);
+
+    for (size_t b = group; b < groupEnd; ++b)
+    {
+      for (const MappedToken& t : groupTokens[b - group])
+      {
+        info.template MapFirstPass<T>(std::string(t.token.begin, t.token.end),
+            transpose ? t.field : t.line);
+      }
+    }
+  }
+}
+
+template<typename T>
+void LoadCSV::CollectTokens(const Block& block,
+                            const std::vector<char>& mask,
+                            const bool transpose,
+                            std::vector<MappedToken>& mappedTokens,
+                            BlockError& error) const
+{
+  mappedTokens.clear();
+  error.line = SIZE_MAX;
+
+  std::vector<Range> tokens;
+  const char* p = block.begin;
+  Range line;
+  size_t l = block.firstLine;
+  while (NextLine(p, block.end, line))
+  {
+    // If each line is a dimension, only the lines that are mapped matter.
+    if (!transpose && mask[l] == MapNone)
+    {
+      ++l;
+      continue;
+    }
+
+    if (!TokenizeLine(line, l, tokens, error))
+      return;
+
+    for (size_t f = 0; f < fields; ++f)
+    {
+      const char mode = transpose ? mask[f] : mask[l];
+      if (mode == MapNone)
+        continue;
+
+      T value;
+      if (mode == MapNonNumeric &&
+          ParseCSVNumber(tokens[f].begin, tokens[f].end, value))
+        continue;
+
+      MappedToken t;
+      t.token = tokens[f];
+      t.line = l;
+      t.field = f;
+      mappedTokens.push_back(t);
+    }
+
+    ++l;
+  }
+}
+
+template<typename T>
+void LoadCSV::CheckElemType() const
+{
+  if (!std::is_same<T, double>::value && !std::is_same<T, float>::value)
+  {
+    Log::Warn << "No fast number parser exists for the element type of the "
+        << "matrix; every token of '" << filename << "' will be read by the "
+        << "DatasetMapper, one at a time." << std::endl;
+  }
+}
+
+} // namespace data
+} // namespace mlpack
+
+#endif
@@ -20,6 +20,7 @@
 
 #include "load_csv.hpp"
 #include "load.hpp"
+#include "binary_dataset.hpp"
 #include "extension.hpp"
 
 #include <boost/algorithm/string/trim.hpp>
@@ -118,7 +119,36 @@ bool Load(const std::string& filename,
   arma::file_type loadType;
   std::string stringType;
 
-  if (extension == "csv" || extension == "tsv")
+  if (extension == "mlpd")
+  {
+    // Binary dataset files are not handled by Armadillo.  They already hold
+    // one point per column.
+    Log::Info << "Loading '" << filename << "' as binary dataset.  "
+        << std::flush;
+    bool success = true;
+    try
+    {
+      LoadBinaryDataset(filename, matrix);
+      if (!transpose)
+        success = inplace_transpose(matrix, fatal);
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+
+    Log::Info << "Size is " << matrix.n_cols << " x " << matrix.n_rows
+        << ".\n";
+    Timer::Stop("loading_data");
+    return success;
+  }
+  else if (extension == "csv" || extension == "tsv")
   {
     loadType = arma::diskio::guess_file_type(stream);
     if (loadType == arma::csv_ascii)
@@ -355,6 +385,36 @@ bool Load(const std::string& filename,
       return false;
     }
   }
+  else if (extension == "mlpd")
+  {
+    Log::Info << "Loading '" << filename << "' as binary dataset.  "
+        << std::flush;
+    try
+    {
+      std::string serializedInfo;
+      LoadBinaryDataset(filename, matrix, &serializedInfo);
+      if (serializedInfo.empty())
+        info = DatasetMapper<PolicyType>(matrix.n_rows);
+      else
+        DeserializeInfo(serializedInfo, info);
+
+      // The file holds one point per column.
+      if (!transpose)
+      {
+        return inplace_transpose(matrix, fatal);
+      }
+    }
+    catch (std::exception& e)
+    {
+      Timer::Stop("loading_data");
+      if (fatal)
+        Log::Fatal << e.what() << std::endl;
+      else
+        Log::Warn << e.what() << std::endl;
+
+      return false;
+    }
+  }
   else if (extension == "arff")
   {
     Log::Info << "Loading '" << filename << "' as ARFF dataset.  "
@@ -142,6 +142,9 @@ class IncrementPolicy
     }
   }
 
+  //! Get whether or not all tokens are mapped.
+  bool ForceAllMappings() const { return forceAllMappings; }
+
  private:
   // Whether or not we should map all tokens.
   bool forceAllMappings;
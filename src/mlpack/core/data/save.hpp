@@ -20,6 +20,8 @@
 
 #include "format.hpp"
 #include "image_info.hpp"
+#include "dataset_mapper.hpp"
+#include "binary_dataset.hpp"
 
 namespace mlpack {
 namespace data /** Functions to load and save matrices. */ {
@@ -39,13 +41,16 @@ namespace data /** Functions to load and save matrices. */ {
  *  - Raw binary (raw_binary), denoted by .bin
  *  - Armadillo binary (arma_binary), denoted by .bin
  *  - HDF5 (hdf5_binary), denoted by .hdf5, .hdf, .h5, or .he5
+ *  - mlpack binary dataset, denoted by .mlpd (see BinaryDatasetHeader)
  *
  * If the file extension is not one of those types, an error will be given.  If
  * the 'fatal' parameter is set to true, a std::runtime_error exception will be
  * thrown upon failure.  If the 'transpose' parameter is set to true, the matrix
  * will be transposed before saving.  Generally, because mlpack stores matrices
  * in a column-major format and most datasets are stored on disk as row-major,
- * this parameter should be left at its default value of 'true'.
+ * this parameter should be left at its default value of 'true'.  (Binary
+ * datasets are stored with one point per column, so with 'transpose' set to
+ * true they are saved as they are.)
  *
  * @param filename Name of file to save to.
  * @param matrix Matrix to save into file.
@@ -59,6 +64,26 @@ bool Save(const std::string& filename,
           const bool fatal = false,
           bool transpose = true);
 
+/**
+ * Saves a matrix and the mappings of its categorical dimensions to file.  Only
+ * binary datasets (.mlpd) can hold the mappings; for other types of files,
+ * this is the same as saving the matrix alone.  See the other overload of
+ * Save() for the meaning of the parameters.
+ *
+ * @param filename Name of file to save to.
+ * @param matrix Matrix to save into file.
+ * @param info DatasetMapper holding the mappings of the matrix.
+ * @param fatal If an error should be reported as fatal (default false).
+ * @param transpose If true, transpose the matrix before saving (default true).
+ * @return Boolean value indicating success or failure of save.
+ */
+template<typename eT, typename PolicyType>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetMapper<PolicyType>& info,
+          const bool fatal = false,
+          bool transpose = true);
+
 /**
  * Saves a sparse matrix to file, guessing the filetype from the
  * extension.  This will transpose the matrix at save time.  If the
@@ -64,6 +64,14 @@ bool Save(const std::string& filename,
     return false;
   }
 
+  // Binary dataset files are not handled by Armadillo.
+  if (extension == "mlpd")
+  {
+    Timer::Stop("saving_data");
+    return Save(filename, matrix, DatasetMapper<IncrementPolicy>(), fatal,
+        transpose);
+  }
+
   // Catch errors opening the file.
   std::fstream stream;
 #ifdef  _WIN32 // Always open in binary mode on Windows.
@@ -205,6 +213,48 @@ bool Save(const std::string& filename,
   return true;
 }
 
+// Save with mappings.
+template<typename eT, typename PolicyType>
+bool Save(const std::string& filename,
+          const arma::Mat<eT>& matrix,
+          const DatasetMapper<PolicyType>& info,
+          const bool fatal,
+          bool transpose)
+{
+  // Only binary dataset files can hold the mappings.
+  if (Extension(filename) != "mlpd")
+    return Save(filename, matrix, fatal, transpose);
+
+  Timer::Start("saving_data");
+  Log::Info << "Saving binary dataset to '" << filename << "'." << std::endl;
+
+  try
+  {
+    // The file holds one point per column, so it is the other way around
+    // from the text formats: the matrix is stored as it is unless it holds
+    // one point per row.
+    const std::string serializedInfo = (info.Dimensionality() == 0) ? "" :
+        SerializeInfo(info);
+    if (transpose)
+      SaveBinaryDataset(filename, matrix, serializedInfo);
+    else
+      SaveBinaryDataset(filename, arma::Mat<eT>(matrix.t()), serializedInfo);
+  }
+  catch (std::exception& e)
+  {
+    Timer::Stop("saving_data");
+    if (fatal)
+      Log::Fatal << e.what() << std::endl;
+    else
+      Log::Warn << e.what() << std::endl;
+
+    return false;
+  }
+
+  Timer::Stop("saving_data");
+  return true;
+}
+
 // Save a Sparse Matrix
 template<typename eT>
 bool Save(const std::string& filename,
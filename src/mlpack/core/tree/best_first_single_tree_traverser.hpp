@@ -0,0 +1,114 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser.hpp
+ *
+ * A single-tree traverser that visits the nodes in order of their score, best
+ * first, and that can stop after a given number of base cases.  The RuleType
+ * class must implement the method 'BaseCases()', returning the number of base
+ * cases it has evaluated so far.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
+#include <queue>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * Traverse a tree for a single query point, always descending into the node
+ * with the best (lowest) score among those seen so far, as given by the
+ * Score() method of the rules.  Nodes are rescored when they are taken, so the
+ * bounds found in the meantime prune them.
+ *
+ * Without a budget, this finds the same results as a depth-first traversal.
+ * With a budget of maxBaseCases, the traversal of a query point stops once
+ * that many base cases have been evaluated for it, which bounds the work of
+ * each query; as the best nodes are visited first, the results found by then
+ * are usually the best ones.
+ *
+ * Trees with self-children (i.e. cover trees) evaluate the base case of each
+ * node in Score(), so this traverser only calls BaseCase() for the points of
+ * other trees.
+ */
+template<typename TreeType, typename RuleType>
+class BestFirstSingleTreeTraverser
+{
+ public:
+  /**
+   * Instantiate the best-first single tree traverser with the given rule set.
+   */
+  BestFirstSingleTreeTraverser(RuleType& rule);
+
+  /**
+   * Traverse the tree with the given point.
+   *
+   * @param queryIndex The index of the point in the query set which is being
+   *     used as the query point.
+   * @param referenceNode The tree node to be traversed.
+   */
+  void Traverse(const size_t queryIndex, TreeType& referenceNode);
+
+  //! Get the number of prunes.
+  size_t NumPrunes() const { return numPrunes; }
+
+  //! Get the maximum number of base cases of each traversal (0 means there is
+  //! no limit).
+  size_t MaxBaseCases() const { return maxBaseCases; }
+  //! Modify the maximum number of base cases of each traversal (0 means there
+  //! is no limit).
+  size_t& MaxBaseCases() { return maxBaseCases; }
+
+  //! Get the number of base cases evaluated by the last traversal.
+  size_t LastBaseCases() const { return lastBaseCases; }
+
+  //! Get the number of traversals that were stopped by the budget.
+  size_t NumStopped() const { return numStopped; }
+
+ private:
+  //! A node waiting to be visited, with its score.
+  struct NodeScore
+  {
+    //! The node.
+    TreeType* node;
+    //! The score of the node.
+    double score;
+
+    //! The priority queue takes the node with the lowest score first.
+    bool operator<(const NodeScore& other) const
+    { return score > other.score; }
+  };
+
+  //! Reference to the rules with which the tree will be traversed.
+  RuleType& rule;
+
+  //! The nodes waiting to be visited; kept between traversals to reuse its
+  //! memory.
+  std::vector<NodeScore> queue;
+
+  //! The number of nodes which have been pruned during traversal.
+  size_t numPrunes;
+
+  //! The maximum number of base cases of each traversal (0 means no limit).
+  size_t maxBaseCases;
+
+  //! The number of base cases evaluated by the last traversal.
+  size_t lastBaseCases;
+
+  //! The number of traversals that were stopped by the budget.
+  size_t numStopped;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "best_first_single_tree_traverser_impl.hpp"
+
+#endif
@@ -0,0 +1,103 @@
+/**
+ * @file core/tree/best_first_single_tree_traverser_impl.hpp
+ *
+ * Implementation of the best-first single tree traverser.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+#define MLPACK_CORE_TREE_BEST_FIRST_SINGLE_TREE_TRAVERSER_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "best_first_single_tree_traverser.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename TreeType, typename RuleType>
+BestFirstSingleTreeTraverser<TreeType, RuleType>::BestFirstSingleTreeTraverser(
+    RuleType& rule) :
+    rule(rule),
+    numPrunes(0),
+    maxBaseCases(0),
+    lastBaseCases(0),
+    numStopped(0)
+{ /* Nothing to do. */ }
+
+template<typename TreeType, typename RuleType>
+void BestFirstSingleTreeTraverser<TreeType, RuleType>::Traverse(
+    const size_t queryIndex,
+    TreeType& referenceNode)
+{
+  const size_t startBaseCases = rule.BaseCases();
+  queue.clear();
+
+  NodeScore root;
+  root.node = &referenceNode;
+  root.score = rule.Score(queryIndex, referenceNode);
+  if (root.score == DBL_MAX)
+    ++numPrunes;
+  else
+    queue.push_back(root);
+
+  while (!queue.empty())
+  {
+    if (maxBaseCases > 0 && rule.BaseCases() - startBaseCases >= maxBaseCases)
+    {
+      ++numStopped;
+      break;
+    }
+
+    std::pop_heap(queue.begin(), queue.end());
+    TreeType& node = *queue.back().node;
+    const double score = rule.Rescore(queryIndex, node, queue.back().score);
+    queue.pop_back();
+
+    // The bound may have improved since the node was scored.
+    if (score == DBL_MAX)
+    {
+      ++numPrunes;
+      continue;
+    }
+
+    // Run the base cases of the points held by the node, unless the tree
+    // evaluates them in Score().
+    if (!TreeTraits<TreeType>::HasSelfChildren)
+    {
+      for (size_t i = 0; i < node.NumPoints(); ++i)
+      {
+        if (maxBaseCases > 0 &&
+            rule.BaseCases() - startBaseCases >= maxBaseCases)
+          break;
+
+        rule.BaseCase(queryIndex, node.Point(i));
+      }
+    }
+
+    // Queue the children that cannot be pruned.
+    for (size_t i = 0; i < node.NumChildren(); ++i)
+    {
+      NodeScore child;
+      child.node = &node.Child(i);
+      child.score = rule.Score(queryIndex, node.Child(i));
+      if (child.score == DBL_MAX)
+      {
+        ++numPrunes;
+        continue;
+      }
+
+      queue.push_back(child);
+      std::push_heap(queue.begin(), queue.end());
+    }
+  }
+
+  lastBaseCases = rule.BaseCases() - startBaseCases;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
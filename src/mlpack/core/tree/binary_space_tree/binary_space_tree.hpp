@@ -15,6 +15,7 @@
 
 #include "../statistic.hpp"
 #include "midpoint_split.hpp"
+#include "split_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -32,6 +33,12 @@ namespace tree /** Trees and tree-building procedures. */ {
  * This tree does take one runtime parameter in the constructor, which is the
  * max leaf size to be used.
  *
+ * Once a tree is built, PackNodes() can move every node below the root into
+ * one block of memory in depth-first order, along with the ranges of the
+ * bounds if they are HRectBounds, so that traversals stay cache-friendly.
+ * Packed trees behave the same as trees that are not; copies and deserialized
+ * trees are never packed.
+ *
  * @tparam MetricType The metric used for tree-building.  The BoundType may
  *     place restrictions on the metrics that can be used.
  * @tparam StatisticType Extra data contained in the node.  See statistic.hpp
@@ -88,6 +95,12 @@ class BinarySpaceTree
   //! The dataset.  If we are the root of the tree, we own the dataset and must
   //! delete it.
   MatType* dataset;
+  //! If we are the root of the tree, the block of memory holding every other
+  //! node and the ranges of their bounds (see PackNodes()); otherwise NULL.
+  char* packedMemory;
+  //! Whether this node lives in the block of memory of the root, in which case
+  //! it must be destroyed but not deleted.
+  bool packed;
 
  public:
   //! A single-tree traverser for binary space trees; see
@@ -507,27 +520,102 @@ class BinarySpaceTree
   //! Store the center of the bounding region in the given vector.
   void Center(arma::vec& center) const { bound.Center(center); }
 
+  /**
+   * Move every node below the root into one block of memory, in depth-first
+   * order, so that traversals touch fewer cache lines: the left child of each
+   * node directly follows it, and the ranges of HRectBounds are stored in the
+   * same block.  The statistics of every node are built again, so this should
+   * be called on a newly built tree, before it is used.  Nothing is done if
+   * this is not the root, or if the tree is already packed.
+   */
+  void PackNodes();
+
  private:
   /**
    * Splits the current node, assigning its left and right children recursively.
+   * Also fills a list of the changed indices, if it is given.  If the split
+   * allows it, large nodes are split in parallel with OpenMP tasks; the tree is
+   * the same as that of a serial build.
    *
+   * @param oldFromNew Vector holding permuted indices, or NULL.
    * @param maxLeafSize Maximum number of points held in a leaf.
    * @param splitter Instantiated SplitType object.
    */
-  void SplitNode(const size_t maxLeafSize,
+  void SplitNode(std::vector<size_t>* oldFromNew,
+                 const size_t maxLeafSize,
                  SplitType<BoundType<MetricType>, MatType>& splitter);
 
   /**
-   * Splits the current node, assigning its left and right children recursively.
-   * Also returns a list of the changed indices.
+   * Partition the points of the current node with the given split, and build
+   * its children.
    *
-   * @param oldFromNew Vector holding permuted indices.
+   * @param oldFromNew Vector holding permuted indices, or NULL.
    * @param maxLeafSize Maximum number of points held in a leaf.
    * @param splitter Instantiated SplitType object.
+   * @param splitInfo The information about the split.
    */
-  void SplitNode(std::vector<size_t>& oldFromNew,
-                 const size_t maxLeafSize,
-                 SplitType<BoundType<MetricType>, MatType>& splitter);
+  void BuildChildren(std::vector<size_t>* oldFromNew,
+                     const size_t maxLeafSize,
+                     SplitType<BoundType<MetricType>, MatType>& splitter,
+                     const typename Split::SplitInfo& splitInfo);
+
+  /**
+   * Rearrange the points of the current node according to the given split,
+   * and return the split column.  This overload is used when the split only
+   * calls split::PerformSplit(), so that large nodes can be partitioned in
+   * parallel.
+   */
+  size_t PartitionNode(std::vector<size_t>* oldFromNew,
+                       Split& splitter,
+                       const typename Split::SplitInfo& splitInfo,
+                       std::true_type /* usesPerformSplit */);
+
+  //! Rearrange the points of the current node with the PerformSplit() of the
+  //! split, and return the split column.
+  size_t PartitionNode(std::vector<size_t>* oldFromNew,
+                       Split& splitter,
+                       const typename Split::SplitInfo& splitInfo,
+                       std::false_type /* usesPerformSplit */);
+
+  //! Build a child of the current node holding the given points.
+  BinarySpaceTree* NewChild(const size_t childBegin,
+                            const size_t childCount,
+                            std::vector<size_t>* oldFromNew,
+                            const size_t maxLeafSize,
+                            Split& splitter);
+
+  //! Destroy the children of this node, and free the block of memory of the
+  //! tree if we are the root.
+  void DeleteChildren();
+
+  //! Return the number of bytes the given bound needs in the block of memory
+  //! of the tree; only HRectBounds store anything there.
+  template<typename BoundType2>
+  static size_t PackedBoundSize(const BoundType2& nodeBound);
+
+  //! Return the number of bytes the given HRectBound needs in the block of
+  //! memory of the tree.
+  template<typename BoundElemType>
+  static size_t PackedBoundSize(
+      const bound::HRectBound<MetricType, BoundElemType>& nodeBound);
+
+  //! Move the given bound into the block of memory of the tree, if it can be,
+  //! and advance the memory pointer past it.
+  template<typename BoundType2>
+  static void PackBound(BoundType2& nodeBound, char*& memory);
+
+  //! Move the ranges of the given HRectBound into the block of memory of the
+  //! tree, and advance the memory pointer past them.
+  template<typename BoundElemType>
+  static void PackBound(bound::HRectBound<MetricType, BoundElemType>& nodeBound,
+                        char*& memory);
+
+  //! Nodes with at least this many points build their children concurrently,
+  //! if the split allows it (see SplitTraits).
+  static const size_t ParallelBuildSize = 8192;
+  //! Nodes with at least this many points are partitioned in parallel, if the
+  //! split allows it (see SplitTraits).
+  static const size_t ParallelSplitSize = 131072;
 
   /**
    * Update the bound of the current node. This method does not take into
@@ -566,6 +654,27 @@ class BinarySpaceTree
   void serialize(Archive& ar, const unsigned int version);
 };
 
+/**
+ * Pack the nodes of the given tree into one block of memory, if it is a
+ * BinarySpaceTree (see BinarySpaceTree::PackNodes()).  Other trees are left as
+ * they are.
+ */
+template<typename TreeType>
+void PackTreeNodes(TreeType& /* tree */) { }
+
+//! Pack the nodes of the given BinarySpaceTree; see PackTreeNodes() above.
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void PackTreeNodes(BinarySpaceTree<MetricType, StatisticType, MatType,
+                                   BoundType, SplitType>& tree)
+{
+  tree.PackNodes();
+}
+
 } // namespace tree
 } // namespace mlpack
 
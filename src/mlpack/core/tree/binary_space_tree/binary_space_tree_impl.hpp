@@ -39,11 +39,13 @@ BinarySpaceTree(
     count(data.n_cols), /* and spans all of the dataset. */
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    packedMemory(NULL),
+    packed(false)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitNode(NULL, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -67,7 +69,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    packedMemory(NULL),
+    packed(false)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(data.n_cols);
@@ -76,7 +80,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -101,7 +105,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(data)) // Copies the dataset.
+    dataset(new MatType(data)), // Copies the dataset.
+    packedMemory(NULL),
+    packed(false)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(data.n_cols);
@@ -110,7 +116,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -136,11 +142,13 @@ BinarySpaceTree(MatType&& data, const size_t maxLeafSize) :
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    packedMemory(NULL),
+    packed(false)
 {
   // Do the actual splitting of this node.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(maxLeafSize, splitter);
+  SplitNode(NULL, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -164,7 +172,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    packedMemory(NULL),
+    packed(false)
 {
   // Initialize oldFromNew correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -173,7 +183,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -198,7 +208,9 @@ BinarySpaceTree(
     count(data.n_cols),
     bound(data.n_rows),
     parentDistance(0), // Parent distance for the root is 0: it has no parent.
-    dataset(new MatType(std::move(data)))
+    dataset(new MatType(std::move(data))),
+    packedMemory(NULL),
+    packed(false)
 {
   // Initialize the oldFromNew vector correctly.
   oldFromNew.resize(dataset->n_cols);
@@ -207,7 +219,7 @@ BinarySpaceTree(
 
   // Now do the actual splitting.
   SplitType<BoundType<MetricType>, MatType> splitter;
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -237,10 +249,12 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset()) // Point to the parent's dataset.
+    dataset(&parent->Dataset()), // Point to the parent's dataset.
+    packedMemory(NULL),
+    packed(false)
 {
   // Perform the actual splitting.
-  SplitNode(maxLeafSize, splitter);
+  SplitNode(NULL, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -266,14 +280,16 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset().n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    packedMemory(NULL),
+    packed(false)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
   assert(oldFromNew.size() == dataset->n_cols);
 
   // Perform the actual splitting.
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -300,14 +316,16 @@ BinarySpaceTree(
     begin(begin),
     count(count),
     bound(parent->Dataset()->n_rows),
-    dataset(&parent->Dataset())
+    dataset(&parent->Dataset()),
+    packedMemory(NULL),
+    packed(false)
 {
   // Hopefully the vector is initialized correctly!  We can't check that
   // entirely but we can do a minor sanity check.
   Log::Assert(oldFromNew.size() == dataset->n_cols);
 
   // Perform the actual splitting.
-  SplitNode(oldFromNew, maxLeafSize, splitter);
+  SplitNode(&oldFromNew, maxLeafSize, splitter);
 
   // Create the statistic depending on if we are a leaf or not.
   stat = StatisticType(*this);
@@ -342,7 +360,9 @@ BinarySpaceTree(
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
     // Copy matrix, but only if we are the root.
-    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL)
+    dataset((other.parent == NULL) ? new MatType(*other.dataset) : NULL),
+    packedMemory(NULL),
+    packed(false)
 {
   // Create left and right children (if any).
   if (other.Left())
@@ -398,11 +418,8 @@ operator=(const BinarySpaceTree& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
-  left = NULL;
-  right = NULL;
   parent = other.Parent();
   begin = other.Begin();
   count = other.Count();
@@ -470,8 +487,7 @@ operator=(BinarySpaceTree&& other)
 
   // Freeing memory that will not be used anymore.
   delete dataset;
-  delete left;
-  delete right;
+  DeleteChildren();
 
   parent = other.Parent();
   left = other.Left();
@@ -484,6 +500,7 @@ operator=(BinarySpaceTree&& other)
   furthestDescendantDistance = other.FurthestDescendantDistance();
   minimumBoundDistance = other.MinimumBoundDistance();
   dataset = other.dataset;
+  packedMemory = other.packedMemory;
 
   other.left = NULL;
   other.right = NULL;
@@ -494,6 +511,7 @@ operator=(BinarySpaceTree&& other)
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.packedMemory = NULL;
 
   return *this;
 }
@@ -520,7 +538,9 @@ BinarySpaceTree(BinarySpaceTree&& other) :
     parentDistance(other.parentDistance),
     furthestDescendantDistance(other.furthestDescendantDistance),
     minimumBoundDistance(other.minimumBoundDistance),
-    dataset(other.dataset)
+    dataset(other.dataset),
+    packedMemory(other.packedMemory),
+    packed(false)
 {
   // Now we are a clone of the other tree.  But we must also clear the other
   // tree's contents, so it doesn't delete anything when it is destructed.
@@ -533,6 +553,7 @@ BinarySpaceTree(BinarySpaceTree&& other) :
   other.furthestDescendantDistance = 0.0;
   other.minimumBoundDistance = 0.0;
   other.dataset = NULL;
+  other.packedMemory = NULL;
 
   // Set new parent.
   if (left)
@@ -576,8 +597,7 @@ template<typename MetricType,
 BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     ~BinarySpaceTree()
 {
-  delete left;
-  delete right;
+  DeleteChildren();
 
   // If we're the root, delete the matrix.
   if (!parent)
@@ -843,19 +863,77 @@ inline size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   return (begin + index);
 }
 
-/**
- * Return the index of a particular point contained in this node.
- */
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
          template<typename BoundMetricType, typename...> class BoundType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
-inline size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
-                              SplitType>::Point(const size_t index) const
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+PackNodes()
 {
-  return (begin + index);
+  if (parent || packedMemory || !left)
+    return;
+
+  // Find how much memory the nodes below the root and their bounds need.
+  size_t numNodes = 0;
+  size_t boundSize = 0;
+  std::vector<BinarySpaceTree*> nodes(1, this);
+  while (!nodes.empty())
+  {
+    BinarySpaceTree* node = nodes.back();
+    nodes.pop_back();
+    if (node->parent)
+    {
+      ++numNodes;
+      boundSize += PackedBoundSize(node->bound);
+    }
+
+    if (node->right)
+      nodes.push_back(node->right);
+    if (node->left)
+      nodes.push_back(node->left);
+  }
+
+  packedMemory = new char[numNodes * sizeof(BinarySpaceTree) + boundSize];
+  BinarySpaceTree* nodeMemory = (BinarySpaceTree*) packedMemory;
+  char* boundMemory = packedMemory + numNodes * sizeof(BinarySpaceTree);
+
+  // Now move the nodes into the block in depth-first order, so that the left
+  // child of each node directly follows it.  Each entry of the stack is a
+  // node that has been moved, and which of its children to move next.
+  std::vector<std::pair<BinarySpaceTree*, bool>> stack;
+  if (right)
+    stack.push_back(std::make_pair(this, true));
+  stack.push_back(std::make_pair(this, false));
+  size_t next = 0;
+  while (!stack.empty())
+  {
+    BinarySpaceTree* parentNode = stack.back().first;
+    BinarySpaceTree*& child = stack.back().second ? parentNode->right :
+        parentNode->left;
+    stack.pop_back();
+
+    // The old node is empty once it has been moved from.
+    BinarySpaceTree* node = new (nodeMemory + next++) BinarySpaceTree(
+        std::move(*child));
+    delete child;
+    child = node;
+    node->parent = parentNode;
+    node->packed = true;
+    PackBound(node->bound, boundMemory);
+
+    if (node->right)
+      stack.push_back(std::make_pair(node, true));
+    if (node->left)
+      stack.push_back(std::make_pair(node, false));
+  }
+
+  // Some statistics hold pointers to nodes, so they are built again now that
+  // the nodes have moved.  Children come after their parent in the block.
+  for (size_t i = numNodes; i > 0; --i)
+    nodeMemory[i - 1].stat = StatisticType(nodeMemory[i - 1]);
+  stat = StatisticType(*this);
 }
 
 template<typename MetricType,
@@ -865,63 +943,94 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-    SplitNode(const size_t maxLeafSize,
-              SplitType<BoundType<MetricType>, MatType>& splitter)
+DeleteChildren()
 {
-  // We need to expand the bounds of this node properly.
-  UpdateBound(bound);
-
-  // Calculate the furthest descendant distance.
-  furthestDescendantDistance = 0.5 * bound.Diameter();
-
-  // Now, check if we need to split at all.
-  if (count <= maxLeafSize)
-    return; // We can't split this.
-
-  // splitCol denotes the two partitions of the dataset after the split. The
-  // points on its left go to the left child and the others go to the right
-  // child.
-  size_t splitCol;
-
-  // Find the partition of the node. This method does not perform the split.
-  typename Split::SplitInfo splitInfo;
-
-  const bool split = splitter.SplitNode(bound, *dataset, begin, count,
-      splitInfo);
+  // Nodes in the block of memory of the root are destroyed, but not freed.
+  BinarySpaceTree* children[2] = { left, right };
+  for (size_t i = 0; i < 2; ++i)
+  {
+    if (children[i] && children[i]->packed)
+      children[i]->~BinarySpaceTree();
+    else
+      delete children[i];
+  }
 
-  // The node may not be always split. For instance, if all the points are the
-  // same, we can't split them.
-  if (!split)
-    return;
+  left = NULL;
+  right = NULL;
 
-  // Perform the actual splitting.  This will order the dataset such that
-  // points that belong to the left subtree are on the left of splitCol, and
-  // points from the right subtree are on the right side of splitCol.
-  splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo);
+  delete[] packedMemory;
+  packedMemory = NULL;
+}
 
-  assert(splitCol > begin);
-  assert(splitCol < begin + count);
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundType2>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::PackedBoundSize(const BoundType2& /* nodeBound */)
+{
+  return 0;
+}
 
-  // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, splitter,
-      maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      splitter, maxLeafSize);
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundElemType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::PackedBoundSize(
+    const bound::HRectBound<MetricType, BoundElemType>& nodeBound)
+{
+  return nodeBound.Dim() * sizeof(math::RangeType<BoundElemType>);
+}
 
-  // Calculate parent distances for those two nodes.
-  arma::vec center, leftCenter, rightCenter;
-  Center(center);
-  left->Center(leftCenter);
-  right->Center(rightCenter);
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundType2>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+PackBound(BoundType2& /* nodeBound */, char*& /* memory */)
+{
+  // Nothing to do: only the ranges of an HRectBound are packed.
+}
 
-  const ElemType leftParentDistance = bound.Metric().Evaluate(center,
-      leftCenter);
-  const ElemType rightParentDistance = bound.Metric().Evaluate(center,
-      rightCenter);
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename BoundElemType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+PackBound(bound::HRectBound<MetricType, BoundElemType>& nodeBound,
+          char*& memory)
+{
+  const size_t size = PackedBoundSize(nodeBound);
+  nodeBound.UseMemory((math::RangeType<BoundElemType>*) memory);
+  memory += size;
+}
 
-  left->ParentDistance() = leftParentDistance;
-  right->ParentDistance() = rightParentDistance;
+/**
+ * Return the index of a particular point contained in this node.
+ */
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+inline size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+                              SplitType>::Point(const size_t index) const
+{
+  return (begin + index);
 }
 
 template<typename MetricType,
@@ -931,7 +1040,7 @@ template<typename MetricType,
          template<typename SplitBoundType, typename SplitMatType>
              class SplitType>
 void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
-SplitNode(std::vector<size_t>& oldFromNew,
+SplitNode(std::vector<size_t>* oldFromNew,
           const size_t maxLeafSize,
           SplitType<BoundType<MetricType>, MatType>& splitter)
 {
@@ -945,11 +1054,6 @@ SplitNode(std::vector<size_t>& oldFromNew,
   if (count <= maxLeafSize)
     return; // We can't split this.
 
-  // splitCol denotes the two partitions of the dataset after the split. The
-  // points on its left go to the left child and the others go to the right
-  // child.
-  size_t splitCol;
-
   // Find the partition of the node. This method does not perform the split.
   typename Split::SplitInfo splitInfo;
 
@@ -961,21 +1065,73 @@ SplitNode(std::vector<size_t>& oldFromNew,
   if (!split)
     return;
 
+#ifdef _OPENMP
+  // Large nodes are split with OpenMP tasks, which need a parallel region to
+  // run in; the first such node opens it, unless we are in one already.  It
+  // has omp_get_max_threads() threads, which callers limit with
+  // util::ScopedThreads (as NeighborSearch does with its NumThreads()).
+  const bool splitInParallel =
+      (SplitTraits<Split>::ConcurrentChildren && count >= ParallelBuildSize) ||
+      (SplitTraits<Split>::UsesPerformSplit && count >= ParallelSplitSize);
+  if (splitInParallel && omp_get_level() == 0)
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      BuildChildren(oldFromNew, maxLeafSize, splitter, splitInfo);
+    }
+    return;
+  }
+#endif
+
+  BuildChildren(oldFromNew, maxLeafSize, splitter, splitInfo);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+BuildChildren(std::vector<size_t>* oldFromNew,
+              const size_t maxLeafSize,
+              SplitType<BoundType<MetricType>, MatType>& splitter,
+              const typename Split::SplitInfo& splitInfo)
+{
   // Perform the actual splitting.  This will order the dataset such that
   // points that belong to the left subtree are on the left of splitCol, and
   // points from the right subtree are on the right side of splitCol.
-  splitCol = splitter.PerformSplit(*dataset, begin, count, splitInfo,
-      oldFromNew);
+  const size_t splitCol = PartitionNode(oldFromNew, splitter, splitInfo,
+      std::integral_constant<bool, SplitTraits<Split>::UsesPerformSplit>());
 
   assert(splitCol > begin);
   assert(splitCol < begin + count);
 
   // Now that we know the split column, we will recursively split the children
-  // by calling their constructors (which perform this splitting process).
-  left = new BinarySpaceTree(this, begin, splitCol - begin, oldFromNew,
-      splitter, maxLeafSize);
-  right = new BinarySpaceTree(this, splitCol, begin + count - splitCol,
-      oldFromNew, splitter, maxLeafSize);
+  // by calling their constructors (which perform this splitting process).  If
+  // the split allows it, the left child of a large node is built by another
+  // task while this one builds the right child; each child only touches its
+  // own points, so the tree is the same as if they were built in order.
+  const bool concurrent = SplitTraits<Split>::ConcurrentChildren &&
+      count >= ParallelBuildSize;
+  if (concurrent)
+  {
+    #pragma omp task shared(splitter)
+    left = NewChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+        splitter);
+  }
+  else
+  {
+    left = NewChild(begin, splitCol - begin, oldFromNew, maxLeafSize,
+        splitter);
+  }
+  right = NewChild(splitCol, begin + count - splitCol, oldFromNew, maxLeafSize,
+      splitter);
+  if (concurrent)
+  {
+    #pragma omp taskwait
+  }
 
   // Calculate parent distances for those two nodes.
   arma::vec center, leftCenter, rightCenter;
@@ -992,6 +1148,75 @@ SplitNode(std::vector<size_t>& oldFromNew,
   right->ParentDistance() = rightParentDistance;
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::PartitionNode(std::vector<size_t>* oldFromNew,
+                              Split& splitter,
+                              const typename Split::SplitInfo& splitInfo,
+                              std::true_type /* usesPerformSplit */)
+{
+#ifdef _OPENMP
+  // SplitNode() has opened a parallel region for large nodes.
+  if (count >= ParallelSplitSize && omp_get_level() > 0)
+  {
+    return split::ParallelPerformSplit<MatType, Split>(*dataset, begin, count,
+        splitInfo, oldFromNew);
+  }
+#endif
+
+  return PartitionNode(oldFromNew, splitter, splitInfo, std::false_type());
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+size_t BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
+    SplitType>::PartitionNode(std::vector<size_t>* oldFromNew,
+                              Split& splitter,
+                              const typename Split::SplitInfo& splitInfo,
+                              std::false_type /* usesPerformSplit */)
+{
+  if (oldFromNew)
+  {
+    return splitter.PerformSplit(*dataset, begin, count, splitInfo,
+        *oldFromNew);
+  }
+
+  return splitter.PerformSplit(*dataset, begin, count, splitInfo);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>*
+BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+NewChild(const size_t childBegin,
+         const size_t childCount,
+         std::vector<size_t>* oldFromNew,
+         const size_t maxLeafSize,
+         Split& splitter)
+{
+  if (oldFromNew)
+  {
+    return new BinarySpaceTree(this, childBegin, childCount, *oldFromNew,
+        splitter, maxLeafSize);
+  }
+
+  return new BinarySpaceTree(this, childBegin, childCount, splitter,
+      maxLeafSize);
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -1049,7 +1274,9 @@ BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
     stat(*this),
     parentDistance(0),
     furthestDescendantDistance(0),
-    dataset(NULL)
+    dataset(NULL),
+    packedMemory(NULL),
+    packed(false)
 {
   // Nothing to do.
 }
@@ -1070,10 +1297,7 @@ void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
   // If we're loading, and we have children, they need to be deleted.
   if (Archive::is_loading::value)
   {
-    if (left)
-      delete left;
-    if (right)
-      delete right;
+    DeleteChildren();
     if (!parent)
       delete dataset;
 
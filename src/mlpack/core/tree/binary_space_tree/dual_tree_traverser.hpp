@@ -18,6 +18,7 @@
 #include <mlpack/prereqs.hpp>
 
 #include "binary_space_tree.hpp"
+#include "../leaf_distances.hpp"
 
 namespace mlpack {
 namespace tree {
@@ -86,6 +87,21 @@ class BinarySpaceTree<MetricType, StatisticType, MatType, BoundType,
   //! Traversal information, held in the class so that it isn't continually
   //! being reallocated.
   typename RuleType::TraversalInfoType traversalInfo;
+
+  //! Compute the base cases between a point of the given query leaf and the
+  //! points of the given reference leaf, with the LeafBaseCases() method of
+  //! the rules.
+  void LeafBaseCases(BinarySpaceTree& queryNode,
+                     const size_t queryIndex,
+                     BinarySpaceTree& referenceNode,
+                     std::true_type /* hasLeafBaseCases */);
+
+  //! Compute the base cases between a point of the given query leaf and the
+  //! points of the given reference leaf, one at a time.
+  void LeafBaseCases(BinarySpaceTree& queryNode,
+                     const size_t queryIndex,
+                     BinarySpaceTree& referenceNode,
+                     std::false_type /* hasLeafBaseCases */);
 };
 
 } // namespace tree
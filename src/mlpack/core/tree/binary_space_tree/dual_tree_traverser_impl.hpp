@@ -73,7 +73,6 @@ DualTreeTraverser<RuleType>::Traverse(
   {
     // Loop through each of the points in each node.
     const size_t queryEnd = queryNode.Begin() + queryNode.Count();
-    const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
     for (size_t query = queryNode.Begin(); query < queryEnd; ++query)
     {
       // See if we need to investigate this point (this function should be
@@ -85,8 +84,8 @@ DualTreeTraverser<RuleType>::Traverse(
       if (childScore == DBL_MAX)
         continue; // We can't improve this particular point.
 
-      for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
-        rule.BaseCase(query, ref);
+      LeafBaseCases(queryNode, query, referenceNode, std::integral_constant<
+          bool, HasLeafBaseCases<RuleType, BinarySpaceTree>::value>());
 
       numBaseCases += referenceNode.Count();
     }
@@ -352,6 +351,42 @@ DualTreeTraverser<RuleType>::Traverse(
   }
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+DualTreeTraverser<RuleType>::LeafBaseCases(
+    BinarySpaceTree& queryNode,
+    const size_t queryIndex,
+    BinarySpaceTree& referenceNode,
+    std::true_type /* hasLeafBaseCases */)
+{
+  rule.LeafBaseCases(queryNode, queryIndex, referenceNode);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         template<typename BoundMetricType, typename...> class BoundType,
+         template<typename SplitBoundType, typename SplitMatType>
+             class SplitType>
+template<typename RuleType>
+void BinarySpaceTree<MetricType, StatisticType, MatType, BoundType, SplitType>::
+DualTreeTraverser<RuleType>::LeafBaseCases(
+    BinarySpaceTree& /* queryNode */,
+    const size_t queryIndex,
+    BinarySpaceTree& referenceNode,
+    std::false_type /* hasLeafBaseCases */)
+{
+  const size_t refEnd = referenceNode.Begin() + referenceNode.Count();
+  for (size_t ref = referenceNode.Begin(); ref < refEnd; ++ref)
+    rule.BaseCase(queryIndex, ref);
+}
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,120 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree.hpp
+ *
+ * A pointer-free, read-only layout of a kd-tree (a BinarySpaceTree with
+ * HRectBound) that can be written to a file and used straight from a memory
+ * mapping of it.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+/**
+ * A view of a kd-tree stored in one contiguous block of memory, which holds,
+ * in order:
+ *
+ *  - the dimensionality, the number of points and the number of nodes;
+ *  - the nodes, in depth-first order, with the root first;
+ *  - the lower and upper ends of the bound of each node;
+ *  - the dataset, in the order of the tree, one point per column;
+ *  - the original index of each point of the dataset.
+ *
+ * Children are referred to by their index in the node array, so the block can
+ * be mapped at any address.  The view does not own the block.
+ */
+class FlatKDTree
+{
+ public:
+  //! A node of the tree.
+  struct Node
+  {
+    //! Index of the first point held by the node.
+    uint64_t begin;
+    //! Number of points held by the node.
+    uint64_t count;
+    //! Index of the left child, or 0 if the node is a leaf.
+    uint64_t left;
+    //! Index of the right child, or 0 if the node is a leaf.
+    uint64_t right;
+  };
+
+  /**
+   * Create a view of the flat tree stored in the given block.  A
+   * std::runtime_error is thrown if the block is too small for the tree it
+   * claims to hold.
+   *
+   * @param data Start of the block; must be aligned to 8 bytes.
+   * @param size Size of the block in bytes.
+   */
+  FlatKDTree(const char* data, const size_t size);
+
+  /**
+   * Write the given kd-tree in the flat layout.
+   *
+   * @param stream Stream to write to.
+   * @param tree Root of the tree; it must use HRectBound.
+   * @param oldFromNew Original index of each point of the tree's dataset.
+   */
+  template<typename TreeType>
+  static void Write(std::ostream& stream,
+                    const TreeType& tree,
+                    const std::vector<size_t>& oldFromNew);
+
+  //! Get the dimensionality of the points.
+  size_t Dimensionality() const { return dimensionality; }
+  //! Get the number of points in the tree.
+  size_t NumPoints() const { return numPoints; }
+  //! Get the number of nodes in the tree.
+  size_t NumNodes() const { return numNodes; }
+
+  //! Get the node with the given index.  The root has index 0.
+  const Node& GetNode(const size_t i) const { return nodes[i]; }
+  //! Get the lower ends of the bound of the given node.
+  const double* Lo(const size_t i) const
+  { return bounds + 2 * i * dimensionality; }
+  //! Get the upper ends of the bound of the given node.
+  const double* Hi(const size_t i) const
+  { return bounds + (2 * i + 1) * dimensionality; }
+  //! Get the dataset, in the order of the tree, one point per column.
+  const double* Dataset() const { return dataset; }
+  //! Get the original index of the given point of the dataset.
+  size_t OldFromNew(const size_t i) const { return (size_t) oldFromNew[i]; }
+
+  //! Get the size in bytes of the block holding this tree.
+  size_t Size() const { return size; }
+
+ private:
+  //! The dimensionality of the points.
+  size_t dimensionality;
+  //! The number of points.
+  size_t numPoints;
+  //! The number of nodes.
+  size_t numNodes;
+  //! The nodes.
+  const Node* nodes;
+  //! The bounds of the nodes.
+  const double* bounds;
+  //! The dataset.
+  const double* dataset;
+  //! The original indices of the points.
+  const uint64_t* oldFromNew;
+  //! The size of the block.
+  size_t size;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_tree_impl.hpp"
+
+#endif
@@ -0,0 +1,101 @@
+/**
+ * @file core/tree/binary_space_tree/flat_tree_impl.hpp
+ *
+ * Implementation of FlatKDTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IMPL_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_FLAT_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+inline FlatKDTree::FlatKDTree(const char* data, const size_t size) :
+    size(size)
+{
+  if (size < 3 * sizeof(uint64_t))
+    Log::Fatal << "FlatKDTree: block is too small for a tree!" << std::endl;
+
+  const uint64_t* info = (const uint64_t*) data;
+  dimensionality = (size_t) info[0];
+  numPoints = (size_t) info[1];
+  numNodes = (size_t) info[2];
+
+  const size_t expectedSize = 3 * sizeof(uint64_t) +
+      numNodes * sizeof(Node) +
+      2 * numNodes * dimensionality * sizeof(double) +
+      numPoints * dimensionality * sizeof(double) +
+      numPoints * sizeof(uint64_t);
+  if (numNodes == 0 || size < expectedSize)
+    Log::Fatal << "FlatKDTree: block is too small for a tree!" << std::endl;
+
+  nodes = (const Node*) (info + 3);
+  bounds = (const double*) (nodes + numNodes);
+  dataset = bounds + 2 * numNodes * dimensionality;
+  oldFromNew = (const uint64_t*) (dataset + numPoints * dimensionality);
+  this->size = expectedSize;
+}
+
+//! Append the given node and its descendants to the flat node and bound
+//! arrays, in depth-first order, and return the index of the node.
+template<typename TreeType>
+size_t FlattenKDTreeNode(const TreeType& node,
+                         std::vector<FlatKDTree::Node>& nodes,
+                         std::vector<double>& bounds)
+{
+  const size_t index = nodes.size();
+  nodes.push_back(FlatKDTree::Node());
+  nodes[index].begin = node.Begin();
+  nodes[index].count = node.Count();
+  nodes[index].left = 0;
+  nodes[index].right = 0;
+
+  for (size_t d = 0; d < node.Bound().Dim(); ++d)
+    bounds.push_back(node.Bound()[d].Lo());
+  for (size_t d = 0; d < node.Bound().Dim(); ++d)
+    bounds.push_back(node.Bound()[d].Hi());
+
+  if (node.Left() != NULL)
+  {
+    const size_t left = FlattenKDTreeNode(*node.Left(), nodes, bounds);
+    const size_t right = FlattenKDTreeNode(*node.Right(), nodes, bounds);
+    nodes[index].left = left;
+    nodes[index].right = right;
+  }
+
+  return index;
+}
+
+template<typename TreeType>
+void FlatKDTree::Write(std::ostream& stream,
+                       const TreeType& tree,
+                       const std::vector<size_t>& oldFromNew)
+{
+  std::vector<Node> nodes;
+  std::vector<double> bounds;
+  FlattenKDTreeNode(tree, nodes, bounds);
+
+  const uint64_t info[3] = { tree.Dataset().n_rows, tree.Dataset().n_cols,
+      nodes.size() };
+  stream.write((const char*) info, sizeof(info));
+  stream.write((const char*) nodes.data(), nodes.size() * sizeof(Node));
+  stream.write((const char*) bounds.data(), bounds.size() * sizeof(double));
+  stream.write((const char*) tree.Dataset().memptr(),
+      tree.Dataset().n_elem * sizeof(double));
+
+  const std::vector<uint64_t> indices(oldFromNew.begin(), oldFromNew.end());
+  stream.write((const char*) indices.data(),
+      indices.size() * sizeof(uint64_t));
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
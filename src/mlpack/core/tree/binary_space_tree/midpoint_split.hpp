@@ -17,6 +17,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -117,6 +118,14 @@ class MidpointSplit
   }
 };
 
+//! The midpoint split only depends on the bound of the node.
+template<typename BoundType, typename MatType>
+struct SplitTraits<MidpointSplit<BoundType, MatType>>
+{
+  static const bool UsesPerformSplit = true;
+  static const bool ConcurrentChildren = true;
+};
+
 } // namespace tree
 } // namespace mlpack
 
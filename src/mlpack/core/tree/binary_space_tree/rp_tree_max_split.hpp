@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 
 namespace mlpack {
 namespace tree /** Trees and tree-building procedures. */ {
@@ -137,6 +138,15 @@ class RPTreeMaxSplit
                           ElemType& splitVal);
 };
 
+//! The random projection split draws random numbers, so its children must be
+//! built in order for the tree to be the same.
+template<typename BoundType, typename MatType>
+struct SplitTraits<RPTreeMaxSplit<BoundType, MatType>>
+{
+  static const bool UsesPerformSplit = true;
+  static const bool ConcurrentChildren = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
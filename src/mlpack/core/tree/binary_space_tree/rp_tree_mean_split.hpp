@@ -16,6 +16,7 @@
 #include <mlpack/prereqs.hpp>
 #include "rp_tree_max_split.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 #include <mlpack/core/math/lin_alg.hpp>
 
 namespace mlpack {
@@ -168,6 +169,15 @@ class RPTreeMeanSplit
                             ElemType& splitVal);
 };
 
+//! The random projection split draws random numbers, so its children must be
+//! built in order for the tree to be the same.
+template<typename BoundType, typename MatType>
+struct SplitTraits<RPTreeMeanSplit<BoundType, MatType>>
+{
+  static const bool UsesPerformSplit = true;
+  static const bool ConcurrentChildren = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -0,0 +1,44 @@
+/**
+ * @file core/tree/binary_space_tree/split_traits.hpp
+ *
+ * A class for template metaprogramming traits for the split types of the
+ * BinarySpaceTree.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+#define MLPACK_CORE_TREE_BINARY_SPACE_TREE_SPLIT_TRAITS_HPP
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A class to obtain compile-time traits about SplitType classes, which the
+ * BinarySpaceTree uses to decide which parts of its construction can be done
+ * in parallel.  If you are writing your own SplitType class, you may make a
+ * template specialization in order to set the values correctly; the defaults
+ * give a serial construction, which is always correct.
+ *
+ * @see BoundTraits, TreeTraits
+ */
+template<typename SplitType>
+struct SplitTraits
+{
+  //! If true, then the PerformSplit() functions of the split only call
+  //! split::PerformSplit(), so a node may be partitioned with
+  //! split::ParallelPerformSplit() instead.  This defaults to false.
+  static const bool UsesPerformSplit = false;
+
+  //! If true, then the split has no state and uses no random numbers, so the
+  //! two children of a node may be built at the same time without changing the
+  //! tree.  This defaults to false.
+  static const bool ConcurrentChildren = false;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -102,13 +102,15 @@ class UBTreeSplit
    */
   void InitializeAddresses(const MatType& data);
 
-  //! A comparator for sorting addresses.
-  static bool ComparePair(
-      const std::pair<arma::Col<AddressElemType>, size_t>& p1,
-      const std::pair<arma::Col<AddressElemType>, size_t>& p2)
-  {
-    return bound::addr::CompareAddresses(p1.first, p2.first) < 0;
-  }
+  /**
+   * Sort the addresses of all points in the dataset, with one radix sort of
+   * the (element, index) pairs for each element of the addresses.
+   */
+  void SortAddresses();
+
+  //! Addresses are computed and sorted in parallel when the dataset has at
+  //! least this many points.
+  static const size_t ParallelAddressSize = 16384;
 };
 
 } // namespace tree
@@ -15,6 +15,7 @@
 
 #include "ub_tree_split.hpp"
 #include <mlpack/core/tree/bounds.hpp>
+#include <mlpack/core/tree/radix_sort.hpp>
 
 namespace mlpack {
 namespace tree {
@@ -32,9 +33,8 @@ bool UBTreeSplit<BoundType, MatType>::SplitNode(BoundType& bound,
     // Calculate all addresses.
     InitializeAddresses(data);
 
-    // Probably this is not a good idea. Maybe it is better to get
-    // a number of distinct samples and find the median.
-    std::sort(addresses.begin(), addresses.end(), ComparePair);
+    // Sort the addresses.
+    SortAddresses();
 
     // Save the vector in order to rearrange the dataset later.
     splitInfo.addresses = &addresses;
@@ -147,8 +147,10 @@ void UBTreeSplit<BoundType, MatType>::InitializeAddresses(const MatType& data)
 {
   addresses.resize(data.n_cols);
 
-  // Calculate all addresses.
-  for (size_t i = 0; i < data.n_cols; ++i)
+  // Calculate all addresses.  Each is independent, so large datasets are split
+  // between threads.
+  #pragma omp parallel for if (data.n_cols >= ParallelAddressSize)
+  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
   {
     addresses[i].first.zeros(data.n_rows);
     bound::addr::PointToAddress(addresses[i].first, data.col(i));
@@ -156,6 +158,37 @@ void UBTreeSplit<BoundType, MatType>::InitializeAddresses(const MatType& data)
   }
 }
 
+template<typename BoundType, typename MatType>
+void UBTreeSplit<BoundType, MatType>::SortAddresses()
+{
+  if (addresses.size() < 2)
+    return;
+
+  // Addresses are compared element by element, so a stable radix sort on each
+  // element, from the last one to the first one, orders them.  The addresses
+  // themselves are moved only once, at the end.
+  const size_t dim = addresses[0].first.n_elem;
+  std::vector<std::pair<AddressElemType, size_t>> keys(addresses.size());
+  for (size_t i = 0; i < keys.size(); ++i)
+    keys[i].second = i;
+
+  for (size_t row = dim; row > 0; --row)
+  {
+    #pragma omp parallel for if (keys.size() >= ParallelAddressSize)
+    for (omp_size_t i = 0; i < (omp_size_t) keys.size(); ++i)
+      keys[i].first = addresses[keys[i].second].first[row - 1];
+
+    RadixSort(keys);
+  }
+
+  std::vector<std::pair<arma::Col<AddressElemType>, size_t>> sorted(
+      addresses.size());
+  #pragma omp parallel for if (keys.size() >= ParallelAddressSize)
+  for (omp_size_t i = 0; i < (omp_size_t) keys.size(); ++i)
+    sorted[i] = std::move(addresses[keys[i].second]);
+  addresses.swap(sorted);
+}
+
 template<typename BoundType, typename MatType>
 size_t UBTreeSplit<BoundType, MatType>::PerformSplit(
     MatType& data,
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/perform_split.hpp>
+#include "split_traits.hpp"
 #include <mlpack/core/math/random.hpp>
 
 namespace mlpack {
@@ -166,6 +167,15 @@ class VantagePointSplit
                                  ElemType& mu);
 };
 
+//! The vantage point split samples points at random, so its children must be
+//! built in order for the tree to be the same.
+template<typename BoundType, typename MatType, size_t MaxNumSamples>
+struct SplitTraits<VantagePointSplit<BoundType, MatType, MaxNumSamples>>
+{
+  static const bool UsesPerformSplit = true;
+  static const bool ConcurrentChildren = false;
+};
+
 } // namespace tree
 } // namespace mlpack
 
@@ -15,7 +15,10 @@
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/range.hpp>
 
+#include <deque>
+
 #include "../statistic.hpp"
+#include "../leaf_distances.hpp"
 #include "first_point_is_root.hpp"
 
 namespace mlpack {
@@ -461,6 +464,44 @@ class CoverTree
   //! The metric used for this tree.
   MetricType* metric;
 
+  /**
+   * Scratch memory that is reused while the tree is built, instead of being
+   * allocated again for each node.
+   */
+  struct BuildArena
+  {
+    //! Create the scratch memory for a dataset with the given number of
+    //! points.
+    BuildArena(const size_t numPoints) : depth(0), used(numPoints, 0) { }
+
+    //! Depth of the node whose children are being created.
+    size_t depth;
+    //! For each depth, the indices of the near and far sets of the child being
+    //! created.  (A deque keeps references to them valid as it grows.)
+    std::deque<arma::Col<size_t>> indices;
+    //! For each depth, the distances of the near and far sets of the child
+    //! being created.
+    std::deque<arma::vec> distances;
+    //! Marks the points used by the child that was just created.
+    std::vector<char> used;
+    //! Buffer of indices for SortPointSet().
+    std::vector<size_t> sortIndices;
+    //! Buffer of distances for SortPointSet().
+    std::vector<ElemType> sortDistances;
+  };
+
+  //! Point sets with at least this many points have their distances computed
+  //! in parallel.
+  static const size_t ParallelDistanceSize = 4096;
+  //! Number of points whose Euclidean distances are computed together.
+  static const size_t DistanceBlockSize = 256;
+
+  //! Whether ComputeDistances() can compute the distances of a block of points
+  //! at once: only Euclidean distances between dense points can.
+  typedef std::integral_constant<bool,
+      LeafDistanceTraits<MetricType>::Supported &&
+      !arma::is_SpMat<MatType>::value> BlockedDistances;
+
   /**
    * Create the children for this node.
    */
@@ -468,7 +509,22 @@ class CoverTree
                       arma::vec& distances,
                       size_t nearSetSize,
                       size_t& farSetSize,
-                      size_t& usedSetSize);
+                      size_t& usedSetSize,
+                      BuildArena& arena);
+
+  /**
+   * Create a child of this node and build it with the given near and far sets
+   * (see the constructor that builds a node from them).
+   */
+  CoverTree* BuildChild(const size_t pointIndex,
+                        const int scale,
+                        const ElemType parentDistance,
+                        arma::Col<size_t>& indices,
+                        arma::vec& distances,
+                        const size_t nearSetSize,
+                        size_t& farSetSize,
+                        size_t& usedSetSize,
+                        BuildArena& arena);
 
   /**
    * Fill the vector of distances with the distances between the point specified
@@ -485,6 +541,24 @@ class CoverTree
                         const arma::Col<size_t>& indices,
                         arma::vec& distances,
                         const size_t pointSetSize);
+
+  //! Compute the distances for ComputeDistances() a block of points at a time:
+  //! the differences between the points of a block and the given point are
+  //! gathered into one matrix, whose squared column norms are then computed
+  //! in a single pass.
+  void ComputeDistances(const size_t pointIndex,
+                        const arma::Col<size_t>& indices,
+                        arma::vec& distances,
+                        const size_t pointSetSize,
+                        const std::true_type /* blocked */);
+
+  //! Compute the distances for ComputeDistances() one at a time, with the
+  //! metric.
+  void ComputeDistances(const size_t pointIndex,
+                        const arma::Col<size_t>& indices,
+                        arma::vec& distances,
+                        const size_t pointSetSize,
+                        const std::false_type /* blocked */);
   /**
    * Split the given indices and distances into a near and a far set, returning
    * the number of points in the near set.  The distances must already be
@@ -522,13 +596,19 @@ class CoverTree
    * @param childFarSetSize Number of points in child far set (childFarSet).
    * @param childUsedSetSize Number of points in child used set (childUsedSet).
    * @param farSetSize Number of points in far set (farSet).
+   * @param arena Scratch memory of the build.
    */
   size_t SortPointSet(arma::Col<size_t>& indices,
                       arma::vec& distances,
                       const size_t childFarSetSize,
                       const size_t childUsedSetSize,
-                      const size_t farSetSize);
+                      const size_t farSetSize,
+                      BuildArena& arena);
 
+  /**
+   * Move the points of the near and far sets that the child just created has
+   * used to the used set.
+   */
   void MoveToUsedSet(arma::Col<size_t>& indices,
                      arma::vec& distances,
                      size_t& nearSetSize,
@@ -536,7 +616,8 @@ class CoverTree
                      size_t& usedSetSize,
                      arma::Col<size_t>& childIndices,
                      const size_t childFarSetSize,
-                     const size_t childUsedSetSize);
+                     const size_t childUsedSetSize,
+                     BuildArena& arena);
   size_t PruneFarSet(arma::Col<size_t>& indices,
                      arma::vec& distances,
                      const ElemType bound,
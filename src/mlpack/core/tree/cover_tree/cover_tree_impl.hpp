@@ -85,8 +85,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   // Create the children.
   size_t farSetSize = 0;
   size_t usedSetSize = 0;
+  BuildArena arena(dataset.n_cols);
   CreateChildren(indices, distances, dataset.n_cols - 1, farSetSize,
-      usedSetSize);
+      usedSetSize, arena);
 
   // If we ended up creating only one child, remove the implicit node.
   while (children.size() == 1)
@@ -180,8 +181,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   // Create the children.
   size_t farSetSize = 0;
   size_t usedSetSize = 0;
+  BuildArena arena(dataset.n_cols);
   CreateChildren(indices, distances, dataset.n_cols - 1, farSetSize,
-      usedSetSize);
+      usedSetSize, arena);
 
   // If we ended up creating only one child, remove the implicit node.
   while (children.size() == 1)
@@ -276,8 +278,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   // Create the children.
   size_t farSetSize = 0;
   size_t usedSetSize = 0;
+  BuildArena arena(dataset->n_cols);
   CreateChildren(indices, distances, dataset->n_cols - 1, farSetSize,
-      usedSetSize);
+      usedSetSize, arena);
 
   // If we ended up creating only one child, remove the implicit node.
   while (children.size() == 1)
@@ -371,8 +374,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   // Create the children.
   size_t farSetSize = 0;
   size_t usedSetSize = 0;
+  BuildArena arena(dataset->n_cols);
   CreateChildren(indices, distances, dataset->n_cols - 1, farSetSize,
-      usedSetSize);
+      usedSetSize, arena);
 
   // If we ended up creating only one child, remove the implicit node.
   while (children.size() == 1)
@@ -460,7 +464,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CoverTree(
   }
 
   // Otherwise, create the children.
-  CreateChildren(indices, distances, nearSetSize, farSetSize, usedSetSize);
+  BuildArena arena(dataset.n_cols);
+  CreateChildren(indices, distances, nearSetSize, farSetSize, usedSetSize,
+      arena);
 }
 
 // Manually create a cover tree node.
@@ -1138,7 +1144,8 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     arma::vec& distances,
     size_t nearSetSize,
     size_t& farSetSize,
-    size_t& usedSetSize)
+    size_t& usedSetSize,
+    BuildArena& arena)
 {
   // Determine the next scale level.  This should be the first level where there
   // are any points in the far set.  So, if we know the maximum distance in the
@@ -1155,17 +1162,16 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     // Make the self child at the lowest possible level.
     // This should not modify farSetSize or usedSetSize.
     size_t tempSize = 0;
-    children.push_back(new CoverTree(*dataset, base, point, INT_MIN, this, 0,
-        indices, distances, 0, tempSize, usedSetSize, *metric));
+    children.push_back(BuildChild(point, INT_MIN, 0, indices, distances, 0,
+        tempSize, usedSetSize, arena));
     distanceComps += children.back()->DistanceComps();
 
     // Every point in the near set should be a leaf.
     for (size_t i = 0; i < nearSetSize; ++i)
     {
       // farSetSize and usedSetSize will not be modified.
-      children.push_back(new CoverTree(*dataset, base, indices[i],
-          INT_MIN, this, distances[i], indices, distances, 0, tempSize,
-          usedSetSize, *metric));
+      children.push_back(BuildChild(indices[i], INT_MIN, distances[i],
+          indices, distances, 0, tempSize, usedSetSize, arena));
       distanceComps += children.back()->DistanceComps();
       usedSetSize++;
     }
@@ -1178,11 +1184,20 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     // [ used | far | other used ]
     // and we want
     // [ far | all used ].
-    SortPointSet(indices, distances, 0, usedSetSize, farSetSize);
+    SortPointSet(indices, distances, 0, usedSetSize, farSetSize, arena);
 
     return;
   }
 
+  // The near and far sets of the children of this node are built in the
+  // scratch memory for its depth; deeper nodes use their own.
+  const size_t depth = arena.depth++;
+  if (arena.indices.size() <= depth)
+  {
+    arena.indices.emplace_back();
+    arena.distances.emplace_back();
+  }
+
   const int nextScale = std::min(scale,
       (int) ceil(log(maxDistance) / log(base))) - 1;
   const ElemType bound = pow(base, nextScale);
@@ -1195,9 +1210,8 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
   // Build the self child (recursively).
   size_t childFarSetSize = nearSetSize - childNearSetSize;
   size_t childUsedSetSize = 0;
-  children.push_back(new CoverTree(*dataset, base, point, nextScale, this, 0,
-      indices, distances, childNearSetSize, childFarSetSize, childUsedSetSize,
-      *metric));
+  children.push_back(BuildChild(point, nextScale, 0, indices, distances,
+      childNearSetSize, childFarSetSize, childUsedSetSize, arena));
   // Don't double-count the self-child (so, subtract one).
   numDescendants += children[0]->NumDescendants();
 
@@ -1218,7 +1232,7 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
   // [ near | far | childUsed + used ]
   // is what we are trying to make.
   SortPointSet(indices, distances, childFarSetSize, childUsedSetSize,
-      farSetSize);
+      farSetSize, arena);
 
   // Update size of near set and used set.
   nearSetSize -= childUsedSetSize;
@@ -1253,9 +1267,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     if ((nearSetSize == 1) && (farSetSize == 0))
     {
       size_t childNearSetSize = 0;
-      children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-          this, distances[0], indices, distances, childNearSetSize, farSetSize,
-          usedSetSize, *metric));
+      children.push_back(BuildChild(indices[0], nextScale, distances[0],
+          indices, distances, childNearSetSize, farSetSize, usedSetSize,
+          arena));
       distanceComps += children.back()->DistanceComps();
       numDescendants += children.back()->NumDescendants();
 
@@ -1270,10 +1284,15 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
 
     // Create the near and far set indices and distance vectors.  We don't fill
     // in the self-point, yet.
-    arma::Col<size_t> childIndices(nearSetSize + farSetSize);
+    arma::Col<size_t>& childIndices = arena.indices[depth];
+    arma::vec& childDistances = arena.distances[depth];
+    if (childIndices.n_elem < nearSetSize + farSetSize)
+    {
+      childIndices.set_size(nearSetSize + farSetSize);
+      childDistances.set_size(nearSetSize + farSetSize);
+    }
     childIndices.rows(0, (nearSetSize + farSetSize - 2)) = indices.rows(1,
         nearSetSize + farSetSize - 1);
-    arma::vec childDistances(nearSetSize + farSetSize);
 
     // Build distances for the child.
     ComputeDistances(indices[0], childIndices, childDistances, nearSetSize
@@ -1295,9 +1314,9 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
 
     // Build this child (recursively).
     childUsedSetSize = 1; // Mark self point as used.
-    children.push_back(new CoverTree(*dataset, base, indices[0], nextScale,
-        this, distances[0], childIndices, childDistances, childNearSetSize,
-        childFarSetSize, childUsedSetSize, *metric));
+    children.push_back(BuildChild(indices[0], nextScale, distances[0],
+        childIndices, childDistances, childNearSetSize, childFarSetSize,
+        childUsedSetSize, arena));
     numDescendants += children.back()->NumDescendants();
 
     // Remove any implicit nodes.
@@ -1311,9 +1330,11 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
     // For each point in the childUsed set, we must move that point to the used
     // set in our own vector.
     MoveToUsedSet(indices, distances, nearSetSize, farSetSize, usedSetSize,
-        childIndices, childFarSetSize, childUsedSetSize);
+        childIndices, childFarSetSize, childUsedSetSize, arena);
   }
 
+  --arena.depth;
+
   // Calculate furthest descendant.
   for (size_t i = (nearSetSize + farSetSize); i < (nearSetSize + farSetSize +
       usedSetSize); ++i)
@@ -1321,6 +1342,42 @@ CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::CreateChildren(
       furthestDescendantDistance = distances[i];
 }
 
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>*
+CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::BuildChild(
+    const size_t pointIndex,
+    const int scale,
+    const ElemType parentDistance,
+    arma::Col<size_t>& indices,
+    arma::vec& distances,
+    const size_t nearSetSize,
+    size_t& farSetSize,
+    size_t& usedSetSize,
+    BuildArena& arena)
+{
+  CoverTree* child = new CoverTree(*dataset, base, pointIndex, scale, this,
+      parentDistance, 0, metric);
+
+  // If the size of the near set is 0, this is a leaf.
+  if (nearSetSize == 0)
+  {
+    child->scale = INT_MIN;
+    child->numDescendants = 1;
+  }
+  else
+  {
+    child->CreateChildren(indices, distances, nearSetSize, farSetSize,
+        usedSetSize, arena);
+  }
+
+  return child;
+}
+
 template<
     typename MetricType,
     typename StatisticType,
@@ -1394,7 +1451,69 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   // For each point, rebuild the distances.  The indices do not need to be
   // modified.
   distanceComps += pointSetSize;
-  for (size_t i = 0; i < pointSetSize; ++i)
+  ComputeDistances(pointIndex, indices, distances, pointSetSize,
+      BlockedDistances());
+}
+
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    ComputeDistances(const size_t pointIndex,
+                     const arma::Col<size_t>& indices,
+                     arma::vec& distances,
+                     const size_t pointSetSize,
+                     const std::true_type /* blocked */)
+{
+  // Each block is independent, so large sets are split between threads.
+  const size_t blocks = (pointSetSize + DistanceBlockSize - 1) /
+      DistanceBlockSize;
+  #pragma omp parallel if (pointSetSize >= ParallelDistanceSize)
+  {
+    arma::Mat<ElemType> differences(dataset->n_rows, DistanceBlockSize);
+    arma::Row<ElemType> squaredDistances;
+
+    #pragma omp for
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t begin = b * DistanceBlockSize;
+      const size_t count = std::min(DistanceBlockSize, pointSetSize - begin);
+      for (size_t i = 0; i < count; ++i)
+      {
+        differences.col(i) = dataset->col(indices[begin + i]) -
+            dataset->col(pointIndex);
+      }
+
+      squaredDistances = arma::sum(arma::square(differences.head_cols(count)),
+          0);
+      for (size_t i = 0; i < count; ++i)
+      {
+        distances[begin + i] = LeafDistanceTraits<MetricType>::TakeRoot ?
+            std::sqrt(squaredDistances[i]) : squaredDistances[i];
+      }
+    }
+  }
+}
+
+template<
+    typename MetricType,
+    typename StatisticType,
+    typename MatType,
+    typename RootPointPolicy
+>
+void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
+    ComputeDistances(const size_t pointIndex,
+                     const arma::Col<size_t>& indices,
+                     arma::vec& distances,
+                     const size_t pointSetSize,
+                     const std::false_type /* blocked */)
+{
+  // Each distance is independent, so large sets are split between threads.
+  #pragma omp parallel for if (pointSetSize >= ParallelDistanceSize)
+  for (omp_size_t i = 0; i < (omp_size_t) pointSetSize; ++i)
   {
     distances[i] = metric->Evaluate(dataset->col(pointIndex),
         dataset->col(indices[i]));
@@ -1412,7 +1531,8 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                  arma::vec& distances,
                  const size_t childFarSetSize,
                  const size_t childUsedSetSize,
-                 const size_t farSetSize)
+                 const size_t farSetSize,
+                 BuildArena& arena)
 {
   // We'll use low-level memcpy calls ourselves, just to ensure it's done
   // quickly and the way we want it to be.  Unfortunately this takes up more
@@ -1425,8 +1545,13 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   if (bufferSize == 0)
     return (childFarSetSize + farSetSize);
 
-  size_t* indicesBuffer = new size_t[bufferSize];
-  ElemType* distancesBuffer = new ElemType[bufferSize];
+  if (arena.sortIndices.size() < bufferSize)
+  {
+    arena.sortIndices.resize(bufferSize);
+    arena.sortDistances.resize(bufferSize);
+  }
+  size_t* indicesBuffer = arena.sortIndices.data();
+  ElemType* distancesBuffer = arena.sortDistances.data();
 
   // The start of the memory region to copy to the buffer.
   const size_t bufferFromLocation = ((bufferSize == farSetSize) ?
@@ -1459,9 +1584,6 @@ size_t CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   memcpy(distances.memptr() + bufferToLocation, distancesBuffer,
       sizeof(ElemType) * bufferSize);
 
-  delete[] indicesBuffer;
-  delete[] distancesBuffer;
-
   // This returns the complete size of the far set.
   return (childFarSetSize + farSetSize);
 }
@@ -1480,92 +1602,80 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
                   size_t& usedSetSize,
                   arma::Col<size_t>& childIndices,
                   const size_t childFarSetSize, // childNearSetSize is 0 here.
-                  const size_t childUsedSetSize)
+                  const size_t childUsedSetSize,
+                  BuildArena& arena)
 {
   const size_t originalSum = nearSetSize + farSetSize + usedSetSize;
 
+  // Mark the points of the child's used set, so that each point of our sets
+  // can be checked in constant time.
+  for (size_t j = 0; j < childUsedSetSize; ++j)
+    arena.used[childIndices[childFarSetSize + j]] = 1;
+
   // Loop across the set.  We will swap points as we need.  It should be noted
   // that farSetSize and nearSetSize may change with each iteration of this loop
   // (depending on if we make a swap or not).
-  size_t startChildUsedSet = 0; // Where to start in the child set.
   for (size_t i = 0; i < nearSetSize; ++i)
   {
     // Discover if this point was in the child's used set.
-    for (size_t j = startChildUsedSet; j < childUsedSetSize; ++j)
+    if (!arena.used[indices[i]])
+      continue;
+
+    // Since this point is from the near set, to preserve the near set, we must
+    // do a swap.
+    if (farSetSize > 0)
     {
-      if (childIndices[childFarSetSize + j] == indices[i])
+      if ((nearSetSize - 1) != i)
+      {
+        // In this case it must be a three-way swap.
+        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+        size_t tempNearIndex = indices[nearSetSize - 1];
+        ElemType tempNearDist = distances[nearSetSize - 1];
+
+        indices[nearSetSize + farSetSize - 1] = indices[i];
+        distances[nearSetSize + farSetSize - 1] = distances[i];
+
+        indices[nearSetSize - 1] = tempIndex;
+        distances[nearSetSize - 1] = tempDist;
+
+        indices[i] = tempNearIndex;
+        distances[i] = tempNearDist;
+      }
+      else
       {
-        // We have found a point; a swap is necessary.
-
-        // Since this point is from the near set, to preserve the near set, we
-        // must do a swap.
-        if (farSetSize > 0)
-        {
-          if ((nearSetSize - 1) != i)
-          {
-            // In this case it must be a three-way swap.
-            size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-            ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-            size_t tempNearIndex = indices[nearSetSize - 1];
-            ElemType tempNearDist = distances[nearSetSize - 1];
-
-            indices[nearSetSize + farSetSize - 1] = indices[i];
-            distances[nearSetSize + farSetSize - 1] = distances[i];
-
-            indices[nearSetSize - 1] = tempIndex;
-            distances[nearSetSize - 1] = tempDist;
-
-            indices[i] = tempNearIndex;
-            distances[i] = tempNearDist;
-          }
-          else
-          {
-            // We can do a two-way swap.
-            size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-            ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-            indices[nearSetSize + farSetSize - 1] = indices[i];
-            distances[nearSetSize + farSetSize - 1] = distances[i];
-
-            indices[i] = tempIndex;
-            distances[i] = tempDist;
-          }
-        }
-        else if ((nearSetSize - 1) != i)
-        {
-          // A two-way swap is possible.
-          size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-          ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-          indices[nearSetSize + farSetSize - 1] = indices[i];
-          distances[nearSetSize + farSetSize - 1] = distances[i];
-
-          indices[i] = tempIndex;
-          distances[i] = tempDist;
-        }
-        else
-        {
-          // No swap is necessary.
-        }
-
-        // We don't need to do a complete preservation of the child index set,
-        // but we want to make sure we only loop over points we haven't seen.
-        // So increment the child counter by 1 and move a point if we need.
-        if (j != startChildUsedSet)
-        {
-          childIndices[childFarSetSize + j] = childIndices[childFarSetSize +
-              startChildUsedSet];
-        }
-
-        // Update all counters from the swaps we have done.
-        ++startChildUsedSet;
-        --nearSetSize;
-        --i; // Since we moved a point out of the near set we must step back.
-
-        break; // Break out of this for loop; back to the first one.
+        // We can do a two-way swap.
+        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+        indices[nearSetSize + farSetSize - 1] = indices[i];
+        distances[nearSetSize + farSetSize - 1] = distances[i];
+
+        indices[i] = tempIndex;
+        distances[i] = tempDist;
       }
     }
+    else if ((nearSetSize - 1) != i)
+    {
+      // A two-way swap is possible.
+      size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+      ElemType tempDist = distances[nearSetSize + farSetSize - 1];
+
+      indices[nearSetSize + farSetSize - 1] = indices[i];
+      distances[nearSetSize + farSetSize - 1] = distances[i];
+
+      indices[i] = tempIndex;
+      distances[i] = tempDist;
+    }
+    else
+    {
+      // No swap is necessary.
+    }
+
+    // Update the counters from the swaps we have done.
+    --nearSetSize;
+    --i; // Since we moved a point out of the near set we must step back.
   }
 
   // Now loop over the far set.  This loop is different because we only require
@@ -1574,38 +1684,28 @@ void CoverTree<MetricType, StatisticType, MatType, RootPointPolicy>::
   for (size_t i = 0; i < farSetSize; ++i)
   {
     // Discover if this point was in the child's used set.
-    for (size_t j = startChildUsedSet; j < childUsedSetSize; ++j)
-    {
-      if (childIndices[childFarSetSize + j] == indices[i + nearSetSize])
-      {
-        // We have found a point to swap.
-
-        // Perform the swap.
-        size_t tempIndex = indices[nearSetSize + farSetSize - 1];
-        ElemType tempDist = distances[nearSetSize + farSetSize - 1];
-
-        indices[nearSetSize + farSetSize - 1] = indices[nearSetSize + i];
-        distances[nearSetSize + farSetSize - 1] = distances[nearSetSize + i];
+    if (!arena.used[indices[i + nearSetSize]])
+      continue;
 
-        indices[nearSetSize + i] = tempIndex;
-        distances[nearSetSize + i] = tempDist;
+    // Perform the swap.
+    size_t tempIndex = indices[nearSetSize + farSetSize - 1];
+    ElemType tempDist = distances[nearSetSize + farSetSize - 1];
 
-        if (j != startChildUsedSet)
-        {
-          childIndices[childFarSetSize + j] = childIndices[childFarSetSize +
-              startChildUsedSet];
-        }
+    indices[nearSetSize + farSetSize - 1] = indices[nearSetSize + i];
+    distances[nearSetSize + farSetSize - 1] = distances[nearSetSize + i];
 
-        // Update all counters from the swaps we have done.
-        ++startChildUsedSet;
-        --farSetSize;
-        --i;
+    indices[nearSetSize + i] = tempIndex;
+    distances[nearSetSize + i] = tempDist;
 
-        break; // Break out of this for loop; back to the first one.
-      }
-    }
+    // Update the counters from the swap we have done.
+    --farSetSize;
+    --i;
   }
 
+  // Clear the marks for the next call.
+  for (size_t j = 0; j < childUsedSetSize; ++j)
+    arena.used[childIndices[childFarSetSize + j]] = 0;
+
   // Update used set size.
   usedSetSize += childUsedSetSize;
 
@@ -88,6 +88,15 @@ class HRectBound
    */
   void Clear();
 
+  /**
+   * Move the ranges of the bound into the given memory, which must have room
+   * for Dim() ranges and must outlive the bound; the bound will not free it.
+   * This lets a tree keep the bounds of its nodes in one block of memory.
+   *
+   * @param memory Uninitialized memory for the ranges.
+   */
+  void UseMemory(math::RangeType<ElemType>* memory);
+
   //! Gets the dimensionality.
   size_t Dim() const { return dim; }
 
@@ -236,6 +245,8 @@ class HRectBound
   size_t dim;
   //! The bounds for each dimension.
   math::RangeType<ElemType>* bounds;
+  //! Whether the bounds were allocated by this object (see UseMemory()).
+  bool ownsBounds;
   //! Cached minimum width of bound.
   ElemType minWidth;
   //! Instantiated metric (likely has size 0).
@@ -27,6 +27,7 @@ template<typename MetricType, typename ElemType>
 inline HRectBound<MetricType, ElemType>::HRectBound() :
     dim(0),
     bounds(NULL),
+    ownsBounds(true),
     minWidth(0)
 { /* Nothing to do. */ }
 
@@ -38,6 +39,7 @@ template<typename MetricType, typename ElemType>
 inline HRectBound<MetricType, ElemType>::HRectBound(const size_t dimension) :
     dim(dimension),
     bounds(new math::RangeType<ElemType>[dim]),
+    ownsBounds(true),
     minWidth(0)
 { /* Nothing to do. */ }
 
@@ -49,6 +51,7 @@ inline HRectBound<MetricType, ElemType>::HRectBound(
     const HRectBound<MetricType, ElemType>& other) :
     dim(other.Dim()),
     bounds(new math::RangeType<ElemType>[dim]),
+    ownsBounds(true),
     minWidth(other.MinWidth())
 {
   // Copy other bounds over.
@@ -71,11 +74,12 @@ inline HRectBound<
   if (dim != other.Dim())
   {
     // Reallocation is necessary.
-    if (bounds)
+    if (bounds && ownsBounds)
       delete[] bounds;
 
     dim = other.Dim();
     bounds = new math::RangeType<ElemType>[dim];
+    ownsBounds = true;
   }
 
   // Now copy each of the bound values.
@@ -95,11 +99,13 @@ inline HRectBound<MetricType, ElemType>::HRectBound(
     HRectBound<MetricType, ElemType>&& other) :
     dim(other.dim),
     bounds(other.bounds),
+    ownsBounds(other.ownsBounds),
     minWidth(other.minWidth)
 {
   // Fix the other bound.
   other.dim = 0;
   other.bounds = NULL;
+  other.ownsBounds = true;
   other.minWidth = 0.0;
 }
 
@@ -109,7 +115,7 @@ inline HRectBound<MetricType, ElemType>::HRectBound(
 template<typename MetricType, typename ElemType>
 inline HRectBound<MetricType, ElemType>::~HRectBound()
 {
-  if (bounds)
+  if (bounds && ownsBounds)
     delete[] bounds;
 }
 
@@ -124,6 +130,23 @@ inline void HRectBound<MetricType, ElemType>::Clear()
   minWidth = 0;
 }
 
+/**
+ * Move the ranges into memory that is owned by someone else.
+ */
+template<typename MetricType, typename ElemType>
+inline void HRectBound<MetricType, ElemType>::UseMemory(
+    math::RangeType<ElemType>* memory)
+{
+  for (size_t i = 0; i < dim; ++i)
+    new (memory + i) math::RangeType<ElemType>(bounds[i]);
+
+  if (bounds && ownsBounds)
+    delete[] bounds;
+
+  bounds = memory;
+  ownsBounds = false;
+}
+
 /***
  * Calculates the centroid of the range, placing it into the given vector.
  *
@@ -671,9 +694,10 @@ void HRectBound<MetricType, ElemType>::serialize(
   // Allocate memory for the bounds, if necessary.
   if (Archive::is_loading::value)
   {
-    if (bounds)
+    if (bounds && ownsBounds)
       delete[] bounds;
     bounds = new math::RangeType<ElemType>[dim];
+    ownsBounds = true;
   }
 
   // We can't serialize a raw array directly, so wrap it.
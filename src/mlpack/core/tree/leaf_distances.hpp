@@ -0,0 +1,205 @@
+/**
+ * @file core/tree/leaf_distances.hpp
+ *
+ * Computation of all the distances between the points of two leaves at once,
+ * for the base cases of dual-tree algorithms that use the Euclidean distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_LEAF_DISTANCES_HPP
+#define MLPACK_CORE_TREE_LEAF_DISTANCES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/sfinae_utility.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+
+#include <unordered_map>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * A class to obtain compile-time traits about the metrics LeafDistances can
+ * compute distances for: only the Euclidean and squared Euclidean distances.
+ */
+template<typename MetricType>
+struct LeafDistanceTraits
+{
+  //! If true, then LeafDistances can compute distances of this metric.
+  static const bool Supported = false;
+  //! If true, then the metric is the square root of the squared distance.
+  static const bool TakeRoot = false;
+};
+
+//! The Euclidean and squared Euclidean distances are supported.
+template<bool MetricTakesRoot>
+struct LeafDistanceTraits<metric::LMetric<2, MetricTakesRoot>>
+{
+  static const bool Supported = true;
+  static const bool TakeRoot = MetricTakesRoot;
+};
+
+/**
+ * LeafDistances computes the squared Euclidean distances between every point
+ * of a query leaf and every point of a reference leaf at once, as
+ * ||q||^2 + ||r||^2 - 2 q^T r: the products come from a single matrix
+ * multiplication, and the squared norms of the points of each leaf are
+ * computed the first time the leaf is seen and kept for every later pair of
+ * leaves.
+ *
+ * This form loses precision when two points are close compared to their norms,
+ * so each distance comes with a bound on its error, which also covers the
+ * rounding of the metric itself.  Rules can then use these distances to skip
+ * the base cases that cannot change their results, and compute the others
+ * exactly with their metric, so that the results are the same as if every base
+ * case had been computed.
+ *
+ * A matrix multiplication does not pay off for points of few dimensions, so
+ * Compute() refuses datasets with fewer than MinDimensionality dimensions.
+ *
+ * @tparam MatType The type of the datasets.
+ */
+template<typename MatType>
+class LeafDistances
+{
+ public:
+  //! The element type of the datasets.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Create the object for the given datasets; nothing is computed yet.
+   *
+   * @param querySet Set of query points.
+   * @param referenceSet Set of reference points.
+   */
+  LeafDistances(const MatType& querySet, const MatType& referenceSet);
+
+  /**
+   * Copy the given object.  The squared norms it holds are copied, but not the
+   * current pair of leaves.
+   *
+   * @param other Object to copy.
+   */
+  LeafDistances(const LeafDistances& other);
+
+  /**
+   * Compute the squared distances between the points of the given query leaf
+   * and the points of the given reference leaf, unless they are the leaves of
+   * the last call.  Returns false if the distances were not computed, because
+   * the datasets have too few dimensions or one of the leaves is empty.
+   *
+   * @param queryLeaf Leaf of the query tree.
+   * @param referenceLeaf Leaf of the reference tree.
+   */
+  template<typename TreeType>
+  bool Compute(const TreeType& queryLeaf, const TreeType& referenceLeaf);
+
+  /**
+   * Get bounds on the distance between the given query and reference points,
+   * which must belong to the leaves of the last call to Compute(), in the
+   * units of the given metric.
+   *
+   * @param queryIndex Index of the query point in the query set.
+   * @param referenceIndex Index of the reference point in the reference set.
+   * @param lo Lower bound on the distance.
+   * @param hi Upper bound on the distance.
+   */
+  template<typename MetricType>
+  void Bounds(const size_t queryIndex,
+              const size_t referenceIndex,
+              double& lo,
+              double& hi) const;
+
+  /**
+   * Get the computed distance between the given query and reference points
+   * (see Bounds()) in the units of the given metric, and store a bound on its
+   * relative error.
+   *
+   * @param queryIndex Index of the query point in the query set.
+   * @param referenceIndex Index of the reference point in the reference set.
+   * @param relativeError Bound on the relative error of the distance; it may
+   *     be infinite.
+   */
+  template<typename MetricType>
+  double Distance(const size_t queryIndex,
+                  const size_t referenceIndex,
+                  double& relativeError) const;
+
+  //! Datasets with fewer dimensions are not handled.
+  static const size_t MinDimensionality = 16;
+
+ private:
+  //! The query set.
+  const MatType& querySet;
+  //! The reference set.
+  const MatType& referenceSet;
+
+  //! Index of the first point of the current query leaf.
+  size_t queryBegin;
+  //! Number of points in the current query leaf.
+  size_t queryCount;
+  //! Index of the first point of the current reference leaf.
+  size_t referenceBegin;
+  //! Number of points in the current reference leaf.
+  size_t referenceCount;
+
+  //! The type of a map from the index of the first point of a leaf to the
+  //! squared norms of its points.
+  typedef std::unordered_map<size_t, arma::Col<ElemType>> NormCache;
+
+  //! Squared norms of the points of every query leaf seen so far.
+  NormCache queryNormCache;
+  //! Squared norms of the points of every reference leaf seen so far, unless
+  //! the query set is the reference set, in which case queryNormCache is used.
+  NormCache referenceNormCache;
+  //! Squared norms of the points of the current query leaf.
+  const arma::Col<ElemType>* queryNorms;
+  //! Squared norms of the points of the current reference leaf.
+  const arma::Col<ElemType>* referenceNorms;
+  //! Squared distances between the points of the current leaves; each column
+  //! holds the distances of one reference point.
+  arma::Mat<ElemType> squaredDistances;
+
+  //! The error of a squared distance is at most this times the sum of the
+  //! squared norms of the two points.
+  double errorScale;
+
+  //! Get the squared norms of the points of the leaf of the given dataset
+  //! that starts at the given index, computing them if it is new.
+  static const arma::Col<ElemType>& Norms(const MatType& dataset,
+                                          NormCache& cache,
+                                          const size_t begin,
+                                          const size_t count);
+
+  //! Get the squared distance between the given points and its error bound.
+  void SquaredDistance(const size_t queryIndex,
+                       const size_t referenceIndex,
+                       double& squaredDistance,
+                       double& error) const;
+};
+
+/**
+ * This gives a HasLeafBaseCases object that tells whether or not a RuleType
+ * class has a LeafBaseCases() method, which computes the base cases between a
+ * query point of a query leaf and every point of a reference leaf, and which
+ * traversers may call instead of BaseCase().
+ */
+HAS_MEM_FUNC(LeafBaseCases, HasLeafBaseCasesCheck);
+
+template<typename RuleType, typename TreeType>
+struct HasLeafBaseCases
+{
+  static const bool value = HasLeafBaseCasesCheck<RuleType,
+      void(RuleType::*)(TreeType&, const size_t, TreeType&)>::value;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "leaf_distances_impl.hpp"
+
+#endif
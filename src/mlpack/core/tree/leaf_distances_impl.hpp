@@ -0,0 +1,168 @@
+/**
+ * @file core/tree/leaf_distances_impl.hpp
+ *
+ * Implementation of LeafDistances.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_LEAF_DISTANCES_IMPL_HPP
+#define MLPACK_CORE_TREE_LEAF_DISTANCES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "leaf_distances.hpp"
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+LeafDistances<MatType>::LeafDistances(const MatType& querySet,
+                                      const MatType& referenceSet) :
+    querySet(querySet),
+    referenceSet(referenceSet),
+    queryBegin(SIZE_MAX),
+    queryCount(0),
+    referenceBegin(SIZE_MAX),
+    referenceCount(0),
+    queryNorms(NULL),
+    referenceNorms(NULL)
+{
+  // Each norm and product is a sum of n_rows terms, with an error of at most
+  // n_rows * epsilon relative to the sum of the squared norms; so is the
+  // rounding of the metric itself.  The rest is left as slack for the final
+  // additions.
+  errorScale = (4 * querySet.n_rows + 8) *
+      std::numeric_limits<ElemType>::epsilon();
+}
+
+template<typename MatType>
+LeafDistances<MatType>::LeafDistances(const LeafDistances& other) :
+    querySet(other.querySet),
+    referenceSet(other.referenceSet),
+    queryBegin(SIZE_MAX),
+    queryCount(0),
+    referenceBegin(SIZE_MAX),
+    referenceCount(0),
+    queryNormCache(other.queryNormCache),
+    referenceNormCache(other.referenceNormCache),
+    queryNorms(NULL),
+    referenceNorms(NULL),
+    errorScale(other.errorScale)
+{ /* Nothing to do. */ }
+
+template<typename MatType>
+template<typename TreeType>
+bool LeafDistances<MatType>::Compute(const TreeType& queryLeaf,
+                                     const TreeType& referenceLeaf)
+{
+  if (querySet.n_rows < MinDimensionality || queryLeaf.Count() == 0 ||
+      referenceLeaf.Count() == 0)
+    return false;
+
+  const bool newQuery = (queryLeaf.Begin() != queryBegin ||
+      queryLeaf.Count() != queryCount);
+  const bool newReference = (referenceLeaf.Begin() != referenceBegin ||
+      referenceLeaf.Count() != referenceCount);
+  if (!newQuery && !newReference)
+    return true;
+
+  if (newQuery)
+  {
+    queryBegin = queryLeaf.Begin();
+    queryCount = queryLeaf.Count();
+    queryNorms = &Norms(querySet, queryNormCache, queryBegin, queryCount);
+  }
+
+  if (newReference)
+  {
+    referenceBegin = referenceLeaf.Begin();
+    referenceCount = referenceLeaf.Count();
+    referenceNorms = &Norms(referenceSet, (&referenceSet == &querySet) ?
+        queryNormCache : referenceNormCache, referenceBegin, referenceCount);
+  }
+
+  squaredDistances = arma::trans(querySet.cols(queryBegin,
+      queryBegin + queryCount - 1)) * referenceSet.cols(referenceBegin,
+      referenceBegin + referenceCount - 1);
+  for (size_t j = 0; j < referenceCount; ++j)
+  {
+    ElemType* column = squaredDistances.colptr(j);
+    for (size_t i = 0; i < queryCount; ++i)
+      column[i] = (*queryNorms)[i] + (*referenceNorms)[j] - 2 * column[i];
+  }
+
+  return true;
+}
+
+template<typename MatType>
+const arma::Col<typename MatType::elem_type>& LeafDistances<MatType>::Norms(
+    const MatType& dataset,
+    NormCache& cache,
+    const size_t begin,
+    const size_t count)
+{
+  // References to the elements of an unordered_map stay valid when more are
+  // added.
+  arma::Col<ElemType>& norms = cache[begin];
+  if (norms.n_elem != count)
+  {
+    norms = arma::trans(arma::sum(arma::square(dataset.cols(begin,
+        begin + count - 1)), 0));
+  }
+
+  return norms;
+}
+
+template<typename MatType>
+void LeafDistances<MatType>::SquaredDistance(const size_t queryIndex,
+                                             const size_t referenceIndex,
+                                             double& squaredDistance,
+                                             double& error) const
+{
+  const size_t i = queryIndex - queryBegin;
+  const size_t j = referenceIndex - referenceBegin;
+  squaredDistance = squaredDistances(i, j);
+  error = errorScale * ((*queryNorms)[i] + (*referenceNorms)[j]);
+}
+
+template<typename MatType>
+template<typename MetricType>
+void LeafDistances<MatType>::Bounds(const size_t queryIndex,
+                                    const size_t referenceIndex,
+                                    double& lo,
+                                    double& hi) const
+{
+  double squaredDistance, error;
+  SquaredDistance(queryIndex, referenceIndex, squaredDistance, error);
+
+  lo = std::max(squaredDistance - error, 0.0);
+  hi = squaredDistance + error;
+  if (LeafDistanceTraits<MetricType>::TakeRoot)
+  {
+    lo = std::sqrt(lo);
+    hi = std::sqrt(hi);
+  }
+}
+
+template<typename MatType>
+template<typename MetricType>
+double LeafDistances<MatType>::Distance(const size_t queryIndex,
+                                        const size_t referenceIndex,
+                                        double& relativeError) const
+{
+  double squaredDistance, error;
+  SquaredDistance(queryIndex, referenceIndex, squaredDistance, error);
+
+  squaredDistance = std::max(squaredDistance, 0.0);
+  relativeError = (squaredDistance > 0.0) ? error / squaredDistance :
+      std::numeric_limits<double>::infinity();
+  return LeafDistanceTraits<MetricType>::TakeRoot ?
+      std::sqrt(squaredDistance) : squaredDistance;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
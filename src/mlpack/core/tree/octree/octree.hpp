@@ -205,6 +205,17 @@ class Octree
          const double width,
          const size_t maxLeafSize = 20);
 
+  /**
+   * Construct this node as a child of the given parent, holding count points
+   * starting at column begin, without splitting it or computing its bound and
+   * statistic.  This is used by BulkBuild(), which fills the node afterwards.
+   *
+   * @param parent Parent of this node.
+   * @param begin Index of the first point held by the node.
+   * @param count Number of points held by the node.
+   */
+  Octree(Octree* parent, const size_t begin, const size_t count);
+
   /**
    * Copy the given tree.  Be careful!  This may use a lot of memory.
    *
@@ -439,6 +450,31 @@ class Octree
                  std::vector<size_t>& oldFromNew,
                  const size_t maxLeafSize);
 
+  /**
+   * Build the tree below the root from the Morton codes of the points: the
+   * cube of the given width around the given center is divided into a grid of
+   * 2^levels cells along each dimension, with as many levels as fit into 64
+   * bits.  The codes of the points are computed in parallel and radix sorted,
+   * the dataset is reordered once, and the nodes are then made from the ranges
+   * of points that share a prefix of their codes, without recursion.  Nodes at
+   * the last level that still hold too many points are split with SplitNode().
+   *
+   * @param center Center of the root node.
+   * @param width Width of the root node.
+   * @param oldFromNew Mappings from old to new, or NULL if there are none.
+   * @param maxLeafSize Maximum number of points allowed in a leaf.
+   */
+  void BulkBuild(const arma::vec& center,
+                 const double width,
+                 std::vector<size_t>* oldFromNew,
+                 const size_t maxLeafSize);
+
+  //! The largest number of levels of Morton codes along each dimension.
+  static const size_t MaxMortonLevels = 32;
+  //! The nodes of a bulk build are filled in parallel when the dataset has at
+  //! least this many points.
+  static const size_t ParallelBuildSize = 65536;
+
   /**
    * This is used for sorting points while splitting.
    */
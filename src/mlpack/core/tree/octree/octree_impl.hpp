@@ -14,6 +14,7 @@
 
 #include "octree.hpp"
 #include <mlpack/core/tree/perform_split.hpp>
+#include <mlpack/core/tree/radix_sort.hpp>
 #include <stack>
 
 namespace mlpack {
@@ -42,7 +43,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(const MatType& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    BulkBuild(center, maxWidth, NULL, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -84,7 +85,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BulkBuild(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -127,7 +128,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BulkBuild(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -168,7 +169,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(MatType&& dataset,
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, maxLeafSize);
+    BulkBuild(center, maxWidth, NULL, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -210,7 +211,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BulkBuild(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -253,7 +254,7 @@ Octree<MetricType, StatisticType, MatType>::Octree(
       if (bound[i].Hi() - bound[i].Lo() > maxWidth)
         maxWidth = bound[i].Hi() - bound[i].Lo();
 
-    SplitNode(center, maxWidth, oldFromNew, maxLeafSize);
+    BulkBuild(center, maxWidth, &oldFromNew, maxLeafSize);
 
     furthestDescendantDistance = 0.5 * bound.Diameter();
   }
@@ -340,6 +341,22 @@ Octree<MetricType, StatisticType, MatType>::Octree(
   stat = StatisticType(*this);
 }
 
+//! Construct a child node, to be filled by BulkBuild().
+template<typename MetricType, typename StatisticType, typename MatType>
+Octree<MetricType, StatisticType, MatType>::Octree(Octree* parent,
+                                                   const size_t begin,
+                                                   const size_t count) :
+    begin(begin),
+    count(count),
+    bound(parent->dataset->n_rows),
+    dataset(parent->dataset),
+    parent(parent),
+    parentDistance(0.0),
+    furthestDescendantDistance(0.0)
+{
+  // Nothing to do.
+}
+
 //! Copy the given tree.
 template<typename MetricType, typename StatisticType, typename MatType>
 Octree<MetricType, StatisticType, MatType>::Octree(const Octree& other) :
@@ -743,6 +760,189 @@ void Octree<MetricType, StatisticType, MatType>::serialize(
   }
 }
 
+//! Build the tree from the Morton codes of the points.
+template<typename MetricType, typename StatisticType, typename MatType>
+void Octree<MetricType, StatisticType, MatType>::BulkBuild(
+    const arma::vec& center,
+    const double width,
+    std::vector<size_t>* oldFromNew,
+    const size_t maxLeafSize)
+{
+  // A node of points that are all the same can't be split.
+  const size_t dim = dataset->n_rows;
+  if (count <= maxLeafSize || dim == 0 || width == 0.0)
+    return;
+
+  // Each level of the codes takes one bit of each dimension, so datasets with
+  // more than 64 dimensions have no codes at all.
+  const size_t levels = std::min(size_t(64) / dim, (size_t) MaxMortonLevels);
+  if (levels == 0)
+  {
+    if (oldFromNew)
+      SplitNode(center, width, *oldFromNew, maxLeafSize);
+    else
+      SplitNode(center, width, maxLeafSize);
+    return;
+  }
+
+  // Find the cell of each point along each dimension, and interleave the bits
+  // of the cells, so that the highest bits of the code give the child of the
+  // root that the point belongs to.
+  const bool parallel = (count >= ParallelBuildSize);
+  const uint64_t maxCell = ((uint64_t) 1 << levels) - 1;
+  const double scale = std::ldexp(1.0, (int) levels) / width;
+  std::vector<std::pair<uint64_t, size_t>> codes(count);
+  #pragma omp parallel for if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) count; ++i)
+  {
+    uint64_t code = 0;
+    for (size_t d = 0; d < dim; ++d)
+    {
+      const double x = ((double) (*dataset)(d, begin + i) -
+          (center[d] - width / 2.0)) * scale;
+      const uint64_t cell = (x <= 0.0) ? 0 : std::min((uint64_t) x, maxCell);
+      for (size_t l = 0; l < levels; ++l)
+        code |= ((cell >> l) & 1) << (l * dim + d);
+    }
+    codes[i] = std::make_pair(code, begin + i);
+  }
+
+  RadixSort(codes, levels * dim);
+
+  // Reorder the points (and the mappings) in place, one cycle of the
+  // permutation at a time, so that only a single point is held aside.  The
+  // point at position i is taken from position codes[i].second, which is set
+  // to i once the point is in place to mark it as done.
+  arma::Col<ElemType> point(dim);
+  for (size_t i = begin; i < begin + count; ++i)
+  {
+    if (codes[i - begin].second == i)
+      continue;
+
+    point = dataset->col(i);
+    const size_t oldIndex = oldFromNew ? (*oldFromNew)[i] : 0;
+    size_t j = i;
+    while (codes[j - begin].second != i)
+    {
+      const size_t source = codes[j - begin].second;
+      dataset->col(j) = dataset->col(source);
+      if (oldFromNew)
+        (*oldFromNew)[j] = (*oldFromNew)[source];
+      codes[j - begin].second = j;
+      j = source;
+    }
+
+    dataset->col(j) = point;
+    if (oldFromNew)
+      (*oldFromNew)[j] = oldIndex;
+    codes[j - begin].second = j;
+  }
+
+  // Now make the children of each node from the ranges of its points that
+  // share the next level of their codes.  The tuple holds { node, level,
+  // center }, where the level is the one that the children of the node are
+  // made from.  The nodes are listed with each parent before its children.
+  std::vector<Octree*> nodes;
+  std::vector<std::pair<Octree*, arma::vec>> deepNodes;
+  std::stack<std::tuple<Octree*, size_t, arma::vec>> stack;
+  stack.push(std::tuple<Octree*, size_t, arma::vec>(this, 0, center));
+  while (!stack.empty())
+  {
+    Octree* node = std::get<0>(stack.top());
+    const size_t level = std::get<1>(stack.top());
+    const arma::vec nodeCenter = std::get<2>(stack.top());
+    stack.pop();
+
+    const double childWidth = std::ldexp(width, -(int) (level + 1));
+    const size_t shift = (levels - 1 - level) * dim;
+    const size_t nodeEnd = node->begin + node->count;
+    size_t first = node->begin;
+    while (first < nodeEnd)
+    {
+      // The codes are sorted, so the points of the child are contiguous.
+      const uint64_t prefix = codes[first - begin].first >> shift;
+      const size_t last = std::upper_bound(codes.begin() + (first - begin),
+          codes.begin() + (nodeEnd - begin), prefix,
+          [shift](const uint64_t p, const std::pair<uint64_t, size_t>& c)
+          { return p < (c.first >> shift); }) - codes.begin() + begin;
+
+      Octree* child = new Octree(node, first, last - first);
+      node->children.push_back(child);
+      nodes.push_back(child);
+
+      if (child->count > maxLeafSize)
+      {
+        // Is the dimension "right" (1) or "left" (0)?
+        arma::vec childCenter(nodeCenter);
+        for (size_t d = 0; d < dim; ++d)
+          childCenter[d] += (((prefix >> d) & 1) ? 0.5 : -0.5) * childWidth;
+
+        if (level + 1 < levels)
+        {
+          stack.push(std::tuple<Octree*, size_t, arma::vec>(child, level + 1,
+              childCenter));
+        }
+        else
+        {
+          deepNodes.push_back(std::make_pair(child, childCenter));
+        }
+      }
+
+      first = last;
+    }
+  }
+
+  // Compute the bounds of the leaves, and then split the nodes of the last
+  // level that still hold too many points; each task only touches the points
+  // of its own node.
+  #pragma omp parallel for schedule(dynamic) if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) nodes.size(); ++i)
+  {
+    Octree* node = nodes[i];
+    if (node->children.empty())
+      node->bound |= dataset->cols(node->begin, node->begin + node->count - 1);
+  }
+
+  const double deepWidth = std::ldexp(width, -(int) levels);
+  #pragma omp parallel for schedule(dynamic) if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) deepNodes.size(); ++i)
+  {
+    Octree* node = deepNodes[i].first;
+    if (node->bound.Diameter() == 0.0)
+      continue;
+
+    if (oldFromNew)
+    {
+      node->SplitNode(deepNodes[i].second, deepWidth / 2.0, *oldFromNew,
+          maxLeafSize);
+    }
+    else
+    {
+      node->SplitNode(deepNodes[i].second, deepWidth / 2.0, maxLeafSize);
+    }
+  }
+
+  // The bounds of the other nodes are those of their children.
+  for (size_t i = nodes.size(); i > 0; --i)
+    for (size_t c = 0; c < nodes[i - 1]->children.size(); ++c)
+      nodes[i - 1]->bound |= nodes[i - 1]->children[c]->bound;
+
+  #pragma omp parallel for if (parallel)
+  for (omp_size_t i = 0; i < (omp_size_t) nodes.size(); ++i)
+  {
+    Octree* node = nodes[i];
+    arma::vec trueCenter, parentCenter;
+    node->bound.Center(trueCenter);
+    node->parent->bound.Center(parentCenter);
+    node->parentDistance = metric.Evaluate(trueCenter, parentCenter);
+    node->furthestDescendantDistance = 0.5 * node->bound.Diameter();
+  }
+
+  // The statistic of each node is initialized after those of its children.
+  for (size_t i = nodes.size(); i > 0; --i)
+    nodes[i - 1]->stat = StatisticType(*nodes[i - 1]);
+}
+
 //! Split the node.
 template<typename MetricType, typename StatisticType, typename MatType>
 void Octree<MetricType, StatisticType, MatType>::SplitNode(
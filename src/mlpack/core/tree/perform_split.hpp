@@ -152,6 +152,146 @@ size_t PerformSplit(MatType& data,
   return left;
 }
 
+/**
+ * This function rearranges points exactly as PerformSplit() does, but it does
+ * so with OpenMP tasks over chunks of the points, and should be called from
+ * inside a parallel region.  The serial split swaps the i'th point before the
+ * split column that goes to the right child with the i'th last point after it
+ * that goes to the left child; these pairs are found in parallel and then
+ * swapped in parallel, so the result (and oldFromNew) is the same as that of
+ * PerformSplit().
+ *
+ * @param data The dataset used by the binary space tree.
+ * @param begin Index of the starting point in the dataset that belongs to
+ *    this node.
+ * @param count Number of points in this node.
+ * @param splitInfo The information about the split.
+ * @param oldFromNew Vector which will be filled with the old positions for
+ *    each new point, or NULL if there is none.
+ * @param chunkSize Number of points handled by each task.
+ */
+template<typename MatType, typename SplitType>
+size_t ParallelPerformSplit(MatType& data,
+                            const size_t begin,
+                            const size_t count,
+                            const typename SplitType::SplitInfo& splitInfo,
+                            std::vector<size_t>* oldFromNew,
+                            const size_t chunkSize = 32768)
+{
+  const size_t chunks = (count + chunkSize - 1) / chunkSize;
+
+  // First find the child of each point, and count the points of each chunk
+  // that go to the left.
+  std::vector<char> toLeft(count);
+  std::vector<size_t> chunkLeft(chunks, 0);
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    #pragma omp task shared(data, splitInfo, toLeft, chunkLeft)
+    {
+      const size_t chunkEnd = std::min(count, (c + 1) * chunkSize);
+      size_t left = 0;
+      for (size_t i = c * chunkSize; i < chunkEnd; ++i)
+      {
+        toLeft[i] = SplitType::AssignToLeftNode(data.col(begin + i), splitInfo);
+        left += toLeft[i];
+      }
+      chunkLeft[c] = left;
+    }
+  }
+  #pragma omp taskwait
+
+  size_t leftCount = 0;
+  for (size_t c = 0; c < chunks; ++c)
+    leftCount += chunkLeft[c];
+
+  // Now count the points of each chunk that are on the wrong side of the split
+  // column; only the chunk that holds the split column must be scanned again.
+  std::vector<size_t> wrongLeft(chunks, 0), wrongRight(chunks, 0);
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    const size_t chunkBegin = c * chunkSize;
+    const size_t chunkEnd = std::min(count, chunkBegin + chunkSize);
+    if (chunkEnd <= leftCount)
+    {
+      wrongLeft[c] = (chunkEnd - chunkBegin) - chunkLeft[c];
+    }
+    else if (chunkBegin >= leftCount)
+    {
+      wrongRight[c] = chunkLeft[c];
+    }
+    else
+    {
+      for (size_t i = chunkBegin; i < chunkEnd; ++i)
+      {
+        if (i < leftCount && !toLeft[i])
+          ++wrongLeft[c];
+        else if (i >= leftCount && toLeft[i])
+          ++wrongRight[c];
+      }
+    }
+  }
+
+  // Find where the points of each chunk go in the lists of points to swap.
+  // Points before the split column are listed in increasing order, and points
+  // after it in decreasing order.
+  std::vector<size_t> leftOffset(chunks), rightOffset(chunks);
+  size_t swaps = 0;
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    leftOffset[c] = swaps;
+    swaps += wrongLeft[c];
+  }
+  size_t rightSwaps = 0;
+  for (size_t c = chunks; c > 0; --c)
+  {
+    rightOffset[c - 1] = rightSwaps;
+    rightSwaps += wrongRight[c - 1];
+  }
+  Log::Assert(swaps == rightSwaps);
+
+  std::vector<size_t> leftPoints(swaps), rightPoints(swaps);
+  for (size_t c = 0; c < chunks; ++c)
+  {
+    if (wrongLeft[c] == 0 && wrongRight[c] == 0)
+      continue;
+
+    #pragma omp task shared(toLeft, leftOffset, rightOffset, leftPoints, \
+        rightPoints)
+    {
+      const size_t chunkBegin = c * chunkSize;
+      const size_t chunkEnd = std::min(count, chunkBegin + chunkSize);
+      size_t l = leftOffset[c];
+      for (size_t i = chunkBegin; i < std::min(chunkEnd, leftCount); ++i)
+        if (!toLeft[i])
+          leftPoints[l++] = begin + i;
+      size_t r = rightOffset[c];
+      for (size_t i = chunkEnd; i > std::max(chunkBegin, leftCount); --i)
+        if (toLeft[i - 1])
+          rightPoints[r++] = begin + i - 1;
+    }
+  }
+  #pragma omp taskwait
+
+  // Finally, swap the pairs of points; no point is in more than one pair.
+  for (size_t s = 0; s < swaps; s += chunkSize)
+  {
+    #pragma omp task shared(data, leftPoints, rightPoints)
+    {
+      const size_t swapEnd = std::min(swaps, s + chunkSize);
+      for (size_t i = s; i < swapEnd; ++i)
+      {
+        data.swap_cols(leftPoints[i], rightPoints[i]);
+        if (oldFromNew)
+          std::swap((*oldFromNew)[leftPoints[i]],
+              (*oldFromNew)[rightPoints[i]]);
+      }
+    }
+  }
+  #pragma omp taskwait
+
+  return begin + leftCount;
+}
+
 } // namespace split
 } // namespace tree
 } // namespace mlpack
@@ -0,0 +1,119 @@
+/**
+ * @file core/tree/quantized_leaves.hpp
+ *
+ * A compressed copy of the points of a dataset, with each coordinate quantized
+ * to 8 bits within the bounding box of the leaf holding the point, for scans of
+ * tree leaves that are limited by memory bandwidth.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_QUANTIZED_LEAVES_HPP
+#define MLPACK_CORE_TREE_QUANTIZED_LEAVES_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/tree_traits.hpp>
+#include <mlpack/core/tree/leaf_distances.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * QuantizedLeaves holds an 8-bit scalar quantization of every point of a
+ * dataset: each coordinate of a point is stored as a code between 0 and 255,
+ * which stands for offset + code * scale, where the offset and the scale of
+ * each dimension are those of the leaf (or block of points) holding the point.
+ * The points of a leaf are close to each other, so the per-leaf range keeps the
+ * quantization error small compared to a range over the whole dataset.  The
+ * codes take one byte per coordinate instead of eight, so scans of the leaves
+ * move an eighth of the memory; the offsets and scales are stored once per
+ * leaf in single precision.
+ *
+ * The distances computed from the codes are approximate: the query point is
+ * exact and each reference coordinate is off by at most half a step of its
+ * leaf.  Searches use them to select candidates, which are then ranked again
+ * with their exact points.
+ *
+ * @tparam MatType The type of the dataset.
+ */
+template<typename MatType>
+class QuantizedLeaves
+{
+ public:
+  //! The element type of the dataset.
+  typedef typename MatType::elem_type ElemType;
+
+  //! Create an empty object; Build() must be called before any distance is
+  //! computed.
+  QuantizedLeaves() { }
+
+  /**
+   * Quantize the points of the dataset of the given tree, within the leaves of
+   * the tree (and the other nodes that hold points, if any).  Trees with
+   * self-children (cover trees) have leaves of one point, and are refused with
+   * a std::invalid_argument exception.  A point held by several leaves (as in
+   * spill trees) is quantized within the first of them.
+   *
+   * @param root Root of the tree.
+   */
+  template<typename TreeType>
+  void Build(const TreeType& root);
+
+  /**
+   * Quantize the points of the given dataset in blocks of consecutive points,
+   * for searches that use no tree.
+   *
+   * @param dataset Dataset to quantize.
+   * @param blockSize Number of points of each block.
+   */
+  void Build(const MatType& dataset, const size_t blockSize);
+
+  //! Release the codes.
+  void Clear();
+
+  //! Return whether the codes have not been built.
+  bool Empty() const { return codes.n_cols == 0; }
+
+  /**
+   * Compute the approximate distance between the given point and the given
+   * point of the quantized dataset, in the units of the given metric, which
+   * must be the Euclidean or squared Euclidean distance (see
+   * LeafDistanceTraits).
+   *
+   * @param query The point to compute the distance from.
+   * @param index Index of the point of the quantized dataset.
+   */
+  template<typename MetricType, typename VecType>
+  double Distance(const VecType& query, const size_t index) const;
+
+  //! Get the codes of the points; each column holds one point.
+  const arma::Mat<unsigned char>& Codes() const { return codes; }
+
+  //! Get the number of bytes used by the codes, offsets and scales.
+  size_t MemoryBytes() const;
+
+ private:
+  //! Quantize the given points of the dataset, as the next leaf.
+  void AddLeaf(const MatType& dataset, const std::vector<size_t>& points);
+
+  //! The code of each coordinate of each point.
+  arma::Mat<unsigned char> codes;
+  //! The index of the leaf of each point.
+  arma::Col<size_t> leaves;
+  //! The minimum of each dimension in each leaf; each column holds one leaf.
+  arma::fmat offsets;
+  //! The step between two codes of each dimension in each leaf.
+  arma::fmat scales;
+  //! The number of leaves quantized so far, while building.
+  size_t numLeaves;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "quantized_leaves_impl.hpp"
+
+#endif
@@ -0,0 +1,183 @@
+/**
+ * @file core/tree/quantized_leaves_impl.hpp
+ *
+ * Implementation of the QuantizedLeaves class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_QUANTIZED_LEAVES_IMPL_HPP
+#define MLPACK_CORE_TREE_QUANTIZED_LEAVES_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "quantized_leaves.hpp"
+
+#include <stack>
+
+namespace mlpack {
+namespace tree {
+
+template<typename MatType>
+template<typename TreeType>
+void QuantizedLeaves<MatType>::Build(const TreeType& root)
+{
+  if (TreeTraits<TreeType>::HasSelfChildren)
+  {
+    throw std::invalid_argument("QuantizedLeaves::Build(): trees with "
+        "self-children have leaves of one point, which cannot be quantized");
+  }
+
+  const MatType& dataset = root.Dataset();
+  codes.set_size(dataset.n_rows, dataset.n_cols);
+  leaves.set_size(dataset.n_cols);
+  leaves.fill(SIZE_MAX);
+
+  // Count the leaves first, to allocate their ranges once.
+  size_t leafCount = 0;
+  std::stack<const TreeType*> nodes;
+  nodes.push(&root);
+  while (!nodes.empty())
+  {
+    const TreeType* node = nodes.top();
+    nodes.pop();
+    if (node->IsLeaf() || node->NumPoints() > 0)
+      ++leafCount;
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(&node->Child(i));
+  }
+
+  offsets.set_size(dataset.n_rows, leafCount);
+  scales.set_size(dataset.n_rows, leafCount);
+  numLeaves = 0;
+
+  std::vector<size_t> points;
+  nodes.push(&root);
+  while (!nodes.empty())
+  {
+    const TreeType* node = nodes.top();
+    nodes.pop();
+    if (node->IsLeaf() || node->NumPoints() > 0)
+    {
+      // Skip the points that another leaf already holds.
+      points.clear();
+      for (size_t i = 0; i < node->NumPoints(); ++i)
+        if (leaves[node->Point(i)] == SIZE_MAX)
+          points.push_back(node->Point(i));
+
+      AddLeaf(dataset, points);
+    }
+
+    for (size_t i = 0; i < node->NumChildren(); ++i)
+      nodes.push(&node->Child(i));
+  }
+}
+
+template<typename MatType>
+void QuantizedLeaves<MatType>::Build(const MatType& dataset,
+                                     const size_t blockSize)
+{
+  const size_t blocks = (dataset.n_cols + blockSize - 1) / blockSize;
+  codes.set_size(dataset.n_rows, dataset.n_cols);
+  leaves.set_size(dataset.n_cols);
+  offsets.set_size(dataset.n_rows, blocks);
+  scales.set_size(dataset.n_rows, blocks);
+  numLeaves = 0;
+
+  std::vector<size_t> points;
+  for (size_t b = 0; b < blocks; ++b)
+  {
+    points.clear();
+    const size_t end = std::min((b + 1) * blockSize, (size_t) dataset.n_cols);
+    for (size_t i = b * blockSize; i < end; ++i)
+      points.push_back(i);
+
+    AddLeaf(dataset, points);
+  }
+}
+
+template<typename MatType>
+void QuantizedLeaves<MatType>::Clear()
+{
+  codes.reset();
+  leaves.reset();
+  offsets.reset();
+  scales.reset();
+}
+
+template<typename MatType>
+template<typename MetricType, typename VecType>
+inline force_inline
+double QuantizedLeaves<MatType>::Distance(const VecType& query,
+                                          const size_t index) const
+{
+  const size_t leaf = leaves[index];
+  const unsigned char* code = codes.colptr(index);
+  const float* offset = offsets.colptr(leaf);
+  const float* scale = scales.colptr(leaf);
+
+  double squaredDistance = 0.0;
+  for (size_t d = 0; d < codes.n_rows; ++d)
+  {
+    const double diff = (double) query[d] - offset[d] - scale[d] * code[d];
+    squaredDistance += diff * diff;
+  }
+
+  return LeafDistanceTraits<MetricType>::TakeRoot ?
+      std::sqrt(squaredDistance) : squaredDistance;
+}
+
+template<typename MatType>
+size_t QuantizedLeaves<MatType>::MemoryBytes() const
+{
+  return codes.n_elem + leaves.n_elem * sizeof(size_t) +
+      (offsets.n_elem + scales.n_elem) * sizeof(float);
+}
+
+template<typename MatType>
+void QuantizedLeaves<MatType>::AddLeaf(const MatType& dataset,
+                                       const std::vector<size_t>& points)
+{
+  const size_t leaf = numLeaves++;
+  if (points.empty())
+  {
+    offsets.col(leaf).zeros();
+    scales.col(leaf).zeros();
+    return;
+  }
+
+  // Find the range of each dimension in the leaf.
+  arma::Col<ElemType> lo(dataset.col(points[0]));
+  arma::Col<ElemType> hi(lo);
+  for (size_t i = 1; i < points.size(); ++i)
+  {
+    lo = arma::min(lo, dataset.col(points[i]));
+    hi = arma::max(hi, dataset.col(points[i]));
+  }
+
+  for (size_t d = 0; d < dataset.n_rows; ++d)
+  {
+    offsets(d, leaf) = (float) lo[d];
+    scales(d, leaf) = (float) ((hi[d] - lo[d]) / 255.0);
+  }
+
+  // Round each coordinate to the nearest code.
+  for (size_t i = 0; i < points.size(); ++i)
+  {
+    const size_t p = points[i];
+    leaves[p] = leaf;
+    for (size_t d = 0; d < dataset.n_rows; ++d)
+    {
+      const double scale = scales(d, leaf);
+      const double code = (scale > 0.0) ?
+          std::round((dataset(d, p) - offsets(d, leaf)) / scale) : 0.0;
+      codes(d, p) = (unsigned char) std::min(std::max(code, 0.0), 255.0);
+    }
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,111 @@
+/**
+ * @file core/tree/radix_sort.hpp
+ *
+ * A least significant digit radix sort of (key, index) pairs with unsigned
+ * integer keys, which is used to order points along space-filling curves when
+ * trees are built.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_TREE_RADIX_SORT_HPP
+#define MLPACK_CORE_TREE_RADIX_SORT_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+namespace tree /** Trees and tree-building procedures. */ {
+
+/**
+ * Sort the given (key, index) pairs by their keys.  This is a stable least
+ * significant digit radix sort, which makes one pass over the pairs for each
+ * byte of the keys that is sorted on; passes in which every key has the same
+ * byte are skipped.  Large sets of pairs are split into one contiguous chunk
+ * per thread, and each thread counts and scatters its own chunk.  Since the
+ * sort is stable, the result does not depend on the number of threads.
+ *
+ * @param pairs (Key, index) pairs to sort.
+ * @param numBits Number of low bits of the keys to sort on; the other bits are
+ *     ignored.
+ * @param parallelSize Minimum number of pairs to sort with several threads.
+ */
+template<typename KeyType>
+void RadixSort(std::vector<std::pair<KeyType, size_t>>& pairs,
+               const size_t numBits = sizeof(KeyType) * CHAR_BIT,
+               const size_t parallelSize = 65536)
+{
+  static_assert(std::is_unsigned<KeyType>::value,
+      "RadixSort() can only sort unsigned integer keys.");
+
+  const size_t n = pairs.size();
+  if (n < 2)
+    return;
+
+  size_t chunks = 1;
+#ifdef _OPENMP
+  if (n >= parallelSize)
+    chunks = (size_t) omp_get_max_threads();
+#endif
+  const size_t chunkSize = (n + chunks - 1) / chunks;
+
+  // The digit counts of each chunk, which are then turned into the position of
+  // the first pair with each digit of each chunk.
+  std::vector<size_t> offsets(256 * chunks);
+  std::vector<std::pair<KeyType, size_t>> buffer(n);
+  const size_t bits = std::min(numBits, sizeof(KeyType) * CHAR_BIT);
+  for (size_t shift = 0; shift < bits; shift += 8)
+  {
+    // The last digit may be narrower than a byte, if bits is not a multiple of
+    // 8; the bits of the keys above it are ignored.
+    const size_t digitMask = (bits - shift >= 8) ? 0xFF :
+        ((size_t(1) << (bits - shift)) - 1);
+    std::fill(offsets.begin(), offsets.end(), 0);
+
+    #pragma omp parallel for if (chunks > 1)
+    for (omp_size_t c = 0; c < (omp_size_t) chunks; ++c)
+    {
+      size_t* counts = offsets.data() + 256 * c;
+      const size_t end = std::min(n, (c + 1) * chunkSize);
+      for (size_t i = c * chunkSize; i < end; ++i)
+        ++counts[(pairs[i].first >> shift) & digitMask];
+    }
+
+    // Nothing moves if every key has the same digit.
+    const size_t firstDigit = (pairs[0].first >> shift) & digitMask;
+    size_t firstCount = 0;
+    for (size_t c = 0; c < chunks; ++c)
+      firstCount += offsets[256 * c + firstDigit];
+    if (firstCount == n)
+      continue;
+
+    // The pairs with a given digit are placed in the order of their chunks.
+    size_t total = 0;
+    for (size_t d = 0; d < 256; ++d)
+    {
+      for (size_t c = 0; c < chunks; ++c)
+      {
+        const size_t count = offsets[256 * c + d];
+        offsets[256 * c + d] = total;
+        total += count;
+      }
+    }
+
+    #pragma omp parallel for if (chunks > 1)
+    for (omp_size_t c = 0; c < (omp_size_t) chunks; ++c)
+    {
+      size_t* positions = offsets.data() + 256 * c;
+      const size_t end = std::min(n, (c + 1) * chunkSize);
+      for (size_t i = c * chunkSize; i < end; ++i)
+        buffer[positions[(pairs[i].first >> shift) & digitMask]++] = pairs[i];
+    }
+
+    pairs.swap(buffer);
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -197,6 +197,17 @@ class DiscreteHilbertValue
   template<typename TreeType>
   void UpdateLargestValue(TreeType* node);
 
+  /**
+   * Set up the Hilbert values of a node that was filled by bulk loading: a
+   * leaf computes the Hilbert values of its points, which must already be
+   * arranged according to them, and an intermediate node takes the largest
+   * Hilbert value of its last child.
+   *
+   * @param node The node that was filled.
+   */
+  template<typename TreeType>
+  void BuildValues(TreeType* node);
+
   /**
    * This method updates the largest Hilbert value of a leaf node and
    * redistributes the Hilbert values of points according to their new position
@@ -50,10 +50,11 @@ DiscreteHilbertValue<TreeElemType>::DiscreteHilbertValue(const TreeType* tree) :
   // Calculate the Hilbert value for all points.
   if (!tree->Parent()) // This is the root node.
     ownsLocalHilbertValues = true;
-  else if (tree->Parent()->Child(0).IsLeaf())
+  else if (tree->Parent()->NumChildren() == 0 ||
+      tree->Parent()->Child(0).IsLeaf())
   {
-    // This is a leaf node.
-    assert(tree->Parent()->NumChildren() > 0);
+    // This is a leaf node, or the first child of a node that is being bulk
+    // loaded, which is set up by BuildValues() once it is filled.
     ownsLocalHilbertValues = true;
   }
 
@@ -470,6 +471,37 @@ void DiscreteHilbertValue<TreeElemType>::UpdateLargestValue(TreeType* node)
   }
 }
 
+template<typename TreeElemType>
+template<typename TreeType>
+void DiscreteHilbertValue<TreeElemType>::BuildValues(TreeType* node)
+{
+  if (node->IsLeaf())
+  {
+    if (!ownsLocalHilbertValues)
+    {
+      localHilbertValues = new arma::Mat<HilbertElemType>(
+          node->Dataset().n_rows, node->MaxLeafSize() + 1);
+      ownsLocalHilbertValues = true;
+    }
+
+    for (size_t i = 0; i < node->NumPoints(); ++i)
+    {
+      localHilbertValues->col(i) =
+          CalculateValue(node->Dataset().col(node->Point(i)));
+    }
+    numValues = node->NumPoints();
+  }
+  else
+  {
+    // Only leaf nodes own the local Hilbert values.
+    if (ownsLocalHilbertValues)
+      delete localHilbertValues;
+    ownsLocalHilbertValues = false;
+
+    UpdateLargestValue(node);
+  }
+}
+
 template<typename TreeElemType>
 template<typename TreeType>
 void DiscreteHilbertValue<TreeElemType>::RedistributeHilbertValues(
@@ -109,6 +109,26 @@ class HilbertRTreeAuxiliaryInformation
    */
   bool HandleNodeRemoval(TreeType* node, const size_t nodeIndex);
 
+  /**
+   * The Hilbert R tree requires all points to be arranged according to their
+   * Hilbert value, so the points are bulk loaded in that order.  This method
+   * sorts them and returns true.
+   *
+   * @param node The root of the tree being bulk loaded.
+   * @param points The indices of the points being loaded.
+   */
+  bool HandleBulkLoadOrder(TreeType* node, std::vector<size_t>& points);
+
+  /**
+   * Compute the Hilbert values of a leaf that was filled by bulk loading, or
+   * the largest Hilbert value of an intermediate node.
+   *
+   * @param node The node that was filled.
+   * @param * (region) The part of space the bulk loader assigned to the node.
+   */
+  template<typename BoundType>
+  void HandleBulkLoad(TreeType* node, const BoundType& /* region */);
+
   /**
    * Update the auxiliary information in the node. The method returns true if
    * the update should be propagated downward.
@@ -150,6 +150,50 @@ HandleNodeRemoval(TreeType* node, const size_t nodeIndex)
   return true;
 }
 
+template<typename TreeType,
+         template<typename> class HilbertValueType>
+bool HilbertRTreeAuxiliaryInformation<TreeType, HilbertValueType>::
+HandleBulkLoadOrder(TreeType* node, std::vector<size_t>& points)
+{
+  typedef typename HilbertValueType<ElemType>::HilbertElemType HilbertElemType;
+
+  // Calculate the Hilbert value of each point once.
+  std::vector<arma::Col<HilbertElemType>> values(points.size());
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) points.size(); ++i)
+  {
+    values[i] = HilbertValueType<ElemType>::CalculateValue(
+        node->Dataset().col(points[i]));
+  }
+
+  std::vector<size_t> order(points.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = i;
+
+  std::stable_sort(order.begin(), order.end(),
+      [&values](const size_t a, const size_t b)
+      {
+        return HilbertValueType<ElemType>::CompareValues(values[a],
+            values[b]) < 0;
+      });
+
+  std::vector<size_t> sortedPoints(points.size());
+  for (size_t i = 0; i < order.size(); ++i)
+    sortedPoints[i] = points[order[i]];
+  points.swap(sortedPoints);
+
+  return true;
+}
+
+template<typename TreeType,
+         template<typename> class HilbertValueType>
+template<typename BoundType>
+void HilbertRTreeAuxiliaryInformation<TreeType, HilbertValueType>::
+HandleBulkLoad(TreeType* node, const BoundType& /* region */)
+{
+  hilbertValue.BuildValues(node);
+}
+
 template<typename TreeType,
          template<typename> class HilbertValueType>
 bool HilbertRTreeAuxiliaryInformation<TreeType, HilbertValueType>::
@@ -114,6 +114,28 @@ class RPlusPlusTreeAuxiliaryInformation
   bool HandleNodeRemoval(TreeType* /* node */, const size_t /* nodeIndex */);
 
 
+  /**
+   * Some tree types require the points to be bulk loaded in a particular
+   * order.  If so, this method should sort the given indices of the points in
+   * that order and return true.  The R++ tree does not: its nodes need the
+   * regions that tiling the points gives them.
+   *
+   * @param * (node) The root of the tree being bulk loaded.
+   * @param * (points) The indices of the points being loaded.
+   */
+  bool HandleBulkLoadOrder(TreeType* /* node */,
+                           std::vector<size_t>& /* points */);
+
+  /**
+   * The R++ tree requires the maximum bounding rectangles of the children of a
+   * node to partition the rectangle of the node.  The regions the bulk loader
+   * assigns to the nodes do, so they become the maximum bounding rectangles.
+   *
+   * @param * (node) The node that was filled.
+   * @param region The part of space the bulk loader assigned to the node.
+   */
+  void HandleBulkLoad(TreeType* /* node */, const BoundType& region);
+
   /**
    * Some tree types require to propagate the information upward.
    * This method should return false if this is not the case. If true is
@@ -89,6 +89,20 @@ bool RPlusPlusTreeAuxiliaryInformation<TreeType>::HandleNodeRemoval(
   return false;
 }
 
+template<typename TreeType>
+bool RPlusPlusTreeAuxiliaryInformation<TreeType>::HandleBulkLoadOrder(
+    TreeType* /* node */, std::vector<size_t>& /* points */)
+{
+  return false;
+}
+
+template<typename TreeType>
+void RPlusPlusTreeAuxiliaryInformation<TreeType>::HandleBulkLoad(
+    TreeType* /* node */, const BoundType& region)
+{
+  outerBound = region;
+}
+
 template<typename TreeType>
 bool RPlusPlusTreeAuxiliaryInformation<TreeType>::UpdateAuxiliaryInfo(
     TreeType* /* node */)
@@ -30,6 +30,12 @@ namespace tree /** Trees and tree-building procedures. */ {
  * the constructor with the dataset to build the tree on, and the entire tree
  * will be built.
  *
+ * The tree is bulk loaded from the dataset: the points are tiled with the
+ * Sort-Tile-Recursive method (or, for Hilbert R trees, sorted by their Hilbert
+ * values) and packed into nearly full nodes from the top down, which is much
+ * faster than inserting them one at a time and gives less overlap between
+ * nodes.  The tree is then a valid tree of its type.
+ *
  * This tree does allow growth, so you can add and delete nodes from it.
  *
  * @tparam MetricType This *must* be EuclideanDistance, but the template
@@ -116,7 +122,7 @@ class RectangleTree
 
   /**
    * Construct this as the root node of a rectangle type tree using the given
-   * dataset.  This will modify the ordering of the points in the dataset!
+   * dataset, which is bulk loaded into the tree.
    *
    * @param data Dataset from which to create the tree.  This will be modified!
    * @param maxLeafSize Maximum size of each leaf in the tree.
@@ -137,7 +143,8 @@ class RectangleTree
 
   /**
    * Construct this as the root node of a rectangle tree type using the given
-   * dataset, and taking ownership of the given dataset.
+   * dataset, and taking ownership of the given dataset, which is bulk loaded
+   * into the tree.
    *
    * @param data Dataset from which to create the tree.
    * @param maxLeafSize Maximum size of each leaf in the tree.
@@ -564,6 +571,62 @@ class RectangleTree
    */
   void BuildStatistics(RectangleTree* node);
 
+  /**
+   * Bulk load the points of the dataset from the given index on into this
+   * empty root node.
+   *
+   * @param firstDataIndex The index of the first point to load.
+   */
+  void BulkLoad(const size_t firstDataIndex);
+
+  /**
+   * Fill this empty node with the given points, creating the nodes below it.
+   * Each child is filled with as many points as it can hold, except that the
+   * last two share the rest if the last one would be less than half full.
+   *
+   * @param order Indices of the points being loaded.
+   * @param first Position in order of the first point of this node.
+   * @param num Number of points of this node.
+   * @param capacity Number of points the subtree of this node can hold; if it
+   *     is the maximum leaf size, this node is a leaf.
+   * @param region The part of space assigned to this node.
+   * @param ordered If true, the points are already in the order they should be
+   *     packed in; otherwise they are tiled.
+   */
+  void FillNode(std::vector<size_t>& order,
+                const size_t first,
+                const size_t num,
+                const size_t capacity,
+                const bound::HRectBound<metric::EuclideanDistance, ElemType>&
+                    region,
+                const bool ordered);
+
+  /**
+   * Tile the given points into groups of the given sizes with the
+   * Sort-Tile-Recursive method: the points are sorted into slabs of whole
+   * groups along the dimension in which they are the most spread out, and each
+   * slab is tiled in turn.  The region of each group is narrowed down to its
+   * slabs.
+   *
+   * @param order Indices of the points being loaded.
+   * @param first Position in order of the first point of the first group.
+   * @param sizes Sizes of all the groups of the node.
+   * @param firstGroup Index of the first group to tile.
+   * @param numGroups Number of groups to tile.
+   * @param regions Regions of all the groups of the node.
+   */
+  void TilePoints(std::vector<size_t>& order,
+                  const size_t first,
+                  const std::vector<size_t>& sizes,
+                  const size_t firstGroup,
+                  const size_t numGroups,
+                  std::vector<bound::HRectBound<metric::EuclideanDistance,
+                      ElemType>>& regions) const;
+
+  //! Nodes with at least this many points are filled by concurrent tasks when
+  //! the tree is bulk loaded.
+  static const size_t ParallelBuildSize = 8192;
+
  protected:
   /**
    * A default constructor.  This is meant to only be used with
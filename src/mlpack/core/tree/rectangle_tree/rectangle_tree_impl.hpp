@@ -39,6 +39,227 @@ BuildStatistics(RectangleTree* node)
   node->Stat() = StatisticType(*node);
 }
 
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+BulkLoad(const size_t firstDataIndex)
+{
+  if (firstDataIndex >= dataset->n_cols)
+    return;
+
+  std::vector<size_t> order(dataset->n_cols - firstDataIndex);
+  for (size_t i = 0; i < order.size(); ++i)
+    order[i] = firstDataIndex + i;
+
+  // The tree is as shallow as it can be: each level multiplies the number of
+  // points a subtree can hold by the maximum number of children.
+  size_t capacity = maxLeafSize;
+  while (capacity < order.size())
+    capacity *= maxNumChildren;
+
+  const bool ordered = auxiliaryInfo.HandleBulkLoadOrder(this, order);
+
+  // The root covers the whole space.
+  bound::HRectBound<metric::EuclideanDistance, ElemType> region(
+      dataset->n_rows);
+  for (size_t k = 0; k < region.Dim(); ++k)
+  {
+    region[k].Lo() = std::numeric_limits<ElemType>::lowest();
+    region[k].Hi() = std::numeric_limits<ElemType>::max();
+  }
+
+#ifdef _OPENMP
+  // Large trees are filled by OpenMP tasks, which need a parallel region to
+  // run in.  It has omp_get_max_threads() threads; see util::ScopedThreads.
+  if (order.size() >= ParallelBuildSize && omp_get_level() == 0)
+  {
+    #pragma omp parallel
+    {
+      #pragma omp single
+      FillNode(order, 0, order.size(), capacity, region, ordered);
+    }
+    return;
+  }
+#endif
+
+  FillNode(order, 0, order.size(), capacity, region, ordered);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+FillNode(std::vector<size_t>& order,
+         const size_t first,
+         const size_t num,
+         const size_t capacity,
+         const bound::HRectBound<metric::EuclideanDistance, ElemType>& region,
+         const bool ordered)
+{
+  numDescendants = num;
+
+  if (capacity == maxLeafSize)
+  {
+    for (size_t i = 0; i < num; ++i)
+    {
+      points[i] = order[first + i];
+      bound |= dataset->col(points[i]);
+    }
+    count = num;
+
+    auxiliaryInfo.HandleBulkLoad(this, region);
+    return;
+  }
+
+  // Fill every child but the last one, which takes the rest; if that would
+  // leave it less than half full, the last two children share the rest.
+  const size_t childCapacity = capacity / maxNumChildren;
+  const size_t numGroups = (num + childCapacity - 1) / childCapacity;
+  std::vector<size_t> sizes(numGroups, childCapacity);
+  sizes.back() = num - (numGroups - 1) * childCapacity;
+  if (numGroups > 1 && sizes.back() < childCapacity / 2)
+  {
+    const size_t rest = childCapacity + sizes.back();
+    sizes[numGroups - 2] = rest - rest / 2;
+    sizes.back() = rest / 2;
+  }
+
+  std::vector<bound::HRectBound<metric::EuclideanDistance, ElemType>> regions(
+      numGroups, region);
+  if (!ordered)
+    TilePoints(order, first, sizes, 0, numGroups, regions);
+
+  // The children are created first, so that each can be filled by its own
+  // task; each only touches its own points.
+  for (size_t i = 0; i < numGroups; ++i)
+  {
+    RectangleTree* child = new RectangleTree(this);
+    children[numChildren++] = child;
+  }
+
+  const bool concurrent = (num >= ParallelBuildSize);
+  size_t childFirst = first;
+  for (size_t i = 0; i < numGroups; ++i)
+  {
+    RectangleTree* child = children[i];
+    if (concurrent && i + 1 < numGroups)
+    {
+      #pragma omp task shared(order, sizes, regions)
+      child->FillNode(order, childFirst, sizes[i], childCapacity, regions[i],
+          ordered);
+    }
+    else
+    {
+      child->FillNode(order, childFirst, sizes[i], childCapacity, regions[i],
+          ordered);
+    }
+
+    childFirst += sizes[i];
+  }
+
+  if (concurrent)
+  {
+    #pragma omp taskwait
+  }
+
+  for (size_t i = 0; i < numChildren; ++i)
+    bound |= children[i]->bound;
+
+  auxiliaryInfo.HandleBulkLoad(this, region);
+}
+
+template<typename MetricType,
+         typename StatisticType,
+         typename MatType,
+         typename SplitType,
+         typename DescentType,
+         template<typename> class AuxiliaryInformationType>
+void RectangleTree<MetricType, StatisticType, MatType, SplitType, DescentType,
+              AuxiliaryInformationType>::
+TilePoints(std::vector<size_t>& order,
+           const size_t first,
+           const std::vector<size_t>& sizes,
+           const size_t firstGroup,
+           const size_t numGroups,
+           std::vector<bound::HRectBound<metric::EuclideanDistance, ElemType>>&
+               regions) const
+{
+  if (numGroups <= 1)
+    return;
+
+  size_t num = 0;
+  for (size_t g = firstGroup; g < firstGroup + numGroups; ++g)
+    num += sizes[g];
+
+  // Find the dimension in which the points are the most spread out.
+  arma::Col<ElemType> minValues(dataset->n_rows);
+  arma::Col<ElemType> maxValues(dataset->n_rows);
+  minValues.fill(std::numeric_limits<ElemType>::max());
+  maxValues.fill(std::numeric_limits<ElemType>::lowest());
+  for (size_t i = first; i < first + num; ++i)
+  {
+    minValues = arma::min(minValues, dataset->col(order[i]));
+    maxValues = arma::max(maxValues, dataset->col(order[i]));
+  }
+  const size_t dim = arma::index_max(maxValues - minValues);
+
+  // Cut as many slabs as if the groups were tiled along
+  // min(dimensions, log2(groups)) dimensions.
+  size_t tiledDims = 1;
+  while (tiledDims < dataset->n_rows &&
+      (size_t(1) << (tiledDims + 1)) <= numGroups)
+    ++tiledDims;
+  const size_t numSlabs = std::min(numGroups, (size_t) std::ceil(
+      std::pow((double) numGroups, 1.0 / tiledDims)));
+  const size_t groupsPerSlab = (numGroups + numSlabs - 1) / numSlabs;
+
+  const MatType& data = *dataset;
+  auto less = [&data, dim](const size_t a, const size_t b)
+  {
+    return data(dim, a) < data(dim, b);
+  };
+
+  size_t slabFirst = first;
+  for (size_t g = 0; g < numGroups; g += groupsPerSlab)
+  {
+    const size_t slabGroups = std::min(groupsPerSlab, numGroups - g);
+    size_t slabSize = 0;
+    for (size_t i = 0; i < slabGroups; ++i)
+      slabSize += sizes[firstGroup + g + i];
+
+    if (g + slabGroups < numGroups)
+    {
+      // Move the points of this slab before those of the following ones; the
+      // slabs are cut halfway between them.
+      const size_t slabEnd = slabFirst + slabSize;
+      std::nth_element(order.begin() + slabFirst, order.begin() + slabEnd,
+          order.begin() + first + num, less);
+      ElemType lowerMax = data(dim, order[slabFirst]);
+      for (size_t i = slabFirst + 1; i < slabEnd; ++i)
+        lowerMax = std::max(lowerMax, data(dim, order[i]));
+      const ElemType cut = lowerMax +
+          (data(dim, order[slabEnd]) - lowerMax) / 2;
+
+      for (size_t i = g; i < g + slabGroups; ++i)
+        regions[firstGroup + i][dim].Hi() = cut;
+      for (size_t i = g + slabGroups; i < numGroups; ++i)
+        regions[firstGroup + i][dim].Lo() = cut;
+    }
+
+    TilePoints(order, slabFirst, sizes, firstGroup + g, slabGroups, regions);
+    slabFirst += slabSize;
+  }
+}
+
 template<typename MetricType,
          typename StatisticType,
          typename MatType,
@@ -70,11 +291,7 @@ RectangleTree(const MatType& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
-
-  for (size_t i = firstDataIndex; i < data.n_cols; ++i)
-    root->InsertPoint(i);
+  BulkLoad(firstDataIndex);
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
@@ -111,11 +328,7 @@ RectangleTree(MatType&& data,
     points(maxLeafSize + 1), // Add one to make splitting the node simpler.
     auxiliaryInfo(this)
 {
-  // For now, just insert the points in order.
-  RectangleTree* root = this;
-
-  for (size_t i = firstDataIndex; i < dataset->n_cols; ++i)
-    root->InsertPoint(i);
+  BulkLoad(firstDataIndex);
 
   // Initialize statistic recursively after tree construction is complete.
   BuildStatistics(this);
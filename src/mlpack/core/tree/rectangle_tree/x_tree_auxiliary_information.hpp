@@ -145,6 +145,34 @@ class XTreeAuxiliaryInformation
     return false;
   }
 
+  /**
+   * Some tree types require the points to be bulk loaded in a particular
+   * order.  If so, this method should sort the given indices of the points in
+   * that order and return true; the nodes are then filled with consecutive
+   * points.  If the method returns false, the RectangleTree tiles the points
+   * itself.
+   *
+   * @param * (node) The root of the tree being bulk loaded.
+   * @param * (points) The indices of the points being loaded.
+   */
+  bool HandleBulkLoadOrder(TreeType* /* node */,
+                           std::vector<size_t>& /* points */)
+  {
+    return false;
+  }
+
+  /**
+   * Some tree types require to save some properties when a node is filled by
+   * bulk loading.  This method is called once the points or the children of
+   * the node are in place.
+   *
+   * @param * (node) The node that was filled.
+   * @param * (region) The part of space the bulk loader assigned to the node.
+   */
+  template<typename BoundType>
+  void HandleBulkLoad(TreeType* /* node */, const BoundType& /* region */)
+  { }
+
   /**
    * Some tree types require to propagate the information upward.
    * This method should return false if this is not the case. If true is
@@ -0,0 +1,57 @@
+/**
+ * @file core/util/conv_to.hpp
+ *
+ * A wrapper around arma::conv_to that does nothing when the element type is
+ * already the right one.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_CONV_TO_HPP
+#define MLPACK_CORE_UTIL_CONV_TO_HPP
+
+#include <mlpack/prereqs.hpp>
+
+namespace mlpack {
+
+/**
+ * Convert an Armadillo object (for instance a column of a single-precision
+ * dataset) so that it can be used with objects of type OutputType (for
+ * instance double-precision centroids).  If the element types already match,
+ * the object itself is returned and nothing is copied, so this can be used in
+ * inner loops that are also instantiated with the native element type.
+ *
+ * The result may refer to the input, so it should only be used within the
+ * expression that computes it.
+ */
+template<typename OutputType>
+struct ConvTo
+{
+  //! The element types match: return the input itself.
+  template<typename InputType>
+  static const InputType& From(
+      const InputType& input,
+      const typename std::enable_if<std::is_same<
+          typename InputType::elem_type,
+          typename OutputType::elem_type>::value>::type* = 0)
+  {
+    return input;
+  }
+
+  //! The element types differ: convert the input.
+  template<typename InputType>
+  static OutputType From(
+      const InputType& input,
+      const typename std::enable_if<!std::is_same<
+          typename InputType::elem_type,
+          typename OutputType::elem_type>::value>::type* = 0)
+  {
+    return arma::conv_to<OutputType>::from(input);
+  }
+};
+
+} // namespace mlpack
+
+#endif
@@ -17,6 +17,9 @@
 using namespace mlpack;
 using namespace mlpack::util;
 
+// Parameters bound to the calling thread with BindParams(), if any.
+static thread_local Params* boundParams = NULL;
+
 // Fake ProgramDoc in case none is supplied.
 static ProgramDoc emptyProgramDoc = ProgramDoc("", "", []() { return ""; },
      []() { return ""; }, {});
@@ -56,9 +59,8 @@ void IO::Add(ParamData&& data)
   #undef BASH_CLEAR
 
   // Define identifier and alias maps.
-  std::map<std::string, util::ParamData>& parameters =
-      GetSingleton().parameters;
-  std::map<char, std::string>& aliases = GetSingleton().aliases;
+  std::map<std::string, util::ParamData>& parameters = Parameters();
+  std::map<char, std::string>& aliases = Aliases();
 
   // If found in current map, print fatal error and terminate the program, but
   // only if the parameter is not consistent.
@@ -76,9 +78,9 @@ void IO::Add(ParamData&& data)
 
   // Add the alias, if necessary.
   if (data.alias != '\0')
-    GetSingleton().aliases[data.alias] = data.name;
+    aliases[data.alias] = data.name;
 
-  GetSingleton().parameters[data.name] = std::move(data);
+  parameters[data.name] = std::move(data);
 }
 
 /**
@@ -88,26 +90,7 @@ void IO::Add(ParamData&& data)
  */
 bool IO::HasParam(const std::string& key)
 {
-  std::string usedKey = key;
-  const std::map<std::string, util::ParamData>& parameters =
-      GetSingleton().parameters;
-
-  if (!parameters.count(key))
-  {
-    // Check any aliases, but only after we are sure the actual option as given
-    // does not exist.
-    if (key.length() == 1 && GetSingleton().aliases.count(key[0]))
-      usedKey = GetSingleton().aliases[key[0]];
-
-    if (!parameters.count(usedKey))
-    {
-      Log::Fatal << "Parameter '--" << key << "' does not exist in this "
-          << "program." << std::endl;
-    }
-  }
-  const std::string& checkKey = usedKey;
-
-  return (parameters.at(checkKey).wasPassed > 0);
+  return CurrentParams().Has(key);
 }
 
 /**
@@ -122,29 +105,7 @@ bool IO::HasParam(const std::string& key)
 void IO::MakeInPlaceCopy(const std::string& outputParamName,
                          const std::string& inputParamName)
 {
-  std::map<std::string, util::ParamData>& parameters =
-      GetSingleton().parameters;
-
-  if (!parameters.count(outputParamName))
-    Log::Fatal << "Unknown parameter '" << outputParamName << "'!" << std::endl;
-  if (!parameters.count(inputParamName))
-    Log::Fatal << "Unknown parameter '" << inputParamName << "'!" << std::endl;
-
-  util::ParamData& output = parameters[outputParamName];
-  util::ParamData& input = parameters[inputParamName];
-
-  if (output.cppType != input.cppType)
-  {
-    Log::Fatal << "Cannot call MakeInPlaceCopy() with different types ("
-        << output.cppType << " and " << input.cppType << ")!" << std::endl;
-  }
-
-  // Is there a function to do this?
-  if (IO::GetSingleton().functionMap[output.tname].count("InPlaceCopy") != 0)
-  {
-    IO::GetSingleton().functionMap[output.tname]["InPlaceCopy"](output, (void*)
-        &input, NULL);
-  }
+  CurrentParams().MakeInPlaceCopy(outputParamName, inputParamName);
 }
 
 // Returns the sole instance of this class.
@@ -171,13 +132,19 @@ void IO::RegisterProgramDoc(ProgramDoc* doc)
 // Get the parameters that the IO object knows about.
 std::map<std::string, ParamData>& IO::Parameters()
 {
-  return GetSingleton().parameters;
+  return CurrentParams().Parameters();
 }
 
-// Get the parameters that the IO object knows about.
+// Get the aliases that the IO object knows about.
 std::map<char, std::string>& IO::Aliases()
 {
-  return GetSingleton().aliases;
+  return CurrentParams().Aliases();
+}
+
+// Get the type-specific handler functions that the IO object knows about.
+Params::FunctionMapType& IO::FunctionMap()
+{
+  return CurrentParams().FunctionMap();
 }
 
 // Get the program name as set by PROGRAM_INFO().
@@ -189,14 +156,7 @@ std::string IO::ProgramName()
 // Set a particular parameter as passed.
 void IO::SetPassed(const std::string& name)
 {
-  if (GetSingleton().parameters.count(name) == 0)
-  {
-    throw std::invalid_argument("IO::SetPassed(): parameter " + name +
-        " not known!");
-  }
-
-  // Set passed to true.
-  GetSingleton().parameters[name].wasPassed = true;
+  CurrentParams().SetPassed(name);
 }
 
 // Store settings.
@@ -204,9 +164,7 @@ void IO::StoreSettings(const std::string& name)
 {
   // Take all of the parameters and put them in the map.  Clear anything old
   // first.
-  std::get<0>(GetSingleton().storageMap[name]) = GetSingleton().parameters;
-  std::get<1>(GetSingleton().storageMap[name]) = GetSingleton().aliases;
-  std::get<2>(GetSingleton().storageMap[name]) = GetSingleton().functionMap;
+  GetSingleton().storageMap[name] = CurrentParams();
 
   ClearSettings();
 }
@@ -226,9 +184,7 @@ void IO::RestoreSettings(const std::string& name, const bool fatal)
   }
   else
   {
-    GetSingleton().parameters = std::get<0>(GetSingleton().storageMap[name]);
-    GetSingleton().aliases = std::get<1>(GetSingleton().storageMap[name]);
-    GetSingleton().functionMap = std::get<2>(GetSingleton().storageMap[name]);
+    CurrentParams() = GetSingleton().storageMap[name];
   }
 }
 
@@ -245,8 +201,8 @@ void IO::ClearSettings()
   std::vector<std::string> persistentTypes;
 
   std::map<std::string, util::ParamData>::const_iterator it =
-      GetSingleton().parameters.begin();
-  while (it != GetSingleton().parameters.end())
+      Parameters().begin();
+  while (it != Parameters().end())
   {
     // Is the parameter persistent?
     if (it->second.persistent)
@@ -262,9 +218,8 @@ void IO::ClearSettings()
   }
 
   // Now check if there are any persistent aliases.
-  std::map<char, std::string>::const_iterator it2 =
-      GetSingleton().aliases.begin();
-  while (it2 != GetSingleton().aliases.end())
+  std::map<char, std::string>::const_iterator it2 = Aliases().begin();
+  while (it2 != Aliases().end())
   {
     // Is this an alias to a persistent parameter?
     if (persistent.count(it2->second) > 0)
@@ -277,11 +232,35 @@ void IO::ClearSettings()
   {
     // Add to persistent function map.
     persistentFunctions[persistentTypes[i]] =
-        GetSingleton().functionMap[persistentTypes[i]];
+        FunctionMap()[persistentTypes[i]];
   }
 
   // Save only the persistent parameters.
-  GetSingleton().parameters = persistent;
-  GetSingleton().aliases = persistentAliases;
-  GetSingleton().functionMap = persistentFunctions;
+  CurrentParams() = Params(persistentAliases, persistent, persistentFunctions);
+}
+
+// Copy the stored settings into a new, independent set of parameters.
+Params IO::MakeParams(const std::string& name)
+{
+  if (GetSingleton().storageMap.count(name) == 0)
+  {
+    throw std::invalid_argument("no settings stored under the name '" + name
+        + "'");
+  }
+
+  return GetSingleton().storageMap.at(name);
+}
+
+// Get the parameters the static accessors operate on.
+Params& IO::CurrentParams()
+{
+  return (boundParams != NULL) ? *boundParams : GetSingleton().params;
+}
+
+// Bind parameters to the calling thread.
+Params* IO::BindParams(Params* params)
+{
+  Params* previous = boundParams;
+  boundParams = params;
+  return previous;
 }
@@ -27,6 +27,7 @@
 #include "version.hpp"
 
 #include "param_data.hpp"
+#include "params.hpp"
 
 #include <mlpack/core/data/load.hpp>
 #include <mlpack/core/data/save.hpp>
@@ -253,6 +254,8 @@ class IO
   static std::map<std::string, util::ParamData>& Parameters();
   //! Return a modifiable list of aliases that IO knows about.
   static std::map<char, std::string>& Aliases();
+  //! Return a modifiable map of the type-specific handler functions.
+  static util::Params::FunctionMapType& FunctionMap();
 
   //! Get the program name as set by the PROGRAM_INFO() macro.
   static std::string ProgramName();
@@ -290,23 +293,46 @@ class IO
    */
   static void ClearSettings();
 
- private:
-  //! Convenience map from alias values to names.
-  std::map<char, std::string> aliases;
-  //! Map of parameters.
-  std::map<std::string, util::ParamData> parameters;
+  /**
+   * Create an independent copy of the parameters and function mappings stored
+   * under the given name (with StoreSettings()).  The returned object shares no
+   * parameter state with IO or with other copies, so it can be used for one
+   * invocation of a binding without affecting the others; see util::Params for
+   * the process-wide state that invocations still share.  A
+   * std::invalid_argument exception will be thrown if no settings with the
+   * given name have been stored.
+   *
+   * @param name Name of the stored settings.
+   */
+  static util::Params MakeParams(const std::string& name);
+
+  /**
+   * Get the parameters that the static accessors currently operate on: the
+   * ones bound to the calling thread with a ParamsScope, if any, or else the
+   * global parameters of IO.
+   */
+  static util::Params& CurrentParams();
+
+  /**
+   * Bind the given parameters to the calling thread, so that the static
+   * accessors called from this thread operate on them.  Passing NULL restores
+   * the global parameters.  Prefer ParamsScope to calling this directly.
+   *
+   * @param params Parameters to bind, or NULL.
+   * @return The parameters that were bound before (possibly NULL).
+   */
+  static util::Params* BindParams(util::Params* params);
 
- public:
   //! Map for functions and types.
   //! Use as functionMap["typename"]["functionName"].
-  typedef std::map<std::string, std::map<std::string,
-      void (*)(util::ParamData&, const void*, void*)>> FunctionMapType;
-  FunctionMapType functionMap;
+  typedef util::Params::FunctionMapType FunctionMapType;
 
  private:
+  //! Global parameters, used when no parameters are bound to a thread.
+  util::Params params;
+
   //! Storage map for parameters.
-  std::map<std::string, std::tuple<std::map<std::string, util::ParamData>,
-      std::map<char, std::string>, FunctionMapType>> storageMap;
+  std::map<std::string, util::Params> storageMap;
 
  public:
   //! True, if IO was used to parse command line options.
@@ -337,6 +363,40 @@ class IO
   IO& operator=(const IO& other);
 };
 
+/**
+ * While a ParamsScope object is alive, the static IO accessors (IO::GetParam(),
+ * IO::HasParam(), and so forth) called from the thread that created it operate
+ * on the given util::Params object instead of the global parameters.  This is
+ * how a binding runs its mlpackMain() on a per-call set of parameters:
+ *
+ * @code
+ * util::Params params = IO::MakeParams("k-Nearest-Neighbors Search");
+ * params.Get<int>("k") = 5;
+ * params.SetPassed("k");
+ * {
+ *   ParamsScope scope(params);
+ *   mlpackMain();
+ * }
+ * @endcode
+ */
+class ParamsScope
+{
+ public:
+  //! Bind the given parameters to the calling thread.
+  ParamsScope(util::Params& params) : previous(IO::BindParams(&params)) { }
+
+  //! Restore whatever was bound before.
+  ~ParamsScope() { IO::BindParams(previous); }
+
+ private:
+  //! The parameters that were bound before this scope.
+  util::Params* previous;
+
+  //! No copies.
+  ParamsScope(const ParamsScope& other);
+  ParamsScope& operator=(const ParamsScope& other);
+};
+
 } // namespace mlpack
 
 // Include the actual definitions of templated methods
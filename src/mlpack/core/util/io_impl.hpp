@@ -32,36 +32,7 @@ namespace mlpack {
 template<typename T>
 T& IO::GetParam(const std::string& identifier)
 {
-  // Only use the alias if the parameter does not exist as given.
-  std::string key =
-      (GetSingleton().parameters.count(identifier) == 0 &&
-       identifier.length() == 1 && GetSingleton().aliases.count(identifier[0]))
-      ? GetSingleton().aliases[identifier[0]] : identifier;
-
-  if (GetSingleton().parameters.count(key) == 0)
-    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
-        << std::endl;
-
-  util::ParamData& d = GetSingleton().parameters[key];
-
-  // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter --" << key << " as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
-
-  // Do we have a special mapped function?
-  if (IO::GetSingleton().functionMap[d.tname].count("GetParam") != 0)
-  {
-    T* output = NULL;
-    IO::GetSingleton().functionMap[d.tname]["GetParam"](d, NULL,
-        (void*) &output);
-    return *output;
-  }
-  else
-  {
-    return *boost::any_cast<T>(&d.value);
-  }
+  return CurrentParams().Get<T>(identifier);
 }
 
 /**
@@ -74,75 +45,13 @@ T& IO::GetParam(const std::string& identifier)
 template<typename T>
 std::string IO::GetPrintableParam(const std::string& identifier)
 {
-  // Only use the alias if the parameter does not exist as given.
-  std::string key = ((GetSingleton().parameters.count(identifier) == 0) &&
-      (identifier.length() == 1) &&
-      (GetSingleton().aliases.count(identifier[0]) > 0)) ?
-      GetSingleton().aliases[identifier[0]] : identifier;
-
-  if (GetSingleton().parameters.count(key) == 0)
-    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
-        << std::endl;
-
-  util::ParamData& d = GetSingleton().parameters[key];
-
-  // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter --" << key << " as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
-
-  // Do we have a special mapped function?
-  if (IO::GetSingleton().functionMap[d.tname].count("GetPrintableParam") != 0)
-  {
-    std::string output;
-    IO::GetSingleton().functionMap[d.tname]["GetPrintableParam"](d, NULL,
-        (void*) &output);
-    return output;
-  }
-  else
-  {
-    std::ostringstream oss;
-    oss << "no GetPrintableParam function handler registered for type "
-        << d.cppType;
-    throw std::runtime_error(oss.str());
-  }
+  return CurrentParams().GetPrintable<T>(identifier);
 }
 
 template<typename T>
 T& IO::GetRawParam(const std::string& identifier)
 {
-  // Only use the alias if the parameter does not exist as given.
-  std::string key =
-      (GetSingleton().parameters.count(identifier) == 0 &&
-       identifier.length() == 1 && GetSingleton().aliases.count(identifier[0]))
-      ? GetSingleton().aliases[identifier[0]] : identifier;
-
-  if (GetSingleton().parameters.count(key) == 0)
-    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
-        << std::endl;
-
-  util::ParamData& d = GetSingleton().parameters[key];
-
-  // Make sure the types are correct.
-  if (TYPENAME(T) != d.tname)
-    Log::Fatal << "Attempted to access parameter --" << key << " as type "
-        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
-        << std::endl;
-
-  // Do we have a special mapped function?
-  if (IO::GetSingleton().functionMap[d.tname].count("GetRawParam") != 0)
-  {
-    T* output = NULL;
-    IO::GetSingleton().functionMap[d.tname]["GetRawParam"](d, NULL,
-        (void*) &output);
-    return *output;
-  }
-  else
-  {
-    // Use the regular GetParam().
-    return GetParam<T>(identifier);
-  }
+  return CurrentParams().GetRaw<T>(identifier);
 }
 
 } // namespace mlpack
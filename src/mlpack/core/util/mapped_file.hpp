@@ -0,0 +1,146 @@
+/**
+ * @file core/util/mapped_file.hpp
+ *
+ * Read-only memory mapping of files, and the common header of the flat
+ * (pointer-free) model files that are used through such a mapping.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_MAPPED_FILE_HPP
+#define MLPACK_CORE_UTIL_MAPPED_FILE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace mlpack {
+namespace util {
+
+/**
+ * A file mapped read-only into memory.  The pages of the file are shared by
+ * every process that maps it, and are only read from disk when they are first
+ * used.
+ */
+class MappedFile
+{
+ public:
+  /**
+   * Map the given file.  A std::runtime_error is thrown if it cannot be
+   * mapped.
+   *
+   * @param filename Name of the file to map.
+   * @param copyOnWrite If true, the mapping may be modified; modified pages
+   *     are copied, and the file itself is never changed.
+   */
+  MappedFile(const std::string& filename, const bool copyOnWrite = false) :
+      filename(filename)
+  {
+    try
+    {
+      boost::interprocess::file_mapping file(filename.c_str(),
+          boost::interprocess::read_only);
+      boost::interprocess::mapped_region(file, copyOnWrite ?
+          boost::interprocess::copy_on_write : boost::interprocess::read_only)
+          .swap(region);
+    }
+    catch (boost::interprocess::interprocess_exception& e)
+    {
+      Log::Fatal << "Cannot map file '" << filename << "': " << e.what()
+          << std::endl;
+    }
+  }
+
+  //! Get the mapped contents of the file.
+  const char* Data() const { return (const char*) region.get_address(); }
+  //! Modify the mapped contents of the file; only allowed if the file was
+  //! mapped copy-on-write.
+  char* Data() { return (char*) region.get_address(); }
+  //! Get the size of the file in bytes.
+  size_t Size() const { return region.get_size(); }
+  //! Get the name of the mapped file.
+  const std::string& Filename() const { return filename; }
+
+ private:
+  //! The name of the mapped file.
+  std::string filename;
+  //! The mapping itself.
+  boost::interprocess::mapped_region region;
+};
+
+/**
+ * The header at the start of every flat model file.  Each section after it
+ * starts at a multiple of 8 bytes, so that the mapped arrays are aligned.
+ */
+struct FlatFileHeader
+{
+  //! Always "MLPKFLAT".
+  char magic[8];
+  //! Always 0x0102030405060708, to detect files from another architecture.
+  uint64_t byteOrder;
+  //! Version of the layout of the file.
+  uint64_t version;
+  //! Name of the type of model stored in the file.
+  char type[40];
+};
+
+/**
+ * Write the header of a flat model file.
+ *
+ * @param stream Stream to write to.
+ * @param type Name of the type of model that follows.
+ */
+inline void WriteFlatFileHeader(std::ostream& stream, const std::string& type)
+{
+  FlatFileHeader header;
+  memset(&header, 0, sizeof(FlatFileHeader));
+  memcpy(header.magic, "MLPKFLAT", 8);
+  header.byteOrder = 0x0102030405060708ULL;
+  header.version = 1;
+  strncpy(header.type, type.c_str(), sizeof(header.type) - 1);
+
+  stream.write((const char*) &header, sizeof(FlatFileHeader));
+}
+
+/**
+ * Check that a mapped file is a flat model file holding the given type of
+ * model, and return a pointer to the data after the header.  A
+ * std::runtime_error is thrown if the file does not match.
+ *
+ * @param file Mapped file.
+ * @param type Name of the expected type of model.
+ */
+inline const char* CheckFlatFileHeader(const MappedFile& file,
+                                       const std::string& type)
+{
+  const FlatFileHeader* header = (const FlatFileHeader*) file.Data();
+  if (file.Size() < sizeof(FlatFileHeader) ||
+      memcmp(header->magic, "MLPKFLAT", 8) != 0)
+  {
+    Log::Fatal << "'" << file.Filename() << "' is not a flat model file!"
+        << std::endl;
+  }
+
+  if (header->byteOrder != 0x0102030405060708ULL || header->version != 1)
+  {
+    Log::Fatal << "'" << file.Filename() << "' was written on another "
+        << "architecture or by another version of mlpack!" << std::endl;
+  }
+
+  const std::string fileType(header->type,
+      strnlen(header->type, sizeof(header->type)));
+  if (fileType != type)
+  {
+    Log::Fatal << "'" << file.Filename() << "' holds a " << fileType
+        << ", not a " << type << "!" << std::endl;
+  }
+
+  return file.Data() + sizeof(FlatFileHeader);
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
@@ -67,6 +67,11 @@ struct ParamData
   //! True if this is a matrix that should not be transposed.  Ignored if the
   //! parameter is not a matrix.
   bool noTranspose;
+  //! True if this is a matrix that the caller gave with one point per column,
+  //! so that it was not transposed when it was set.  Bindings use this to hand
+  //! back their outputs in the same layout.  Ignored if the parameter is not a
+  //! matrix.
+  bool colMajor;
   //! True if this option is required.
   bool required;
   //! True if this option is an input option (otherwise, it is output).
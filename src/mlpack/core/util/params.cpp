@@ -0,0 +1,84 @@
+/**
+ * @file core/util/params.cpp
+ *
+ * Implementation of the Params class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "params.hpp"
+#include "log.hpp"
+
+using namespace mlpack;
+using namespace mlpack::util;
+
+Params::Params(const std::map<char, std::string>& aliases,
+               const std::map<std::string, ParamData>& parameters,
+               const FunctionMapType& functionMap) :
+    aliases(aliases),
+    parameters(parameters),
+    functionMap(functionMap)
+{
+  // Nothing to do.
+}
+
+// Only use the alias if the parameter does not exist as given.
+std::string Params::Key(const std::string& identifier) const
+{
+  if (parameters.count(identifier) == 0 && identifier.length() == 1 &&
+      aliases.count(identifier[0]) > 0)
+    return aliases.at(identifier[0]);
+
+  return identifier;
+}
+
+bool Params::Has(const std::string& identifier) const
+{
+  const std::string key = Key(identifier);
+
+  if (parameters.count(key) == 0)
+  {
+    Log::Fatal << "Parameter '--" << identifier << "' does not exist in this "
+        << "program." << std::endl;
+  }
+
+  return (parameters.at(key).wasPassed > 0);
+}
+
+void Params::MakeInPlaceCopy(const std::string& outputParamName,
+                             const std::string& inputParamName)
+{
+  if (!parameters.count(outputParamName))
+    Log::Fatal << "Unknown parameter '" << outputParamName << "'!" << std::endl;
+  if (!parameters.count(inputParamName))
+    Log::Fatal << "Unknown parameter '" << inputParamName << "'!" << std::endl;
+
+  ParamData& output = parameters[outputParamName];
+  ParamData& input = parameters[inputParamName];
+
+  if (output.cppType != input.cppType)
+  {
+    Log::Fatal << "Cannot call MakeInPlaceCopy() with different types ("
+        << output.cppType << " and " << input.cppType << ")!" << std::endl;
+  }
+
+  // Is there a function to do this?
+  if (functionMap[output.tname].count("InPlaceCopy") != 0)
+  {
+    functionMap[output.tname]["InPlaceCopy"](output, (void*) &input, NULL);
+  }
+}
+
+void Params::SetPassed(const std::string& identifier)
+{
+  if (parameters.count(identifier) == 0)
+  {
+    throw std::invalid_argument("Params::SetPassed(): parameter " +
+        identifier + " not known!");
+  }
+
+  // Set passed to true.
+  parameters[identifier].wasPassed = true;
+}
@@ -0,0 +1,145 @@
+/**
+ * @file core/util/params.hpp
+ *
+ * Definition of the Params class, which holds the parameters (and their
+ * values) for a single invocation of an mlpack binding.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARAMS_HPP
+#define MLPACK_CORE_UTIL_PARAMS_HPP
+
+#include <map>
+#include <string>
+
+#include <mlpack/prereqs.hpp>
+
+#include "param_data.hpp"
+
+namespace mlpack {
+namespace util {
+
+/**
+ * The Params class holds the set of parameters a binding knows about, together
+ * with the values given for them and the type-specific handler functions used
+ * to access those values.  IO keeps one Params object for the parameters that
+ * are being registered or parsed, and hands out independent copies of the
+ * stored settings of a binding via IO::MakeParams().  The copies share no
+ * state, so separate invocations of a binding do not see each other's
+ * parameters.
+ *
+ * Only the parameters are isolated, though.  The log streams (and the verbose
+ * flag of Log::Info), the timers and the random number generator are still
+ * shared by the whole process, so concurrent invocations interleave their
+ * output and their timings, and draw from (and reseed) the same random number
+ * generator, which is not thread-safe.  Invocations that must run concurrently
+ * and reproducibly should run in separate processes.
+ *
+ * Code that uses the static IO accessors (IO::GetParam(), IO::HasParam(), and
+ * so forth) can be pointed at a given Params object with a ParamsScope.
+ */
+class Params
+{
+ public:
+  //! Map for functions and types.
+  //! Use as functionMap["typename"]["functionName"].
+  typedef std::map<std::string, std::map<std::string,
+      void (*)(ParamData&, const void*, void*)>> FunctionMapType;
+
+  /**
+   * Create an empty set of parameters.
+   */
+  Params() { }
+
+  /**
+   * Create a set of parameters with the given aliases, parameters and
+   * function mappings.
+   *
+   * @param aliases Map from aliases to parameter names.
+   * @param parameters Map from parameter names to parameter data.
+   * @param functionMap Map of type-specific handler functions.
+   */
+  Params(const std::map<char, std::string>& aliases,
+         const std::map<std::string, ParamData>& parameters,
+         const FunctionMapType& functionMap);
+
+  /**
+   * See if the specified parameter was passed.
+   *
+   * @param identifier The name of the parameter in question.
+   */
+  bool Has(const std::string& identifier) const;
+
+  /**
+   * Get the value of type T of the given parameter.  You can set the value
+   * using this reference safely.
+   *
+   * @param identifier The name of the parameter in question.
+   */
+  template<typename T>
+  T& Get(const std::string& identifier);
+
+  /**
+   * Cast the given parameter of the given type to a short, printable
+   * std::string, for use in status messages.
+   *
+   * @param identifier The name of the parameter in question.
+   */
+  template<typename T>
+  std::string GetPrintable(const std::string& identifier);
+
+  /**
+   * Get the raw value of the parameter before any processing that Get() might
+   * normally do.
+   *
+   * @param identifier The name of the parameter in question.
+   */
+  template<typename T>
+  T& GetRaw(const std::string& identifier);
+
+  /**
+   * Given two (matrix) parameters, ensure that the first is an in-place copy
+   * of the second.
+   *
+   * @param outputParamName Name of output (matrix) parameter.
+   * @param inputParamName Name of input (matrix) parameter.
+   */
+  void MakeInPlaceCopy(const std::string& outputParamName,
+                       const std::string& inputParamName);
+
+  /**
+   * Mark a particular parameter as passed.
+   *
+   * @param identifier Name of the parameter.
+   */
+  void SetPassed(const std::string& identifier);
+
+  //! Modify the map of parameters.
+  std::map<std::string, ParamData>& Parameters() { return parameters; }
+  //! Modify the map of aliases.
+  std::map<char, std::string>& Aliases() { return aliases; }
+  //! Modify the map of type-specific handler functions.
+  FunctionMapType& FunctionMap() { return functionMap; }
+
+ private:
+  //! Convenience map from alias values to names.
+  std::map<char, std::string> aliases;
+  //! Map of parameters.
+  std::map<std::string, ParamData> parameters;
+  //! Map for functions and types.
+  FunctionMapType functionMap;
+
+  //! Resolve an identifier that may be an alias to the parameter name.
+  std::string Key(const std::string& identifier) const;
+};
+
+} // namespace util
+} // namespace mlpack
+
+// Include implementation.
+#include "params_impl.hpp"
+
+#endif
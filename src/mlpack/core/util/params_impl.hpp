@@ -0,0 +1,118 @@
+/**
+ * @file core/util/params_impl.hpp
+ *
+ * Implementation of templated functions of the Params class.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_PARAMS_IMPL_HPP
+#define MLPACK_CORE_UTIL_PARAMS_IMPL_HPP
+
+// In case it has not already been included.
+#include "params.hpp"
+#include "log.hpp"
+
+namespace mlpack {
+namespace util {
+
+template<typename T>
+T& Params::Get(const std::string& identifier)
+{
+  const std::string key = Key(identifier);
+
+  if (parameters.count(key) == 0)
+    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
+        << std::endl;
+
+  ParamData& d = parameters[key];
+
+  // Make sure the types are correct.
+  if (TYPENAME(T) != d.tname)
+    Log::Fatal << "Attempted to access parameter --" << key << " as type "
+        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
+        << std::endl;
+
+  // Do we have a special mapped function?
+  if (functionMap[d.tname].count("GetParam") != 0)
+  {
+    T* output = NULL;
+    functionMap[d.tname]["GetParam"](d, NULL, (void*) &output);
+    return *output;
+  }
+  else
+  {
+    return *boost::any_cast<T>(&d.value);
+  }
+}
+
+template<typename T>
+std::string Params::GetPrintable(const std::string& identifier)
+{
+  const std::string key = Key(identifier);
+
+  if (parameters.count(key) == 0)
+    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
+        << std::endl;
+
+  ParamData& d = parameters[key];
+
+  // Make sure the types are correct.
+  if (TYPENAME(T) != d.tname)
+    Log::Fatal << "Attempted to access parameter --" << key << " as type "
+        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
+        << std::endl;
+
+  // Do we have a special mapped function?
+  if (functionMap[d.tname].count("GetPrintableParam") != 0)
+  {
+    std::string output;
+    functionMap[d.tname]["GetPrintableParam"](d, NULL, (void*) &output);
+    return output;
+  }
+  else
+  {
+    std::ostringstream oss;
+    oss << "no GetPrintableParam function handler registered for type "
+        << d.cppType;
+    throw std::runtime_error(oss.str());
+  }
+}
+
+template<typename T>
+T& Params::GetRaw(const std::string& identifier)
+{
+  const std::string key = Key(identifier);
+
+  if (parameters.count(key) == 0)
+    Log::Fatal << "Parameter --" << key << " does not exist in this program!"
+        << std::endl;
+
+  ParamData& d = parameters[key];
+
+  // Make sure the types are correct.
+  if (TYPENAME(T) != d.tname)
+    Log::Fatal << "Attempted to access parameter --" << key << " as type "
+        << TYPENAME(T) << ", but its true type is " << d.tname << "!"
+        << std::endl;
+
+  // Do we have a special mapped function?
+  if (functionMap[d.tname].count("GetRawParam") != 0)
+  {
+    T* output = NULL;
+    functionMap[d.tname]["GetRawParam"](d, NULL, (void*) &output);
+    return *output;
+  }
+  else
+  {
+    // Use the regular Get().
+    return Get<T>(identifier);
+  }
+}
+
+} // namespace util
+} // namespace mlpack
+
+#endif
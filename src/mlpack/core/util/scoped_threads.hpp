@@ -0,0 +1,67 @@
+/**
+ * @file core/util/scoped_threads.hpp
+ *
+ * Limit the number of threads of the OpenMP parallel regions that are opened
+ * without a num_threads clause, such as those that build trees.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_CORE_UTIL_SCOPED_THREADS_HPP
+#define MLPACK_CORE_UTIL_SCOPED_THREADS_HPP
+
+namespace mlpack {
+namespace util {
+
+/**
+ * While an object of this class exists, parallel regions opened by the calling
+ * thread without a num_threads clause use the given number of threads; the
+ * previous number is restored when it is destroyed.  A count of 0 leaves the
+ * number of threads as it is.
+ *
+ * @code
+ * {
+ *   util::ScopedThreads scope(knn.NumThreads());
+ *   KDTree<> tree(dataset); // Built with at most knn.NumThreads() threads.
+ * }
+ * @endcode
+ */
+class ScopedThreads
+{
+ public:
+  //! Use the given number of threads until this object is destroyed.
+  explicit ScopedThreads(const size_t numThreads)
+  {
+#ifdef _OPENMP
+    oldThreads = omp_get_max_threads();
+    if (numThreads > 0)
+      omp_set_num_threads((int) numThreads);
+#else
+    (void) numThreads;
+#endif
+  }
+
+  //! Restore the number of threads.
+  ~ScopedThreads()
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(oldThreads);
+#endif
+  }
+
+  ScopedThreads(const ScopedThreads&) = delete;
+  ScopedThreads& operator=(const ScopedThreads&) = delete;
+
+ private:
+#ifdef _OPENMP
+  //! The number of threads to restore.
+  int oldThreads;
+#endif
+};
+
+} // namespace util
+} // namespace mlpack
+
+#endif
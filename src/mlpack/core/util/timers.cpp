@@ -22,12 +22,73 @@ using namespace mlpack;
 using namespace std;
 using namespace chrono;
 
+// The timings of one thread.  Only the thread itself writes them, except for
+// StopAllTimers(); everything is atomic so that they can be read at any time.
+struct Timers::ThreadTimers
+{
+  ThreadTimers(Timers& owner) : owner(owner), threadId(this_thread::get_id())
+  {
+    for (size_t i = 0; i < MaxTimers; ++i)
+    {
+      total[i] = 0;
+      start[i] = 0;
+      running[i] = 0;
+      used[i] = 0;
+    }
+
+    lock_guard<mutex> lock(owner.timersMutex);
+    owner.threads.push_back(this);
+  }
+
+  ~ThreadTimers() { owner.Retire(*this); }
+
+  //! The Timers object these timings belong to.
+  Timers& owner;
+  //! The thread these timings belong to.
+  thread::id threadId;
+  //! The total time of each timer, in nanoseconds.
+  atomic<int64_t> total[MaxTimers];
+  //! The time each running timer was started at, in nanoseconds.
+  atomic<int64_t> start[MaxTimers];
+  //! The epoch each timer was started in, or 0 if it is not running.
+  atomic<uint64_t> running[MaxTimers];
+  //! The last epoch each timer was started in; total is only valid in it.
+  atomic<uint64_t> used[MaxTimers];
+  //! Identifiers of the names this thread has already looked up.
+  map<string, TimerID> cache;
+};
+
+// Get the current time in nanoseconds.
+static int64_t TimerNow()
+{
+  return duration_cast<nanoseconds>(
+      steady_clock::now().time_since_epoch()).count();
+}
+
+const size_t Timers::MaxTimers;
+
+/**
+ * Get the identifier of the given timer.
+ */
+TimerID Timer::ID(const string& name)
+{
+  return IO::GetSingleton().timer.Intern(name);
+}
+
 /**
  * Start the given timer.
  */
 void Timer::Start(const string& name)
 {
-  IO::GetSingleton().timer.StartTimer(name, this_thread::get_id());
+  IO::GetSingleton().timer.StartTimer(name);
+}
+
+/**
+ * Start the timer with the given identifier.
+ */
+void Timer::Start(const TimerID id)
+{
+  IO::GetSingleton().timer.StartTimer(id);
 }
 
 /**
@@ -35,7 +96,15 @@ void Timer::Start(const string& name)
  */
 void Timer::Stop(const string& name)
 {
-  IO::GetSingleton().timer.StopTimer(name, this_thread::get_id());
+  IO::GetSingleton().timer.StopTimer(name);
+}
+
+/**
+ * Stop the timer with the given identifier.
+ */
+void Timer::Stop(const TimerID id)
+{
+  IO::GetSingleton().timer.StopTimer(id);
 }
 
 /**
@@ -64,19 +133,112 @@ void Timer::ResetAll()
   IO::GetSingleton().timer.Reset();
 }
 
-// Reset a Timers object.
+Timers::Timers() : epoch(1), enabled(false)
+{
+  for (size_t i = 0; i < MaxTimers; ++i)
+  {
+    retired[i] = 0;
+    retiredEpoch[i] = 0;
+  }
+}
+
+Timers::ThreadTimers& Timers::Local()
+{
+  thread_local ThreadTimers local(*this);
+  return local;
+}
+
+void Timers::Retire(ThreadTimers& local)
+{
+  // A timer that is still running is stopped when its thread exits.
+  const int64_t currTime = TimerNow();
+
+  lock_guard<mutex> lock(timersMutex);
+  const uint64_t currentEpoch = epoch;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    if (local.used[i] != currentEpoch)
+      continue;
+
+    if (retiredEpoch[i] != currentEpoch)
+    {
+      retired[i] = 0;
+      retiredEpoch[i] = currentEpoch;
+    }
+
+    retired[i] += local.total[i];
+    if (local.running[i] == currentEpoch)
+      retired[i] += currTime - local.start[i];
+  }
+
+  threads.remove(&local);
+}
+
+TimerID Timers::Intern(const string& timerName)
+{
+  ThreadTimers& local = Local();
+  map<string, TimerID>::const_iterator it = local.cache.find(timerName);
+  if (it != local.cache.end())
+    return it->second;
+
+  lock_guard<mutex> lock(timersMutex);
+  if (ids.count(timerName) == 0)
+  {
+    if (names.size() == MaxTimers)
+    {
+      ostringstream error;
+      error << "Timer::ID(): cannot create timer '" << timerName << "'; "
+          << "there are already " << MaxTimers << " timers";
+      throw runtime_error(error.str());
+    }
+
+    ids[timerName] = names.size();
+    names.push_back(timerName);
+  }
+
+  const TimerID id = ids[timerName];
+  local.cache[timerName] = id;
+  return id;
+}
+
+string Timers::Name(const TimerID id)
+{
+  lock_guard<mutex> lock(timersMutex);
+  return (id < names.size()) ? names[id] : string("(unknown)");
+}
+
+// Reset a Timers object.  Timings from before the new epoch are ignored from
+// now on, so the per-thread timings don't need to be touched.
 void Timers::Reset()
 {
   lock_guard<mutex> lock(timersMutex);
-  timers.clear();
-  timerStartTime.clear();
+  ++epoch;
 }
 
 map<string, microseconds> Timers::GetAllTimers()
 {
-  // Make a copy of the timer.
+  map<string, microseconds> result;
+
   lock_guard<mutex> lock(timersMutex);
-  return timers;
+  const uint64_t currentEpoch = epoch;
+  for (size_t i = 0; i < names.size(); ++i)
+  {
+    bool used = (retiredEpoch[i] == currentEpoch);
+    int64_t total = used ? retired[i] : 0;
+    for (ThreadTimers* local : threads)
+    {
+      if (local->used[i] == currentEpoch)
+      {
+        used = true;
+        total += local->total[i];
+      }
+    }
+
+    if (used)
+      result[names[i]] = duration_cast<microseconds>(nanoseconds(total));
+  }
+
+  return result;
 }
 
 microseconds Timers::GetTimer(const string& timerName)
@@ -85,16 +247,32 @@ microseconds Timers::GetTimer(const string& timerName)
     return microseconds(0);
 
   lock_guard<mutex> lock(timersMutex);
-  return timers[timerName];
+  if (ids.count(timerName) == 0)
+    return microseconds(0);
+
+  const TimerID id = ids[timerName];
+  const uint64_t currentEpoch = epoch;
+  int64_t total = (retiredEpoch[id] == currentEpoch) ? retired[id] : 0;
+  for (ThreadTimers* local : threads)
+    if (local->used[id] == currentEpoch)
+      total += local->total[id];
+
+  return duration_cast<microseconds>(nanoseconds(total));
 }
 
 bool Timers::GetState(const string& timerName,
                       const thread::id& threadId)
 {
   lock_guard<mutex> lock(timersMutex);
-  if (timerStartTime.count(threadId) == 0)
-    return 0;
-  return (timerStartTime[threadId].count(timerName) > 0);
+  if (ids.count(timerName) == 0)
+    return false;
+
+  const TimerID id = ids[timerName];
+  for (ThreadTimers* local : threads)
+    if (local->threadId == threadId)
+      return (local->running[id] == epoch.load());
+
+  return false;
 }
 
 void Timers::PrintTimer(const string& timerName)
@@ -159,74 +337,95 @@ void Timers::PrintTimer(const string& timerName)
 
 void Timers::StopAllTimers()
 {
-  // Terminate the program timers.  Don't use StopTimer() since that modifies
-  // the map and would invalidate our iterators.
   lock_guard<mutex> lock(timersMutex);
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-  for (auto it : timerStartTime)
-    for (auto it2 : it.second)
-      timers[it2.first] += duration_cast<microseconds>(currTime - it2.second);
-
-  // If all timers are stopped, we can clear the maps.
-  timerStartTime.clear();
+  const int64_t currTime = TimerNow();
+  for (ThreadTimers* local : threads)
+  {
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+      // The thread may be stopping the timer itself at the same time; only one
+      // of us will count the time.
+      uint64_t currentEpoch = epoch;
+      if (local->running[i].compare_exchange_strong(currentEpoch, 0))
+        local->total[i] += currTime - local->start[i];
+    }
+  }
 }
 
-void Timers::StartTimer(const string& timerName,
-                        const thread::id& threadId)
+void Timers::StartTimer(const string& timerName)
 {
   // Don't do anything if we aren't timing.
   if (!enabled)
     return;
 
-  lock_guard<mutex> lock(timersMutex);
+  StartTimer(Intern(timerName));
+}
+
+void Timers::StartTimer(const TimerID id)
+{
+  // Don't do anything if we aren't timing.
+  if (!enabled)
+    return;
 
-  if ((timerStartTime.count(threadId) > 0) &&
-      (timerStartTime[threadId].count(timerName)))
+  ThreadTimers& local = Local();
+  const uint64_t currentEpoch = epoch.load(memory_order_acquire);
+  if (local.running[id].load(memory_order_relaxed) == currentEpoch)
   {
     ostringstream error;
-    error << "Timer::Start(): timer '" << timerName
+    error << "Timer::Start(): timer '" << Name(id)
         << "' has already been started";
     throw runtime_error(error.str());
   }
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-
-  // If the timer is added for the first time.
-  if (timers.count(timerName) == 0)
+  // If the timer is used for the first time since the last reset, its old
+  // total no longer counts.
+  if (local.used[id].load(memory_order_relaxed) != currentEpoch)
   {
-    timers[timerName] = (microseconds) 0;
+    local.total[id].store(0, memory_order_relaxed);
+    local.used[id].store(currentEpoch, memory_order_release);
   }
 
-  timerStartTime[threadId][timerName] = currTime;
+  local.start[id].store(TimerNow(), memory_order_relaxed);
+  local.running[id].store(currentEpoch, memory_order_release);
 }
 
-void Timers::StopTimer(const string& timerName,
-                       const thread::id& threadId)
+void Timers::StopTimer(const string& timerName)
 {
   // Don't do anything if we aren't timing.
   if (!enabled)
     return;
 
-  lock_guard<mutex> lock(timersMutex);
+  StopTimer(Intern(timerName));
+}
+
+void Timers::StopTimer(const TimerID id)
+{
+  // Don't do anything if we aren't timing.
+  if (!enabled)
+    return;
 
-  if ((timerStartTime.count(threadId) == 0) ||
-      (timerStartTime[threadId].count(timerName) == 0))
+  const int64_t currTime = TimerNow();
+
+  ThreadTimers& local = Local();
+  const uint64_t currentEpoch = epoch.load(memory_order_acquire);
+  const uint64_t startEpoch = local.running[id].exchange(0,
+      memory_order_acq_rel);
+
+  // A timer started before the last Reset() was stopped by it, so there is
+  // nothing left to stop.
+  if (startEpoch != 0 && startEpoch != currentEpoch)
+    return;
+
+  if (startEpoch != currentEpoch)
   {
     ostringstream error;
-    error << "Timer::Stop(): no timer with name '" << timerName
+    error << "Timer::Stop(): no timer with name '" << Name(id)
         << "' currently running";
     throw runtime_error(error.str());
   }
 
-  high_resolution_clock::time_point currTime = high_resolution_clock::now();
-
   // Calculate the delta time.
-  timers[timerName] += duration_cast<microseconds>(currTime -
-      timerStartTime[threadId][timerName]);
-
-  // Remove the entries.
-  timerStartTime[threadId].erase(timerName);
-  if (timerStartTime[threadId].empty())
-    timerStartTime.erase(threadId);
+  local.total[id].fetch_add(currTime - local.start[id].load(
+      memory_order_relaxed), memory_order_relaxed);
 }
@@ -16,11 +16,13 @@
 
 #include <map>
 #include <string>
+#include <vector>
 #include <chrono> // chrono library for cross platform timer calculation.
 #include <thread> // std::thread is used for thread safety.
 #include <mutex>
 #include <list>
 #include <atomic>
+#include <cstdint>
 
 #if defined(_WIN32)
   // uint64_t isn't defined on every windows.
@@ -35,16 +37,38 @@
 
 namespace mlpack {
 
+//! The identifier of an interned timer name; see Timer::ID().
+typedef size_t TimerID;
+
 /**
  * The timer class provides a way for mlpack methods to be timed.  The three
  * methods contained in this class allow a named timer to be started and
  * stopped, and its value to be obtained.  A named timer is specific to the
  * thread it is running on, so if you start a timer in one thread, it cannot be
  * stopped from a different thread.
+ *
+ * Starting and stopping a timer takes no lock.  Code that starts and stops the
+ * same timer very often (for instance inside an OpenMP loop) can avoid looking
+ * up its name each time by interning the name once with Timer::ID():
+ *
+ * @code
+ * static const TimerID computingNeighbors = Timer::ID("computing_neighbors");
+ * Timer::Start(computingNeighbors);
+ * ...
+ * Timer::Stop(computingNeighbors);
+ * @endcode
  */
 class Timer
 {
  public:
+  /**
+   * Get the identifier of the timer with the given name.  The identifier stays
+   * valid for the lifetime of the program, even if the timers are reset.
+   *
+   * @param name Name of the timer.
+   */
+  static TimerID ID(const std::string& name);
+
   /**
    * Start the given timer.  If a timer is started, then stopped, then
    * re-started, then re-stopped, the final value of the timer is the length of
@@ -59,15 +83,36 @@ class Timer
   static void Start(const std::string& name);
 
   /**
-   * Stop the given timer.
+   * Start the timer with the given identifier.
    *
    * @note A std::runtime_error exception will be thrown if a timer is started
    * twice.
    *
+   * @param id Identifier of the timer to be started, from Timer::ID().
+   */
+  static void Start(const TimerID id);
+
+  /**
+   * Stop the given timer.  Stopping a timer that was started before the last
+   * reset does nothing, since the reset already stopped it.
+   *
+   * @note A std::runtime_error exception will be thrown if the timer is not
+   * running.
+   *
    * @param name Name of timer to be stopped.
    */
   static void Stop(const std::string& name);
 
+  /**
+   * Stop the timer with the given identifier.
+   *
+   * @note A std::runtime_error exception will be thrown if the timer is not
+   * running.
+   *
+   * @param id Identifier of the timer to be stopped, from Timer::ID().
+   */
+  static void Stop(const TimerID id);
+
   /**
    * Get the value of the given timer.
    *
@@ -94,11 +139,30 @@ class Timer
   static void ResetAll();
 };
 
+/**
+ * The storage behind Timer.  Each thread accumulates its own timings, without
+ * taking a lock, and the timings of all threads are summed when they are
+ * read.  The timings of a thread that exits are kept.  There is one Timers
+ * object, held by IO; the per-thread storage is not shared between several
+ * Timers objects.
+ */
 class Timers
 {
  public:
+  //! The maximum number of distinct timer names.
+  static const size_t MaxTimers = 256;
+
   //! Default to disabled.
-  Timers() : enabled(false) { }
+  Timers();
+
+  /**
+   * Get the identifier of the timer with the given name, interning the name if
+   * it has not been seen yet.  A std::runtime_error is thrown if there are
+   * more than MaxTimers distinct names.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  TimerID Intern(const std::string& timerName);
 
   /**
    * Returns a copy of all the timers used via this interface.
@@ -128,25 +192,36 @@ class Timers
   void PrintTimer(const std::string& timerName);
 
   /**
-   * Initializes a timer, available like a normal value specified on
-   * the command line.  Timers are of type timeval.  If a timer is started, then
-   * stopped, then re-started, then stopped, the final timer value will be the
-   * length of both runs of the timer.
-   *
-   * @param timerName The name of the timer in question.
-   * @param threadId Id of the thread accessing the timer.
-   */
-  void StartTimer(const std::string& timerName,
-                  const std::thread::id& threadId = std::thread::id());
+   * Initializes a timer on the calling thread, available like a normal value
+   * specified on the command line.  If a timer is started, then stopped, then
+   * re-started, then stopped, the final timer value will be the length of both
+   * runs of the timer.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void StartTimer(const std::string& timerName);
 
   /**
-   * Halts the timer, and replaces its value with the delta time from its start.
-   *
-   * @param timerName The name of the timer in question.
-   * @param threadId Id of the thread accessing the timer.
-   */
-  void StopTimer(const std::string& timerName,
-                 const std::thread::id& threadId = std::thread::id());
+   * Initializes the timer with the given identifier on the calling thread.
+   *
+   * @param id Identifier of the timer in question, from Intern().
+   */
+  void StartTimer(const TimerID id);
+
+  /**
+   * Halts the timer on the calling thread, and adds the time since it was
+   * started to its value.
+   *
+   * @param timerName The name of the timer in question.
+   */
+  void StopTimer(const std::string& timerName);
+
+  /**
+   * Halts the timer with the given identifier on the calling thread.
+   *
+   * @param id Identifier of the timer in question, from Intern().
+   */
+  void StopTimer(const TimerID id);
 
   /**
    * Returns state of the given timer.
@@ -155,7 +230,7 @@ class Timers
    * @param threadId Id of the thread accessing the timer.
    */
   bool GetState(const std::string& timerName,
-                const std::thread::id& threadId = std::thread::id());
+                const std::thread::id& threadId = std::this_thread::get_id());
 
   /**
    * Stop all timers.
@@ -168,14 +243,33 @@ class Timers
   bool Enabled() const { return enabled; }
 
  private:
-  //! A map of all the timers that are being tracked.
-  std::map<std::string, std::chrono::microseconds> timers;
-  //! A mutex for modifying the timers.
+  //! The timings of one thread.
+  struct ThreadTimers;
+
+  //! Get the timings of the calling thread, creating them on first use.
+  ThreadTimers& Local();
+
+  //! Fold the timings of an exiting thread into the retired timings.
+  void Retire(ThreadTimers& local);
+
+  //! Get the name of the timer with the given identifier.
+  std::string Name(const TimerID id);
+
+  //! A mutex for interning names and for reading and retiring timings.
   std::mutex timersMutex;
-  //! A map for the starting values of the timers.
-  std::map<std::thread::id, std::map<std::string,
-      std::chrono::high_resolution_clock::time_point>> timerStartTime;
+  //! The interned names, indexed by identifier.
+  std::vector<std::string> names;
+  //! The identifier of each interned name.
+  std::map<std::string, TimerID> ids;
+  //! The timings of the running threads.
+  std::list<ThreadTimers*> threads;
+  //! The summed timings of the threads that have exited, in nanoseconds.
+  int64_t retired[MaxTimers];
+  //! The epoch of each retired timing; it is only valid in the current epoch.
+  uint64_t retiredEpoch[MaxTimers];
 
+  //! The current epoch; Reset() starts a new one, discarding all timings.
+  std::atomic<uint64_t> epoch;
   //! Whether or not timing is enabled.
   std::atomic<bool> enabled;
 };
@@ -181,12 +181,15 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
     const MatType& data,
     emst::UnionFind& uf)
 {
-  // For each point, find the points in epsilon-nighborhood and their distances.
-  std::vector<std::vector<size_t>> neighbors;
-  std::vector<std::vector<double>> distances;
+  // For each point, find the points in epsilon-neighborhood and their
+  // distances.  The tree was already built on the data by Cluster(), and the
+  // results are held in compressed sparse row form: the neighbors of point i
+  // are neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1].
+  arma::Col<size_t> offsets;
+  arma::Col<size_t> neighbors;
+  arma::vec distances;
   Log::Info << "Performing range search." << std::endl;
-  rangeSearch.Train(data);
-  rangeSearch.Search(data, math::Range(0.0, epsilon), neighbors, distances);
+  rangeSearch.Search(math::Range(0.0, epsilon), offsets, neighbors, distances);
   Log::Info << "Range search complete." << std::endl;
 
   // Now loop over all points.
@@ -194,8 +197,8 @@ void DBSCAN<RangeSearchType, PointSelectionPolicy>::BatchCluster(
   {
     // Get the next index.
     const size_t index = pointSelector.Select(i, data);
-    for (size_t j = 0; j < neighbors[index].size(); ++j)
-      uf.Union(index, neighbors[index][j]);
+    for (size_t j = offsets[index]; j < offsets[index + 1]; ++j)
+      uf.Union(index, neighbors[j]);
   }
 }
 
@@ -89,6 +89,9 @@ PARAM_FLAG("single_mode", "If set, single-tree range search (not dual-tree) "
     "will be used.", "S");
 PARAM_FLAG("naive", "If set, brute-force range search (not tree-based) "
     "will be used.", "N");
+PARAM_INT_IN("threads", "Number of threads to build trees and search with "
+    "(if 0, as many as OpenMP allows).  The clusters are the same whatever the "
+    "number of threads.", "j", 0);
 
 // Actually run the clustering, and process the output.
 template<typename RangeSearchType, typename PointSelectionPolicy>
@@ -97,6 +100,7 @@ void RunDBSCAN(RangeSearchType rs,
 {
   if (IO::HasParam("single_mode"))
     rs.SingleMode() = true;
+  rs.NumThreads() = (size_t) IO::GetParam<int>("threads");
 
   // Load dataset.
   arma::mat dataset = std::move(IO::GetParam<arma::mat>("input"));
@@ -107,6 +111,9 @@ void RunDBSCAN(RangeSearchType rs,
   DBSCAN<RangeSearchType, PointSelectionPolicy> d(epsilon, minSize,
       !IO::HasParam("single_mode"), rs, pointSelector);
 
+  // The tree is built with as many threads as the search uses.
+  util::ScopedThreads scope(rs.NumThreads());
+
   // If possible, avoid the overhead of calculating centroids.
   if (IO::HasParam("centroids"))
   {
@@ -156,6 +163,10 @@ static void mlpackMain()
   RequireParamValue<int>("min_size", [](int y) { return y > 0; },
       true, "invalid value of min_size specified");
 
+  // Sanity check on the number of threads.
+  RequireParamValue<int>("threads", [](int x) { return x >= 0; }, true,
+      "number of threads must not be negative");
+
   // Fire off naive search if needed.
   if (IO::HasParam("naive"))
   {
@@ -465,6 +465,15 @@ class DecisionTree :
   //! trained tree).
   size_t SplitDimension() const { return splitDimension; }
 
+  //! Get the type of the split dimension if this is a non-leaf, or the
+  //! majority class if this is a leaf.
+  size_t DimensionTypeOrMajorityClass() const
+  { return dimensionTypeOrMajorityClass; }
+
+  //! Get the class probabilities if this is a leaf, or the information used
+  //! by the split type if this is a non-leaf.
+  const arma::vec& ClassProbabilities() const { return classProbabilities; }
+
   /**
    * Given a point and that this node is not a leaf, calculate the index of the
    * child node this point would go towards.  This method is primarily used by
@@ -0,0 +1,110 @@
+/**
+ * @file methods/decision_tree/flat_decision_tree.cpp
+ *
+ * Implementation of FlatDecisionForest.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "flat_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+FlatDecisionForest::FlatDecisionForest(const std::string& filename,
+                                       const std::string& type) :
+    file(filename)
+{
+  const char* data = util::CheckFlatFileHeader(file, type);
+  const size_t size = file.Size() - sizeof(util::FlatFileHeader);
+  if (size < 5 * sizeof(uint64_t))
+    Log::Fatal << "'" << filename << "' is truncated!" << std::endl;
+
+  const uint64_t* info = (const uint64_t*) data;
+  numTrees = (size_t) info[0];
+  numClasses = (size_t) info[1];
+  numNodes = (size_t) info[2];
+  const size_t numProbabilities = (size_t) info[3];
+  dimensionality = (size_t) info[4];
+
+  if (numTrees == 0 || size < 5 * sizeof(uint64_t) +
+      numTrees * sizeof(uint64_t) + numNodes * sizeof(Node) +
+      numProbabilities * sizeof(double))
+    Log::Fatal << "'" << filename << "' is truncated!" << std::endl;
+
+  roots = info + 5;
+  nodes = (const Node*) (roots + numTrees);
+  probabilities = (const double*) (nodes + numNodes);
+}
+
+const FlatDecisionForest::Node& FlatDecisionForest::FindLeaf(
+    const size_t tree,
+    const double* point) const
+{
+  const Node* node = nodes + roots[tree];
+  while (node->numChildren != 0)
+  {
+    const double value = point[node->splitDimension];
+    size_t direction;
+    if ((data::Datatype) node->dimensionTypeOrMajorityClass ==
+        data::Datatype::categorical)
+      direction = (size_t) value;
+    else
+      direction = (value <= node->splitValue) ? 0 : 1;
+
+    if (direction >= node->numChildren)
+      Log::Fatal << "Unknown category " << value << " in dimension "
+          << node->splitDimension << "!" << std::endl;
+
+    node = nodes + node->firstChild + direction;
+  }
+
+  return *node;
+}
+
+void FlatDecisionForest::Classify(const double* point,
+                                  size_t& prediction,
+                                  arma::vec& probabilities) const
+{
+  if (numTrees == 1)
+  {
+    const Node& leaf = FindLeaf(0, point);
+    prediction = leaf.dimensionTypeOrMajorityClass;
+    probabilities = arma::vec(this->probabilities + leaf.probabilities,
+        numClasses);
+    return;
+  }
+
+  probabilities.zeros(numClasses);
+  for (size_t i = 0; i < numTrees; ++i)
+  {
+    const Node& leaf = FindLeaf(i, point);
+    probabilities += arma::vec(this->probabilities + leaf.probabilities,
+        numClasses);
+  }
+
+  probabilities /= numTrees;
+  arma::uword maxIndex = 0;
+  probabilities.max(maxIndex);
+  prediction = (size_t) maxIndex;
+}
+
+void FlatDecisionForest::Classify(const arma::mat& data,
+                                  arma::Row<size_t>& predictions,
+                                  arma::mat& probabilities) const
+{
+  predictions.set_size(data.n_cols);
+  probabilities.set_size(numClasses, data.n_cols);
+
+  arma::vec pointProbabilities;
+  for (size_t i = 0; i < data.n_cols; ++i)
+  {
+    Classify(data.colptr(i), predictions[i], pointProbabilities);
+    probabilities.col(i) = pointProbabilities;
+  }
+}
+
+} // namespace tree
+} // namespace mlpack
@@ -0,0 +1,136 @@
+/**
+ * @file methods/decision_tree/flat_decision_tree.hpp
+ *
+ * Read-only decision trees and forests of decision trees that classify points
+ * directly from a memory-mapped flat model file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/mapped_file.hpp>
+
+namespace mlpack {
+namespace tree {
+
+/**
+ * FlatDecisionForest classifies points with one or more decision trees stored
+ * in a flat model file, as written by Save().  With a single tree it gives the
+ * same results as DecisionTree::Classify(); with several trees it averages
+ * their probabilities like RandomForest::Classify().
+ *
+ * The file holds, after its header:
+ *
+ *  - the number of trees, classes, nodes, and stored probabilities, and the
+ *    number of dimensions a point needs to have;
+ *  - the index of the root node of each tree;
+ *  - the nodes of all trees, where the children of a node are contiguous;
+ *  - the class probabilities of all leaves.
+ *
+ * The trees must split numeric dimensions in two at the threshold held in
+ * classProbabilities[0], as BestBinaryNumericSplit does, and categorical
+ * dimensions into one child per category, as AllCategoricalSplit does.
+ */
+class FlatDecisionForest
+{
+ public:
+  //! A node of a tree.
+  struct Node
+  {
+    //! Index of the first child.
+    uint64_t firstChild;
+    //! Number of children, or 0 if the node is a leaf.
+    uint64_t numChildren;
+    //! The dimension the node splits on.
+    uint64_t splitDimension;
+    //! The type of the split dimension, or the majority class of a leaf.
+    uint64_t dimensionTypeOrMajorityClass;
+    //! The threshold of a numeric split.
+    double splitValue;
+    //! Index of the class probabilities of a leaf.
+    uint64_t probabilities;
+  };
+
+  /**
+   * Map the given flat model file, which must hold the given type of model.
+   *
+   * @param filename Name of the file written by Save().
+   * @param type Name of the type of model the file must hold.
+   */
+  FlatDecisionForest(const std::string& filename, const std::string& type);
+
+  /**
+   * Write the given trees to a flat model file.
+   *
+   * @param trees Trees to save.
+   * @param filename Name of the file to write.
+   * @param type Name of the type of model to record in the file.
+   */
+  template<typename TreeType>
+  static void Save(const std::vector<const TreeType*>& trees,
+                   const std::string& filename,
+                   const std::string& type);
+
+  //! Get the number of trees.
+  size_t NumTrees() const { return numTrees; }
+  //! Get the number of classes.
+  size_t NumClasses() const { return numClasses; }
+  //! Get the number of dimensions a point needs to have to be classified.
+  size_t Dimensionality() const { return dimensionality; }
+
+  /**
+   * Classify the given point.
+   *
+   * @param point Point to classify.
+   * @param prediction Variable to store the predicted class in.
+   * @param probabilities Vector to store the class probabilities in.
+   */
+  void Classify(const double* point,
+                size_t& prediction,
+                arma::vec& probabilities) const;
+
+  /**
+   * Classify the given points.
+   *
+   * @param data Points to classify.
+   * @param predictions Vector to store the predicted classes in.
+   * @param probabilities Matrix to store the class probabilities in.
+   */
+  void Classify(const arma::mat& data,
+                arma::Row<size_t>& predictions,
+                arma::mat& probabilities) const;
+
+ private:
+  //! Find the leaf of the given tree that the point falls in.
+  const Node& FindLeaf(const size_t tree, const double* point) const;
+
+  //! The mapped file.
+  util::MappedFile file;
+  //! The number of trees.
+  size_t numTrees;
+  //! The number of classes.
+  size_t numClasses;
+  //! The number of nodes.
+  size_t numNodes;
+  //! The number of dimensions a point needs to have.
+  size_t dimensionality;
+  //! The root of each tree.
+  const uint64_t* roots;
+  //! The nodes of all trees.
+  const Node* nodes;
+  //! The class probabilities of all leaves.
+  const double* probabilities;
+};
+
+} // namespace tree
+} // namespace mlpack
+
+// Include implementation.
+#include "flat_decision_tree_impl.hpp"
+
+#endif
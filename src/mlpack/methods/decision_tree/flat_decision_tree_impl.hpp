@@ -0,0 +1,103 @@
+/**
+ * @file methods/decision_tree/flat_decision_tree_impl.hpp
+ *
+ * Implementation of FlatDecisionForest::Save().
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+#define MLPACK_METHODS_DECISION_TREE_FLAT_DECISION_TREE_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "flat_decision_tree.hpp"
+
+namespace mlpack {
+namespace tree {
+
+//! Fill in the flat node at the given index from the given tree node, and
+//! append the children of the node (contiguously) and their descendants.
+template<typename TreeType>
+void FlattenDecisionTreeNode(const TreeType& node,
+                             const size_t index,
+                             std::vector<FlatDecisionForest::Node>& nodes,
+                             std::vector<double>& probabilities)
+{
+  nodes[index].firstChild = 0;
+  nodes[index].numChildren = node.NumChildren();
+  nodes[index].splitDimension = node.SplitDimension();
+  nodes[index].dimensionTypeOrMajorityClass =
+      node.DimensionTypeOrMajorityClass();
+  nodes[index].splitValue = 0.0;
+  nodes[index].probabilities = 0;
+
+  if (node.NumChildren() == 0)
+  {
+    nodes[index].probabilities = probabilities.size();
+    probabilities.insert(probabilities.end(),
+        node.ClassProbabilities().begin(), node.ClassProbabilities().end());
+    return;
+  }
+
+  if ((data::Datatype) node.DimensionTypeOrMajorityClass() ==
+      data::Datatype::numeric)
+    nodes[index].splitValue = node.ClassProbabilities()[0];
+
+  const size_t firstChild = nodes.size();
+  nodes[index].firstChild = firstChild;
+  nodes.resize(firstChild + node.NumChildren());
+  for (size_t i = 0; i < node.NumChildren(); ++i)
+    FlattenDecisionTreeNode(node.Child(i), firstChild + i, nodes,
+        probabilities);
+}
+
+template<typename TreeType>
+void FlatDecisionForest::Save(const std::vector<const TreeType*>& trees,
+                              const std::string& filename,
+                              const std::string& type)
+{
+  if (trees.empty())
+    Log::Fatal << "Cannot save an untrained model as a flat file!" << std::endl;
+
+  std::vector<uint64_t> roots;
+  std::vector<Node> nodes;
+  std::vector<double> probabilities;
+  for (size_t i = 0; i < trees.size(); ++i)
+  {
+    roots.push_back(nodes.size());
+    nodes.resize(nodes.size() + 1);
+    FlattenDecisionTreeNode(*trees[i], roots.back(), nodes, probabilities);
+  }
+
+  std::ofstream stream(filename.c_str(), std::ios::binary);
+  if (!stream.is_open())
+    Log::Fatal << "Cannot open file '" << filename << "' for writing!"
+        << std::endl;
+
+  // Points need every dimension that is split on.
+  uint64_t dimensionality = 0;
+  for (size_t i = 0; i < nodes.size(); ++i)
+  {
+    if (nodes[i].numChildren != 0)
+      dimensionality = std::max(dimensionality, nodes[i].splitDimension + 1);
+  }
+
+  const uint64_t info[5] = { trees.size(), trees[0]->NumClasses(),
+      nodes.size(), probabilities.size(), dimensionality };
+  util::WriteFlatFileHeader(stream, type);
+  stream.write((const char*) info, sizeof(info));
+  stream.write((const char*) roots.data(), roots.size() * sizeof(uint64_t));
+  stream.write((const char*) nodes.data(), nodes.size() * sizeof(Node));
+  stream.write((const char*) probabilities.data(),
+      probabilities.size() * sizeof(double));
+
+  if (!stream.good())
+    Log::Fatal << "Error writing to file '" << filename << "'!" << std::endl;
+}
+
+} // namespace tree
+} // namespace mlpack
+
+#endif
@@ -75,6 +75,9 @@ PARAM_FLAG("naive", "Compute the MST using O(n^2) naive algorithm.", "n");
 PARAM_INT_IN("leaf_size", "Leaf size in the kd-tree.  One-element leaves give "
     "the empirically best performance, but at the cost of greater memory "
     "requirements.", "l", 1);
+PARAM_FLAG("pack_nodes", "Pack the nodes of the kd-tree into one block of "
+    "memory in depth-first order, which can make the computation faster "
+    "without changing its results.", "p");
 
 using namespace mlpack;
 using namespace mlpack::emst;
@@ -86,6 +89,7 @@ using namespace std;
 static void mlpackMain()
 {
   RequireAtLeastOnePassed({ "output" }, false, "no output will be saved");
+  ReportIgnoredParam({{ "naive", true }}, "pack_nodes");
 
   arma::mat dataPoints = std::move(IO::GetParam<arma::mat>("input"));
 
@@ -118,6 +122,8 @@ static void mlpackMain()
     std::vector<size_t> oldFromNew;
     KDTree<EuclideanDistance, DTBStat, arma::mat> tree(dataPoints, oldFromNew,
         leafSize);
+    if (IO::HasParam("pack_nodes"))
+      tree.PackNodes();
     metric::LMetric<2, true> metric;
     Timer::Stop("tree_building");
 
@@ -38,6 +38,12 @@ namespace gmm {
  *
  * This method should create 'clusters' clusters, and return the assignment of
  * each point to a cluster.
+ *
+ * Both steps of each EM iteration run in parallel with OpenMP: the probability
+ * of each block of observations under each distribution is computed
+ * separately, and the covariances are accumulated per thread (or per
+ * distribution) and then summed, so the results match the serial algorithm up
+ * to floating-point rounding.
  */
 template<typename InitialClusteringType = kmeans::KMeans<>,
          typename CovarianceConstraintPolicy = PositiveDefiniteConstraint,
@@ -147,6 +153,99 @@ class EMFit
       std::vector<Distribution>& dists,
       arma::vec& weights);
 
+  /**
+   * Compute log(weights[i]) + log p_i(x_j), the log of the weighted
+   * probability of each observation x_j under each distribution i, into
+   * element (j, i) of the given matrix.  Each block of observations is handled
+   * for each distribution in parallel, so that all the threads have work with
+   * few distributions as well as with few observations.
+   *
+   * @param observations List of observations.
+   * @param dists Distributions of the model.
+   * @param weights A priori weights of the distributions.
+   * @param logProbabilities Matrix to store the log probabilities in.
+   */
+  void LogProbabilities(const arma::mat& observations,
+                        const std::vector<Distribution>& dists,
+                        const arma::vec& weights,
+                        arma::mat& logProbabilities) const;
+
+  /**
+   * Compute the conditional log probability of each distribution given each
+   * observation (the E step), in parallel.
+   *
+   * @param observations List of observations.
+   * @param dists Distributions of the model.
+   * @param weights A priori weights of the distributions.
+   * @param condLogProb Matrix to store the conditional log probabilities in,
+   *     with one row per observation.
+   */
+  void Expectation(const arma::mat& observations,
+                   const std::vector<Distribution>& dists,
+                   const arma::vec& weights,
+                   arma::mat& condLogProb) const;
+
+  /**
+   * Update the means and covariances of the distributions (the M step), given
+   * the log of the (unnormalized) weight of each observation for each
+   * distribution; condLogProb is overwritten.  The log of the sum of the
+   * weights of each distribution is stored in probRowSums; distributions with
+   * no weight are left unchanged.
+   *
+   * The means come from a single matrix multiplication.  The covariances are
+   * sums of outer products, computed with SYRK on blocks of weighted
+   * observations: with at least as many distributions as threads, each thread
+   * handles whole distributions, and otherwise the threads sum the blocks of
+   * each distribution separately and the sums are added at the end.
+   *
+   * @param observations List of observations.
+   * @param condLogProb Log weight of each observation (row) for each
+   *     distribution (column).
+   * @param dists Distributions to update.
+   * @param probRowSums Vector to store the log of the sum of the weights of
+   *     each distribution in.
+   */
+  void Maximization(const arma::mat& observations,
+                    arma::mat& condLogProb,
+                    std::vector<Distribution>& dists,
+                    arma::vec& probRowSums);
+
+  /**
+   * Compute the covariance of the observations around the given mean, with the
+   * given weights for the observations, and add it to the given (zeroed)
+   * covariance.
+   *
+   * @param observations List of observations.
+   * @param mean Mean of the distribution.
+   * @param obsWeights Weight of each observation; the weights sum to one.
+   * @param parallel If true, the blocks of observations are split among the
+   *     threads.
+   * @param covariance Covariance to add to.
+   */
+  template<typename CovarianceType>
+  void WeightedCovariance(const arma::mat& observations,
+                          const arma::vec& mean,
+                          const arma::vec& obsWeights,
+                          const bool parallel,
+                          CovarianceType& covariance) const;
+
+  //! Add the outer products of the columns of diffs to a full covariance.
+  static void AddOuterProducts(const arma::mat& diffs, arma::mat& covariance)
+  {
+    // Armadillo computes the product of a matrix and its own transpose with
+    // SYRK.
+    covariance += diffs * diffs.t();
+  }
+
+  //! Add the squares of the columns of diffs to a diagonal covariance.
+  static void AddOuterProducts(const arma::mat& diffs, arma::vec& covariance)
+  {
+    covariance += arma::sum(arma::square(diffs), 1);
+  }
+
+  //! The number of observations in each block.
+  static const size_t BlockSize = 1024;
+
   /**
    * Calculate the log-likelihood of a model.  Yes, this is reimplemented in the
    * GMM code.  Intuition suggests that the log-likelihood is not the best way
@@ -88,71 +88,13 @@ Estimate(const arma::mat& observations,
 
     // Calculate the conditional probabilities of choosing a particular
     // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
-
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
+    Expectation(observations, dists, weights, condLogProb);
 
-    // Store the sum of the probability of each state over all the observations.
-    arma::vec probRowSums(dists.size());
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      probRowSums(i) = mlpack::math::AccuLog(condLogProb.col(i));
-    }
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-        dists[i].Mean() = observations * arma::exp(condLogProb.col(i) -
-                                                   probRowSums[i]);
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution,
-          distribution::DiagonalGaussianDistribution>::value)
-      {
-        arma::vec covariance = arma::sum((tmp % tmp) %
-            (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) -
-                                                          probRowSums[i]));
-        arma::mat covariance = tmp * trans(tmpB);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(covariance);
-        dists[i].Covariance(std::move(covariance));
-      }
-    }
+    // Calculate the new values of the means and covariances using the updated
+    // conditional probabilities, and store the sum of the probability of each
+    // state over all the observations.
+    arma::vec probRowSums;
+    Maximization(observations, condLogProb, dists, probRowSums);
 
     // Calculate the new values for omega using the updated conditional
     // probabilities.
@@ -186,6 +128,7 @@ Estimate(const arma::mat& observations,
 
   double lOld = -DBL_MAX;
   arma::mat condLogProb(observations.n_cols, dists.size());
+  const arma::vec logProbabilities = arma::log(probabilities);
 
   // Iterate to update the model until no more improvement is found.
   size_t iteration = 1;
@@ -193,79 +136,18 @@ Estimate(const arma::mat& observations,
   {
     // Calculate the conditional probabilities of choosing a particular
     // Gaussian given the observations and the present theta value.
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Store conditional log probabilities into condLogProb vector for each
-      // Gaussian.  First we make an alias of the condLogProb vector.
-      arma::vec condLogProbAlias = condLogProb.unsafe_col(i);
-      dists[i].LogProbability(observations, condLogProbAlias);
-      condLogProbAlias += log(weights[i]);
-    }
+    Expectation(observations, dists, weights, condLogProb);
 
-    // Normalize row-wise.
-    for (size_t i = 0; i < condLogProb.n_rows; ++i)
-    {
-      // Avoid dividing by zero; if the probability for everything is 0, we
-      // don't want to make it NaN.
-      const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
-      if (probSum != -std::numeric_limits<double>::infinity())
-        condLogProb.row(i) -= probSum;
-    }
+    // The weight of each point for each Gaussian is its conditional
+    // probability for that Gaussian multiplied by the probability of the point
+    // being from this mixture model.
+    condLogProb.each_col() += logProbabilities;
 
-    // This will store the sum of probabilities of each state over all the
+    // Calculate the new values of the means and covariances using these
+    // weights, and store the sum of the weights of each state over all the
     // observations.
-    arma::vec probRowSums(dists.size());
-
-    // Calculate the new value of the means using the updated conditional
-    // probabilities.
-    arma::vec logProbabilities = arma::log(probabilities);
-    for (size_t i = 0; i < dists.size(); ++i)
-    {
-      // Calculate the sum of probabilities of points, which is the
-      // conditional probability of each point being from Gaussian i
-      // multiplied by the probability of the point being from this mixture
-      // model.
-      arma::vec tmpProb = condLogProb.col(i) + logProbabilities;
-      probRowSums[i] = mlpack::math::AccuLog(tmpProb);
-
-      // Don't update if there's no probability of the Gaussian having points.
-      if (probRowSums[i] != -std::numeric_limits<double>::infinity())
-      {
-        dists[i].Mean() = observations *
-              arma::exp(condLogProb.col(i) + logProbabilities - probRowSums[i]);
-      }
-      else
-        continue;
-
-      // Calculate the new value of the covariances using the updated
-      // conditional probabilities and the updated means.
-      arma::mat tmp = observations.each_col() - dists[i].Mean();
-
-      // If the distribution is DiagonalGaussianDistribution, calculate the
-      // covariance only with diagonal components.
-      if (std::is_same<Distribution,
-          distribution::DiagonalGaussianDistribution>::value)
-      {
-        arma::vec cov = arma::sum((tmp % tmp) %
-            (arma::ones<arma::vec>(observations.n_rows) *
-            trans(arma::exp(condLogProb.col(i) +
-                            logProbabilities - probRowSums[i]))), 1);
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-      else
-      {
-        arma::mat tmpB = tmp.each_row() % trans(arma::exp(condLogProb.col(i) +
-            logProbabilities - probRowSums[i]));
-        arma::mat cov = (tmp * trans(tmpB));
-
-        // Apply covariance constraint.
-        constraint.ApplyConstraint(cov);
-        dists[i].Covariance(std::move(cov));
-      }
-    }
+    arma::vec probRowSums;
+    Maximization(observations, condLogProb, dists, probRowSums);
 
     // Calculate the new values for omega using the updated conditional
     // probabilities.
@@ -373,6 +255,173 @@ InitialClustering(const arma::mat& observations,
   weights /= accu(weights);
 }
 
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+LogProbabilities(const arma::mat& observations,
+                 const std::vector<Distribution>& dists,
+                 const arma::vec& weights,
+                 arma::mat& logProbabilities) const
+{
+  logProbabilities.set_size(observations.n_cols, dists.size());
+  if (dists.empty())
+    return;
+
+  // Consecutive tasks are the distributions of the same block.
+  const size_t blocks = (observations.n_cols + BlockSize - 1) / BlockSize;
+  const size_t tasks = blocks * dists.size();
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t t = 0; t < (omp_size_t) tasks; ++t)
+  {
+    const size_t i = t % dists.size();
+    const size_t begin = (t / dists.size()) * BlockSize;
+    const size_t count = std::min((size_t) BlockSize,
+        (size_t) observations.n_cols - begin);
+
+    // Alias the observations of the block instead of copying them.
+    const arma::mat block(const_cast<double*>(observations.colptr(begin)),
+        observations.n_rows, count, false, true);
+    arma::vec blockLogProbabilities;
+    dists[i].LogProbability(block, blockLogProbabilities);
+    logProbabilities.submat(begin, i, begin + count - 1, i) =
+        blockLogProbabilities + log(weights[i]);
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Expectation(const arma::mat& observations,
+            const std::vector<Distribution>& dists,
+            const arma::vec& weights,
+            arma::mat& condLogProb) const
+{
+  // Store conditional log probabilities into condLogProb for each Gaussian.
+  LogProbabilities(observations, dists, weights, condLogProb);
+
+  // Normalize row-wise.
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) condLogProb.n_rows; ++i)
+  {
+    // Avoid dividing by zero; if the probability for everything is 0, we
+    // don't want to make it NaN.
+    const double probSum = mlpack::math::AccuLog(condLogProb.row(i));
+    if (probSum != -std::numeric_limits<double>::infinity())
+      condLogProb.row(i) -= probSum;
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+Maximization(const arma::mat& observations,
+             arma::mat& condLogProb,
+             std::vector<Distribution>& dists,
+             arma::vec& probRowSums)
+{
+  // Full or diagonal covariance, depending on the distribution.
+  typedef typename std::conditional<std::is_same<Distribution,
+      distribution::DiagonalGaussianDistribution>::value,
+      arma::vec, arma::mat>::type CovarianceType;
+
+  // Turn the log weights of each Gaussian into weights that sum to one.
+  probRowSums.set_size(dists.size());
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
+  {
+    probRowSums[i] = mlpack::math::AccuLog(condLogProb.col(i));
+    if (probRowSums[i] != -std::numeric_limits<double>::infinity())
+      condLogProb.col(i) = arma::exp(condLogProb.col(i) - probRowSums[i]);
+    else
+      condLogProb.col(i).zeros();
+  }
+
+  // Calculate the new value of all the means at once.
+  const arma::mat means = observations * condLogProb;
+
+  size_t threads = 1;
+#ifdef _OPENMP
+  threads = (size_t) omp_get_max_threads();
+#endif
+  const bool parallelDists = (dists.size() >= threads);
+
+  #pragma omp parallel for schedule(dynamic) if (parallelDists)
+  for (omp_size_t i = 0; i < (omp_size_t) dists.size(); ++i)
+  {
+    // Don't update if there's no probability of the Gaussian having points.
+    if (probRowSums[i] == -std::numeric_limits<double>::infinity())
+      continue;
+
+    dists[i].Mean() = means.col(i);
+
+    // Calculate the new value of the covariance using the updated conditional
+    // probabilities and the updated mean.
+    CovarianceType covariance(arma::zeros<CovarianceType>(
+        dists[i].Covariance().n_rows, dists[i].Covariance().n_cols));
+    WeightedCovariance(observations, dists[i].Mean(),
+        condLogProb.unsafe_col(i), !parallelDists, covariance);
+
+    // Apply covariance constraint.
+    constraint.ApplyConstraint(covariance);
+    dists[i].Covariance(std::move(covariance));
+  }
+}
+
+template<typename InitialClusteringType,
+         typename CovarianceConstraintPolicy,
+         typename Distribution>
+template<typename CovarianceType>
+void EMFit<InitialClusteringType, CovarianceConstraintPolicy, Distribution>::
+WeightedCovariance(const arma::mat& observations,
+                   const arma::vec& mean,
+                   const arma::vec& obsWeights,
+                   const bool parallel,
+                   CovarianceType& covariance) const
+{
+  size_t threads = 1;
+#ifdef _OPENMP
+  if (parallel)
+    threads = (size_t) omp_get_max_threads();
+#endif
+  std::vector<CovarianceType> partialCovariances(threads);
+
+  const size_t blocks = (observations.n_cols + BlockSize - 1) / BlockSize;
+  #pragma omp parallel if (parallel)
+  {
+    size_t thread = 0;
+#ifdef _OPENMP
+    thread = (size_t) omp_get_thread_num();
+#endif
+    CovarianceType& partialCovariance = partialCovariances[thread];
+    partialCovariance = covariance;
+
+    #pragma omp for
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t begin = b * BlockSize;
+      const size_t end = std::min((size_t) observations.n_cols,
+          begin + BlockSize);
+
+      // Scale each difference by the square root of its weight, so that the
+      // outer product of the differences is weighted.
+      arma::mat diffs = observations.cols(begin, end - 1).each_col() - mean;
+      diffs.each_row() %= arma::sqrt(obsWeights.subvec(begin, end - 1)).t();
+      AddOuterProducts(diffs, partialCovariance);
+    }
+  }
+
+  // The partial sums of the threads that did not start are empty.
+  covariance.zeros();
+  for (size_t t = 0; t < threads; ++t)
+  {
+    if (partialCovariances[t].n_elem == covariance.n_elem)
+      covariance += partialCovariances[t];
+  }
+}
+
 template<typename InitialClusteringType,
          typename CovarianceConstraintPolicy,
          typename Distribution>
@@ -383,25 +432,24 @@ LogLikelihood(const arma::mat& observations,
 {
   double logLikelihood = 0;
 
-  arma::vec logPhis;
-  arma::mat logLikelihoods(dists.size(), observations.n_cols);
-
   // It has to be LogProbability() otherwise Probability() would overflow easily
-  for (size_t i = 0; i < dists.size(); ++i)
-  {
-    dists[i].LogProbability(observations, logPhis);
-    logLikelihoods.row(i) = log(weights(i)) + trans(logPhis);
-  }
+  arma::mat logLikelihoods;
+  LogProbabilities(observations, dists, weights, logLikelihoods);
+
+  arma::vec pointLogLikelihoods(observations.n_cols);
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) observations.n_cols; ++j)
+    pointLogLikelihoods[j] = mlpack::math::AccuLog(logLikelihoods.row(j));
+
   // Now sum over every point.
   for (size_t j = 0; j < observations.n_cols; ++j)
   {
-    if (mlpack::math::AccuLog(logLikelihoods.col(j)) ==
-        -std::numeric_limits<double>::infinity())
+    if (pointLogLikelihoods[j] == -std::numeric_limits<double>::infinity())
     {
       Log::Info << "Likelihood of point " << j << " is 0!  It is probably an "
           << "outlier." << std::endl;
     }
-    logLikelihood += mlpack::math::AccuLog(logLikelihoods.col(j));
+    logLikelihood += pointLogLikelihoods[j];
   }
 
   return logLikelihood;
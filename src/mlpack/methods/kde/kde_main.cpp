@@ -143,6 +143,9 @@ PARAM_STRING_IN("kernel", "Kernel to use for the prediction."
 PARAM_STRING_IN("tree", "Tree to use for the prediction."
     "('kd-tree', 'ball-tree', 'cover-tree', 'octree', 'r-tree').",
     "t", "kd-tree");
+PARAM_FLAG("pack_nodes", "Pack the nodes of kd-trees and ball trees into one "
+    "block of memory in depth-first order, which can make predictions faster "
+    "without changing their results.", "K");
 PARAM_STRING_IN("algorithm", "Algorithm to use for the prediction."
     "('dual-tree', 'single-tree').",
     "a", "dual-tree");
@@ -206,6 +209,7 @@ static void mlpackMain()
   RequireOnlyOnePassed({ "reference", "input_model" }, true);
   ReportIgnoredParam({{ "input_model", true }}, "tree");
   ReportIgnoredParam({{ "input_model", true }}, "kernel");
+  ReportIgnoredParam({{ "input_model", true }}, "pack_nodes");
 
   // Monte Carlo parameters only make sense if it is activated.
   ReportIgnoredParam({{ "monte_carlo", false }}, "mc_probability");
@@ -274,6 +278,8 @@ static void mlpackMain()
     else if (treeStr == "r-tree")
       kde->TreeType() = KDEModel::R_TREE;
 
+    kde->PackNodes() = IO::HasParam("pack_nodes");
+
     // Build model.
     kde->BuildModel(std::move(reference));
 
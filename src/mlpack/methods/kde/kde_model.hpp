@@ -156,6 +156,8 @@ class TrainVisitor : public boost::static_visitor<void>
  private:
   //! The reference set used for training.
   arma::mat&& referenceSet;
+  //! Whether to pack the nodes of kd-trees and ball trees.
+  const bool packNodes;
 
  public:
   //! Default TrainVisitor on some KDEType.
@@ -167,8 +169,10 @@ class TrainVisitor : public boost::static_visitor<void>
 
   // TODO Implement specific cases where a leaf size can be selected.
 
-  //! TrainVisitor constructor. Takes ownership of the given referenceSet.
-  TrainVisitor(arma::mat&& referenceSet);
+  //! TrainVisitor constructor. Takes ownership of the given referenceSet, and
+  //! packs the nodes of kd-trees and ball trees if packNodes is true (see
+  //! BinarySpaceTree::PackNodes()).
+  TrainVisitor(arma::mat&& referenceSet, const bool packNodes = false);
 };
 
 /**
@@ -351,6 +355,18 @@ class ModeVisitor : public boost::static_visitor<KDEMode&>
   KDEMode& operator()(KDEType* kde) const;
 };
 
+/**
+ * DimensionalityVisitor returns the dimensionality of the reference set of a
+ * KDEType.
+ */
+class DimensionalityVisitor : public boost::static_visitor<size_t>
+{
+ public:
+  //! Return the dimensionality of the reference set of KDEType instance.
+  template<typename KDEType>
+  size_t operator()(KDEType* kde) const;
+};
+
 class DeleteVisitor : public boost::static_visitor<void>
 {
  public:
@@ -396,6 +412,11 @@ class KDEModel
   //! Type of tree.
   TreeTypes treeType;
 
+  //! Whether the nodes of kd-trees and ball trees are packed into one block of
+  //! memory when they are built.  This is not serialized, since loaded trees
+  //! are never packed.
+  bool packNodes;
+
   //! Whether Monte Carlo estimations will be used.
   bool monteCarlo;
 
@@ -524,6 +545,14 @@ class KDEModel
   //! Modify the tree type of the model.
   TreeTypes& TreeType() { return treeType; }
 
+  //! Get whether the nodes of kd-trees and ball trees are packed into one
+  //! block of memory when they are built.
+  bool PackNodes() const { return packNodes; }
+
+  //! Modify whether the nodes of kd-trees and ball trees are packed into one
+  //! block of memory when they are built.
+  bool& PackNodes() { return packNodes; }
+
   //! Get the kernel type of the model.
   KernelTypes KernelType() const { return kernelType; }
 
@@ -566,6 +595,9 @@ class KDEModel
   //! Modify the mode of the model.
   KDEMode& Mode();
 
+  //! Get the dimensionality of the reference set of the model.
+  size_t Dimensionality() const;
+
   /**
    * Build the KDE model with the given parameters and then trains it with the
    * given reference data.
@@ -36,6 +36,7 @@ inline KDEModel::KDEModel(const double bandwidth,
   absError(absError),
   kernelType(kernelType),
   treeType(treeType),
+  packNodes(false),
   monteCarlo(monteCarlo),
   mcProb(mcProb),
   initialSampleSize(initialSampleSize),
@@ -52,6 +53,7 @@ inline KDEModel::KDEModel(const KDEModel& other) :
   absError(other.absError),
   kernelType(other.kernelType),
   treeType(other.treeType),
+  packNodes(other.packNodes),
   monteCarlo(other.monteCarlo),
   mcProb(other.mcProb),
   initialSampleSize(other.initialSampleSize),
@@ -68,6 +70,7 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   absError(other.absError),
   kernelType(other.kernelType),
   treeType(other.treeType),
+  packNodes(other.packNodes),
   monteCarlo(other.monteCarlo),
   mcProb(other.mcProb),
   initialSampleSize(other.initialSampleSize),
@@ -81,6 +84,7 @@ inline KDEModel::KDEModel(KDEModel&& other) :
   other.absError = KDEDefaultParams::absError;
   other.kernelType = KernelTypes::GAUSSIAN_KERNEL;
   other.treeType = TreeTypes::KD_TREE;
+  other.packNodes = false;
   other.monteCarlo = KDEDefaultParams::monteCarlo;
   other.mcProb = KDEDefaultParams::mcProb;
   other.initialSampleSize = KDEDefaultParams::initialSampleSize;
@@ -97,6 +101,7 @@ inline KDEModel& KDEModel::operator=(KDEModel other)
   absError = other.absError;
   kernelType = other.kernelType;
   treeType = other.treeType;
+  packNodes = other.packNodes;
   monteCarlo = other.monteCarlo;
   mcProb = other.mcProb;
   initialSampleSize = other.initialSampleSize;
@@ -265,7 +270,7 @@ inline void KDEModel::BuildModel(arma::mat&& referenceSet)
   boost::apply_visitor(breakCoefficientVisitor, kdeModel);
 
   // Train the model.
-  TrainVisitor train(std::move(referenceSet));
+  TrainVisitor train(std::move(referenceSet), packNodes);
   boost::apply_visitor(train, kdeModel);
 }
 
@@ -345,8 +350,10 @@ void DualBiKDE::operator()(KDETypeT<KernelType, TreeType>* kde) const
 }
 
 // Parameters for Train.
-TrainVisitor::TrainVisitor(arma::mat&& referenceSet) :
-    referenceSet(std::move(referenceSet))
+TrainVisitor::TrainVisitor(arma::mat&& referenceSet,
+                           const bool packNodes) :
+    referenceSet(std::move(referenceSet)),
+    packNodes(packNodes)
 {}
 
 // Default Train.
@@ -358,7 +365,11 @@ void TrainVisitor::operator()(KDEType<KernelType, TreeType>* kde) const
 {
   Log::Info << "Training KDE model..." << std::endl;
   if (kde)
+  {
     kde->Train(std::move(referenceSet));
+    if (packNodes)
+      tree::PackTreeNodes(*kde->ReferenceTree());
+  }
   else
     throw std::runtime_error("no KDE model initialized");
 }
@@ -537,6 +548,22 @@ KDEMode& KDEModel::Mode()
   return boost::apply_visitor(ModeVisitor(), kdeModel);
 }
 
+// Dimensionality of the reference set.
+template<typename KDEType>
+size_t DimensionalityVisitor::operator()(KDEType* kde) const
+{
+  if (kde && kde->IsTrained())
+    return kde->ReferenceTree()->Dataset().n_rows;
+  else
+    throw std::runtime_error("no KDE model initialized");
+}
+
+// Get dimensionality of model.
+inline size_t KDEModel::Dimensionality() const
+{
+  return boost::apply_visitor(DimensionalityVisitor(), kdeModel);
+}
+
 // Serialize the model.
 template<typename Archive>
 void KDEModel::serialize(Archive& ar, const unsigned int version)
@@ -14,6 +14,7 @@
 #define MLPACK_METHODS_KDE_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/leaf_distances.hpp>
 
 namespace mlpack {
 namespace kde {
@@ -63,6 +64,17 @@ class KDERules
   //! Base Case.
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between the given query point and every point of
+   * the given reference leaf.  For the Euclidean distance, the distances
+   * between the two leaves are computed all at once (see tree::LeafDistances);
+   * the few whose relative error could exceed maxLeafDistanceError are
+   * computed again exactly.
+   */
+  void LeafBaseCases(TreeType& queryLeaf,
+                     const size_t queryIndex,
+                     TreeType& referenceLeaf);
+
   //! SingleTree Rescore.
   double Score(const size_t queryIndex, TreeType& referenceNode);
 
@@ -98,6 +110,12 @@ class KDERules
   double EvaluateKernel(const size_t queryIndex,
                         const size_t referenceIndex) const;
 
+  //! Add the kernel value of the given distance between the given points to
+  //! the density of the query point.
+  void AddBaseCase(const size_t queryIndex,
+                   const size_t referenceIndex,
+                   const double distance);
+
   //! Evaluate kernel value of 2 points.
   double EvaluateKernel(const arma::vec& query,
                         const arma::vec& reference) const;
@@ -175,6 +193,13 @@ class KDERules
 
   //! The number of scores.
   size_t scores;
+
+  //! The distances between the points of the last pair of leaves.
+  tree::LeafDistances<arma::mat> leafDistances;
+
+  //! Distances computed by leafDistances are only used if the bound on their
+  //! relative error is at most this.
+  constexpr static double maxLeafDistanceError = 1e-10;
 };
 
 /**
@@ -54,7 +54,8 @@ KDERules<MetricType, KernelType, TreeType>::KDERules(
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    leafDistances(querySet, referenceSet)
 {
   // Initialize accumError.
   accumError = arma::vec(querySet.n_cols, arma::fill::zeros);
@@ -83,6 +84,47 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   // Calculations.
   const double distance = metric.Evaluate(querySet.col(queryIndex),
                                           referenceSet.col(referenceIndex));
+  AddBaseCase(queryIndex, referenceIndex, distance);
+  return distance;
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+void KDERules<MetricType, KernelType, TreeType>::LeafBaseCases(
+    TreeType& queryLeaf,
+    const size_t queryIndex,
+    TreeType& referenceLeaf)
+{
+  const size_t referenceEnd = referenceLeaf.Begin() + referenceLeaf.Count();
+  if (!tree::LeafDistanceTraits<MetricType>::Supported ||
+      !leafDistances.Compute(queryLeaf, referenceLeaf))
+  {
+    for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+      BaseCase(queryIndex, r);
+    return;
+  }
+
+  for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+  {
+    if ((sameSet && (queryIndex == r)) ||
+        ((lastQueryIndex == queryIndex) && (lastReferenceIndex == r)))
+      continue;
+
+    double relativeError;
+    const double distance = leafDistances.template Distance<MetricType>(
+        queryIndex, r, relativeError);
+    if (relativeError > maxLeafDistanceError)
+      BaseCase(queryIndex, r);
+    else
+      AddBaseCase(queryIndex, r, distance);
+  }
+}
+
+template<typename MetricType, typename KernelType, typename TreeType>
+inline void KDERules<MetricType, KernelType, TreeType>::AddBaseCase(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double distance)
+{
   const double kernelValue = kernel.Evaluate(distance);
   densities(queryIndex) += kernelValue;
 
@@ -93,7 +135,6 @@ double KDERules<MetricType, KernelType, TreeType>::BaseCase(
   lastQueryIndex = queryIndex;
   lastReferenceIndex = referenceIndex;
   traversalInfo.LastBaseCase() = distance;
-  return distance;
 }
 
 //! Single-tree scoring function.
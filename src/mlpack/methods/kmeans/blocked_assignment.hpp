@@ -0,0 +1,125 @@
+/**
+ * @file methods/kmeans/blocked_assignment.hpp
+ *
+ * Assignment of points to their closest centroids in blocks, with matrix
+ * multiplications when the metric is the Euclidean distance.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_ASSIGNMENT_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_ASSIGNMENT_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/tree/leaf_distances.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * BlockedAssignment finds the closest centroid to each point of a block of
+ * consecutive points of a dataset.  For the Euclidean and squared Euclidean
+ * distances on dense matrices, the squared distances are computed as
+ * ||x||^2 - 2 C^T x + ||c||^2: the products of a block of points with a tile
+ * of centroids come from a single matrix multiplication, with tiles sized to
+ * fit in the cache, and the closest centroid of each point is kept as the tiles
+ * go, so the distances of a point to all the centroids are never stored.
+ *
+ * As in tree::LeafDistances, this form loses precision when a point is close to
+ * a centroid compared to their norms.  So for each point, the gap between its
+ * closest centroid and the others is checked against a bound on the error of
+ * the distances, and if it is too small, the distances of that point are
+ * computed again with the metric.  Thus the assignments are the same as if
+ * every distance had been computed with the metric.  All of these computations
+ * are done in the element type of the dataset, with the centroids converted to
+ * it once, so a single-precision dataset is assigned in single precision.
+ *
+ * With other metrics or sparse matrices, each distance is computed with the
+ * metric.
+ *
+ * @tparam MetricType Type of metric used to assign the points.
+ * @tparam MatType Type of the dataset.
+ */
+template<typename MetricType, typename MatType>
+class BlockedAssignment
+{
+ public:
+  //! The element type of the dataset.
+  typedef typename MatType::elem_type ElemType;
+
+  /**
+   * Prepare to assign the points of the given dataset to the given centroids;
+   * both must outlive the object.
+   *
+   * @param dataset Dataset holding the points.
+   * @param centroids Current cluster centroids.
+   * @param metric Instantiated metric.
+   */
+  BlockedAssignment(const MatType& dataset,
+                    const arma::mat& centroids,
+                    MetricType& metric);
+
+  /**
+   * Find the closest centroid to each of the points of the dataset from begin
+   * to end (excluded), and store the index of the centroid of the i'th point
+   * in assignments[i - begin].  Returns the number of distances computed,
+   * including those computed again with the metric.
+   *
+   * @param begin Index of the first point.
+   * @param end Index after the last point.
+   * @param assignments Array of (end - begin) closest centroids to fill.
+   */
+  size_t Assign(const size_t begin,
+                const size_t end,
+                size_t* assignments) const;
+
+  //! If true, the distances are computed with matrix multiplications.
+  static const bool Blocked =
+      tree::LeafDistanceTraits<MetricType>::Supported &&
+      arma::is_Mat<MatType>::value;
+
+  //! The number of points that callers should assign at once.
+  static const size_t PointBlockSize = 256;
+  //! The number of bytes of centroids in each tile.
+  static const size_t TileBytes = 131072;
+
+ private:
+  //! Assign the points with matrix multiplications.
+  size_t Assign(const size_t begin,
+                const size_t end,
+                size_t* assignments,
+                std::true_type /* blocked */) const;
+
+  //! Assign the points with the metric.
+  size_t Assign(const size_t begin,
+                const size_t end,
+                size_t* assignments,
+                std::false_type /* blocked */) const;
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The centroids.
+  const arma::mat& centroids;
+  //! The instantiated metric.
+  MetricType& metric;
+
+  //! The centroids, in the element type of the dataset.
+  arma::Mat<ElemType> tileCentroids;
+  //! The squared norms of the centroids.
+  arma::vec centroidNorms;
+  //! The number of centroids in each tile.
+  size_t tileSize;
+  //! The error of a squared distance is at most this times the sum of the
+  //! squared norms of the point and the centroid.
+  double errorScale;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "blocked_assignment_impl.hpp"
+
+#endif
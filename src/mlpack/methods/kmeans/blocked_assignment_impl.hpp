@@ -0,0 +1,173 @@
+/**
+ * @file methods/kmeans/blocked_assignment_impl.hpp
+ *
+ * Implementation of BlockedAssignment.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_BLOCKED_ASSIGNMENT_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_BLOCKED_ASSIGNMENT_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "blocked_assignment.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+BlockedAssignment<MetricType, MatType>::BlockedAssignment(
+    const MatType& dataset,
+    const arma::mat& centroids,
+    MetricType& metric) :
+    dataset(dataset),
+    centroids(centroids),
+    metric(metric),
+    tileSize(centroids.n_cols),
+    errorScale(0.0)
+{
+  if (!Blocked)
+    return;
+
+  tileCentroids = arma::conv_to<arma::Mat<ElemType>>::from(centroids);
+  centroidNorms = arma::conv_to<arma::vec>::from(
+      arma::sum(arma::square(tileCentroids), 0));
+
+  const size_t columnBytes = std::max((size_t) centroids.n_rows, (size_t) 1) *
+      sizeof(ElemType);
+  tileSize = std::max(TileBytes / columnBytes, (size_t) 16);
+
+  // The same bound as in tree::LeafDistances, which also covers the rounding
+  // of the centroids to the element type of the dataset.
+  errorScale = (4 * dataset.n_rows + 8) *
+      std::numeric_limits<ElemType>::epsilon();
+}
+
+template<typename MetricType, typename MatType>
+size_t BlockedAssignment<MetricType, MatType>::Assign(
+    const size_t begin,
+    const size_t end,
+    size_t* assignments) const
+{
+  return Assign(begin, end, assignments,
+      std::integral_constant<bool, Blocked>());
+}
+
+template<typename MetricType, typename MatType>
+size_t BlockedAssignment<MetricType, MatType>::Assign(
+    const size_t begin,
+    const size_t end,
+    size_t* assignments,
+    std::true_type /* blocked */) const
+{
+  if (begin >= end)
+    return 0;
+
+  const size_t count = end - begin;
+  const size_t k = centroids.n_cols;
+
+  // Alias the points instead of copying them.
+  const arma::Mat<ElemType> points(const_cast<ElemType*>(
+      dataset.colptr(begin)), dataset.n_rows, count, false, true);
+  const arma::Row<ElemType> pointNorms = arma::sum(arma::square(points), 0);
+
+  // For each point, the smallest ||c||^2 - 2 c^T x and its centroid, and the
+  // smallest value of the other centroids minus their error bound.
+  std::vector<double> best(count, std::numeric_limits<double>::infinity());
+  std::vector<double> others(count, std::numeric_limits<double>::infinity());
+  std::vector<size_t> bestCentroids(count, k);
+
+  arma::Mat<ElemType> products;
+  for (size_t first = 0; first < k; first += tileSize)
+  {
+    const size_t size = std::min(tileSize, k - first);
+    const arma::Mat<ElemType> tile(const_cast<ElemType*>(
+        tileCentroids.colptr(first)), tileCentroids.n_rows, size, false, true);
+    products = arma::trans(tile) * points;
+
+    for (size_t p = 0; p < count; ++p)
+    {
+      const ElemType* column = products.colptr(p);
+      for (size_t j = 0; j < size; ++j)
+      {
+        const double norm = centroidNorms[first + j];
+        const double value = norm - 2.0 * (double) column[j];
+        if (value < best[p])
+        {
+          if (bestCentroids[p] != k)
+          {
+            others[p] = std::min(others[p], best[p] - errorScale *
+                centroidNorms[bestCentroids[p]]);
+          }
+          best[p] = value;
+          bestCentroids[p] = first + j;
+        }
+        else
+        {
+          others[p] = std::min(others[p], value - errorScale * norm);
+        }
+      }
+    }
+  }
+
+  // The closest centroid is certain unless another one may be as close once
+  // the errors are taken into account; then the distances are computed again.
+  size_t distanceCalculations = count * k;
+  for (size_t p = 0; p < count; ++p)
+  {
+    const size_t closest = bestCentroids[p];
+    if (closest != k && others[p] > best[p] + errorScale *
+        (2.0 * pointNorms[p] + centroidNorms[closest]))
+    {
+      assignments[p] = closest;
+      continue;
+    }
+
+    Assign(begin + p, begin + p + 1, assignments + p, std::false_type());
+    distanceCalculations += k;
+  }
+
+  return distanceCalculations;
+}
+
+template<typename MetricType, typename MatType>
+size_t BlockedAssignment<MetricType, MatType>::Assign(
+    const size_t begin,
+    const size_t end,
+    size_t* assignments,
+    std::false_type /* blocked */) const
+{
+  for (size_t i = begin; i < end; ++i)
+  {
+    // Find the closest centroid to this point.
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      // When the distances are also computed with matrix multiplications, the
+      // centroids are taken in the element type of the dataset, so that both
+      // use the same arithmetic.
+      const double distance = Blocked ?
+          metric.Evaluate(dataset.col(i), tileCentroids.unsafe_col(j)) :
+          metric.Evaluate(dataset.col(i), centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i - begin] = closestCluster;
+  }
+
+  return (end > begin) ? (end - begin) * centroids.n_cols : 0;
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -12,17 +12,37 @@
 #ifndef MLPACK_METHODS_KMEANS_ELKAN_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_ELKAN_KMEANS_HPP
 
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+
 namespace mlpack {
 namespace kmeans {
 
-template<typename MetricType, typename MatType>
-class ElkanKMeans
+/**
+ * An implementation of a single iteration of Elkan's algorithm, which keeps an
+ * upper bound on the distance from each point to its centroid and a lower bound
+ * on the distance from each point to each centroid, and only computes the
+ * distances that the triangle inequality cannot rule out.  The points are
+ * handled in parallel; each thread sums the points of its own clusters.
+ *
+ * The lower bounds take k times the memory of the dataset when the dataset is
+ * low-dimensional, so they may be stored in single precision, which halves
+ * that memory.  They are then rounded down, so they remain lower bounds and
+ * the clustering is the same.  Use ElkanKMeans or FloatBoundElkanKMeans as the
+ * LloydStepType of KMeans.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::fmat).
+ * @tparam BoundElemType Type of the lower bounds (double or float).
+ */
+template<typename MetricType, typename MatType, typename BoundElemType>
+class ElkanKMeansType
 {
  public:
   /**
    * Construct the ElkanKMeans object, which must store several sets of bounds.
    */
-  ElkanKMeans(const MatType& dataset, MetricType& metric);
+  ElkanKMeansType(const MatType& dataset, MetricType& metric);
 
   /**
    * Run a single iteration of Elkan's algorithm, updating the given centroids
@@ -39,6 +59,9 @@ class ElkanKMeans
   size_t DistanceCalculations() const { return distanceCalculations; }
 
  private:
+  //! Round the given distance down to a lower bound of type BoundElemType.
+  static BoundElemType LowerBound(const double distance);
+
   //! The dataset.
   const MatType& dataset;
   //! The instantiated metric.
@@ -55,12 +78,22 @@ class ElkanKMeans
   //! Upper bounds on the distance between each point and its closest cluster.
   arma::vec upperBounds;
   //! Lower bounds on the distance between each point and each cluster.
-  arma::mat lowerBounds;
+  arma::Mat<BoundElemType> lowerBounds;
 
   //! Track distance calculations.
   size_t distanceCalculations;
 };
 
+//! A template typedef for Elkan's algorithm with lower bounds in double
+//! precision.
+template<typename MetricType, typename MatType>
+using ElkanKMeans = ElkanKMeansType<MetricType, MatType, double>;
+
+//! A template typedef for Elkan's algorithm with lower bounds in single
+//! precision.
+template<typename MetricType, typename MatType>
+using FloatBoundElkanKMeans = ElkanKMeansType<MetricType, MatType, float>;
+
 } // namespace kmeans
 } // namespace mlpack
 
@@ -18,9 +18,10 @@
 namespace mlpack {
 namespace kmeans {
 
-template<typename MetricType, typename MatType>
-ElkanKMeans<MetricType, MatType>::ElkanKMeans(const MatType& dataset,
-                                              MetricType& metric) :
+template<typename MetricType, typename MatType, typename BoundElemType>
+ElkanKMeansType<MetricType, MatType, BoundElemType>::ElkanKMeansType(
+    const MatType& dataset,
+    MetricType& metric) :
     dataset(dataset),
     metric(metric),
     distanceCalculations(0)
@@ -29,10 +30,11 @@ ElkanKMeans<MetricType, MatType>::ElkanKMeans(const MatType& dataset,
 }
 
 // Run a single iteration of Elkan's algorithm for Lloyd iterations.
-template<typename MetricType, typename MatType>
-double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
-                                                 arma::mat& newCentroids,
-                                                 arma::Col<size_t>& counts)
+template<typename MetricType, typename MatType, typename BoundElemType>
+double ElkanKMeansType<MetricType, MatType, BoundElemType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
 {
   // Clear new centroids.
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
@@ -46,9 +48,6 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   // being the closest cluster centroid.
   clusterDistances.diag().fill(DBL_MAX);
 
-  // Initially set r(x) to true.
-  std::vector<bool> mustRecalculate(dataset.n_cols, true);
-
   // If this is the first iteration, we must reset all the bounds.
   if (lowerBounds.n_rows != centroids.n_cols)
   {
@@ -63,13 +62,16 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 
   // Step 1: for all centers, compute between-cluster distances.  For all
   // centers, compute s(c) = 1/2 min d(c, c').
-  for (size_t i = 0; i < centroids.n_cols; ++i)
+  size_t iterationCalculations = 0;
+  #pragma omp parallel for schedule(dynamic) \
+      reduction(+:iterationCalculations)
+  for (omp_size_t i = 0; i < (omp_size_t) centroids.n_cols; ++i)
   {
     for (size_t j = i + 1; j < centroids.n_cols; ++j)
     {
       const double distance = metric.Evaluate(centroids.col(i),
                                               centroids.col(j));
-      distanceCalculations++;
+      iterationCalculations++;
       clusterDistances(i, j) = distance;
       clusterDistances(j, i) = distance;
     }
@@ -79,78 +81,114 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   // that this is equivalent to s(c) for each cluster c.
   minClusterDistances = 0.5 * arma::min(clusterDistances).t();
 
-  // Now loop over all points, and see which ones need to be updated.
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  // Each thread sums the points of its own clusters; the sums of the threads
+  // are added once all the points have been assigned.
+  size_t threads = 1;
+#ifdef _OPENMP
+  threads = (size_t) omp_get_max_threads();
+#endif
+  std::vector<arma::mat> localCentroids(threads);
+  std::vector<arma::Col<size_t>> localCounts(threads);
+
+  // Now loop over all points in parallel, and see which ones need to be
+  // updated.
+  #pragma omp parallel reduction(+:iterationCalculations)
   {
-    // Step 2: identify all points such that u(x) <= s(c(x)).
-    if (upperBounds(i) <= minClusterDistances(assignments[i]))
-    {
-      // No change needed.  This point must still belong to that cluster.
-      counts(assignments[i])++;
-      newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-      continue;
-    }
-    else
+    size_t thread = 0;
+#ifdef _OPENMP
+    thread = (size_t) omp_get_thread_num();
+#endif
+    arma::mat& threadCentroids = localCentroids[thread];
+    arma::Col<size_t>& threadCounts = localCounts[thread];
+    threadCentroids.zeros(centroids.n_rows, centroids.n_cols);
+    threadCounts.zeros(centroids.n_cols);
+
+    #pragma omp for schedule(dynamic, 256)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      for (size_t c = 0; c < centroids.n_cols; ++c)
+      // Step 2: identify all points such that u(x) <= s(c(x)).  Those must
+      // still belong to their cluster; the others are checked against every
+      // other cluster.
+      if (upperBounds(i) > minClusterDistances(assignments[i]))
       {
-        // Step 3: for all remaining points x and centers c such that c != c(x),
-        // u(x) > l(x, c) and u(x) > 0.5 d(c(x), c)...
-        if (assignments[i] == c)
-          continue; // Pruned because this cluster is already the assignment.
-
-        if (upperBounds(i) <= lowerBounds(c, i))
-          continue; // Pruned by triangle inequality on lower bound.
-
-        if (upperBounds(i) <= 0.5 * clusterDistances(assignments[i], c))
-          continue; // Pruned by triangle inequality on cluster distances.
-
-        // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
-        // Otherwise, d(x, c(x)) = u(x).
-        double dist;
-        if (mustRecalculate[i])
+        // Initially set r(x) to true.
+        bool mustRecalculate = true;
+        for (size_t c = 0; c < centroids.n_cols; ++c)
         {
-          mustRecalculate[i] = false;
-          dist = metric.Evaluate(dataset.col(i), centroids.col(assignments[i]));
-          lowerBounds(assignments[i], i) = dist;
-          upperBounds(i) = dist;
-          distanceCalculations++;
+          // Step 3: for all remaining points x and centers c such that
+          // c != c(x), u(x) > l(x, c) and u(x) > 0.5 d(c(x), c)...
+          if (assignments[i] == c)
+            continue; // Pruned because this cluster is already the assignment.
 
-          // Check if we can prune again.
           if (upperBounds(i) <= lowerBounds(c, i))
             continue; // Pruned by triangle inequality on lower bound.
 
           if (upperBounds(i) <= 0.5 * clusterDistances(assignments[i], c))
             continue; // Pruned by triangle inequality on cluster distances.
-        }
-        else
-        {
-          dist = upperBounds(i); // This is equivalent to d(x, c(x)).
-        }
 
-        // Step 3b: if d(x, c(x)) > l(x, c) or d(x, c(x)) > 0.5 d(c(x), c)...
-        if (dist > lowerBounds(c, i) ||
-            dist > 0.5 * clusterDistances(assignments[i], c))
-        {
-          // Compute d(x, c).  If d(x, c) < d(x, c(x)) then assign c(x) = c.
-          const double pointDist = metric.Evaluate(dataset.col(i),
-                                                   centroids.col(c));
-          lowerBounds(c, i) = pointDist;
-          distanceCalculations++;
-          if (pointDist < dist)
+          // Step 3a: if r(x) then compute d(x, c(x)) and assign r(x) = false.
+          // Otherwise, d(x, c(x)) = u(x).
+          double dist;
+          if (mustRecalculate)
+          {
+            mustRecalculate = false;
+            dist = metric.Evaluate(dataset.col(i),
+                centroids.col(assignments[i]));
+            lowerBounds(assignments[i], i) = LowerBound(dist);
+            upperBounds(i) = dist;
+            iterationCalculations++;
+
+            // Check if we can prune again.
+            if (upperBounds(i) <= lowerBounds(c, i))
+              continue; // Pruned by triangle inequality on lower bound.
+
+            if (upperBounds(i) <= 0.5 * clusterDistances(assignments[i], c))
+              continue; // Pruned by triangle inequality on cluster distances.
+          }
+          else
           {
-            upperBounds(i) = pointDist;
-            assignments[i] = c;
+            dist = upperBounds(i); // This is equivalent to d(x, c(x)).
+          }
+
+          // Step 3b: if d(x, c(x)) > l(x, c) or d(x, c(x)) > 0.5 d(c(x), c)...
+          if (dist > lowerBounds(c, i) ||
+              dist > 0.5 * clusterDistances(assignments[i], c))
+          {
+            // Compute d(x, c).  If d(x, c) < d(x, c(x)) then assign c(x) = c.
+            const double pointDist = metric.Evaluate(dataset.col(i),
+                                                     centroids.col(c));
+            lowerBounds(c, i) = LowerBound(pointDist);
+            iterationCalculations++;
+            if (pointDist < dist)
+            {
+              upperBounds(i) = pointDist;
+              assignments[i] = c;
+            }
           }
         }
       }
+
+      // At this point, we know the new cluster assignment.
+      // Step 4: for each center c, let m(c) be the mean of the points assigned
+      // to c.
+      threadCentroids.unsafe_col(assignments[i]) +=
+          ConvTo<arma::vec>::From(dataset.col(i));
+      threadCounts[assignments[i]]++;
     }
+  }
+
+  // Combine the sums of the threads, in parallel over the centroids.
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) centroids.n_cols; ++c)
+  {
+    for (size_t t = 0; t < threads; ++t)
+    {
+      if (localCounts[t].n_elem == 0)
+        continue; // This thread never started.
 
-    // At this point, we know the new cluster assignment.
-    // Step 4: for each center c, let m(c) be the mean of the points assigned to
-    // c.
-    newCentroids.col(assignments[i]) += arma::vec(dataset.col(i));
-    counts[assignments[i]]++;
+      newCentroids.unsafe_col(c) += localCentroids[t].unsafe_col(c);
+      counts[c] += localCounts[t][c];
+    }
   }
 
   // Now, normalize and calculate the distance each cluster has moved.
@@ -163,16 +201,17 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
 
     moveDistances(c) = metric.Evaluate(newCentroids.col(c), centroids.col(c));
     cNorm += std::pow(moveDistances(c), 2.0);
-    distanceCalculations++;
+    iterationCalculations++;
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     // Step 5: for each point x and center c, assign
     //   l(x, c) = max { l(x, c) - d(c, m(c)), 0 }.
     // But it doesn't actually matter if l(x, c) is positive.
     for (size_t c = 0; c < centroids.n_cols; ++c)
-      lowerBounds(c, i) -= moveDistances(c);
+      lowerBounds(c, i) = LowerBound(lowerBounds(c, i) - moveDistances(c));
 
     // Step 6: for each point x, assign
     //   u(x) = u(x) + d(m(c(x)), c(x))
@@ -180,9 +219,26 @@ double ElkanKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     upperBounds(i) += moveDistances(assignments[i]);
   }
 
+  distanceCalculations += iterationCalculations;
+
   return std::sqrt(cNorm);
 }
 
+template<typename MetricType, typename MatType, typename BoundElemType>
+BoundElemType ElkanKMeansType<MetricType, MatType, BoundElemType>::LowerBound(
+    const double distance)
+{
+  // A bound of lower precision may only be rounded down.
+  const BoundElemType bound = (BoundElemType) distance;
+  if ((double) bound > distance)
+  {
+    return std::nextafter(bound,
+        -std::numeric_limits<BoundElemType>::infinity());
+  }
+
+  return bound;
+}
+
 } // namespace kmeans
 } // namespace mlpack
 
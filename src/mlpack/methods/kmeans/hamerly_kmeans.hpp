@@ -12,9 +12,21 @@
 #ifndef MLPACK_METHODS_KMEANS_HAMERLY_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_HAMERLY_KMEANS_HPP
 
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+
 namespace mlpack {
 namespace kmeans {
 
+/**
+ * An implementation of a single iteration of Hamerly's algorithm, which keeps
+ * an upper bound on the distance from each point to its centroid and a single
+ * lower bound on the distance to every other centroid.  The points are handled
+ * in parallel; each thread sums the points of its own clusters.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::fmat).
+ */
 template<typename MetricType, typename MatType>
 class HamerlyKMeans
 {
@@ -67,63 +67,105 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     }
   }
 
-  for (size_t i = 0; i < dataset.n_cols; ++i)
-  {
-    const double m = std::max(minClusterDistances(assignments[i]),
-                              lowerBounds(i));
-
-    // First bound test.
-    if (upperBounds(i) <= m)
-    {
-      ++hamerlyPruned;
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
+  // Each thread sums the points of its own clusters; the sums of the threads
+  // are added once all the points have been assigned.
+  size_t threads = 1;
+#ifdef _OPENMP
+  threads = (size_t) omp_get_max_threads();
+#endif
+  std::vector<arma::mat> localCentroids(threads);
+  std::vector<arma::Col<size_t>> localCounts(threads);
 
-    // Tighten upper bound.
-    upperBounds(i) = metric.Evaluate(dataset.col(i),
-                                     centroids.col(assignments[i]));
-    ++distanceCalculations;
+  size_t iterationCalculations = 0;
+  #pragma omp parallel reduction(+:hamerlyPruned, iterationCalculations)
+  {
+    size_t thread = 0;
+#ifdef _OPENMP
+    thread = (size_t) omp_get_thread_num();
+#endif
+    arma::mat& threadCentroids = localCentroids[thread];
+    arma::Col<size_t>& threadCounts = localCounts[thread];
+    threadCentroids.zeros(centroids.n_rows, centroids.n_cols);
+    threadCounts.zeros(centroids.n_cols);
 
-    // Second bound test.
-    if (upperBounds(i) <= m)
+    #pragma omp for schedule(dynamic, 256)
+    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
     {
-      newCentroids.col(assignments[i]) += dataset.col(i);
-      ++counts(assignments[i]);
-      continue;
-    }
+      const double m = std::max(minClusterDistances(assignments[i]),
+                                lowerBounds(i));
 
-    // The bounds failed.  So test against all other clusters.
-    // This is Hamerly's Point-All-Ctrs() function from the paper.
-    // We have to reset the lower bound first.
-    lowerBounds(i) = DBL_MAX;
-    for (size_t c = 0; c < centroids.n_cols; ++c)
-    {
-      if (c == assignments[i])
+      // First bound test.
+      if (upperBounds(i) <= m)
+      {
+        ++hamerlyPruned;
+        threadCentroids.unsafe_col(assignments[i]) +=
+            ConvTo<arma::vec>::From(dataset.col(i));
+        ++threadCounts(assignments[i]);
         continue;
+      }
 
-      const double dist = metric.Evaluate(dataset.col(i), centroids.col(c));
+      // Tighten upper bound.
+      upperBounds(i) = metric.Evaluate(dataset.col(i),
+                                       centroids.col(assignments[i]));
+      ++iterationCalculations;
 
-      // Is this a better cluster?  At this point, upperBounds[i] = d(i, c(i)).
-      if (dist < upperBounds(i))
+      // Second bound test.
+      if (upperBounds(i) <= m)
       {
-        // lowerBounds holds the second closest cluster.
-        lowerBounds(i) = upperBounds(i);
-        upperBounds(i) = dist;
-        assignments[i] = c;
+        threadCentroids.unsafe_col(assignments[i]) +=
+            ConvTo<arma::vec>::From(dataset.col(i));
+        ++threadCounts(assignments[i]);
+        continue;
       }
-      else if (dist < lowerBounds(i))
+
+      // The bounds failed.  So test against all other clusters.
+      // This is Hamerly's Point-All-Ctrs() function from the paper.
+      // We have to reset the lower bound first.
+      lowerBounds(i) = DBL_MAX;
+      for (size_t c = 0; c < centroids.n_cols; ++c)
       {
-        // This is a closer second-closest cluster.
-        lowerBounds(i) = dist;
+        if (c == assignments[i])
+          continue;
+
+        const double dist = metric.Evaluate(dataset.col(i), centroids.col(c));
+
+        // Is this a better cluster?  At this point,
+        // upperBounds[i] = d(i, c(i)).
+        if (dist < upperBounds(i))
+        {
+          // lowerBounds holds the second closest cluster.
+          lowerBounds(i) = upperBounds(i);
+          upperBounds(i) = dist;
+          assignments[i] = c;
+        }
+        else if (dist < lowerBounds(i))
+        {
+          // This is a closer second-closest cluster.
+          lowerBounds(i) = dist;
+        }
       }
+      iterationCalculations += centroids.n_cols - 1;
+
+      // Update new centroids.
+      threadCentroids.unsafe_col(assignments[i]) +=
+          ConvTo<arma::vec>::From(dataset.col(i));
+      ++threadCounts(assignments[i]);
     }
-    distanceCalculations += centroids.n_cols - 1;
+  }
+  distanceCalculations += iterationCalculations;
 
-    // Update new centroids.
-    newCentroids.col(assignments[i]) += dataset.col(i);
-    ++counts(assignments[i]);
+  // Combine the sums of the threads, in parallel over the centroids.
+  #pragma omp parallel for
+  for (omp_size_t c = 0; c < (omp_size_t) centroids.n_cols; ++c)
+  {
+    for (size_t t = 0; t < threads; ++t)
+    {
+      if (localCounts[t].n_elem == 0)
+        continue; // This thread never started.
+
+      newCentroids.unsafe_col(c) += localCentroids[t].unsafe_col(c);
+      counts[c] += localCounts[t][c];
+    }
   }
 
   // Normalize centroids and calculate cluster movement (contains parts of
@@ -158,7 +200,8 @@ double HamerlyKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
   }
 
   // Now update bounds (lines 3-8 of Update-Bounds()).
-  for (size_t i = 0; i < dataset.n_cols; ++i)
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
   {
     upperBounds(i) += centroidMovements(assignments[i]);
     if (assignments[i] == furthestMovingCluster)
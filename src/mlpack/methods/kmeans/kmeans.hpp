@@ -18,6 +18,8 @@
 #include "sample_initialization.hpp"
 #include "max_variance_new_cluster.hpp"
 #include "naive_kmeans.hpp"
+#include "blocked_assignment.hpp"
+#include "mini_batch_kmeans.hpp"
 
 #include <mlpack/core/tree/binary_space_tree.hpp>
 
@@ -155,6 +157,35 @@ class KMeans
                const bool initialAssignmentGuess = false,
                const bool initialCentroidGuess = false);
 
+  /**
+   * Perform mini-batch k-means clustering on a stream of data, which is given
+   * in chunks of points by the given source, so that datasets that do not fit
+   * in memory can be clustered in a single pass over them.  Unless
+   * initialGuess is true, the centroids are initialized from the first chunk
+   * with the InitialPartitionPolicy.  Each chunk then updates the centroids in
+   * batches of consecutive points, as MiniBatchKMeans::Update() does; the
+   * LloydStepType and the EmptyClusterPolicy are not used, and a cluster that
+   * receives no points keeps its centroid.
+   *
+   * @tparam ChunkSourceType Source of chunks, with a method
+   *      'bool Next(MatType& chunk)' that fills chunk with the next points and
+   *      returns false when there are none left (see ColumnChunkSource).
+   * @param source Source of the chunks of points to cluster.
+   * @param clusters Number of clusters to compute.
+   * @param centroids Matrix in which centroids are stored.
+   * @param initialGuess If true, then it is assumed that centroids contains the
+   *      initial cluster centroids.
+   * @param batchSize Number of consecutive points in each batch.
+   */
+  template<typename ChunkSourceType>
+  void ClusterStream(
+      ChunkSourceType& source,
+      const size_t clusters,
+      arma::mat& centroids,
+      const bool initialGuess = false,
+      const size_t batchSize =
+          MiniBatchKMeans<MetricType, MatType>::DefaultBatchSize);
+
   //! Get the maximum number of iterations.
   size_t MaxIterations() const { return maxIterations; }
   //! Set the maximum number of iterations.
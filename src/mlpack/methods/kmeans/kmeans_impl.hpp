@@ -14,6 +14,7 @@
 
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/util/sfinae_utility.hpp>
+#include <mlpack/core/util/conv_to.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -192,7 +193,8 @@ Cluster(const MatType& data,
       centroids.zeros(data.n_rows, clusters);
       for (size_t i = 0; i < data.n_cols; ++i)
       {
-        centroids.col(assignments[i]) += arma::vec(data.col(i));
+        centroids.col(assignments[i]) += arma::vec(
+            ConvTo<arma::vec>::From(data.col(i)));
         counts[assignments[i]]++;
       }
 
@@ -299,7 +301,8 @@ Cluster(const MatType& data,
     centroids.zeros(data.n_rows, clusters);
     for (size_t i = 0; i < data.n_cols; ++i)
     {
-      centroids.col(assignments[i]) += arma::vec(data.col(i));
+      centroids.col(assignments[i]) += arma::vec(
+          ConvTo<arma::vec>::From(data.col(i)));
       counts[assignments[i]]++;
     }
 
@@ -311,30 +314,110 @@ Cluster(const MatType& data,
   Cluster(data, clusters, centroids,
       initialAssignmentGuess || initialCentroidGuess);
 
-  // Calculate final assignments in parallel over the entire dataset.
+  // Calculate final assignments in parallel over the entire dataset, a block of
+  // points at a time.
   assignments.set_size(data.n_cols);
 
-  #pragma omp parallel for
-  for (omp_size_t i = 0; i < (omp_size_t) data.n_cols; ++i)
+  typedef BlockedAssignment<MetricType, MatType> AssignmentType;
+  const AssignmentType assignment(data, centroids, metric);
+  const size_t blockSize = AssignmentType::PointBlockSize;
+  const size_t blocks = (data.n_cols + blockSize - 1) / blockSize;
+
+  #pragma omp parallel for schedule(dynamic)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
   {
-    // Find the closest centroid to this point.
-    double minDistance = std::numeric_limits<double>::infinity();
-    size_t closestCluster = centroids.n_cols; // Invalid value.
+    const size_t begin = b * blockSize;
+    const size_t end = std::min((size_t) data.n_cols, begin + blockSize);
+    assignment.Assign(begin, end, assignments.memptr() + begin);
+  }
+}
 
-    for (size_t j = 0; j < centroids.n_cols; ++j)
-    {
-      const double distance = metric.Evaluate(data.col(i), centroids.col(j));
+/**
+ * Perform mini-batch k-means clustering on a stream of chunks of points.
+ */
+template<typename MetricType,
+         typename InitialPartitionPolicy,
+         typename EmptyClusterPolicy,
+         template<class, class> class LloydStepType,
+         typename MatType>
+template<typename ChunkSourceType>
+void KMeans<
+    MetricType,
+    InitialPartitionPolicy,
+    EmptyClusterPolicy,
+    LloydStepType,
+    MatType>::
+ClusterStream(ChunkSourceType& source,
+              const size_t clusters,
+              arma::mat& centroids,
+              const bool initialGuess,
+              const size_t batchSize)
+{
+  MatType chunk;
+  if (!source.Next(chunk))
+  {
+    Log::Warn << "KMeans::ClusterStream(): no points given." << std::endl;
+    return;
+  }
+
+  if (initialGuess)
+  {
+    if (centroids.n_cols != clusters)
+      Log::Fatal << "KMeans::ClusterStream(): wrong number of initial cluster "
+        << "centroids (" << centroids.n_cols << ", should be " << clusters
+        << ")!" << std::endl;
 
-      if (distance < minDistance)
+    if (centroids.n_rows != chunk.n_rows)
+      Log::Fatal << "KMeans::ClusterStream(): initial cluster centroids have "
+        << "wrong dimensionality (" << centroids.n_rows << ", should be "
+        << chunk.n_rows << ")!" << std::endl;
+  }
+  else
+  {
+    // The initial partition is found on the first chunk only.
+    arma::Row<size_t> assignments;
+    bool gotAssignments = GetInitialAssignmentsOrCentroids(partitioner, chunk,
+        clusters, assignments, centroids);
+    if (gotAssignments)
+    {
+      arma::Row<size_t> counts;
+      counts.zeros(clusters);
+      centroids.zeros(chunk.n_rows, clusters);
+      for (size_t i = 0; i < chunk.n_cols; ++i)
       {
-        minDistance = distance;
-        closestCluster = j;
+        centroids.col(assignments[i]) += arma::vec(
+            ConvTo<arma::vec>::From(chunk.col(i)));
+        counts[assignments[i]]++;
       }
-    }
 
-    Log::Assert(closestCluster != centroids.n_cols);
-    assignments[i] = closestCluster;
+      for (size_t i = 0; i < clusters; ++i)
+        if (counts[i] != 0)
+          centroids.col(i) /= counts[i];
+    }
   }
+
+  // The step only keeps a reference to the chunk, which is never sampled.
+  MiniBatchKMeans<MetricType, MatType> step(chunk, metric, batchSize);
+  size_t points = 0;
+  size_t chunks = 0;
+  double movement;
+  do
+  {
+    if (chunk.n_rows != centroids.n_rows)
+      Log::Fatal << "KMeans::ClusterStream(): chunk " << chunks << " has "
+          << "wrong dimensionality (" << chunk.n_rows << ", should be "
+          << centroids.n_rows << ")!" << std::endl;
+
+    movement = step.Update(chunk, centroids);
+    points += chunk.n_cols;
+    ++chunks;
+  } while (source.Next(chunk));
+
+  Log::Info << "KMeans::ClusterStream(): clustered " << points << " points in "
+      << chunks << " chunks; movement of the last batch " << movement << "."
+      << std::endl;
+  Log::Info << step.DistanceCalculations() << " distance calculations."
+      << std::endl;
 }
 
 template<typename MetricType,
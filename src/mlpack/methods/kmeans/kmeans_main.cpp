@@ -17,6 +17,8 @@
 #include "allow_empty_clusters.hpp"
 #include "kill_empty_clusters.hpp"
 #include "refined_start.hpp"
+#include "kmeans_plus_plus_initialization.hpp"
+#include "kmeans_parallel_initialization.hpp"
 #include "elkan_kmeans.hpp"
 #include "hamerly_kmeans.hpp"
 #include "pelleg_moore_kmeans.hpp"
@@ -49,14 +51,29 @@ PROGRAM_INFO("K-Means Clustering",
     "used in each sample, the " + PRINT_PARAM_STRING("percentage") +
     " parameter is used (it should be a value between 0.0 and 1.0)."
     "\n\n"
+    "The k-means++ approach (\"k-means++: the advantages of careful "
+    "seeding\", 2007) can instead be used with the " +
+    PRINT_PARAM_STRING("kmeans_plus_plus") + " parameter; it samples each "
+    "initial point in proportion to the squared distance to the points chosen "
+    "so far.  For large datasets, its parallel variant k-means|| (\"Scalable "
+    "k-means++\", 2012), which oversamples candidate points in a few passes "
+    "over the data and then clusters them, can be used with the " +
+    PRINT_PARAM_STRING("kmeans_parallel") + " parameter.  Both usually need "
+    "fewer Lloyd iterations than random initial points."
+    "\n\n"
     "There are several options available for the algorithm used for each Lloyd "
     "iteration, specified with the " + PRINT_PARAM_STRING("algorithm") + " "
     " option.  The standard O(kN) approach can be used ('naive').  Other "
     "options include the Pelleg-Moore tree-based algorithm ('pelleg-moore'), "
-    "Elkan's triangle-inequality based algorithm ('elkan'), Hamerly's "
-    "modification to Elkan's algorithm ('hamerly'), the dual-tree k-means "
-    "algorithm ('dualtree'), and the dual-tree k-means algorithm using the "
-    "cover tree ('dualtree-covertree')."
+    "Elkan's triangle-inequality based algorithm ('elkan'), which may keep its "
+    "bounds in single precision to halve their memory ('elkan-float'), "
+    "Hamerly's modification to Elkan's algorithm ('hamerly'), the dual-tree "
+    "k-means algorithm ('dualtree'), and the dual-tree k-means algorithm using "
+    "the cover tree ('dualtree-covertree').  The mini-batch algorithm "
+    "('minibatch') updates the centroids with a random sample of 1024 points "
+    "at each iteration instead of the whole dataset, and stops when the "
+    "centroids barely move; it is much faster on large datasets, but its "
+    "clustering is approximate."
     "\n\n"
     "The behavior for when an empty cluster is encountered can be modified with"
     " the " + PRINT_PARAM_STRING("allow_empty_clusters") + " option.  When "
@@ -71,6 +88,13 @@ PROGRAM_INFO("K-Means Clustering",
     "calculate; therefore, specifying either of these parameters will often "
     "accelerate runtime."
     "\n\n"
+    "With the " + PRINT_PARAM_STRING("single_precision") + " option, the "
+    "naive algorithm converts the dataset once to single precision (float32) "
+    "and clusters it in single precision, which halves its memory and the "
+    "memory traffic of the distance computations; only the sums of each block "
+    "of points are added up in double precision.  The dataset given back in "
+    "the output then holds the single-precision values."
+    "\n\n"
     "Initial clustering assignments may be specified using the " +
     PRINT_PARAM_STRING("initial_centroids") + " parameter, and the maximum "
     "number of iterations may be specified with the " +
@@ -140,9 +164,16 @@ PARAM_INT_IN("samplings", "Number of samplings to perform for refined start "
 PARAM_DOUBLE_IN("percentage", "Percentage of dataset to use for each refined "
     "start sampling (use when --refined_start is specified).", "p", 0.02);
 
+PARAM_FLAG("kmeans_plus_plus", "Use the k-means++ initialization strategy to "
+    "choose initial points.", "K");
+PARAM_FLAG("kmeans_parallel", "Use the parallel k-means|| initialization "
+    "strategy to choose initial points.", "L");
+
 PARAM_STRING_IN("algorithm", "Algorithm to use for the Lloyd iteration "
-    "('naive', 'pelleg-moore', 'elkan', 'hamerly', 'dualtree', or "
-    "'dualtree-covertree').", "a", "naive");
+    "('naive', 'pelleg-moore', 'elkan', 'elkan-float', 'hamerly', 'dualtree', "
+    "'dualtree-covertree', or 'minibatch').", "a", "naive");
+PARAM_FLAG("single_precision", "Cluster the dataset in single precision "
+    "(only with the 'naive' algorithm).", "f");
 
 // Given the type of initial partition policy, figure out the empty cluster
 // policy and run k-means.
@@ -157,7 +188,8 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp);
 // Given the template parameters, sanitize/load input and run k-means.
 template<typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
-         template<class, class> class LloydStepType>
+         template<class, class> class LloydStepType,
+         typename MatType = arma::mat>
 void RunKMeans(const InitialPartitionPolicy& ipp);
 
 static void mlpackMain()
@@ -171,6 +203,15 @@ static void mlpackMain()
   // Now, start building the KMeans type that we'll be using.  Start with the
   // initial partition policy.  The call to FindEmptyClusterPolicy<> results in
   // a call to RunKMeans<> and the algorithm is completed.
+  if (IO::HasParam("refined_start") + IO::HasParam("kmeans_plus_plus") +
+      IO::HasParam("kmeans_parallel") > 1)
+  {
+    Log::Fatal << "Can only pass one of " <<
+        PRINT_PARAM_STRING("refined_start") << ", " <<
+        PRINT_PARAM_STRING("kmeans_plus_plus") << ", or " <<
+        PRINT_PARAM_STRING("kmeans_parallel") << "!" << endl;
+  }
+
   if (IO::HasParam("refined_start"))
   {
     RequireParamValue<int>("samplings", [](int x) { return x > 0; }, true,
@@ -183,6 +224,16 @@ static void mlpackMain()
 
     FindEmptyClusterPolicy<RefinedStart>(RefinedStart(samplings, percentage));
   }
+  else if (IO::HasParam("kmeans_plus_plus"))
+  {
+    FindEmptyClusterPolicy<KMeansPlusPlusInitialization>(
+        KMeansPlusPlusInitialization());
+  }
+  else if (IO::HasParam("kmeans_parallel"))
+  {
+    FindEmptyClusterPolicy<KMeansParallelInitialization>(
+        KMeansParallelInitialization());
+  }
   else
   {
     FindEmptyClusterPolicy<SampleInitialization>(SampleInitialization());
@@ -212,13 +263,24 @@ void FindEmptyClusterPolicy(const InitialPartitionPolicy& ipp)
 template<typename InitialPartitionPolicy, typename EmptyClusterPolicy>
 void FindLloydStepType(const InitialPartitionPolicy& ipp)
 {
-  RequireParamInSet<string>("algorithm", { "elkan", "hamerly", "pelleg-moore",
-      "dualtree", "dualtree-covertree", "naive" }, true, "unknown k-means "
-      "algorithm");
+  RequireParamInSet<string>("algorithm", { "elkan", "elkan-float", "hamerly",
+      "pelleg-moore", "dualtree", "dualtree-covertree", "naive", "minibatch" },
+      true,
+      "unknown k-means algorithm");
 
   const string algorithm = IO::GetParam<string>("algorithm");
-  if (algorithm == "elkan")
+  if (IO::HasParam("single_precision"))
+  {
+    RequireParamInSet<string>("algorithm", { "naive" }, true,
+        "single precision is only available with the naive algorithm");
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans,
+        arma::fmat>(ipp);
+  }
+  else if (algorithm == "elkan")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, ElkanKMeans>(ipp);
+  else if (algorithm == "elkan-float")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
+        FloatBoundElkanKMeans>(ipp);
   else if (algorithm == "hamerly")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, HamerlyKMeans>(ipp);
   else if (algorithm == "pelleg-moore")
@@ -232,12 +294,47 @@ void FindLloydStepType(const InitialPartitionPolicy& ipp)
         CoverTreeDualTreeKMeans>(ipp);
   else if (algorithm == "naive")
     RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy, NaiveKMeans>(ipp);
+  else if (algorithm == "minibatch")
+    RunKMeans<InitialPartitionPolicy, EmptyClusterPolicy,
+        MiniBatchKMeans>(ipp);
+}
+
+// Take the dataset out of the input parameter.
+void LoadDataset(arma::mat& dataset)
+{
+  dataset = std::move(IO::GetParam<arma::mat>("input"));
+}
+
+// Convert the dataset once to the element type it is clustered in, and release
+// the input parameter, so that the dataset is only held once.
+template<typename eT>
+void LoadDataset(arma::Mat<eT>& dataset)
+{
+  dataset = arma::conv_to<arma::Mat<eT>>::from(
+      IO::GetParam<arma::mat>("input"));
+  IO::GetParam<arma::mat>("input").reset();
+}
+
+// Hand the dataset back in double precision for the output.
+arma::mat ToDoubles(arma::mat&& dataset)
+{
+  return std::move(dataset);
+}
+
+// Same as above, for a dataset clustered in another element type.
+template<typename eT>
+arma::mat ToDoubles(arma::Mat<eT>&& dataset)
+{
+  arma::mat converted = arma::conv_to<arma::mat>::from(dataset);
+  dataset.reset();
+  return converted;
 }
 
 // Given the template parameters, sanitize/load input and run k-means.
 template<typename InitialPartitionPolicy,
          typename EmptyClusterPolicy,
-         template<class, class> class LloydStepType>
+         template<class, class> class LloydStepType,
+         typename MatType>
 void RunKMeans(const InitialPartitionPolicy& ipp)
 {
   // Now, do validation of input options.
@@ -266,7 +363,9 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   RequireAtLeastOnePassed({ "in_place", "output", "centroid" }, false,
       "no results will be saved");
 
-  arma::mat dataset = IO::GetParam<arma::mat>("input");  // Load our dataset.
+  // Load our dataset, in the element type it is clustered in.
+  MatType dataset;
+  LoadDataset(dataset);
   arma::mat centroids;
 
   const bool initialCentroidGuess = IO::HasParam("initial_centroids");
@@ -278,8 +377,11 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
       clusters = centroids.n_cols;
 
     ReportIgnoredParam({{ "refined_start", true }}, "initial_centroids");
+    ReportIgnoredParam({{ "kmeans_plus_plus", true }}, "initial_centroids");
+    ReportIgnoredParam({{ "kmeans_parallel", true }}, "initial_centroids");
 
-    if (!IO::HasParam("refined_start"))
+    if (!IO::HasParam("refined_start") && !IO::HasParam("kmeans_plus_plus") &&
+        !IO::HasParam("kmeans_parallel"))
       Log::Info << "Using initial centroid guesses." << endl;
   }
 
@@ -287,14 +389,15 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
   KMeans<metric::EuclideanDistance,
          InitialPartitionPolicy,
          EmptyClusterPolicy,
-         LloydStepType> kmeans(maxIterations, metric::EuclideanDistance(), ipp);
+         LloydStepType,
+         MatType> kmeans(maxIterations, metric::EuclideanDistance(), ipp);
 
   if (IO::HasParam("output") || IO::HasParam("in_place"))
   {
     // We need to get the assignments.
     arma::Row<size_t> assignments;
-    kmeans.Cluster(dataset, clusters, assignments, centroids,
-        false, initialCentroidGuess);
+    kmeans.Cluster(dataset, clusters, assignments, centroids, false,
+        initialCentroidGuess);
     Timer::Stop("clustering");
 
     // Now figure out what to do with our results.
@@ -302,15 +405,16 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
     {
       // Add the column of assignments to the dataset; but we have to convert
       // them to type double first.
+      arma::mat output = ToDoubles(std::move(dataset));
       arma::rowvec converted(assignments.n_elem);
       for (size_t i = 0; i < assignments.n_elem; ++i)
         converted(i) = (double) assignments(i);
 
-      dataset.insert_rows(dataset.n_rows, converted);
+      output.insert_rows(output.n_rows, converted);
 
       // Save the dataset.
       IO::MakeInPlaceCopy("output", "input");
-      IO::GetParam<arma::mat>("output") = std::move(dataset);
+      IO::GetParam<arma::mat>("output") = std::move(output);
     }
     else
     {
@@ -324,14 +428,15 @@ void RunKMeans(const InitialPartitionPolicy& ipp)
       else
       {
         // Convert the assignments to doubles.
+        arma::mat output = ToDoubles(std::move(dataset));
         arma::rowvec converted(assignments.n_elem);
         for (size_t i = 0; i < assignments.n_elem; ++i)
           converted(i) = (double) assignments(i);
 
-        dataset.insert_rows(dataset.n_rows, converted);
+        output.insert_rows(output.n_rows, converted);
 
         // Now save, in the different file.
-        IO::GetParam<arma::mat>("output") = std::move(dataset);
+        IO::GetParam<arma::mat>("output") = std::move(output);
       }
     }
   }
@@ -0,0 +1,113 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization.hpp
+ *
+ * An implementation of the k-means|| (scalable k-means++) strategy for choosing
+ * initial centroids, which oversamples candidate centroids in a few passes over
+ * the data and then clusters the candidates.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+#include "kmeans_plus_plus_initialization.hpp"
+#include "blocked_assignment.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * The k-means|| initialization strategy, which is described in the following
+ * paper:
+ *
+ * @code
+ * @article{bahmani2012scalable,
+ *   title={Scalable k-means++},
+ *   author={Bahmani, Bahman and Moseley, Benjamin and Vattani, Andrea and
+ *       Kumar, Ravi and Vassilvitskii, Sergei},
+ *   journal={Proceedings of the VLDB Endowment},
+ *   volume={5},
+ *   number={7},
+ *   pages={622--633},
+ *   year={2012}
+ * }
+ * @endcode
+ *
+ * k-means++ needs one pass over the data for each centroid.  Instead, starting
+ * from one random point, each round of k-means|| keeps every point as a
+ * candidate with probability proportional to its squared distance to the
+ * closest candidate so far, so that about (oversampling * k) candidates are
+ * added in each round.  The paper proves that O(log n) rounds suffice, and
+ * finds that about five rounds are as good in practice.  Each candidate is then
+ * weighted by the number of points closest to it, and the k centroids are
+ * chosen from the weighted candidates with k-means++ and refined with a few
+ * weighted Lloyd iterations.
+ *
+ * The passes over the data are parallel: the distances are updated in parallel
+ * over the points, and the points are assigned to the candidates with
+ * BlockedAssignment.
+ */
+class KMeansParallelInitialization
+{
+ public:
+  /**
+   * Create the KMeansParallelInitialization object, optionally specifying the
+   * oversampling factor and the number of rounds.
+   *
+   * @param oversampling Expected number of candidates added in each round,
+   *     relative to the number of clusters.
+   * @param rounds Number of rounds of sampling.
+   */
+  KMeansParallelInitialization(const double oversampling = 2.0,
+                               const size_t rounds = 5) :
+      oversampling(oversampling), rounds(rounds) { }
+
+  /**
+   * Initialize the centroids matrix by choosing centroids from the data matrix
+   * with the k-means|| strategy.
+   *
+   * @tparam MatType Type of data (arma::mat, arma::fmat or arma::sp_mat).
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  void Cluster(const MatType& data,
+               const size_t clusters,
+               arma::mat& centroids);
+
+  //! Get the oversampling factor.
+  double Oversampling() const { return oversampling; }
+  //! Modify the oversampling factor.
+  double& Oversampling() { return oversampling; }
+
+  //! Get the number of rounds.
+  size_t Rounds() const { return rounds; }
+  //! Modify the number of rounds.
+  size_t& Rounds() { return rounds; }
+
+  //! The number of weighted Lloyd iterations on the candidates.
+  static const size_t LloydIterations = 10;
+
+ private:
+  //! The expected number of candidates added in each round, relative to the
+  //! number of clusters.
+  double oversampling;
+  //! The number of rounds of sampling.
+  size_t rounds;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "kmeans_parallel_initialization_impl.hpp"
+
+#endif
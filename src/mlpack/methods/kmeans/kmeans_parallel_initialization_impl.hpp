@@ -0,0 +1,139 @@
+/**
+ * @file methods/kmeans/kmeans_parallel_initialization_impl.hpp
+ *
+ * Implementation of the k-means|| initialization strategy
+ * (KMeansParallelInitialization).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PARALLEL_INITIALIZATION_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "kmeans_parallel_initialization.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MatType>
+void KMeansParallelInitialization::Cluster(const MatType& data,
+                                           const size_t clusters,
+                                           arma::mat& centroids)
+{
+  // Sample the candidates.  The first one is a random point.
+  std::vector<size_t> candidates(1, math::RandInt(0, data.n_cols));
+  arma::vec distances(data.n_cols);
+  distances.fill(std::numeric_limits<double>::infinity());
+  size_t updated = 0;
+  for (size_t r = 0; r < rounds; ++r)
+  {
+    // Update the squared distance of each point to its closest candidate with
+    // the candidates of the last round.
+    const size_t end = candidates.size();
+    #pragma omp parallel for
+    for (omp_size_t p = 0; p < (omp_size_t) data.n_cols; ++p)
+    {
+      for (size_t c = updated; c < end; ++c)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(p), data.col(candidates[c]));
+        if (distance < distances[p])
+          distances[p] = distance;
+      }
+    }
+    updated = end;
+
+    // Every point is already a candidate if the cost is zero.
+    const double cost = arma::accu(distances);
+    if (!(cost > 0.0))
+      break;
+
+    const double scale = oversampling * clusters / cost;
+    for (size_t p = 0; p < data.n_cols; ++p)
+    {
+      if (distances[p] > 0.0 && math::Random() < scale * distances[p])
+        candidates.push_back(p);
+    }
+  }
+
+  // With too few candidates, there is nothing to choose from.
+  if (candidates.size() <= clusters)
+  {
+    KMeansPlusPlusInitialization::Cluster(data, clusters, centroids);
+    return;
+  }
+
+  arma::mat candidateCentroids(data.n_rows, candidates.size());
+  for (size_t c = 0; c < candidates.size(); ++c)
+  {
+    candidateCentroids.col(c) =
+        ConvTo<arma::vec>::From(data.col(candidates[c]));
+  }
+
+  // Weight each candidate by the number of points closest to it.
+  metric::EuclideanDistance metric;
+  arma::Col<size_t> assignments(data.n_cols);
+  {
+    typedef BlockedAssignment<metric::EuclideanDistance, MatType>
+        AssignmentType;
+    const AssignmentType assignment(data, candidateCentroids, metric);
+    const size_t blockSize = AssignmentType::PointBlockSize;
+    const size_t blocks = (data.n_cols + blockSize - 1) / blockSize;
+
+    #pragma omp parallel for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+    {
+      const size_t begin = b * blockSize;
+      const size_t end = std::min((size_t) data.n_cols, begin + blockSize);
+      assignment.Assign(begin, end, assignments.memptr() + begin);
+    }
+  }
+
+  arma::vec weights(candidates.size(), arma::fill::zeros);
+  for (size_t i = 0; i < data.n_cols; ++i)
+    weights[assignments[i]] += 1.0;
+
+  // Choose the centroids among the weighted candidates, and refine them with
+  // weighted Lloyd iterations.
+  KMeansPlusPlusInitialization::WeightedCluster(candidateCentroids, weights,
+      clusters, centroids);
+
+  arma::Col<size_t> candidateAssignments(candidates.size());
+  for (size_t iteration = 0; iteration < LloydIterations; ++iteration)
+  {
+    const BlockedAssignment<metric::EuclideanDistance, arma::mat> assignment(
+        candidateCentroids, centroids, metric);
+    assignment.Assign(0, candidates.size(), candidateAssignments.memptr());
+
+    arma::mat sums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+    arma::vec totals(centroids.n_cols, arma::fill::zeros);
+    for (size_t c = 0; c < candidates.size(); ++c)
+    {
+      sums.col(candidateAssignments[c]) += weights[c] *
+          candidateCentroids.col(c);
+      totals[candidateAssignments[c]] += weights[c];
+    }
+
+    // A centroid without candidates stays where it is.
+    arma::mat newCentroids(centroids);
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      if (totals[j] > 0.0)
+        newCentroids.col(j) = sums.col(j) / totals[j];
+    }
+
+    const bool converged = arma::approx_equal(newCentroids, centroids,
+        "absdiff", 0.0);
+    centroids = std::move(newCentroids);
+    if (converged)
+      break;
+  }
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -0,0 +1,145 @@
+/**
+ * @file methods/kmeans/kmeans_plus_plus_initialization.hpp
+ *
+ * An implementation of the k-means++ strategy for choosing initial centroids,
+ * which samples each centroid in proportion to the squared distance of the
+ * points to the centroids chosen so far.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_KMEANS_PLUS_PLUS_INITIALIZATION_HPP
+#define MLPACK_METHODS_KMEANS_KMEANS_PLUS_PLUS_INITIALIZATION_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/math/random.hpp>
+#include <mlpack/core/metrics/lmetric.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * The k-means++ initialization strategy, which is described in the following
+ * paper:
+ *
+ * @code
+ * @inproceedings{arthur2007k,
+ *   title={k-means++: the advantages of careful seeding},
+ *   author={Arthur, David and Vassilvitskii, Sergei},
+ *   booktitle={Proceedings of the Eighteenth Annual ACM-SIAM Symposium on
+ *       Discrete Algorithms (SODA '07)},
+ *   pages={1027--1035},
+ *   year={2007}
+ * }
+ * @endcode
+ *
+ * The first centroid is a random point, and each of the others is a point
+ * sampled with probability proportional to its squared distance to the closest
+ * centroid chosen so far.  The distance of each point to its closest centroid
+ * is kept and updated in parallel as each centroid is chosen, so k centroids
+ * take O(nk) distance calculations.
+ */
+class KMeansPlusPlusInitialization
+{
+ public:
+  //! Empty constructor, required by the InitialPartitionPolicy type definition.
+  KMeansPlusPlusInitialization() { }
+
+  /**
+   * Initialize the centroids matrix by sampling points from the data matrix
+   * with the k-means++ strategy.
+   *
+   * @param data Dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  inline static void Cluster(const MatType& data,
+                             const size_t clusters,
+                             arma::mat& centroids)
+  {
+    WeightedCluster(data, arma::vec(data.n_cols, arma::fill::ones), clusters,
+        centroids);
+  }
+
+  /**
+   * Initialize the centroids matrix with the k-means++ strategy, where each
+   * point counts as many times as its weight.  KMeansParallelInitialization
+   * uses this to choose the centroids among its weighted candidates.
+   *
+   * @param data Dataset.
+   * @param weights Weight of each point of the dataset.
+   * @param clusters Number of clusters.
+   * @param centroids Matrix to put initial centroids into.
+   */
+  template<typename MatType>
+  static void WeightedCluster(const MatType& data,
+                              const arma::vec& weights,
+                              const size_t clusters,
+                              arma::mat& centroids)
+  {
+    centroids.set_size(data.n_rows, clusters);
+
+    // The squared distance of each point to its closest centroid so far.
+    arma::vec distances(data.n_cols);
+    distances.fill(std::numeric_limits<double>::infinity());
+    for (size_t i = 0; i < clusters; ++i)
+    {
+      // The first centroid is sampled in proportion to the weights alone.
+      const size_t index = (i == 0) ? Sample(weights) :
+          Sample(weights % distances);
+      centroids.col(i) = ConvTo<arma::vec>::From(data.col(index));
+
+      if (i + 1 == clusters)
+        break;
+
+      #pragma omp parallel for
+      for (omp_size_t p = 0; p < (omp_size_t) data.n_cols; ++p)
+      {
+        const double distance = metric::SquaredEuclideanDistance::Evaluate(
+            data.col(p), centroids.col(i));
+        if (distance < distances[p])
+          distances[p] = distance;
+      }
+    }
+  }
+
+ private:
+  /**
+   * Sample an index with probability proportional to the given nonnegative
+   * values, or uniformly if they are all zero.
+   *
+   * @param values Unnormalized probability of each index.
+   */
+  static size_t Sample(const arma::vec& values)
+  {
+    const double total = arma::accu(values);
+    if (!(total > 0.0) || !std::isfinite(total))
+      return math::RandInt(0, values.n_elem);
+
+    const double threshold = math::Random() * total;
+    double sum = 0.0;
+    size_t last = 0;
+    for (size_t i = 0; i < values.n_elem; ++i)
+    {
+      if (values[i] <= 0.0)
+        continue;
+
+      sum += values[i];
+      last = i;
+      if (threshold < sum)
+        return i;
+    }
+
+    // Rounding may leave the threshold just above the sum.
+    return last;
+  }
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
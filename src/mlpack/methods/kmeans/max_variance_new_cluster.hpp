@@ -15,6 +15,7 @@
 #define MLPACK_METHODS_KMEANS_MAX_VARIANCE_NEW_CLUSTER_HPP
 
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/conv_to.hpp>
 
 namespace mlpack {
 namespace kmeans {
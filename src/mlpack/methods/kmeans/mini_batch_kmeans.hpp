@@ -0,0 +1,206 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans.hpp
+ *
+ * An implementation of mini-batch k-means, which updates the centroids with a
+ * small random sample of the dataset at each iteration, instead of with the
+ * whole dataset.  This is described in the following paper:
+ *
+ * @code
+ * @inproceedings{sculley2010web,
+ *   title={Web-scale k-means clustering},
+ *   author={Sculley, David},
+ *   booktitle={Proceedings of the 19th International Conference on World Wide
+ *       Web (WWW '10)},
+ *   pages={1177--1178},
+ *   year={2010}
+ * }
+ * @endcode
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+
+namespace mlpack {
+namespace kmeans {
+
+/**
+ * This is an implementation of a single mini-batch step of k-means, for use as
+ * the LloydStepType of the KMeans class.  Each iteration samples a batch of
+ * points from the dataset, assigns each to its closest centroid, and moves each
+ * centroid towards the mean of its points in the batch, with a learning rate of
+ * one over the number of points that the centroid has received so far.  Thus
+ * each centroid is the mean of all the points it has been given, and the cost
+ * of an iteration does not depend on the size of the dataset.
+ *
+ * The counts given back by Iterate() are those numbers of points, so a cluster
+ * is only empty until it receives its first point.  The iterations stop when
+ * the squared movement of the centroids falls below the tolerance times the
+ * variance of the dataset (estimated from the first batch).
+ *
+ * The same updates can be made with consecutive batches of points with
+ * Update(), which is how KMeans::ClusterStream() clusters streams of data.
+ *
+ * @tparam MetricType Type of metric used with this implementation.
+ * @tparam MatType Matrix type (arma::mat or arma::fmat).
+ */
+template<typename MetricType, typename MatType>
+class MiniBatchKMeans
+{
+ public:
+  /**
+   * Construct the MiniBatchKMeans object with the given dataset and metric.
+   *
+   * @param dataset Dataset to sample the batches from.
+   * @param metric Instantiated metric.
+   * @param batchSize Number of points in each batch.
+   * @param tolerance Squared movement of the centroids, relative to the
+   *     variance of the dataset, below which the iterations stop.
+   */
+  MiniBatchKMeans(const MatType& dataset,
+                  MetricType& metric,
+                  const size_t batchSize = DefaultBatchSize,
+                  const double tolerance = DefaultTolerance);
+
+  /**
+   * Run a single mini-batch iteration, updating the given centroids into the
+   * newCentroids matrix.  The movement of the centroids is returned, or 0 if
+   * the iterations have converged.
+   *
+   * @param centroids Current cluster centroids.
+   * @param newCentroids New cluster centroids.
+   * @param counts Number of points that each cluster has received so far.
+   */
+  double Iterate(const arma::mat& centroids,
+                 arma::mat& newCentroids,
+                 arma::Col<size_t>& counts);
+
+  /**
+   * Update the given centroids with the given points, taken in consecutive
+   * batches, and return the movement of the centroids in the last batch.
+   *
+   * @param points Points to update the centroids with.
+   * @param centroids Centroids to update.
+   */
+  double Update(const MatType& points, arma::mat& centroids);
+
+  //! Get the number of points that each cluster has received so far.
+  const arma::Col<size_t>& CenterCounts() const { return centerCounts; }
+
+  //! Get the number of points in each batch.
+  size_t BatchSize() const { return batchSize; }
+  //! Modify the number of points in each batch.
+  size_t& BatchSize() { return batchSize; }
+
+  //! Get the tolerance on the squared movement of the centroids.
+  double Tolerance() const { return tolerance; }
+  //! Modify the tolerance on the squared movement of the centroids.
+  double& Tolerance() { return tolerance; }
+
+  //! Get the number of distance calculations made so far.
+  size_t DistanceCalculations() const { return distanceCalculations; }
+
+  //! The default number of points in each batch.
+  static const size_t DefaultBatchSize = 1024;
+  //! The default tolerance on the squared movement of the centroids.
+  static constexpr double DefaultTolerance = 1e-4;
+
+ private:
+  /**
+   * Move the centroids towards the given columns of the given points, and
+   * return the squared movement of the centroids.
+   *
+   * @param points Matrix holding the points of the batch.
+   * @param indices Columns of the points of the batch.
+   * @param centroids Centroids to update.
+   */
+  double UpdateBatch(const MatType& points,
+                     const arma::Col<size_t>& indices,
+                     arma::mat& centroids);
+
+  //! The dataset.
+  const MatType& dataset;
+  //! The instantiated metric.
+  MetricType& metric;
+  //! The number of points in each batch.
+  size_t batchSize;
+  //! The tolerance on the squared movement of the centroids.
+  double tolerance;
+
+  //! The number of points that each cluster has received so far.
+  arma::Col<size_t> centerCounts;
+  //! The mean variance of the dimensions of the dataset, or a negative value
+  //! until it has been estimated.
+  double variance;
+
+  //! Number of distance calculations.
+  size_t distanceCalculations;
+};
+
+/**
+ * A source of chunks of consecutive columns of a matrix, for
+ * KMeans::ClusterStream().  Used with a matrix that maps a file (see
+ * data::MappedMatrix), each chunk is read once, in order, so the whole matrix
+ * never has to be held in memory.
+ *
+ * Other sources of chunks (for instance, data::CSVChunkSource, or ones that
+ * read from a database or a socket) need only the same Next() method.
+ */
+template<typename MatType>
+class ColumnChunkSource
+{
+ public:
+  /**
+   * Create a source of chunks of the given matrix, which must outlive it.
+   *
+   * @param matrix Matrix to take the chunks from.
+   * @param chunkSize Number of columns in each chunk.
+   */
+  ColumnChunkSource(const MatType& matrix, const size_t chunkSize = 65536) :
+      matrix(matrix),
+      chunkSize(std::max(chunkSize, (size_t) 1)),
+      position(0)
+  { }
+
+  /**
+   * Fill the given matrix with the next chunk of columns, and return false if
+   * there are none left.
+   *
+   * @param chunk Matrix to fill with the next chunk.
+   */
+  bool Next(MatType& chunk)
+  {
+    if (position >= matrix.n_cols)
+      return false;
+
+    const size_t end = std::min(matrix.n_cols, position + chunkSize);
+    chunk = matrix.cols(position, end - 1);
+    position = end;
+    return true;
+  }
+
+  //! Start again from the first column.
+  void Reset() { position = 0; }
+
+ private:
+  //! The matrix to take the chunks from.
+  const MatType& matrix;
+  //! The number of columns in each chunk.
+  size_t chunkSize;
+  //! The first column of the next chunk.
+  size_t position;
+};
+
+} // namespace kmeans
+} // namespace mlpack
+
+// Include implementation.
+#include "mini_batch_kmeans_impl.hpp"
+
+#endif
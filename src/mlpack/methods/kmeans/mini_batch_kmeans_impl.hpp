@@ -0,0 +1,164 @@
+/**
+ * @file methods/kmeans/mini_batch_kmeans_impl.hpp
+ *
+ * Implementation of mini-batch k-means (MiniBatchKMeans).
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+#define MLPACK_METHODS_KMEANS_MINI_BATCH_KMEANS_IMPL_HPP
+
+// In case it hasn't been included yet.
+#include "mini_batch_kmeans.hpp"
+
+namespace mlpack {
+namespace kmeans {
+
+template<typename MetricType, typename MatType>
+MiniBatchKMeans<MetricType, MatType>::MiniBatchKMeans(const MatType& dataset,
+                                                      MetricType& metric,
+                                                      const size_t batchSize,
+                                                      const double tolerance) :
+    dataset(dataset),
+    metric(metric),
+    batchSize(batchSize),
+    tolerance(tolerance),
+    variance(-1.0),
+    distanceCalculations(0)
+{ /* Nothing to do. */ }
+
+// Run a single iteration.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Iterate(
+    const arma::mat& centroids,
+    arma::mat& newCentroids,
+    arma::Col<size_t>& counts)
+{
+  if (centerCounts.n_elem != centroids.n_cols)
+    centerCounts.zeros(centroids.n_cols);
+
+  // Sample the batch.  The indices are sorted so that the points are read in
+  // the order in which they are stored.
+  const size_t size = std::max(std::min(batchSize, (size_t) dataset.n_cols),
+      (size_t) 1);
+  arma::Col<size_t> indices(size);
+  for (size_t i = 0; i < size; ++i)
+  {
+    indices[i] = std::min((size_t) (math::Random() * dataset.n_cols),
+        (size_t) dataset.n_cols - 1);
+  }
+  indices = arma::sort(indices);
+
+  // The tolerance is relative to the variance of the dataset, which is
+  // estimated from the first batch.
+  if (variance < 0.0)
+  {
+    arma::vec mean(dataset.n_rows, arma::fill::zeros);
+    arma::vec squares(dataset.n_rows, arma::fill::zeros);
+    for (size_t i = 0; i < size; ++i)
+    {
+      const arma::vec point = ConvTo<arma::vec>::From(dataset.col(indices[i]));
+      mean += point;
+      squares += arma::square(point);
+    }
+    mean /= size;
+    squares /= size;
+    variance = std::max(arma::mean(squares - arma::square(mean)), 0.0);
+  }
+
+  newCentroids = centroids;
+  const double movement = UpdateBatch(dataset, indices, newCentroids);
+  counts = centerCounts;
+
+  if (movement <= tolerance * variance)
+    return 0.0;
+
+  return std::sqrt(movement);
+}
+
+// Update the centroids with consecutive batches of the given points.
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::Update(const MatType& points,
+                                                   arma::mat& centroids)
+{
+  if (centerCounts.n_elem != centroids.n_cols)
+    centerCounts.zeros(centroids.n_cols);
+
+  const size_t size = std::max(batchSize, (size_t) 1);
+  double movement = 0.0;
+  for (size_t first = 0; first < points.n_cols; first += size)
+  {
+    const size_t last = std::min((size_t) points.n_cols, first + size);
+    const arma::Col<size_t> indices =
+        arma::regspace<arma::Col<size_t>>(first, last - 1);
+    movement = UpdateBatch(points, indices, centroids);
+  }
+
+  return std::sqrt(movement);
+}
+
+template<typename MetricType, typename MatType>
+double MiniBatchKMeans<MetricType, MatType>::UpdateBatch(
+    const MatType& points,
+    const arma::Col<size_t>& indices,
+    arma::mat& centroids)
+{
+  // Find the closest centroid to each point of the batch, in parallel.
+  arma::Col<size_t> assignments(indices.n_elem);
+  #pragma omp parallel for
+  for (omp_size_t i = 0; i < (omp_size_t) indices.n_elem; ++i)
+  {
+    double minDistance = std::numeric_limits<double>::infinity();
+    size_t closestCluster = centroids.n_cols; // Invalid value.
+
+    for (size_t j = 0; j < centroids.n_cols; ++j)
+    {
+      const double distance = metric.Evaluate(points.col(indices[i]),
+          centroids.unsafe_col(j));
+      if (distance < minDistance)
+      {
+        minDistance = distance;
+        closestCluster = j;
+      }
+    }
+
+    Log::Assert(closestCluster != centroids.n_cols);
+    assignments[i] = closestCluster;
+  }
+  distanceCalculations += centroids.n_cols * indices.n_elem;
+
+  arma::mat sums(centroids.n_rows, centroids.n_cols, arma::fill::zeros);
+  arma::Col<size_t> batchCounts(centroids.n_cols, arma::fill::zeros);
+  for (size_t i = 0; i < indices.n_elem; ++i)
+  {
+    sums.unsafe_col(assignments[i]) +=
+        ConvTo<arma::vec>::From(points.col(indices[i]));
+    batchCounts[assignments[i]]++;
+  }
+
+  // Each centroid stays the mean of all the points it has received: it moves
+  // towards the mean of its points in the batch by the fraction of its points
+  // that are in the batch.
+  double movement = 0.0;
+  for (size_t j = 0; j < centroids.n_cols; ++j)
+  {
+    if (batchCounts[j] == 0)
+      continue;
+
+    centerCounts[j] += batchCounts[j];
+    const arma::vec step = (sums.col(j) - (double) batchCounts[j] *
+        centroids.col(j)) / (double) centerCounts[j];
+    centroids.col(j) += step;
+    movement += arma::dot(step, step);
+  }
+
+  return movement;
+}
+
+} // namespace kmeans
+} // namespace mlpack
+
+#endif
@@ -15,6 +15,8 @@
 #ifndef MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #define MLPACK_METHODS_KMEANS_NAIVE_KMEANS_HPP
 #include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/conv_to.hpp>
+#include "blocked_assignment.hpp"
 
 namespace mlpack {
 namespace kmeans {
@@ -25,6 +27,14 @@ namespace kmeans {
  * looking for the mlpack::kmeans::KMeans class instead of this one.  This class
  * is used by KMeans as the actual implementation of the Lloyd iteration.
  *
+ * The points are assigned to their centroids in blocks with BlockedAssignment,
+ * so with the Euclidean distance on dense matrices, the distances come from
+ * matrix multiplications.  Each thread sums the points of its own clusters, and
+ * the sums are combined at the end of the iteration.  The points are summed in
+ * the element type of the dataset (so a single-precision dataset is clustered
+ * in single precision), and only the sums of each block of points are added in
+ * double precision, which keeps the rounding errors of the sums small.
+ *
  * @param MetricType Type of metric used with this implementation.
  * @param MatType Matrix type (arma::mat or arma::sp_mat).
  */
@@ -36,47 +36,89 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
                                                  arma::mat& newCentroids,
                                                  arma::Col<size_t>& counts)
 {
+  typedef typename MatType::elem_type ElemType;
+
   newCentroids.zeros(centroids.n_rows, centroids.n_cols);
   counts.zeros(centroids.n_cols);
 
-  // Find the closest centroid to each point and update the new centroids.
-  // Computed in parallel over the complete dataset
-  #pragma omp parallel
+  // Find the closest centroid to each point, a block of points at a time, and
+  // update the new centroids.  The points of a block are summed in the element
+  // type of the dataset, and the sums of each block are added to the sums of
+  // the thread in double precision; the sums of the threads are added once all
+  // the points have been assigned.
+  typedef BlockedAssignment<MetricType, MatType> AssignmentType;
+  const AssignmentType assignment(dataset, centroids, metric);
+  const size_t blockSize = AssignmentType::PointBlockSize;
+  const size_t blocks = (dataset.n_cols + blockSize - 1) / blockSize;
+
+  size_t threads = 1;
+#ifdef _OPENMP
+  threads = (size_t) omp_get_max_threads();
+#endif
+  std::vector<arma::mat> localCentroids(threads);
+  std::vector<arma::Col<size_t>> localCounts(threads);
+
+  size_t iterationCalculations = 0;
+  #pragma omp parallel reduction(+:iterationCalculations)
   {
-    // The current state of the K-means is private for each thread
-    arma::mat localCentroids(centroids.n_rows, centroids.n_cols,
+    size_t thread = 0;
+#ifdef _OPENMP
+    thread = (size_t) omp_get_thread_num();
+#endif
+    arma::mat& threadCentroids = localCentroids[thread];
+    arma::Col<size_t>& threadCounts = localCounts[thread];
+    threadCentroids.zeros(centroids.n_rows, centroids.n_cols);
+    threadCounts.zeros(centroids.n_cols);
+    std::vector<size_t> assignments(blockSize);
+
+    // The sums and counts of the points of the current block, and the
+    // clusters they belong to.
+    arma::Mat<ElemType> blockCentroids(centroids.n_rows, centroids.n_cols,
         arma::fill::zeros);
-    arma::Col<size_t> localCounts(centroids.n_cols, arma::fill::zeros);
+    std::vector<size_t> blockCounts(centroids.n_cols, 0);
+    std::vector<size_t> blockClusters;
+    blockClusters.reserve(blockSize);
 
-    #pragma omp for
-    for (omp_size_t i = 0; i < (omp_size_t) dataset.n_cols; ++i)
+    #pragma omp for schedule(dynamic)
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
     {
-      // Find the closest centroid to this point.
-      double minDistance = std::numeric_limits<double>::infinity();
-      size_t closestCluster = centroids.n_cols; // Invalid value.
+      const size_t begin = b * blockSize;
+      const size_t end = std::min((size_t) dataset.n_cols, begin + blockSize);
+      iterationCalculations += assignment.Assign(begin, end,
+          assignments.data());
 
-      for (size_t j = 0; j < centroids.n_cols; ++j)
+      // Update the closest centroid of each point.
+      for (size_t i = begin; i < end; ++i)
       {
-        const double distance = metric.Evaluate(dataset.col(i),
-            centroids.unsafe_col(j));
-        if (distance < minDistance)
-        {
-          minDistance = distance;
-          closestCluster = j;
-        }
+        const size_t closestCluster = assignments[i - begin];
+        if (blockCounts[closestCluster]++ == 0)
+          blockClusters.push_back(closestCluster);
+        blockCentroids.unsafe_col(closestCluster) += dataset.col(i);
       }
 
-      Log::Assert(closestCluster != centroids.n_cols);
-
-      // We now have the minimum distance centroid index.  Update that centroid.
-      localCentroids.unsafe_col(closestCluster) += dataset.col(i);
-      localCounts(closestCluster)++;
+      for (const size_t c : blockClusters)
+      {
+        threadCentroids.unsafe_col(c) +=
+            ConvTo<arma::vec>::From(blockCentroids.unsafe_col(c));
+        threadCounts[c] += blockCounts[c];
+        blockCentroids.unsafe_col(c).zeros();
+        blockCounts[c] = 0;
+      }
+      blockClusters.clear();
     }
-    // Combine calculated state from each thread
-    #pragma omp critical
+  }
+
+  // Combine the sums of the threads, in parallel over the centroids.
+  #pragma omp parallel for
+  for (omp_size_t j = 0; j < (omp_size_t) centroids.n_cols; ++j)
+  {
+    for (size_t t = 0; t < threads; ++t)
     {
-      newCentroids += localCentroids;
-      counts += localCounts;
+      if (localCounts[t].n_elem == 0)
+        continue; // This thread never started.
+
+      newCentroids.unsafe_col(j) += localCentroids[t].unsafe_col(j);
+      counts[j] += localCounts[t][j];
     }
   }
 
@@ -85,7 +127,7 @@ double NaiveKMeans<MetricType, MatType>::Iterate(const arma::mat& centroids,
     if (counts(i) != 0)
       newCentroids.col(i) /= counts(i);
 
-  distanceCalculations += centroids.n_cols * dataset.n_cols;
+  distanceCalculations += iterationCalculations;
 
   // Calculate cluster distortion for this iteration.
   double cNorm = 0.0;
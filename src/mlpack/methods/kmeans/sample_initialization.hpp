@@ -16,6 +16,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/math/random.hpp>
+#include <mlpack/core/util/conv_to.hpp>
 
 namespace mlpack {
 namespace kmeans {
@@ -44,7 +45,7 @@ class SampleInitialization
     {
       // Randomly sample a point.
       const size_t index = math::RandInt(0, data.n_cols);
-      centroids.col(i) = data.col(index);
+      centroids.col(i) = ConvTo<arma::vec>::From(data.col(index));
     }
   }
 };
@@ -909,7 +909,8 @@ void LSHSearch<SortPolicy, MatType>::Search(
 
   size_t avgIndicesReturned = 0;
 
-  Timer::Start("computing_neighbors");
+  static const TimerID computingNeighbors = Timer::ID("computing_neighbors");
+  Timer::Start(computingNeighbors);
 
   // Parallelization to process more than one query at a time.
   #pragma omp parallel for \
@@ -936,7 +937,7 @@ void LSHSearch<SortPolicy, MatType>::Search(
     BaseCase(i, refIndices, k, querySet, resultingNeighbors, distances);
   }
 
-  Timer::Stop("computing_neighbors");
+  Timer::Stop(computingNeighbors);
 
   distanceEvaluations += avgIndicesReturned;
   avgIndicesReturned /= querySet.n_cols;
@@ -975,7 +976,8 @@ Search(const size_t k,
 
   size_t avgIndicesReturned = 0;
 
-  Timer::Start("computing_neighbors");
+  static const TimerID computingNeighbors = Timer::ID("computing_neighbors");
+  Timer::Start(computingNeighbors);
 
   // Parallelization to process more than one query at a time.
   #pragma omp parallel for \
@@ -1002,7 +1004,7 @@ Search(const size_t k,
     BaseCase(i, refIndices, k, resultingNeighbors, distances);
   }
 
-  Timer::Stop("computing_neighbors");
+  Timer::Stop(computingNeighbors);
 
   distanceEvaluations += avgIndicesReturned;
   avgIndicesReturned /= referenceSet.n_cols;
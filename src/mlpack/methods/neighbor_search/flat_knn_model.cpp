@@ -0,0 +1,165 @@
+/**
+ * @file methods/neighbor_search/flat_knn_model.cpp
+ *
+ * Implementation of FlatKNNModel.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#include "flat_knn_model.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+FlatKNNModel::FlatKNNModel(const std::string& filename) :
+    file(filename),
+    tree(util::CheckFlatFileHeader(file, "KNNModel"),
+         file.Size() - sizeof(util::FlatFileHeader)),
+    dataset(const_cast<double*>(tree.Dataset()), tree.Dimensionality(),
+            tree.NumPoints(), false, true)
+{
+  // Nothing to do.
+}
+
+void FlatKNNModel::Save(const NSModel<NearestNeighborSort>& model,
+                        const std::string& filename)
+{
+  const NSType<NearestNeighborSort, tree::KDTree>* ns =
+      model.SearchObject<tree::KDTree>();
+  if (ns == NULL || model.SearchMode() == NAIVE_MODE)
+    Log::Fatal << "Only models using a kd-tree can be saved as flat files!"
+        << std::endl;
+  if (model.RandomBasis())
+    Log::Fatal << "Models using a random basis cannot be saved as flat files!"
+        << std::endl;
+  if (model.HasUpdates())
+    Log::Fatal << "Models with inserted or removed points must be compacted "
+        << "before they are saved as flat files!" << std::endl;
+
+  // The flat file maps the points of the tree straight to their ids.
+  std::vector<size_t> ids = ns->OldFromNewReferences();
+  if (!model.Ids().is_empty())
+  {
+    for (size_t i = 0; i < ids.size(); ++i)
+      ids[i] = model.Ids()[ids[i]];
+  }
+
+  std::ofstream stream(filename.c_str(), std::ios::binary);
+  if (!stream.is_open())
+    Log::Fatal << "Cannot open file '" << filename << "' for writing!"
+        << std::endl;
+
+  util::WriteFlatFileHeader(stream, "KNNModel");
+  tree::FlatKDTree::Write(stream, ns->ReferenceTree(), ids);
+
+  if (!stream.good())
+    Log::Fatal << "Error writing to file '" << filename << "'!" << std::endl;
+}
+
+void FlatKNNModel::Search(arma::mat&& querySet,
+                          const size_t k,
+                          arma::Mat<size_t>& neighbors,
+                          arma::mat& distances) const
+{
+  Log::Info << "Searching for " << k << " neighbors with single-tree "
+      << "kd-tree search on flat model file..." << std::endl;
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  std::vector<Candidate> heap;
+  heap.reserve(k + 1);
+  for (size_t i = 0; i < querySet.n_cols; ++i)
+  {
+    heap.clear();
+    SearchNode(0, querySet.colptr(i), k, heap);
+    std::sort_heap(heap.begin(), heap.end());
+
+    for (size_t j = 0; j < k; ++j)
+    {
+      if (j < heap.size())
+      {
+        neighbors(j, i) = tree.OldFromNew(heap[j].second);
+        distances(j, i) = std::sqrt(heap[j].first);
+      }
+      else
+      {
+        neighbors(j, i) = SIZE_MAX;
+        distances(j, i) = DBL_MAX;
+      }
+    }
+  }
+}
+
+void FlatKNNModel::SearchNode(const size_t index,
+                              const double* query,
+                              const size_t k,
+                              std::vector<Candidate>& heap) const
+{
+  const tree::FlatKDTree::Node& node = tree.GetNode(index);
+  const size_t dim = tree.Dimensionality();
+
+  if (node.left == 0)
+  {
+    // Leaf: compare against every point.
+    for (size_t i = node.begin; i < node.begin + node.count; ++i)
+    {
+      const double* point = tree.Dataset() + i * dim;
+      double distance = 0.0;
+      for (size_t d = 0; d < dim; ++d)
+        distance += (point[d] - query[d]) * (point[d] - query[d]);
+
+      if (heap.size() < k)
+      {
+        heap.push_back(Candidate(distance, i));
+        std::push_heap(heap.begin(), heap.end());
+      }
+      else if (distance < heap.front().first)
+      {
+        std::pop_heap(heap.begin(), heap.end());
+        heap.back() = Candidate(distance, i);
+        std::push_heap(heap.begin(), heap.end());
+      }
+    }
+
+    return;
+  }
+
+  // Visit the closer child first; prune children that cannot hold a better
+  // candidate.
+  const double leftDistance = MinDistance(node.left, query);
+  const double rightDistance = MinDistance(node.right, query);
+  const size_t first = (leftDistance <= rightDistance) ? node.left :
+      node.right;
+  const size_t second = (leftDistance <= rightDistance) ? node.right :
+      node.left;
+  const double firstDistance = std::min(leftDistance, rightDistance);
+  const double secondDistance = std::max(leftDistance, rightDistance);
+
+  if (heap.size() < k || firstDistance < heap.front().first)
+    SearchNode(first, query, k, heap);
+  if (heap.size() < k || secondDistance < heap.front().first)
+    SearchNode(second, query, k, heap);
+}
+
+double FlatKNNModel::MinDistance(const size_t index, const double* query) const
+{
+  const double* lo = tree.Lo(index);
+  const double* hi = tree.Hi(index);
+
+  double distance = 0.0;
+  for (size_t d = 0; d < tree.Dimensionality(); ++d)
+  {
+    const double below = lo[d] - query[d];
+    const double above = query[d] - hi[d];
+    const double gap = std::max(0.0, std::max(below, above));
+    distance += gap * gap;
+  }
+
+  return distance;
+}
+
+} // namespace neighbor
+} // namespace mlpack
@@ -0,0 +1,91 @@
+/**
+ * @file methods/neighbor_search/flat_knn_model.hpp
+ *
+ * A read-only k-nearest-neighbor model that searches a kd-tree directly in a
+ * memory-mapped flat model file.
+ *
+ * mlpack is free software; you may redistribute it and/or modify it under the
+ * terms of the 3-clause BSD license.  You should have received a copy of the
+ * 3-clause BSD license along with mlpack.  If not, see
+ * http://www.opensource.org/licenses/BSD-3-Clause for more information.
+ */
+#ifndef MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_KNN_MODEL_HPP
+#define MLPACK_METHODS_NEIGHBOR_SEARCH_FLAT_KNN_MODEL_HPP
+
+#include <mlpack/prereqs.hpp>
+#include <mlpack/core/util/mapped_file.hpp>
+#include <mlpack/core/tree/binary_space_tree.hpp>
+
+#include "ns_model.hpp"
+
+namespace mlpack {
+namespace neighbor {
+
+/**
+ * FlatKNNModel answers exact k-nearest-neighbor queries with the Euclidean
+ * distance from a kd-tree stored in a flat model file, as written by Save().
+ * The file is mapped read-only and is never copied, so loading it takes no
+ * time and every process that loads the same file shares its pages.
+ */
+class FlatKNNModel
+{
+ public:
+  /**
+   * Map the given flat model file.
+   *
+   * @param filename Name of the file written by Save().
+   */
+  FlatKNNModel(const std::string& filename);
+
+  /**
+   * Write the kd-tree of the given model to a flat model file.  The model must
+   * use a kd-tree without a random basis.
+   *
+   * @param model Model to save.
+   * @param filename Name of the file to write.
+   */
+  static void Save(const NSModel<NearestNeighborSort>& model,
+                   const std::string& filename);
+
+  //! Get the reference set, in the order of the tree.
+  const arma::mat& Dataset() const { return dataset; }
+
+  /**
+   * Search for the k nearest neighbors of each query point, using single-tree
+   * search on the mapped tree.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param neighbors Matrix to store the indices of the neighbors in.
+   * @param distances Matrix to store the distances to the neighbors in.
+   */
+  void Search(arma::mat&& querySet,
+              const size_t k,
+              arma::Mat<size_t>& neighbors,
+              arma::mat& distances) const;
+
+ private:
+  //! A candidate neighbor: its squared distance and its index in the tree.
+  typedef std::pair<double, size_t> Candidate;
+
+  //! Recurse into the given node, keeping the k best candidates in a max-heap.
+  void SearchNode(const size_t index,
+                  const double* query,
+                  const size_t k,
+                  std::vector<Candidate>& heap) const;
+
+  //! Get the squared minimum distance from the query to the given node.
+  double MinDistance(const size_t index, const double* query) const;
+
+  //! The mapped file.
+  util::MappedFile file;
+  //! The tree inside the mapped file.
+  tree::FlatKDTree tree;
+  //! The reference set, aliasing the mapped file.
+  arma::mat dataset;
+};
+
+} // namespace neighbor
+} // namespace mlpack
+
+#endif
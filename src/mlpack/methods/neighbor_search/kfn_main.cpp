@@ -106,6 +106,10 @@ PARAM_DOUBLE_IN("percentage", "If specified, will do approximate furthest "
     "neighbor search. Must be in the range (0,1] (decimal form). Resultant "
     "neighbors will be at least (p*100) % of the distance as the true furthest "
     "neighbor.", "p", 1);
+PARAM_INT_IN("threads", "Number of threads to build trees and search with "
+    "(if 0, as many as OpenMP allows).  Exact search gives the same results "
+    "whatever the number of threads; approximate dual-tree search uses a single "
+    "thread.", "j", 0);
 
 static void mlpackMain()
 {
@@ -152,6 +156,10 @@ static void mlpackMain()
       true, "leaf size must be positive");
   const int lsInt = IO::GetParam<int>("leaf_size");
 
+  // Sanity check on the number of threads.
+  RequireParamValue<int>("threads", [](int x) { return x >= 0; }, true,
+      "number of threads must not be negative");
+
   // Sanity check on epsilon.
   double epsilon = IO::GetParam<double>("epsilon");
   RequireParamValue<double>("epsilon", [](double x)
@@ -235,6 +243,8 @@ static void mlpackMain()
 
     arma::mat referenceSet = std::move(IO::GetParam<arma::mat>("reference"));
 
+    // The tree is built with as many threads as the search uses.
+    util::ScopedThreads scope((size_t) IO::GetParam<int>("threads"));
     kfn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
         epsilon);
   }
@@ -259,6 +269,8 @@ static void mlpackMain()
         << " dataset)." << endl;
   }
 
+  kfn->NumThreads() = (size_t) IO::GetParam<int>("threads");
+
   // Perform search, if desired.
   if (IO::HasParam("k"))
   {
@@ -75,6 +75,8 @@ PROGRAM_INFO("k-Nearest-Neighbors Search",
 PARAM_MATRIX_IN("reference", "Matrix containing the reference dataset.", "r");
 PARAM_MATRIX_OUT("distances", "Matrix to output distances into.", "d");
 PARAM_UMATRIX_OUT("neighbors", "Matrix to output neighbors into.", "n");
+PARAM_COL_OUT("base_cases", "Number of base cases (distance evaluations) "
+    "computed for each query point (not given for dual-tree search).", "B");
 PARAM_MATRIX_IN("true_distances", "Matrix of true distances to compute "
     "the effective error (average relative error) (it is printed when -v is "
     "specified).", "D");
@@ -107,13 +109,32 @@ PARAM_DOUBLE_IN("rho", "Balance threshold (only valid for spill trees).", "b",
 
 PARAM_FLAG("random_basis", "Before tree-building, project the data onto a "
     "random orthogonal basis.", "R");
+PARAM_FLAG("pack_nodes", "Pack the nodes of kd-trees and ball trees into one "
+    "block of memory in depth-first order, which can make searches faster "
+    "without changing their results.", "P");
 PARAM_INT_IN("seed", "Random seed (if 0, std::time(NULL) is used).", "s", 0);
 
 // Search settings.
 PARAM_STRING_IN("algorithm", "Type of neighbor search: 'naive', 'single_tree', "
-    "'dual_tree', 'greedy'.", "a", "dual_tree");
+    "'dual_tree', 'greedy', 'best_first'.", "a", "dual_tree");
 PARAM_DOUBLE_IN("epsilon", "If specified, will do approximate nearest neighbor "
     "search with given relative error.", "e", 0);
+PARAM_INT_IN("threads", "Number of threads to build trees and search with "
+    "(if 0, as many as OpenMP allows).  Exact search gives the same results "
+    "whatever the number of threads; approximate dual-tree search uses a single "
+    "thread.", "j", 0);
+PARAM_INT_IN("max_base_cases", "Maximum number of base cases (distance "
+    "evaluations) for each query point in 'best_first' search, which visits "
+    "the nodes of the tree in order of their distance to the query point "
+    "(if 0, there is no limit and the search is exact).  It must be at least "
+    "k, or k times rerank with 'int8' quantization.", "c", 0);
+PARAM_STRING_IN("quantization", "Storage of the reference points scanned by "
+    "naive, single-tree, greedy and best-first search: 'none' (the exact "
+    "points) or 'int8' (8-bit codes within each leaf of the tree, whose best "
+    "candidates are ranked again with the exact points).", "Q", "none");
+PARAM_INT_IN("rerank", "Number of candidates ranked again with exact "
+    "distances for each query point with 'int8' quantization, as a multiple "
+    "of k.", "K", 4);
 
 static void mlpackMain()
 {
@@ -127,6 +148,14 @@ static void mlpackMain()
 
   ReportIgnoredParam({{ "input_model", true }}, "tree_type");
   ReportIgnoredParam({{ "input_model", true }}, "random_basis");
+  ReportIgnoredParam({{ "input_model", true }}, "pack_nodes");
+  if (IO::HasParam("pack_nodes") && IO::HasParam("reference") &&
+      IO::GetParam<string>("tree_type") != "kd" &&
+      IO::GetParam<string>("tree_type") != "ball")
+  {
+    Log::Warn << PRINT_PARAM_STRING("pack_nodes") << " ignored because the "
+        << "tree type is neither 'kd' nor 'ball'." << endl;
+  }
   ReportIgnoredParam({{ "input_model", true }}, "tau");
   ReportIgnoredParam({{ "input_model", true }}, "rho");
   if (IO::HasParam("input_model") && IO::HasParam("leaf_size"))
@@ -150,6 +179,7 @@ static void mlpackMain()
   // If the user specifies output files but no k, they should be warned.
   ReportIgnoredParam({{ "k", false }}, "neighbors");
   ReportIgnoredParam({{ "k", false }}, "distances");
+  ReportIgnoredParam({{ "k", false }}, "base_cases");
   ReportIgnoredParam({{ "k", false }}, "true_neighbors");
   ReportIgnoredParam({{ "k", false }}, "true_distances");
   ReportIgnoredParam({{ "k", false }}, "query");
@@ -159,6 +189,51 @@ static void mlpackMain()
       true, "leaf size must be positive");
   const int lsInt = IO::GetParam<int>("leaf_size");
 
+  // Sanity check on the number of threads.
+  RequireParamValue<int>("threads", [](int x) { return x >= 0; }, true,
+      "number of threads must not be negative");
+
+  // Sanity check on the maximum number of base cases.
+  RequireParamValue<int>("max_base_cases", [](int x) { return x >= 0; }, true,
+      "maximum number of base cases must not be negative");
+  if (IO::GetParam<string>("algorithm") != "best_first")
+  {
+    ReportIgnoredParam("max_base_cases",
+        "best-first search is not being used");
+  }
+
+  // Sanity checks on quantization.
+  RequireParamInSet<string>("quantization", { "none", "int8" }, true,
+      "unknown quantization");
+  RequireParamValue<int>("rerank", [](int x) { return x > 0; }, true,
+      "rerank must be positive");
+  const bool quantized = (IO::GetParam<string>("quantization") == "int8");
+  if (quantized && IO::GetParam<string>("algorithm") == "dual_tree")
+  {
+    Log::Fatal << "Quantization cannot be used with dual-tree search; use "
+        << "'naive', 'single_tree', 'greedy' or 'best_first' as "
+        << PRINT_PARAM_STRING("algorithm") << "." << endl;
+  }
+  if (!quantized)
+    ReportIgnoredParam("rerank", "quantization is not being used");
+
+  // A smaller budget would leave some of the candidates of a query point
+  // unfilled.
+  if (IO::GetParam<string>("algorithm") == "best_first" &&
+      IO::HasParam("k") && IO::GetParam<int>("k") > 0 &&
+      IO::GetParam<int>("max_base_cases") > 0)
+  {
+    const size_t candidates = (size_t) IO::GetParam<int>("k") *
+        (quantized ? (size_t) IO::GetParam<int>("rerank") : 1);
+    if ((size_t) IO::GetParam<int>("max_base_cases") < candidates)
+    {
+      Log::Fatal << "Invalid " << PRINT_PARAM_STRING("max_base_cases") << ": "
+          << IO::GetParam<int>("max_base_cases") << "; must be 0 or at least "
+          << (quantized ? "k times rerank" : "k") << " (" << candidates
+          << ")." << endl;
+    }
+  }
+
   // Sanity check on tau.
   RequireParamValue<double>("tau", [](double x) { return x >= 0.0; },
       true, "tau must be positive");
@@ -186,7 +261,7 @@ static void mlpackMain()
 
   const string algorithm = IO::GetParam<string>("algorithm");
   RequireParamInSet<string>("algorithm", { "naive", "single_tree", "dual_tree",
-      "greedy" }, true, "unknown neighbor search algorithm");
+      "greedy", "best_first" }, true, "unknown neighbor search algorithm");
   NeighborSearchMode searchMode = DUAL_TREE_MODE;
 
   if (algorithm == "naive")
@@ -197,6 +272,8 @@ static void mlpackMain()
     searchMode = DUAL_TREE_MODE;
   else if (algorithm == "greedy")
     searchMode = GREEDY_SINGLE_TREE_MODE;
+  else if (algorithm == "best_first")
+    searchMode = BEST_FIRST_SINGLE_TREE_MODE;
 
   if (IO::HasParam("reference"))
   {
@@ -245,6 +322,7 @@ static void mlpackMain()
     knn->TreeType() = tree;
     knn->RandomBasis() = randomBasis;
     knn->LeafSize() = size_t(lsInt);
+    knn->PackNodes() = IO::HasParam("pack_nodes");
     knn->Tau() = tau;
     knn->Rho() = rho;
 
@@ -253,6 +331,8 @@ static void mlpackMain()
 
     arma::mat referenceSet = std::move(IO::GetParam<arma::mat>("reference"));
 
+    // The tree is built with as many threads as the search uses.
+    util::ScopedThreads scope((size_t) IO::GetParam<int>("threads"));
     knn->BuildModel(std::move(referenceSet), size_t(lsInt), searchMode,
         epsilon);
   }
@@ -277,6 +357,21 @@ static void mlpackMain()
         << " dataset)." << endl;
   }
 
+  // The overlapping leaves of spill trees would give the same neighbor several
+  // times to a best-first search.
+  if (searchMode == BEST_FIRST_SINGLE_TREE_MODE &&
+      knn->TreeType() == KNNModel::SPILL_TREE)
+  {
+    if (IO::HasParam("reference"))
+      delete knn;
+    Log::Fatal << "Best-first search cannot be used with spill trees." << endl;
+  }
+
+  knn->NumThreads() = (size_t) IO::GetParam<int>("threads");
+  knn->MaxBaseCases() = (size_t) IO::GetParam<int>("max_base_cases");
+  knn->Quantized() = quantized;
+  knn->RerankFactor() = (size_t) IO::GetParam<int>("rerank");
+
   // Perform search, if desired.
   if (IO::HasParam("k"))
   {
@@ -302,10 +397,10 @@ static void mlpackMain()
     // Sanity check on k value: must be greater than 0, must be less than or
     // equal to the number of reference points.  Since it is unsigned,
     // we only test the upper bound.
-    if (k > knn->Dataset().n_cols)
+    if (k > knn->NumPoints())
     {
       // Clean memory if needed before crashing.
-      const size_t referencePoints = knn->Dataset().n_cols;
+      const size_t referencePoints = knn->NumPoints();
       if (IO::HasParam("reference"))
         delete knn;
       Log::Fatal << "Invalid k: " << k << "; must be greater than 0 and less "
@@ -315,10 +410,10 @@ static void mlpackMain()
 
     // Sanity check on k value: must not be equal to the number of reference
     // points when query data has not been provided.
-    if (!IO::HasParam("query") && k == knn->Dataset().n_cols)
+    if (!IO::HasParam("query") && k == knn->NumPoints())
     {
       // Clean memory if needed before crashing.
-      const size_t referencePoints = knn->Dataset().n_cols;
+      const size_t referencePoints = knn->NumPoints();
       if (IO::HasParam("reference"))
         delete knn;
       Log::Fatal << "Invalid k: " << k << "; must be less than the number of "
@@ -386,6 +481,8 @@ static void mlpackMain()
     // Save output.
     IO::GetParam<arma::Mat<size_t>>("neighbors") = std::move(neighbors);
     IO::GetParam<arma::mat>("distances") = std::move(distances);
+    IO::GetParam<arma::vec>("base_cases") =
+        arma::conv_to<arma::vec>::from(knn->QueryBaseCases());
   }
 
   IO::GetParam<KNNModel*>("output_model") = knn;
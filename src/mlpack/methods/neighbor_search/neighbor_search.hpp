@@ -24,6 +24,7 @@
 #include "neighbor_search_stat.hpp"
 #include "sort_policies/nearest_neighbor_sort.hpp"
 #include "neighbor_search_rules.hpp"
+#include <mlpack/core/tree/quantized_leaves.hpp>
 
 namespace mlpack {
 // Neighbor-search routines. These include all-nearest-neighbors and
@@ -40,7 +41,8 @@ enum NeighborSearchMode
   NAIVE_MODE,
   SINGLE_TREE_MODE,
   DUAL_TREE_MODE,
-  GREEDY_SINGLE_TREE_MODE
+  GREEDY_SINGLE_TREE_MODE,
+  BEST_FIRST_SINGLE_TREE_MODE
 };
 
 /**
@@ -311,6 +313,11 @@ class NeighborSearch
   //! Return the number of node combination scores during the last search.
   size_t Scores() const { return scores; }
 
+  //! Return the number of base cases evaluated for each query point during the
+  //! last search.  This is empty after a dual-tree search, where the work is
+  //! shared between query points.
+  const arma::Col<size_t>& QueryBaseCases() const { return queryBaseCases; }
+
   //! Access the search mode.
   NeighborSearchMode SearchMode() const { return searchMode; }
   //! Modify the search mode.
@@ -321,6 +328,36 @@ class NeighborSearch
   //! Modify the relative error to be considered in approximate search.
   double& Epsilon() { return epsilon; }
 
+  //! Access the number of threads used by Search(); 0 means as many as
+  //! OpenMP would use by default.
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads used by Search(); 0 means as many as OpenMP
+  //! would use by default.
+  size_t& NumThreads() { return numThreads; }
+
+  //! Access the maximum number of base cases evaluated for each query point in
+  //! best-first single-tree search; 0 means there is no limit.
+  size_t MaxBaseCases() const { return maxBaseCases; }
+  //! Modify the maximum number of base cases evaluated for each query point in
+  //! best-first single-tree search; 0 means there is no limit.
+  size_t& MaxBaseCases() { return maxBaseCases; }
+
+  //! Access whether naive, single-tree, greedy and best-first search compute
+  //! the base cases with 8-bit quantized reference points (see
+  //! tree::QuantizedLeaves), ranking the candidates found again with their
+  //! exact points.  Only the Euclidean distance supports this.
+  bool Quantized() const { return quantized; }
+  //! Modify whether naive, single-tree, greedy and best-first search compute
+  //! the base cases with 8-bit quantized reference points.
+  bool& Quantized() { return quantized; }
+
+  //! Access the number of candidates kept for each query point in quantized
+  //! search, as a multiple of k, to be ranked again with exact distances.
+  size_t RerankFactor() const { return rerankFactor; }
+  //! Modify the number of candidates kept for each query point in quantized
+  //! search, as a multiple of k, to be ranked again with exact distances.
+  size_t& RerankFactor() { return rerankFactor; }
+
   //! Access the reference dataset.
   const MatType& ReferenceSet() const { return *referenceSet; }
 
@@ -329,6 +366,10 @@ class NeighborSearch
   //! Modify the reference tree.
   Tree& ReferenceTree() { return *referenceTree; }
 
+  //! Access the original index of each point of the reference tree's dataset.
+  const std::vector<size_t>& OldFromNewReferences() const
+  { return oldFromNewReferences; }
+
   //! Serialize the NeighborSearch model.
   template<typename Archive>
   void serialize(Archive& ar, const unsigned int /* version */);
@@ -349,15 +390,89 @@ class NeighborSearch
   //! Instantiation of metric.
   MetricType metric;
 
+  //! The number of threads to search with; 0 means the OpenMP default.
+  size_t numThreads;
+
+  //! The maximum number of base cases for each query point in best-first
+  //! search; 0 means there is no limit.
+  size_t maxBaseCases;
+
+  //! If true, the base cases of point-wise searches use quantized points.
+  bool quantized;
+  //! The number of candidates of quantized search, as a multiple of k.
+  size_t rerankFactor;
+  //! The quantized reference points; built at the first quantized search.
+  tree::QuantizedLeaves<MatType> quantizedReferences;
+
   //! The total number of base cases.
   size_t baseCases;
   //! The total number of scores (applicable for non-naive search).
   size_t scores;
+  //! The number of base cases evaluated for each query point (applicable for
+  //! all but dual-tree search).
+  arma::Col<size_t> queryBaseCases;
 
   //! If this is true, the reference tree bounds need to be reset on a call to
   //! Search() without a query set.
   bool treeNeedsReset;
 
+  //! Number of query points searched by each thread at a time in single-tree,
+  //! greedy and naive search.
+  static const size_t QueryBlockSize = 256;
+  //! The number of subtrees the query tree is split into for dual-tree
+  //! search, so that they can be searched in parallel.
+  static const size_t QuerySubtrees = 256;
+  //! Query trees with at most this many points are not split; neither are
+  //! subtrees split into smaller ones than this.
+  static const size_t QuerySubtreeMinSize = 1024;
+  //! Number of reference points quantized together when there are no leaves
+  //! to quantize them in.
+  static const size_t QuantizedBlockSize = 64;
+
+  //! Get the number of threads to search with.
+  int SearchThreads() const;
+
+  /**
+   * Search for the k best neighbors of each point of the query set with one
+   * traversal of the reference tree per point, or with brute force, as given
+   * by the search mode (which must not be DUAL_TREE_MODE).  The query points
+   * are split into blocks that are searched in parallel, each with its own
+   * rules object.  The search of each point does not depend on the others, so
+   * the results are exactly those of a serial search.
+   *
+   * @param querySet Set of query points.
+   * @param k Number of neighbors to search for.
+   * @param sameSet Whether the query set is the reference set.
+   * @param neighbors Matrix to store the (unmapped) neighbors into.
+   * @param distances Matrix to store the distances into.
+   */
+  void SearchPoints(const MatType& querySet,
+                    const size_t k,
+                    const bool sameSet,
+                    arma::Mat<size_t>& neighbors,
+                    arma::mat& distances);
+
+  /**
+   * Search for the k best neighbors of each point of the query tree with
+   * dual-tree traversals.  If the tree type allows it, the query tree is split
+   * into subtrees that are searched in parallel, each with its own rules
+   * object.  The neighbor distances are the same as those of a single
+   * traversal of the whole query tree, but neighbors tied at the same
+   * distance may be reported in a different order (or, at the k'th neighbor,
+   * be another of the tied points).
+   *
+   * @param queryTree Tree built on the query points.
+   * @param k Number of neighbors to search for.
+   * @param sameSet Whether the query set is the reference set.
+   * @param neighbors Matrix to store the (unmapped) neighbors into.
+   * @param distances Matrix to store the distances into.
+   */
+  void SearchTree(Tree& queryTree,
+                  const size_t k,
+                  const bool sameSet,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances);
+
   //! The NSModel class should have access to internal members.
   template<typename SortPol>
   friend class TrainVisitor;
@@ -15,6 +15,7 @@
 
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/tree/greedy_single_tree_traverser.hpp>
+#include <mlpack/core/tree/best_first_single_tree_traverser.hpp>
 #include "neighbor_search_rules.hpp"
 #include <mlpack/core/tree/spill_tree/is_spill_tree.hpp>
 
@@ -66,6 +67,10 @@ SingleTreeTraversalType>::NeighborSearch(MatType referenceSetIn,
     searchMode(mode),
     epsilon(epsilon),
     metric(metric),
+    numThreads(0),
+    maxBaseCases(0),
+    quantized(false),
+    rerankFactor(4),
     baseCases(0),
     scores(0),
     treeNeedsReset(false)
@@ -93,6 +98,10 @@ SingleTreeTraversalType>::NeighborSearch(Tree referenceTree,
     searchMode(mode),
     epsilon(epsilon),
     metric(metric),
+    numThreads(0),
+    maxBaseCases(0),
+    quantized(false),
+    rerankFactor(4),
     baseCases(0),
     scores(0),
     treeNeedsReset(false)
@@ -119,6 +128,10 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
     searchMode(mode),
     epsilon(epsilon),
     metric(metric),
+    numThreads(0),
+    maxBaseCases(0),
+    quantized(false),
+    rerankFactor(4),
     baseCases(0),
     scores(0),
     treeNeedsReset(false)
@@ -129,7 +142,7 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearchMode mode,
   // Build the tree on the empty dataset, if necessary.
   if (mode != NAIVE_MODE)
   {
-    referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+    referenceTree = BuildTree<Tree>(std::move(MatType()),
         oldFromNewReferences);
     referenceSet = &referenceTree->Dataset();
   }
@@ -153,8 +166,14 @@ SingleTreeTraversalType>::NeighborSearch(const NeighborSearch& other) :
     searchMode(other.searchMode),
     epsilon(other.epsilon),
     metric(other.metric),
+    numThreads(other.numThreads),
+    maxBaseCases(other.maxBaseCases),
+    quantized(other.quantized),
+    rerankFactor(other.rerankFactor),
+    quantizedReferences(other.quantizedReferences),
     baseCases(other.baseCases),
     scores(other.scores),
+    queryBaseCases(other.queryBaseCases),
     treeNeedsReset(false)
 {
   // Nothing else to do.
@@ -177,8 +196,14 @@ SingleTreeTraversalType>::NeighborSearch(NeighborSearch&& other) :
     searchMode(other.searchMode),
     epsilon(other.epsilon),
     metric(std::move(other.metric)),
+    numThreads(other.numThreads),
+    maxBaseCases(other.maxBaseCases),
+    quantized(other.quantized),
+    rerankFactor(other.rerankFactor),
+    quantizedReferences(std::move(other.quantizedReferences)),
     baseCases(other.baseCases),
     scores(other.scores),
+    queryBaseCases(std::move(other.queryBaseCases)),
     treeNeedsReset(other.treeNeedsReset)
 {
   // Clear the other model.
@@ -230,8 +255,14 @@ NeighborSearch<SortPolicy,
   searchMode = other.searchMode;
   epsilon = other.epsilon;
   metric = other.metric;
+  numThreads = other.numThreads;
+  maxBaseCases = other.maxBaseCases;
+  quantized = other.quantized;
+  rerankFactor = other.rerankFactor;
+  quantizedReferences = other.quantizedReferences;
   baseCases = other.baseCases;
   scores = other.scores;
+  queryBaseCases = other.queryBaseCases;
   treeNeedsReset = false;
 }
 
@@ -272,15 +303,21 @@ NeighborSearch<SortPolicy,
   searchMode = other.searchMode;
   epsilon = other.epsilon;
   metric = other.metric;
+  numThreads = other.numThreads;
+  maxBaseCases = other.maxBaseCases;
+  quantized = other.quantized;
+  rerankFactor = other.rerankFactor;
+  quantizedReferences = std::move(other.quantizedReferences);
   baseCases = other.baseCases;
   scores = other.scores;
+  queryBaseCases = std::move(other.queryBaseCases);
   treeNeedsReset = other.treeNeedsReset;
 
   // Reset the other object.  Clean memory if needed.
   if (!other.referenceTree)
     delete other.referenceSet;
 
-  other.referenceTree = BuildTree<Tree>(std::move(arma::mat()),
+  other.referenceTree = BuildTree<Tree>(std::move(MatType()),
       other.oldFromNewReferences);
   other.referenceSet = &other.referenceTree->Dataset();
   other.searchMode = DUAL_TREE_MODE,
@@ -319,6 +356,9 @@ template<typename SortPolicy,
 void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
 DualTreeTraversalType, SingleTreeTraversalType>::Train(MatType referenceSetIn)
 {
+  // The quantized points will be built again on the new points.
+  quantizedReferences.Clear();
+
   // Clean up the old tree, if we built one.
   if (referenceTree)
   {
@@ -359,6 +399,9 @@ DualTreeTraversalType, SingleTreeTraversalType>::Train(Tree referenceTree)
     throw std::invalid_argument("cannot train on given reference tree when "
         "naive search (without trees) is desired");
 
+  // The quantized points will be built again on the new points.
+  quantizedReferences.Clear();
+
   if (this->referenceTree)
   {
     oldFromNewReferences.clear();
@@ -427,108 +470,26 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       neighborPtr = new arma::Mat<size_t>; // Reference indices need mapping.
   }
 
-  // Set the size of the neighbor and distance matrices.
-  neighborPtr->set_size(k, querySet.n_cols);
-  distancePtr->set_size(k, querySet.n_cols);
-
-  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-
-  switch (searchMode)
+  if (searchMode == DUAL_TREE_MODE)
   {
-    case NAIVE_MODE:
-    {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
-
-      // The naive brute-force traversal.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
-
-      baseCases += querySet.n_cols * referenceSet->n_cols;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
-      break;
-    }
-    case SINGLE_TREE_MODE:
-    {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric, epsilon);
-
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
-
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
-
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
-      break;
-    }
-    case DUAL_TREE_MODE:
+    // Build the query tree.
+    Timer::Stop("computing_neighbors");
+    Timer::Start("tree_building");
+    Tree* queryTree;
     {
-      // Build the query tree.
-      Timer::Stop("computing_neighbors");
-      Timer::Start("tree_building");
-      Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
-      Timer::Stop("tree_building");
-      Timer::Start("computing_neighbors");
-
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, queryTree->Dataset(), k, metric, epsilon);
-
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
-
-      traverser.Traverse(*queryTree, *referenceTree);
-
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
-
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
-
-      delete queryTree;
-      break;
+      util::ScopedThreads scope(numThreads);
+      queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
     }
-    case GREEDY_SINGLE_TREE_MODE:
-    {
-      // Create the helper object for the tree traversal.
-      RuleType rules(*referenceSet, querySet, k, metric);
+    Timer::Stop("tree_building");
+    Timer::Start("computing_neighbors");
 
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+    SearchTree(*queryTree, k, false, *neighborPtr, *distancePtr);
 
-      // Set the value of minBaseCases.
-      traverser.MinBaseCases() = k;
-
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < querySet.n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
-
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
-
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
-
-      rules.GetResults(*neighborPtr, *distancePtr);
-      break;
-    }
+    delete queryTree;
+  }
+  else
+  {
+    SearchPoints(querySet, k, false, *neighborPtr, *distancePtr);
   }
 
   Timer::Stop("computing_neighbors");
@@ -637,27 +598,7 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
       tree::TreeTraits<Tree>::RearrangesDataset)
     neighborPtr = new arma::Mat<size_t>;
 
-  neighborPtr->set_size(k, querySet.n_cols);
-  distances.set_size(k, querySet.n_cols);
-
-  // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, querySet, k, metric, epsilon, sameSet);
-
-  // Create the traverser.
-  DualTreeTraversalType<RuleType> traverser(rules);
-  traverser.Traverse(queryTree, *referenceTree);
-
-  scores += rules.Scores();
-  baseCases += rules.BaseCases();
-
-  Log::Info << rules.Scores() << " node combinations were scored." << std::endl;
-  Log::Info << rules.BaseCases() << " base cases were calculated." << std::endl;
-
-  rules.GetResults(*neighborPtr, distances);
-
-  Log::Info << rules.Scores() << " node combinations were scored.\n";
-  Log::Info << rules.BaseCases() << " base cases were calculated.\n";
+  SearchTree(queryTree, k, sameSet, *neighborPtr, distances);
 
   Timer::Stop("computing_neighbors");
 
@@ -724,145 +665,435 @@ DualTreeTraversalType, SingleTreeTraversalType>::Search(
     neighborPtr = new arma::Mat<size_t>;
   }
 
-  // Initialize results.
-  neighborPtr->set_size(k, referenceSet->n_cols);
-  distancePtr->set_size(k, referenceSet->n_cols);
+  if (searchMode == DUAL_TREE_MODE)
+  {
+    // The dual-tree monochromatic search case may require resetting the
+    // bounds in the tree.
+    if (treeNeedsReset)
+    {
+      std::stack<Tree*> nodes;
+      nodes.push(referenceTree);
+      while (!nodes.empty())
+      {
+        Tree* node = nodes.top();
+        nodes.pop();
+
+        // Reset bounds of this node.
+        node->Stat().Reset();
 
-  // Create the helper object for the traversal.
-  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, k, metric, epsilon,
-      true /* don't return the same point as nearest neighbor */);
+        // Then add the children.
+        for (size_t i = 0; i < node->NumChildren(); ++i)
+          nodes.push(&node->Child(i));
+      }
+    }
+
+    if (tree::IsSpillTree<Tree>::value)
+    {
+      // For Dual Tree Search on SpillTree, the queryTree must be built with
+      // non overlapping (tau = 0).
+      Tree queryTree(*referenceSet);
+      SearchTree(queryTree, k, true, *neighborPtr, *distancePtr);
+    }
+    else
+    {
+      SearchTree(*referenceTree, k, true, *neighborPtr, *distancePtr);
+    }
 
-  switch (searchMode)
+    // Next time we perform this search, we'll need to reset the tree.
+    treeNeedsReset = true;
+  }
+  else
+  {
+    // Don't return the same point as nearest neighbor.
+    SearchPoints(*referenceSet, k, true, *neighborPtr, *distancePtr);
+  }
+
+  Timer::Stop("computing_neighbors");
+
+  // Do we need to map the reference indices?
+  if (!oldFromNewReferences.empty() &&
+      tree::TreeTraits<Tree>::RearrangesDataset)
   {
-    case NAIVE_MODE:
+    neighbors.set_size(k, referenceSet->n_cols);
+    distances.set_size(k, referenceSet->n_cols);
+
+    for (size_t i = 0; i < distances.n_cols; ++i)
     {
-      // The naive brute-force solution.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        for (size_t j = 0; j < referenceSet->n_cols; ++j)
-          rules.BaseCase(i, j);
+      // Map distances (copy a column).
+      const size_t refMapping = oldFromNewReferences[i];
+      distances.col(refMapping) = distancePtr->col(i);
 
-      baseCases += referenceSet->n_cols * referenceSet->n_cols;
-      break;
+      // Map each neighbor's index.
+      for (size_t j = 0; j < distances.n_rows; ++j)
+        neighbors(j, refMapping) = oldFromNewReferences[(*neighborPtr)(j, i)];
     }
-    case SINGLE_TREE_MODE:
+
+    // The query points are the reference points, so the work counts must be
+    // mapped too.
+    if (!queryBaseCases.is_empty())
     {
-      // Create the traverser.
-      SingleTreeTraversalType<RuleType> traverser(rules);
+      arma::Col<size_t> oldQueryBaseCases(queryBaseCases.n_elem);
+      for (size_t i = 0; i < queryBaseCases.n_elem; ++i)
+        oldQueryBaseCases[oldFromNewReferences[i]] = queryBaseCases[i];
+      queryBaseCases = std::move(oldQueryBaseCases);
+    }
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+    // Finished with temporary matrices.
+    delete neighborPtr;
+    delete distancePtr;
+  }
+}
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+int NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchThreads() const
+{
+#ifdef _OPENMP
+  return (numThreads == 0) ? omp_get_max_threads() : (int) numThreads;
+#else
+  return 1;
+#endif
+}
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
-      break;
-    }
-    case DUAL_TREE_MODE:
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchPoints(
+    const MatType& querySet,
+    const size_t k,
+    const bool sameSet,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+  queryBaseCases.set_size(querySet.n_cols);
+
+  // With quantized reference points, the traversal keeps more candidates, found
+  // with approximate distances, and the best of them are found again with
+  // exact distances.
+  size_t searchK = k;
+  if (quantized)
+  {
+    if (!tree::LeafDistanceTraits<MetricType>::Supported)
     {
-      // The dual-tree monochromatic search case may require resetting the
-      // bounds in the tree.
-      if (treeNeedsReset)
-      {
-        std::stack<Tree*> nodes;
-        nodes.push(referenceTree);
-        while (!nodes.empty())
-        {
-          Tree* node = nodes.top();
-          nodes.pop();
+      throw std::invalid_argument("quantized search is only supported with the "
+          "Euclidean distance");
+    }
 
-          // Reset bounds of this node.
-          node->Stat().Reset();
+    if (quantizedReferences.Empty())
+    {
+      Timer::Start("quantization");
+      if (referenceTree && !tree::TreeTraits<Tree>::HasSelfChildren)
+        quantizedReferences.Build(*referenceTree);
+      else
+        quantizedReferences.Build(*referenceSet, QuantizedBlockSize);
+      Timer::Stop("quantization");
 
-          // Then add the children.
-          for (size_t i = 0; i < node->NumChildren(); ++i)
-            nodes.push(&node->Child(i));
-        }
-      }
+      Log::Info << "Quantized the reference points into "
+          << quantizedReferences.MemoryBytes() << " bytes." << std::endl;
+    }
 
-      // Create the traverser.
-      DualTreeTraversalType<RuleType> traverser(rules);
+    searchK = std::min(k * std::max(rerankFactor, (size_t) 1),
+        (size_t) referenceSet->n_cols - (sameSet ? 1 : 0));
+  }
 
-      if (tree::IsSpillTree<Tree>::value)
+  // Trees with self-children (i.e. cover trees) cache base cases in the
+  // statistics of the reference nodes during single-tree search, so the blocks
+  // can only be searched one at a time.
+  const bool parallel = (searchMode == NAIVE_MODE) ||
+      !tree::TreeTraits<Tree>::HasSelfChildren;
+  const size_t blocks = (querySet.n_cols + QueryBlockSize - 1) /
+      QueryBlockSize;
+
+  size_t blockScores = 0;
+  size_t blockBaseCases = 0;
+  size_t blockStopped = 0;
+  #pragma omp parallel for schedule(dynamic) if(parallel) \
+      num_threads(SearchThreads()) \
+      reduction(+:blockScores, blockBaseCases, blockStopped)
+  for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
+  {
+    const size_t begin = b * QueryBlockSize;
+    const size_t count = std::min((size_t) QueryBlockSize,
+        (size_t) querySet.n_cols - begin);
+
+    // Create the helper object for the traversal of the block.
+    MetricType blockMetric(metric);
+    RuleType rules(*referenceSet, querySet, searchK, blockMetric, epsilon,
+        sameSet, begin, count);
+    if (quantized)
+      rules.QuantizedReferences() = &quantizedReferences;
+
+    switch (searchMode)
+    {
+      case NAIVE_MODE:
       {
-        // For Dual Tree Search on SpillTree, the queryTree must be built with
-        // non overlapping (tau = 0).
-        Tree queryTree(*referenceSet);
-        traverser.Traverse(queryTree, *referenceTree);
+        // The naive brute-force traversal.
+        for (size_t i = begin; i < begin + count; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(i, j);
+
+        queryBaseCases.subvec(begin, begin + count - 1).fill(
+            referenceSet->n_cols);
+        blockBaseCases += count * referenceSet->n_cols;
+        break;
       }
-      else
+      case SINGLE_TREE_MODE:
       {
-        traverser.Traverse(*referenceTree, *referenceTree);
-        // Next time we perform this search, we'll need to reset the tree.
-        treeNeedsReset = true;
+        // Create the traverser.
+        SingleTreeTraversalType<RuleType> traverser(rules);
+
+        // Now have it traverse for each point.
+        for (size_t i = begin; i < begin + count; ++i)
+        {
+          const size_t startBaseCases = rules.BaseCases();
+          traverser.Traverse(i, *referenceTree);
+          queryBaseCases[i] = rules.BaseCases() - startBaseCases;
+        }
+        break;
       }
+      case GREEDY_SINGLE_TREE_MODE:
+      {
+        // Create the traverser.
+        tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+        // Set the value of minBaseCases.
+        traverser.MinBaseCases() = searchK;
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
+        // Now have it traverse for each point.
+        for (size_t i = begin; i < begin + count; ++i)
+        {
+          const size_t startBaseCases = rules.BaseCases();
+          traverser.Traverse(i, *referenceTree);
+          queryBaseCases[i] = rules.BaseCases() - startBaseCases;
+        }
+        break;
+      }
+      case BEST_FIRST_SINGLE_TREE_MODE:
+      {
+        // Create the traverser, which visits the best nodes first and stops
+        // each traversal after maxBaseCases base cases.  Each base case is
+        // with a new reference point, so a budget of searchK base cases is
+        // enough to fill every candidate of a query point; smaller budgets
+        // are raised to it.
+        tree::BestFirstSingleTreeTraverser<Tree, RuleType> traverser(rules);
+        traverser.MaxBaseCases() = (maxBaseCases == 0) ? 0 :
+            std::max(maxBaseCases, searchK);
+
+        // Now have it traverse for each point.
+        for (size_t i = begin; i < begin + count; ++i)
+        {
+          traverser.Traverse(i, *referenceTree);
+          queryBaseCases[i] = traverser.LastBaseCases();
+        }
 
-      // Next time we perform this search, we'll need to reset the tree.
-      treeNeedsReset = true;
-      break;
+        blockStopped += traverser.NumStopped();
+        break;
+      }
+      case DUAL_TREE_MODE:
+        break; // SearchTree() handles this mode.
     }
-    case GREEDY_SINGLE_TREE_MODE:
+
+    if (searchMode != NAIVE_MODE)
     {
-      // Create the traverser.
-      tree::GreedySingleTreeTraverser<Tree, RuleType> traverser(rules);
+      blockScores += rules.Scores();
+      blockBaseCases += rules.BaseCases();
+    }
 
-      // Set the value of minBaseCases.
-      traverser.MinBaseCases() = k;
+    // Store the results of the block straight into its columns.
+    arma::Mat<size_t> blockNeighbors(neighbors.colptr(begin), k, count, false,
+        true);
+    arma::mat blockDistances(distances.colptr(begin), k, count, false, true);
+    if (!quantized)
+    {
+      rules.GetResults(blockNeighbors, blockDistances);
+      continue;
+    }
 
-      // Now have it traverse for each point.
-      for (size_t i = 0; i < referenceSet->n_cols; ++i)
-        traverser.Traverse(i, *referenceTree);
+    // Rank the candidates of each query point again with exact distances.
+    arma::Mat<size_t> candidateNeighbors;
+    arma::mat candidateDistances;
+    rules.GetResults(candidateNeighbors, candidateDistances);
 
-      scores += rules.Scores();
-      baseCases += rules.BaseCases();
+    std::vector<std::pair<double, size_t>> ranked(searchK);
+    for (size_t i = 0; i < count; ++i)
+    {
+      size_t found = 0;
+      for (size_t j = 0; j < searchK; ++j)
+      {
+        const size_t reference = candidateNeighbors(j, i);
+        if (reference == size_t() - 1)
+          continue;
 
-      Log::Info << rules.Scores() << " node combinations were scored."
-          << std::endl;
-      Log::Info << rules.BaseCases() << " base cases were calculated."
-          << std::endl;
-      break;
+        ranked[found++] = std::make_pair(blockMetric.Evaluate(
+            querySet.col(begin + i), referenceSet->col(reference)), reference);
+      }
+
+      const size_t best = std::min(k, found);
+      std::partial_sort(ranked.begin(), ranked.begin() + best,
+          ranked.begin() + found,
+          [](const std::pair<double, size_t>& a,
+             const std::pair<double, size_t>& b)
+          {
+            return (a.first != b.first) ?
+                SortPolicy::IsBetter(a.first, b.first) : (a.second < b.second);
+          });
+
+      for (size_t j = 0; j < k; ++j)
+      {
+        blockNeighbors(j, i) = (j < best) ? ranked[j].second : size_t() - 1;
+        blockDistances(j, i) = (j < best) ? ranked[j].first :
+            SortPolicy::WorstDistance();
+      }
+
+      queryBaseCases[begin + i] += found;
+      blockBaseCases += found;
     }
   }
 
-  rules.GetResults(*neighborPtr, *distancePtr);
+  scores += blockScores;
+  baseCases += blockBaseCases;
 
-  Timer::Stop("computing_neighbors");
+  if (searchMode != NAIVE_MODE)
+  {
+    Log::Info << blockScores << " node combinations were scored."
+        << std::endl;
+    Log::Info << blockBaseCases << " base cases were calculated."
+        << std::endl;
+  }
 
-  // Do we need to map the reference indices?
-  if (!oldFromNewReferences.empty() &&
-      tree::TreeTraits<Tree>::RearrangesDataset)
+  if (searchMode == BEST_FIRST_SINGLE_TREE_MODE && maxBaseCases > 0)
   {
-    neighbors.set_size(k, referenceSet->n_cols);
-    distances.set_size(k, referenceSet->n_cols);
+    Log::Info << blockStopped << " of " << querySet.n_cols << " query points "
+        << "reached the limit of " << maxBaseCases << " base cases."
+        << std::endl;
+  }
+}
 
-    for (size_t i = 0; i < distances.n_cols; ++i)
+template<typename SortPolicy,
+         typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType,
+         template<typename> class DualTreeTraversalType,
+         template<typename> class SingleTreeTraversalType>
+void NeighborSearch<SortPolicy, MetricType, MatType, TreeType,
+DualTreeTraversalType, SingleTreeTraversalType>::SearchTree(
+    Tree& queryTree,
+    const size_t k,
+    const bool sameSet,
+    arma::Mat<size_t>& neighbors,
+    arma::mat& distances)
+{
+  typedef NeighborSearchRules<SortPolicy, MetricType, Tree> RuleType;
+
+  const MatType& querySet = queryTree.Dataset();
+  neighbors.set_size(k, querySet.n_cols);
+  distances.set_size(k, querySet.n_cols);
+
+  if (quantized)
+  {
+    throw std::invalid_argument("quantized search cannot be used with "
+        "dual-tree search");
+  }
+
+  // The work of a dual-tree traversal is shared between the query points.
+  queryBaseCases.reset();
+
+  // Trees that rearrange the dataset hold the descendants of each node
+  // contiguously, so the query tree can be split into subtrees that are
+  // searched independently by several threads, each with its own rules object
+  // holding the candidates of its points.  Exact results do not depend on the
+  // split, because ties between candidates are broken by index, but
+  // approximate ones do, so the tree is only split for exact search.  Trees
+  // with self-children (cover trees) and spill trees are searched whole.
+  std::vector<Tree*> subtrees;
+  const bool splitTree = tree::TreeTraits<Tree>::RearrangesDataset &&
+      !tree::TreeTraits<Tree>::HasSelfChildren &&
+      !tree::IsSpillTree<Tree>::value && epsilon == 0.0 &&
+      SearchThreads() > 1;
+  if (splitTree && querySet.n_cols > QuerySubtreeMinSize)
+  {
+    const size_t maxSize = std::max((size_t) QuerySubtreeMinSize,
+        (size_t) querySet.n_cols / QuerySubtrees);
+
+    std::stack<Tree*> nodes;
+    nodes.push(&queryTree);
+    while (!nodes.empty())
     {
-      // Map distances (copy a column).
-      const size_t refMapping = oldFromNewReferences[i];
-      distances.col(refMapping) = distancePtr->col(i);
+      Tree* node = nodes.top();
+      nodes.pop();
 
-      // Map each neighbor's index.
-      for (size_t j = 0; j < distances.n_rows; ++j)
-        neighbors(j, refMapping) = oldFromNewReferences[(*neighborPtr)(j, i)];
+      if (node->IsLeaf() || node->NumPoints() > 0 ||
+          node->NumDescendants() <= maxSize)
+      {
+        subtrees.push_back(node);
+      }
+      else
+      {
+        for (size_t i = node->NumChildren(); i > 0; --i)
+          nodes.push(&node->Child(i - 1));
+      }
     }
+  }
+  else
+  {
+    subtrees.push_back(&queryTree);
+  }
 
-    // Finished with temporary matrices.
-    delete neighborPtr;
-    delete distancePtr;
+  size_t subtreeScores = 0;
+  size_t subtreeBaseCases = 0;
+  #pragma omp parallel for schedule(dynamic) num_threads(SearchThreads()) \
+      reduction(+:subtreeScores, subtreeBaseCases)
+  for (omp_size_t i = 0; i < (omp_size_t) subtrees.size(); ++i)
+  {
+    Tree& subtree = *subtrees[i];
+    const size_t begin = (&subtree == &queryTree) ? 0 : subtree.Descendant(0);
+    const size_t count = (&subtree == &queryTree) ? querySet.n_cols :
+        subtree.NumDescendants();
+
+    // Create the helper object for the traversal of the subtree.
+    MetricType subtreeMetric(metric);
+    RuleType rules(*referenceSet, querySet, k, subtreeMetric, epsilon,
+        sameSet, begin, count);
+
+    // Create the traverser.
+    DualTreeTraversalType<RuleType> traverser(rules);
+    traverser.Traverse(subtree, *referenceTree);
+
+    subtreeScores += rules.Scores();
+    subtreeBaseCases += rules.BaseCases();
+
+    // Store the results of the subtree straight into its columns.
+    arma::Mat<size_t> subtreeNeighbors(neighbors.colptr(begin), k, count,
+        false, true);
+    arma::mat subtreeDistances(distances.colptr(begin), k, count, false,
+        true);
+    rules.GetResults(subtreeNeighbors, subtreeDistances);
   }
+
+  scores += subtreeScores;
+  baseCases += subtreeBaseCases;
+
+  Log::Info << subtreeScores << " node combinations were scored." << std::endl;
+  Log::Info << subtreeBaseCases << " base cases were calculated." << std::endl;
 }
 
 //! Calculate the average relative error.
@@ -996,11 +1227,13 @@ DualTreeTraversalType, SingleTreeTraversalType>::serialize(
     }
   }
 
-  // Reset base cases and scores.
+  // Reset base cases and scores.  The quantized points are not saved; they
+  // are built again at the next quantized search.
   if (Archive::is_loading::value)
   {
     baseCases = 0;
     scores = 0;
+    quantizedReferences.Clear();
   }
 }
 
@@ -14,8 +14,10 @@
 #define MLPACK_METHODS_NEIGHBOR_SEARCH_NEIGHBOR_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/leaf_distances.hpp>
+#include <mlpack/core/tree/quantized_leaves.hpp>
 
-#include <queue>
+#include <algorithm>
 
 namespace mlpack {
 namespace neighbor {
@@ -46,16 +48,23 @@ class NeighborSearchRules
    * @param epsilon Relative approximate error.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
+   * @param queryBegin Index of the first query point to search for.
+   * @param queryCount Number of query points to search for, starting at
+   *      queryBegin; by default, all the remaining points of the query set.
+   *      Only the points in this range may be given to BaseCase() and Score().
    */
   NeighborSearchRules(const typename TreeType::Mat& referenceSet,
                       const typename TreeType::Mat& querySet,
                       const size_t k,
                       MetricType& metric,
                       const double epsilon = 0,
-                      const bool sameSet = false);
+                      const bool sameSet = false,
+                      const size_t queryBegin = 0,
+                      const size_t queryCount = size_t(-1));
 
   /**
-   * Store the list of candidates for each query point in the given matrices.
+   * Store the list of candidates for each query point in the given matrices;
+   * column i holds the candidates of query point queryBegin + i.
    *
    * @param neighbors Matrix storing lists of neighbors for each query point.
    * @param distances Matrix storing distances of neighbors for each query
@@ -73,6 +82,21 @@ class NeighborSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between the given query point and every point of
+   * the given reference leaf, with the same results as calling BaseCase() for
+   * each of them.  For the Euclidean distance, the distances between the two
+   * leaves are estimated all at once (see tree::LeafDistances), and only the
+   * points that might become candidates are evaluated exactly.
+   *
+   * @param queryLeaf Leaf holding the query point.
+   * @param queryIndex Index of query point.
+   * @param referenceLeaf Reference leaf.
+   */
+  void LeafBaseCases(TreeType& queryLeaf,
+                     const size_t queryIndex,
+                     TreeType& referenceLeaf);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -157,6 +181,18 @@ class NeighborSearchRules
   //! Modify the traversal info.
   TraversalInfoType& TraversalInfo() { return traversalInfo; }
 
+  //! Convenience typedef.
+  typedef tree::QuantizedLeaves<typename TreeType::Mat> QuantizedType;
+
+  //! Get the quantized reference points BaseCase() computes approximate
+  //! distances with (NULL to use the exact points).
+  const QuantizedType* QuantizedReferences() const
+  { return quantizedReferences; }
+  //! Modify the quantized reference points BaseCase() computes approximate
+  //! distances with (NULL to use the exact points).  The metric must be
+  //! supported by tree::LeafDistances.
+  const QuantizedType*& QuantizedReferences() { return quantizedReferences; }
+
  protected:
   //! The reference set.
   const typename TreeType::Mat& referenceSet;
@@ -167,20 +203,28 @@ class NeighborSearchRules
   //! Candidate represents a possible candidate neighbor (distance, index).
   typedef std::pair<double, size_t> Candidate;
 
-  //! Compare two candidates based on the distance.
+  //! Compare two candidates based on the distance, and on the index if the
+  //! distances are equal, so that the candidates that are kept do not depend
+  //! on the order in which the reference points are visited.
   struct CandidateCmp {
     bool operator()(const Candidate& c1, const Candidate& c2)
     {
-      return !SortPolicy::IsBetter(c2.first, c1.first);
+      if (c1.first != c2.first)
+        return SortPolicy::IsBetter(c1.first, c2.first);
+      return (c1.second < c2.second);
     };
   };
 
-  //! Use a priority queue to represent the list of candidate neighbors.
-  typedef std::priority_queue<Candidate, std::vector<Candidate>, CandidateCmp>
-      CandidateList;
+  //! The candidate neighbors of every query point: k candidates per point,
+  //! each set kept as a heap (with std::push_heap() and std::pop_heap()) whose
+  //! first element is the worst candidate.  A single array is used so that
+  //! BaseCase() never allocates memory.
+  std::vector<Candidate> candidates;
 
-  //! Set of candidate neighbors for each point.
-  std::vector<CandidateList> candidates;
+  //! Index of the first query point searched for.
+  size_t queryBegin;
+  //! Number of query points searched for.
+  size_t queryCount;
 
   //! Number of neighbors to search for.
   const size_t k;
@@ -210,6 +254,19 @@ class NeighborSearchRules
   //! traversal before each call to Score().
   TraversalInfoType traversalInfo;
 
+  //! The distances between the points of the last pair of leaves.
+  tree::LeafDistances<typename TreeType::Mat> leafDistances;
+
+  //! The quantized reference points, if the base cases are approximate.
+  const QuantizedType* quantizedReferences;
+
+  //! Get the heap of candidates of the given query point.
+  Candidate* CandidateHeap(const size_t queryIndex)
+  { return candidates.data() + (queryIndex - queryBegin) * k; }
+  //! Get the heap of candidates of the given query point.
+  const Candidate* CandidateHeap(const size_t queryIndex) const
+  { return candidates.data() + (queryIndex - queryBegin) * k; }
+
   /**
    * Recalculate the bound for a given query node.
    */
@@ -26,9 +26,13 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     const size_t k,
     MetricType& metric,
     const double epsilon,
-    const bool sameSet) :
+    const bool sameSet,
+    const size_t queryBegin,
+    const size_t queryCount) :
     referenceSet(referenceSet),
     querySet(querySet),
+    queryBegin(queryBegin),
+    queryCount(std::min(queryCount, (size_t) querySet.n_cols - queryBegin)),
     k(k),
     metric(metric),
     sameSet(sameSet),
@@ -36,7 +40,9 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    leafDistances(querySet, referenceSet),
+    quantizedReferences(NULL)
 {
   // We must set the traversal info last query and reference node pointers to
   // something that is both invalid (i.e. not a tree node) and not NULL.  We'll
@@ -47,16 +53,11 @@ NeighborSearchRules<SortPolicy, MetricType, TreeType>::NeighborSearchRules(
   // Let's build the list of candidate neighbors for each query point.
   // It will be initialized with k candidates: (WorstDistance, size_t() - 1)
   // The list of candidates will be updated when visiting new points with the
-  // BaseCase() method.
+  // BaseCase() method.  Since all the candidates are equal, every list is
+  // already a heap.
   const Candidate def = std::make_pair(SortPolicy::WorstDistance(),
       size_t() - 1);
-
-  std::vector<Candidate> vect(k, def);
-  CandidateList pqueue(CandidateCmp(), std::move(vect));
-
-  candidates.reserve(querySet.n_cols);
-  for (size_t i = 0; i < querySet.n_cols; ++i)
-    candidates.push_back(pqueue);
+  candidates.assign(this->queryCount * k, def);
 }
 
 template<typename SortPolicy, typename MetricType, typename TreeType>
@@ -64,17 +65,17 @@ void NeighborSearchRules<SortPolicy, MetricType, TreeType>::GetResults(
     arma::Mat<size_t>& neighbors,
     arma::mat& distances)
 {
-  neighbors.set_size(k, querySet.n_cols);
-  distances.set_size(k, querySet.n_cols);
+  neighbors.set_size(k, queryCount);
+  distances.set_size(k, queryCount);
 
-  for (size_t i = 0; i < querySet.n_cols; ++i)
+  for (size_t i = 0; i < queryCount; ++i)
   {
-    CandidateList& pqueue = candidates[i];
+    Candidate* heap = CandidateHeap(queryBegin + i);
     for (size_t j = 1; j <= k; ++j)
     {
-      neighbors(k - j, i) = pqueue.top().second;
-      distances(k - j, i) = pqueue.top().first;
-      pqueue.pop();
+      neighbors(k - j, i) = heap[0].second;
+      distances(k - j, i) = heap[0].first;
+      std::pop_heap(heap, heap + k - j + 1, CandidateCmp());
     }
   }
 };
@@ -93,8 +94,11 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   if ((lastQueryIndex == queryIndex) && (lastReferenceIndex == referenceIndex))
     return lastBaseCase;
 
-  double distance = metric.Evaluate(querySet.col(queryIndex),
-                                    referenceSet.col(referenceIndex));
+  double distance = quantizedReferences ?
+      quantizedReferences->template Distance<MetricType>(
+          querySet.unsafe_col(queryIndex), referenceIndex) :
+      metric.Evaluate(querySet.col(queryIndex),
+                      referenceSet.col(referenceIndex));
   ++baseCases;
 
   InsertNeighbor(queryIndex, referenceIndex, distance);
@@ -107,6 +111,43 @@ BaseCase(const size_t queryIndex, const size_t referenceIndex)
   return distance;
 }
 
+template<typename SortPolicy, typename MetricType, typename TreeType>
+void NeighborSearchRules<SortPolicy, MetricType, TreeType>::LeafBaseCases(
+    TreeType& queryLeaf,
+    const size_t queryIndex,
+    TreeType& referenceLeaf)
+{
+  const size_t referenceEnd = referenceLeaf.Begin() + referenceLeaf.Count();
+  if (!tree::LeafDistanceTraits<MetricType>::Supported ||
+      !leafDistances.Compute(queryLeaf, referenceLeaf))
+  {
+    for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+      BaseCase(queryIndex, r);
+    return;
+  }
+
+  const Candidate* heap = CandidateHeap(queryIndex);
+  for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+  {
+    if ((sameSet && (queryIndex == r)) ||
+        ((lastQueryIndex == queryIndex) && (lastReferenceIndex == r)))
+      continue;
+
+    // If even the best distance the point could have would not make it a
+    // candidate, BaseCase() would not do anything with it.
+    double lo, hi;
+    leafDistances.template Bounds<MetricType>(queryIndex, r, lo, hi);
+    const double bestDistance = SortPolicy::IsBetter(lo, hi) ? lo : hi;
+    if (!CandidateCmp()(std::make_pair(bestDistance, r), heap[0]))
+    {
+      ++baseCases;
+      continue;
+    }
+
+    BaseCase(queryIndex, r);
+  }
+}
+
 template<typename SortPolicy, typename MetricType, typename TreeType>
 inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
     const size_t queryIndex,
@@ -143,7 +184,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Score(
   }
 
   // Compare against the best k'th distance for this query point so far.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = CandidateHeap(queryIndex)[0].first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ?
@@ -179,7 +220,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::Rescore(
   const double distance = SortPolicy::ConvertToDistance(oldScore);
 
   // Just check the score again against the distances.
-  double bestDistance = candidates[queryIndex].top().first;
+  double bestDistance = CandidateHeap(queryIndex)[0].first;
   bestDistance = SortPolicy::Relax(bestDistance, epsilon);
 
   return (SortPolicy::IsBetter(distance, bestDistance)) ? oldScore : DBL_MAX;
@@ -404,7 +445,7 @@ inline double NeighborSearchRules<SortPolicy, MetricType, TreeType>::
   // Loop over points held in the node.
   for (size_t i = 0; i < queryNode.NumPoints(); ++i)
   {
-    const double distance = candidates[queryNode.Point(i)].top().first;
+    const double distance = CandidateHeap(queryNode.Point(i))[0].first;
     if (SortPolicy::IsBetter(worstDistance, distance))
       worstDistance = distance;
     if (SortPolicy::IsBetter(distance, bestPointDistance))
@@ -499,13 +540,15 @@ InsertNeighbor(
     const size_t neighbor,
     const double distance)
 {
-  CandidateList& pqueue = candidates[queryIndex];
+  Candidate* heap = CandidateHeap(queryIndex);
   Candidate c = std::make_pair(distance, neighbor);
 
-  if (CandidateCmp()(c, pqueue.top()))
+  // This is what std::priority_queue::pop() and push() would do.
+  if (CandidateCmp()(c, heap[0]))
   {
-    pqueue.pop();
-    pqueue.push(c);
+    std::pop_heap(heap, heap + k, CandidateCmp());
+    heap[k - 1] = c;
+    std::push_heap(heap, heap + k, CandidateCmp());
   }
 }
 
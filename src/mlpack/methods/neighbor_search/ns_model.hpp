@@ -152,6 +152,8 @@ class TrainVisitor : public boost::static_visitor<void>
   const double tau;
   //! Balance threshold (for spill trees).
   const double rho;
+  //! Whether to pack the nodes of kd-trees and ball trees.
+  const bool packNodes;
 
   //! Train on the given NSType considering the leafSize.
   template<typename NSType>
@@ -183,11 +185,13 @@ class TrainVisitor : public boost::static_visitor<void>
   void operator()(NSTypeT<tree::Octree>* ns) const;
 
   //! Construct the TrainVisitor object with the given reference set, leafSize
-  //! for BinarySpaceTrees, and tau and rho for spill trees.
+  //! for BinarySpaceTrees, tau and rho for spill trees, and whether to pack
+  //! the nodes of kd-trees and ball trees (see BinarySpaceTree::PackNodes()).
   TrainVisitor(arma::mat&& referenceSet,
                const size_t leafSize,
                const double tau,
-               const double rho);
+               const double rho,
+               const bool packNodes = false);
 };
 
 /**
@@ -212,6 +216,64 @@ class EpsilonVisitor : public boost::static_visitor<double&>
   double& operator()(NSType *ns) const;
 };
 
+/**
+ * NumThreadsVisitor exposes the NumThreads() method of the given NSType.
+ */
+class NumThreadsVisitor : public boost::static_visitor<size_t&>
+{
+ public:
+  //! Return the number of threads used for search.
+  template<typename NSType>
+  size_t& operator()(NSType* ns) const;
+};
+
+/**
+ * MaxBaseCasesVisitor exposes the MaxBaseCases() method of the given NSType.
+ */
+class MaxBaseCasesVisitor : public boost::static_visitor<size_t&>
+{
+ public:
+  //! Return the maximum number of base cases of each query in best-first
+  //! search.
+  template<typename NSType>
+  size_t& operator()(NSType* ns) const;
+};
+
+/**
+ * QuantizedVisitor exposes the Quantized() method of the given NSType.
+ */
+class QuantizedVisitor : public boost::static_visitor<bool&>
+{
+ public:
+  //! Return whether the search uses quantized reference points.
+  template<typename NSType>
+  bool& operator()(NSType* ns) const;
+};
+
+/**
+ * RerankFactorVisitor exposes the RerankFactor() method of the given NSType.
+ */
+class RerankFactorVisitor : public boost::static_visitor<size_t&>
+{
+ public:
+  //! Return the number of candidates of quantized search, as a multiple of k.
+  template<typename NSType>
+  size_t& operator()(NSType* ns) const;
+};
+
+/**
+ * QueryBaseCasesVisitor exposes the QueryBaseCases() method of the given
+ * NSType.
+ */
+class QueryBaseCasesVisitor :
+    public boost::static_visitor<const arma::Col<size_t>&>
+{
+ public:
+  //! Return the number of base cases of each query point in the last search.
+  template<typename NSType>
+  const arma::Col<size_t>& operator()(NSType* ns) const;
+};
+
 /**
  * ReferenceSetVisitor exposes the referenceSet of the given NSType.
  */
@@ -223,6 +285,19 @@ class ReferenceSetVisitor : public boost::static_visitor<const arma::mat&>
   const arma::mat& operator()(NSType *ns) const;
 };
 
+/**
+ * OldFromNewVisitor exposes the original index of each point of the reference
+ * set of the given NSType.
+ */
+class OldFromNewVisitor :
+    public boost::static_visitor<const std::vector<size_t>&>
+{
+ public:
+  //! Return the mappings of the reference points.
+  template<typename NSType>
+  const std::vector<size_t>& operator()(NSType* ns) const;
+};
+
 /**
  * DeleteVisitor deletes the given NSType instance.
  */
@@ -242,6 +317,21 @@ class DeleteVisitor : public boost::static_visitor<void>
  * flexibility as the NeighborSearch class.  So if you are using it outside of
  * mlpack_knn and mlpack_kfn, be aware that it is limited!
  *
+ * Points can be added to and removed from a trained model with Insert() and
+ * Remove(), without rebuilding its tree.  Each point has an id: the points of
+ * the reference set given to BuildModel() have the ids 0 to n - 1, and
+ * inserted points get the following ids, in order.  The results of a search
+ * hold these ids, and stay exact:
+ *
+ *  - inserted points go to a buffer that is searched by brute force; when it
+ *    holds InsertBufferSize points, it is merged with the trees of inserted
+ *    points in the manner of Bentley and Saxe, so that there is a logarithmic
+ *    number of kd-trees, each about twice as large as the one before;
+ *  - removed points are only marked, and skipped in the results; once more
+ *    than 1 / CompactRemovedFraction of the stored points have been removed,
+ *    or once the inserted points would fill a tree as large as the one of the
+ *    reference set, everything is rebuilt into a single tree with Compact().
+ *
  * @tparam SortPolicy The sort policy for distances; see NearestNeighborSort.
  */
 template<typename SortPolicy>
@@ -274,6 +364,10 @@ class NSModel
 
   //! For tree types that accept the maxLeafSize parameter.
   size_t leafSize;
+  //! Whether the nodes of kd-trees and ball trees are packed into one block of
+  //! memory when they are built.  This is not serialized, since loaded trees
+  //! are never packed.
+  bool packNodes;
 
   //! Overlapping size (for spill trees).
   double tau;
@@ -306,6 +400,106 @@ class NSModel
                  NSType<SortPolicy, tree::UBTree>*,
                  NSType<SortPolicy, tree::Octree>*> nSearch;
 
+  //! Number of points in the buffer of inserted points that makes it be
+  //! merged into a tree.
+  static const size_t InsertBufferSize = 1024;
+  //! The model is compacted once more than 1 / CompactRemovedFraction of the
+  //! stored points have been removed.
+  static const size_t CompactRemovedFraction = 4;
+
+  //! Ids of the points of the reference set of nSearch, by their original
+  //! index; empty if they are 0, 1, 2, ...
+  arma::Col<size_t> ids;
+  //! Inserted points that are not in a tree yet, searched by brute force.
+  arma::mat buffer;
+  //! Ids of the points of the buffer.
+  arma::Col<size_t> bufferIds;
+  //! Trees of inserted points; each is either NULL or about twice as large as
+  //! the one before.
+  std::vector<NSType<SortPolicy, tree::KDTree>*> levels;
+  //! Ids of the points of each tree of inserted points, by original index.
+  std::vector<arma::Col<size_t>> levelIds;
+  //! Whether each point, by id, has been removed; points after the end have
+  //! not.
+  std::vector<char> removed;
+  //! Number of removed points that are still stored.
+  size_t numRemoved;
+  //! The id of the next inserted point.
+  size_t nextId;
+
+  /**
+   * Create the NeighborSearch object for the current tree type and train it
+   * on the given reference set, replacing the current one.  The random basis
+   * is not applied.
+   */
+  void BuildSearch(arma::mat&& referenceSet,
+                   const NeighborSearchMode searchMode,
+                   const double epsilon);
+
+  //! Forget every inserted and removed point.
+  void ClearUpdates();
+
+  //! Return whether the given id belongs to a removed point.
+  bool IsRemoved(const size_t id) const
+  { return (id < removed.size()) && removed[id]; }
+
+  /**
+   * Append the points of the given reference set that have not been removed,
+   * and their ids, to the given matrix and ids.
+   *
+   * @param referenceSet Reference set of a NeighborSearch object.
+   * @param oldFromNew Original index of each point of the reference set, or
+   *     empty if the points were not reordered.
+   * @param setIds Id of each point by original index, or empty if the ids are
+   *     the original indices.
+   * @param points Matrix to append the points to.
+   * @param pointIds Vector to append the ids to.
+   */
+  void CollectPoints(const arma::mat& referenceSet,
+                     const std::vector<size_t>& oldFromNew,
+                     const arma::Col<size_t>& setIds,
+                     arma::mat& points,
+                     arma::Col<size_t>& pointIds) const;
+
+  //! Merge the buffer of inserted points into a tree.
+  void FlushBuffer();
+
+  /**
+   * Search for the neighbors of the query points in one part of the model,
+   * and merge them with the neighbors found so far, skipping removed points.
+   * Queries that find fewer than k points that were not removed are searched
+   * again for twice as many neighbors.
+   *
+   * @param search Function searching for the neighbors of a set of queries,
+   *     with signature void(const arma::mat&, size_t, arma::Mat<size_t>&,
+   *     arma::mat&).
+   * @param setSize Number of points in the part of the model.
+   * @param setIds Id of each point by original index, or empty if the ids are
+   *     the original indices.
+   */
+  template<typename SearchFunction>
+  void SearchPart(SearchFunction search,
+                  const size_t setSize,
+                  const arma::Col<size_t>& setIds,
+                  const arma::mat& querySet,
+                  const size_t k,
+                  arma::Mat<size_t>& neighbors,
+                  arma::mat& distances) const;
+
+  //! Search the buffer of inserted points by brute force, and merge the
+  //! results with the neighbors found so far.
+  void SearchBuffer(const arma::mat& querySet,
+                    arma::Mat<size_t>& neighbors,
+                    arma::mat& distances) const;
+
+  //! Insert the given neighbor into the sorted neighbors of the given query,
+  //! if it is good enough.
+  static void InsertNeighbor(arma::Mat<size_t>& neighbors,
+                             arma::mat& distances,
+                             const size_t queryIndex,
+                             const size_t id,
+                             const double distance);
+
  public:
   /**
    * Initialize the NSModel with the given type and whether or not a random
@@ -363,10 +557,38 @@ class NSModel
   double Epsilon() const;
   double& Epsilon();
 
+  //! Expose the number of threads used for search (0 means all of them).
+  size_t NumThreads() const;
+  size_t& NumThreads();
+
+  //! Expose the maximum number of base cases of each query point in
+  //! best-first search (0 means there is no limit).
+  size_t MaxBaseCases() const;
+  size_t& MaxBaseCases();
+
+  //! Expose whether the search uses 8-bit quantized reference points, ranking
+  //! the candidates again with exact distances.
+  bool Quantized() const;
+  bool& Quantized();
+
+  //! Expose the number of candidates of quantized search, as a multiple of k.
+  size_t RerankFactor() const;
+  size_t& RerankFactor();
+
+  //! Get the number of base cases evaluated for each query point by the last
+  //! search.  This is empty after a dual-tree search, and while the model holds
+  //! inserted or removed points (whose search is split between several trees).
+  arma::Col<size_t> QueryBaseCases() const;
+
   //! Expose leafSize.
   size_t LeafSize() const { return leafSize; }
   size_t& LeafSize() { return leafSize; }
 
+  //! Expose whether the nodes of kd-trees and ball trees are packed into one
+  //! block of memory when they are built.
+  bool PackNodes() const { return packNodes; }
+  bool& PackNodes() { return packNodes; }
+
   //! Expose tau.
   double Tau() const { return tau; }
   double& Tau() { return tau; }
@@ -379,23 +601,71 @@ class NSModel
   TreeTypes TreeType() const { return treeType; }
   TreeTypes& TreeType() { return treeType; }
 
+  //! Get the NeighborSearch object of the model if it uses the given type of
+  //! tree, or NULL otherwise.
+  template<template<typename TreeMetricType,
+                    typename TreeStatType,
+                    typename TreeMatType> class SearchTreeType>
+  const NSType<SortPolicy, SearchTreeType>* SearchObject() const
+  {
+    NSType<SortPolicy, SearchTreeType>* const* ns =
+        boost::get<NSType<SortPolicy, SearchTreeType>*>(&nSearch);
+    return (ns == NULL) ? NULL : *ns;
+  }
+
   //! Expose randomBasis.
   bool RandomBasis() const { return randomBasis; }
   bool& RandomBasis() { return randomBasis; }
 
+  //! Return the number of points of the model that have not been removed.
+  size_t NumPoints() const;
+
+  //! Return whether points have been inserted or removed since the tree was
+  //! last built.
+  bool HasUpdates() const
+  { return (buffer.n_cols > 0) || !levels.empty() || (numRemoved > 0); }
+
+  //! Get the id of each point of the reference set, by original index; empty
+  //! if they are 0, 1, 2, ...
+  const arma::Col<size_t>& Ids() const { return ids; }
+
   //! Build the reference tree.
   void BuildModel(arma::mat&& referenceSet,
                   const size_t leafSize,
                   const NeighborSearchMode searchMode,
                   const double epsilon = 0);
 
+  /**
+   * Add the given points to the model.  They get consecutive ids, after the
+   * largest one in the model.
+   *
+   * @param points Points to add.
+   * @return Id of the first added point.
+   */
+  size_t Insert(arma::mat&& points);
+
+  /**
+   * Remove the points with the given ids from the model.  A
+   * std::invalid_argument is thrown if an id is not in the model, or if no
+   * points would be left.
+   *
+   * @param pointIds Ids of the points to remove.
+   */
+  void Remove(const arma::Col<size_t>& pointIds);
+
+  //! Rebuild the tree on every point of the model that has not been removed,
+  //! if points have been inserted or removed since it was built.
+  void Compact();
+
   //! Perform neighbor search.  The query set will be reordered.
   void Search(arma::mat&& querySet,
               const size_t k,
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
 
-  //! Perform monochromatic neighbor search.
+  //! Perform monochromatic neighbor search.  If points have been inserted or
+  //! removed, the model is compacted first, and the columns of the results
+  //! hold the remaining points, in the order of their ids.
   void Search(const size_t k,
               arma::Mat<size_t>& neighbors,
               arma::mat& distances);
@@ -409,7 +679,7 @@ class NSModel
 
 //! Set the serialization version of the NSModel class.
 BOOST_TEMPLATE_CLASS_VERSION(template<typename SortPolicy>,
-    mlpack::neighbor::NSModel<SortPolicy>, 1);
+    mlpack::neighbor::NSModel<SortPolicy>, 2);
 
 // Include implementation.
 #include "ns_model_impl.hpp"
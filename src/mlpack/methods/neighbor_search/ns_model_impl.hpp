@@ -19,6 +19,7 @@
 #include "ns_model.hpp"
 
 #include <boost/serialization/variant.hpp>
+#include <boost/serialization/vector.hpp>
 
 namespace mlpack {
 namespace neighbor {
@@ -143,11 +144,13 @@ template<typename SortPolicy>
 TrainVisitor<SortPolicy>::TrainVisitor(arma::mat&& referenceSet,
                                        const size_t leafSize,
                                        const double tau,
-                                       const double rho) :
+                                       const double rho,
+                                       const bool packNodes) :
     referenceSet(std::move(referenceSet)),
     leafSize(leafSize),
     tau(tau),
-    rho(rho)
+    rho(rho),
+    packNodes(packNodes)
 {}
 
 //! Default Train on the given NSType instance.
@@ -219,6 +222,8 @@ void TrainVisitor<SortPolicy>::TrainLeaf(NSType* ns) const
     std::vector<size_t> oldFromNewReferences;
     typename NSType::Tree referenceTree(std::move(referenceSet),
         oldFromNewReferences, leafSize);
+    if (packNodes)
+      tree::PackTreeNodes(referenceTree);
     ns->Train(std::move(referenceTree));
     // Set the mappings.
     ns->oldFromNewReferences = std::move(oldFromNewReferences);
@@ -243,6 +248,51 @@ double& EpsilonVisitor::operator()(NSType* ns) const
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Expose the NumThreads method of the given NSType.
+template<typename NSType>
+size_t& NumThreadsVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->NumThreads();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Expose the MaxBaseCases method of the given NSType.
+template<typename NSType>
+size_t& MaxBaseCasesVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->MaxBaseCases();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Expose the Quantized method of the given NSType.
+template<typename NSType>
+bool& QuantizedVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->Quantized();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Expose the RerankFactor method of the given NSType.
+template<typename NSType>
+size_t& RerankFactorVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->RerankFactor();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
+//! Expose the QueryBaseCases method of the given NSType.
+template<typename NSType>
+const arma::Col<size_t>& QueryBaseCasesVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->QueryBaseCases();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
 //! Expose the referenceSet of the given NSType.
 template<typename NSType>
 const arma::mat& ReferenceSetVisitor::operator()(NSType* ns) const
@@ -252,6 +302,15 @@ const arma::mat& ReferenceSetVisitor::operator()(NSType* ns) const
   throw std::runtime_error("no neighbor search model initialized");
 }
 
+//! Expose the mappings of the reference points of the given NSType.
+template<typename NSType>
+const std::vector<size_t>& OldFromNewVisitor::operator()(NSType* ns) const
+{
+  if (ns)
+    return ns->OldFromNewReferences();
+  throw std::runtime_error("no neighbor search model initialized");
+}
+
 //! Clean memory, if necessary.
 template<typename NSType>
 void DeleteVisitor::operator()(NSType* ns) const
@@ -268,9 +327,12 @@ template<typename SortPolicy>
 NSModel<SortPolicy>::NSModel(TreeTypes treeType, bool randomBasis) :
     treeType(treeType),
     leafSize(20),
+    packNodes(false),
     tau(0),
     rho(0.7),
-    randomBasis(randomBasis)
+    randomBasis(randomBasis),
+    numRemoved(0),
+    nextId(0)
 {
   // Nothing to do.
 }
@@ -279,32 +341,60 @@ template<typename SortPolicy>
 NSModel<SortPolicy>::NSModel(const NSModel& other) :
     treeType(other.treeType),
     leafSize(other.leafSize),
+    packNodes(other.packNodes),
     tau(other.tau),
     rho(other.rho),
     randomBasis(other.randomBasis),
     q(other.q),
-    nSearch(other.nSearch)
+    nSearch(other.nSearch),
+    ids(other.ids),
+    buffer(other.buffer),
+    bufferIds(other.bufferIds),
+    levelIds(other.levelIds),
+    removed(other.removed),
+    numRemoved(other.numRemoved),
+    nextId(other.nextId)
 {
-  // Nothing to do.
+  for (size_t i = 0; i < other.levels.size(); ++i)
+  {
+    levels.push_back((other.levels[i] == NULL) ? NULL :
+        new NSType<SortPolicy, tree::KDTree>(*other.levels[i]));
+  }
 }
 
 template<typename SortPolicy>
 NSModel<SortPolicy>::NSModel(NSModel&& other) :
     treeType(other.treeType),
     leafSize(other.leafSize),
+    packNodes(other.packNodes),
     tau(other.tau),
     rho(other.rho),
     randomBasis(other.randomBasis),
     q(std::move(other.q)),
-    nSearch(other.nSearch)
+    nSearch(other.nSearch),
+    ids(std::move(other.ids)),
+    buffer(std::move(other.buffer)),
+    bufferIds(std::move(other.bufferIds)),
+    levels(std::move(other.levels)),
+    levelIds(std::move(other.levelIds)),
+    removed(std::move(other.removed)),
+    numRemoved(other.numRemoved),
+    nextId(other.nextId)
 {
   // Reset parameters of the other model.
   other.treeType = TreeTypes::KD_TREE;
   other.leafSize = 20;
+  other.packNodes = false;
   other.tau = 0;
   other.rho = 0.7;
   other.randomBasis = false;
   other.nSearch = decltype(other.nSearch)();
+  other.levels.clear();
+  other.ClearUpdates();
+  other.ids.reset();
+  other.removed.clear();
+  other.numRemoved = 0;
+  other.nextId = 0;
 }
 
 template<typename SortPolicy>
@@ -314,12 +404,27 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(const NSModel& other)
 
   treeType = other.treeType;
   leafSize = other.leafSize;
+  packNodes = other.packNodes;
   tau = other.tau;
   rho = other.rho;
   randomBasis = other.randomBasis;
   q = other.q;
   nSearch = other.nSearch;
 
+  ClearUpdates();
+  ids = other.ids;
+  buffer = other.buffer;
+  bufferIds = other.bufferIds;
+  for (size_t i = 0; i < other.levels.size(); ++i)
+  {
+    levels.push_back((other.levels[i] == NULL) ? NULL :
+        new NSType<SortPolicy, tree::KDTree>(*other.levels[i]));
+  }
+  levelIds = other.levelIds;
+  removed = other.removed;
+  numRemoved = other.numRemoved;
+  nextId = other.nextId;
+
   return *this;
 }
 
@@ -330,6 +435,7 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
 
   treeType = other.treeType;
   leafSize = other.leafSize;
+  packNodes = other.packNodes;
   tau = other.tau;
   rho = other.rho;
   randomBasis = other.randomBasis;
@@ -337,13 +443,30 @@ NSModel<SortPolicy>& NSModel<SortPolicy>::operator=(NSModel&& other)
   // Copy the pointer and type.
   nSearch = other.nSearch;
 
+  ClearUpdates();
+  ids = std::move(other.ids);
+  buffer = std::move(other.buffer);
+  bufferIds = std::move(other.bufferIds);
+  levels = std::move(other.levels);
+  levelIds = std::move(other.levelIds);
+  removed = std::move(other.removed);
+  numRemoved = other.numRemoved;
+  nextId = other.nextId;
+
   // Reset parameters of the other model.
   other.treeType = TreeTypes::KD_TREE;
   other.leafSize = 20;
+  other.packNodes = false;
   other.tau = 0;
   other.rho = 0.7;
   other.randomBasis = false;
   other.nSearch = decltype(other.nSearch)();
+  other.levels.clear();
+  other.ClearUpdates();
+  other.ids.reset();
+  other.removed.clear();
+  other.numRemoved = 0;
+  other.nextId = 0;
 
   return *this;
 }
@@ -353,6 +476,7 @@ template<typename SortPolicy>
 NSModel<SortPolicy>::~NSModel()
 {
   boost::apply_visitor(DeleteVisitor(), nSearch);
+  ClearUpdates();
 }
 
 //! Serialize the kNN model.
@@ -374,9 +498,32 @@ void NSModel<SortPolicy>::serialize(Archive& ar, const unsigned int version)
 
   // This should never happen, but just in case, be clean with memory.
   if (Archive::is_loading::value)
+  {
     boost::apply_visitor(DeleteVisitor(), nSearch);
+    ClearUpdates();
+  }
 
   ar & BOOST_SERIALIZATION_NVP(nSearch);
+
+  // Older versions of NSModel could not insert or remove points.
+  if (version > 1)
+  {
+    ar & BOOST_SERIALIZATION_NVP(ids);
+    ar & BOOST_SERIALIZATION_NVP(buffer);
+    ar & BOOST_SERIALIZATION_NVP(bufferIds);
+    ar & BOOST_SERIALIZATION_NVP(levels);
+    ar & BOOST_SERIALIZATION_NVP(levelIds);
+    ar & BOOST_SERIALIZATION_NVP(removed);
+    ar & BOOST_SERIALIZATION_NVP(numRemoved);
+    ar & BOOST_SERIALIZATION_NVP(nextId);
+  }
+  else if (Archive::is_loading::value)
+  {
+    ids.reset();
+    removed.clear();
+    numRemoved = 0;
+    nextId = Dataset().n_cols;
+  }
 }
 
 //! Expose the dataset.
@@ -412,6 +559,62 @@ double& NSModel<SortPolicy>::Epsilon()
   return boost::apply_visitor(EpsilonVisitor(), nSearch);
 }
 
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::NumThreads() const
+{
+  return boost::apply_visitor(NumThreadsVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t& NSModel<SortPolicy>::NumThreads()
+{
+  return boost::apply_visitor(NumThreadsVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::MaxBaseCases() const
+{
+  return boost::apply_visitor(MaxBaseCasesVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t& NSModel<SortPolicy>::MaxBaseCases()
+{
+  return boost::apply_visitor(MaxBaseCasesVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+bool NSModel<SortPolicy>::Quantized() const
+{
+  return boost::apply_visitor(QuantizedVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+bool& NSModel<SortPolicy>::Quantized()
+{
+  return boost::apply_visitor(QuantizedVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::RerankFactor() const
+{
+  return boost::apply_visitor(RerankFactorVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+size_t& NSModel<SortPolicy>::RerankFactor()
+{
+  return boost::apply_visitor(RerankFactorVisitor(), nSearch);
+}
+
+template<typename SortPolicy>
+arma::Col<size_t> NSModel<SortPolicy>::QueryBaseCases() const
+{
+  if (HasUpdates())
+    return arma::Col<size_t>();
+  return boost::apply_visitor(QueryBaseCasesVisitor(), nSearch);
+}
+
 //! Build the reference tree.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
@@ -452,13 +655,27 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
     }
   }
 
-  // Clean memory, if necessary.
-  boost::apply_visitor(DeleteVisitor(), nSearch);
-
   // Do we need to modify the reference set?
   if (randomBasis)
     referenceSet = q * referenceSet;
 
+  ClearUpdates();
+  ids.reset();
+  removed.clear();
+  numRemoved = 0;
+  nextId = referenceSet.n_cols;
+  BuildSearch(std::move(referenceSet), searchMode, epsilon);
+}
+
+//! Create and train the NeighborSearch object.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::BuildSearch(arma::mat&& referenceSet,
+                                      const NeighborSearchMode searchMode,
+                                      const double epsilon)
+{
+  // Clean memory, if necessary.
+  boost::apply_visitor(DeleteVisitor(), nSearch);
+
   if (searchMode != NAIVE_MODE)
   {
     Timer::Start("tree_building");
@@ -516,7 +733,8 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
       break;
   }
 
-  TrainVisitor<SortPolicy> tn(std::move(referenceSet), leafSize, tau, rho);
+  TrainVisitor<SortPolicy> tn(std::move(referenceSet), leafSize, tau, rho,
+      packNodes);
   boost::apply_visitor(tn, nSearch);
 
   if (searchMode != NAIVE_MODE)
@@ -526,6 +744,376 @@ void NSModel<SortPolicy>::BuildModel(arma::mat&& referenceSet,
   }
 }
 
+//! Return the number of points that have not been removed.
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::NumPoints() const
+{
+  size_t numPoints = Dataset().n_cols + buffer.n_cols;
+  for (size_t i = 0; i < levels.size(); ++i)
+    if (levels[i] != NULL)
+      numPoints += levels[i]->ReferenceSet().n_cols;
+
+  return numPoints - numRemoved;
+}
+
+//! Add points to the model.
+template<typename SortPolicy>
+size_t NSModel<SortPolicy>::Insert(arma::mat&& points)
+{
+  if (points.n_rows != Dataset().n_rows)
+  {
+    std::stringstream ss;
+    ss << "Points to insert have invalid dimensions (" << points.n_rows
+        << "); should be " << Dataset().n_rows;
+    throw std::invalid_argument(ss.str());
+  }
+
+  const size_t firstId = nextId;
+  if (points.n_cols == 0)
+    return firstId;
+
+  // The stored points are in the random basis, if there is one.
+  if (randomBasis)
+    points = q * points;
+
+  arma::Col<size_t> pointIds(points.n_cols);
+  for (size_t i = 0; i < points.n_cols; ++i)
+    pointIds[i] = firstId + i;
+
+  buffer.insert_cols(buffer.n_cols, points);
+  bufferIds.insert_rows(bufferIds.n_elem, pointIds);
+  nextId += points.n_cols;
+
+  if (buffer.n_cols >= InsertBufferSize)
+    FlushBuffer();
+
+  return firstId;
+}
+
+//! Remove points from the model.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::Remove(const arma::Col<size_t>& pointIds)
+{
+  if (removed.size() < nextId)
+    removed.resize(nextId, 0);
+
+  // Mark the points, and undo the marks if one of them cannot be removed.
+  for (size_t i = 0; i < pointIds.n_elem; ++i)
+  {
+    if (pointIds[i] >= nextId || removed[pointIds[i]])
+    {
+      for (size_t j = 0; j < i; ++j)
+        removed[pointIds[j]] = 0;
+
+      std::stringstream ss;
+      ss << "Cannot remove point " << pointIds[i] << ": there is no point with "
+          << "that id in the model";
+      throw std::invalid_argument(ss.str());
+    }
+
+    removed[pointIds[i]] = 1;
+  }
+
+  if (pointIds.n_elem >= NumPoints())
+  {
+    for (size_t i = 0; i < pointIds.n_elem; ++i)
+      removed[pointIds[i]] = 0;
+
+    throw std::invalid_argument("cannot remove every point of the model");
+  }
+
+  numRemoved += pointIds.n_elem;
+  if (CompactRemovedFraction * numRemoved > NumPoints() + numRemoved)
+    Compact();
+}
+
+//! Rebuild the tree on every point that has not been removed.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::Compact()
+{
+  if (!HasUpdates())
+    return;
+
+  arma::mat points;
+  arma::Col<size_t> pointIds;
+  CollectPoints(Dataset(), boost::apply_visitor(OldFromNewVisitor(), nSearch),
+      ids, points, pointIds);
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    if (levels[i] != NULL)
+    {
+      CollectPoints(levels[i]->ReferenceSet(),
+          levels[i]->OldFromNewReferences(), levelIds[i], points, pointIds);
+    }
+  }
+  CollectPoints(buffer, std::vector<size_t>(), bufferIds, points, pointIds);
+
+  // Keep the points in the order of their ids.
+  const arma::uvec order = arma::sort_index(pointIds);
+  points = points.cols(order);
+  pointIds = arma::Col<size_t>(pointIds.elem(order));
+
+  const NeighborSearchMode searchMode = SearchMode();
+  const double epsilon = Epsilon();
+  const size_t numThreads = NumThreads();
+  const size_t maxBaseCases = MaxBaseCases();
+  const bool quantized = Quantized();
+  const size_t rerankFactor = RerankFactor();
+
+  ClearUpdates();
+  numRemoved = 0;
+  {
+    util::ScopedThreads scope(numThreads);
+    BuildSearch(std::move(points), searchMode, epsilon);
+  }
+  NumThreads() = numThreads;
+  MaxBaseCases() = maxBaseCases;
+  Quantized() = quantized;
+  RerankFactor() = rerankFactor;
+
+  // The ids are only stored if they are not the original indices.
+  if (pointIds[pointIds.n_elem - 1] == pointIds.n_elem - 1)
+    ids.reset();
+  else
+    ids = std::move(pointIds);
+}
+
+//! Delete the buffer and the trees of inserted points.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::ClearUpdates()
+{
+  for (size_t i = 0; i < levels.size(); ++i)
+    delete levels[i];
+
+  levels.clear();
+  levelIds.clear();
+  buffer.reset();
+  bufferIds.reset();
+}
+
+//! Collect the points of a reference set that have not been removed.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::CollectPoints(const arma::mat& referenceSet,
+                                        const std::vector<size_t>& oldFromNew,
+                                        const arma::Col<size_t>& setIds,
+                                        arma::mat& points,
+                                        arma::Col<size_t>& pointIds) const
+{
+  std::vector<size_t> kept;
+  std::vector<size_t> keptIds;
+  for (size_t i = 0; i < referenceSet.n_cols; ++i)
+  {
+    const size_t index = oldFromNew.empty() ? i : oldFromNew[i];
+    const size_t id = setIds.is_empty() ? index : setIds[index];
+    if (!IsRemoved(id))
+    {
+      kept.push_back(i);
+      keptIds.push_back(id);
+    }
+  }
+
+  const size_t start = points.n_cols;
+  points.resize(referenceSet.n_rows, start + kept.size());
+  pointIds.resize(start + kept.size());
+  for (size_t i = 0; i < kept.size(); ++i)
+  {
+    points.col(start + i) = referenceSet.col(kept[i]);
+    pointIds[start + i] = keptIds[i];
+  }
+}
+
+//! Merge the buffer of inserted points into a tree.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::FlushBuffer()
+{
+  // The buffer and every tree before the first empty one are merged into a
+  // new tree in its place.
+  size_t level = 0;
+  size_t mergedSize = buffer.n_cols;
+  while (level < levels.size() && levels[level] != NULL)
+    mergedSize += levels[level++]->ReferenceSet().n_cols;
+
+  // Once the inserted points are as many as those of the reference set, it is
+  // cheaper to rebuild everything.
+  if (mergedSize >= Dataset().n_cols)
+  {
+    Compact();
+    return;
+  }
+
+  arma::mat points;
+  arma::Col<size_t> pointIds;
+  CollectPoints(buffer, std::vector<size_t>(), bufferIds, points, pointIds);
+  buffer.reset();
+  bufferIds.reset();
+  for (size_t i = 0; i < level; ++i)
+  {
+    CollectPoints(levels[i]->ReferenceSet(), levels[i]->OldFromNewReferences(),
+        levelIds[i], points, pointIds);
+    delete levels[i];
+    levels[i] = NULL;
+    levelIds[i].reset();
+  }
+
+  // The removed points are dropped on the way.
+  numRemoved -= (mergedSize - points.n_cols);
+
+  if (level == levels.size())
+  {
+    levels.push_back(NULL);
+    levelIds.push_back(arma::Col<size_t>());
+  }
+
+  if (points.n_cols == 0)
+    return;
+
+  // The tree is always built, so that any search mode can be used later, with
+  // as many threads as the search uses.
+  util::ScopedThreads scope(NumThreads());
+  NSType<SortPolicy, tree::KDTree>* ns =
+      new NSType<SortPolicy, tree::KDTree>(DUAL_TREE_MODE);
+  TrainVisitor<SortPolicy> tn(std::move(points), leafSize, tau, rho,
+      packNodes);
+  tn(ns);
+
+  levels[level] = ns;
+  levelIds[level] = std::move(pointIds);
+}
+
+//! Search for neighbors in one part of the model.
+template<typename SortPolicy>
+template<typename SearchFunction>
+void NSModel<SortPolicy>::SearchPart(SearchFunction search,
+                                     const size_t setSize,
+                                     const arma::Col<size_t>& setIds,
+                                     const arma::mat& querySet,
+                                     const size_t k,
+                                     arma::Mat<size_t>& neighbors,
+                                     arma::mat& distances) const
+{
+  if (setSize == 0)
+    return;
+
+  // At first, ask for enough neighbors to skip up to k removed points.
+  size_t partK = std::min(setSize, k + std::min(numRemoved, k));
+  bool allQueries = true;
+  std::vector<size_t> queries;
+  while (allQueries || !queries.empty())
+  {
+    arma::mat subset;
+    if (!allQueries)
+    {
+      subset.set_size(querySet.n_rows, queries.size());
+      for (size_t i = 0; i < queries.size(); ++i)
+        subset.col(i) = querySet.col(queries[i]);
+    }
+    const arma::mat& partQueries = allQueries ? querySet : subset;
+
+    arma::Mat<size_t> partNeighbors;
+    arma::mat partDistances;
+    search(partQueries, partK, partNeighbors, partDistances);
+
+    std::vector<size_t> retry;
+    for (size_t i = 0; i < partQueries.n_cols; ++i)
+    {
+      const size_t queryIndex = allQueries ? i : queries[i];
+
+      // If too many of the neighbors were removed, better points may follow
+      // them.
+      size_t found = 0;
+      for (size_t j = 0; j < partK; ++j)
+      {
+        const size_t index = partNeighbors(j, i);
+        if (index != SIZE_MAX &&
+            !IsRemoved(setIds.is_empty() ? index : setIds[index]))
+          ++found;
+      }
+
+      if (found < k && partK < setSize)
+      {
+        retry.push_back(queryIndex);
+        continue;
+      }
+
+      for (size_t j = 0; j < partK; ++j)
+      {
+        const size_t index = partNeighbors(j, i);
+        if (index == SIZE_MAX)
+          continue;
+
+        const size_t id = setIds.is_empty() ? index : setIds[index];
+        if (!IsRemoved(id))
+        {
+          InsertNeighbor(neighbors, distances, queryIndex, id,
+              partDistances(j, i));
+        }
+      }
+    }
+
+    queries.swap(retry);
+    allQueries = false;
+    partK = std::min(setSize, 2 * partK);
+  }
+}
+
+//! Search the buffer of inserted points by brute force.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::SearchBuffer(const arma::mat& querySet,
+                                       arma::Mat<size_t>& neighbors,
+                                       arma::mat& distances) const
+{
+  if (buffer.n_cols == 0)
+    return;
+
+  // Use as many threads as the searches of the trees.
+#ifdef _OPENMP
+  const int threads = (NumThreads() == 0) ? omp_get_max_threads() :
+      (int) NumThreads();
+#endif
+  #pragma omp parallel for num_threads(threads)
+  for (omp_size_t i = 0; i < (omp_size_t) querySet.n_cols; ++i)
+  {
+    for (size_t j = 0; j < buffer.n_cols; ++j)
+    {
+      if (IsRemoved(bufferIds[j]))
+        continue;
+
+      const double distance = metric::EuclideanDistance::Evaluate(
+          querySet.col(i), buffer.col(j));
+      InsertNeighbor(neighbors, distances, i, bufferIds[j], distance);
+    }
+  }
+}
+
+//! Insert a neighbor into the sorted neighbors of a query.
+template<typename SortPolicy>
+void NSModel<SortPolicy>::InsertNeighbor(arma::Mat<size_t>& neighbors,
+                                         arma::mat& distances,
+                                         const size_t queryIndex,
+                                         const size_t id,
+                                         const double distance)
+{
+  // Empty slots are marked with SIZE_MAX; a neighbor at the same distance as
+  // one found before goes after it.
+  size_t pos = neighbors.n_rows;
+  while (pos > 0 && (neighbors(pos - 1, queryIndex) == SIZE_MAX ||
+      (SortPolicy::IsBetter(distance, distances(pos - 1, queryIndex)) &&
+       distance != distances(pos - 1, queryIndex))))
+    --pos;
+
+  if (pos == neighbors.n_rows)
+    return;
+
+  for (size_t i = neighbors.n_rows - 1; i > pos; --i)
+  {
+    neighbors(i, queryIndex) = neighbors(i - 1, queryIndex);
+    distances(i, queryIndex) = distances(i - 1, queryIndex);
+  }
+
+  neighbors(pos, queryIndex) = id;
+  distances(pos, queryIndex) = distance;
+}
+
 //! Perform neighbor search.  The query set will be reordered.
 template<typename SortPolicy>
 void NSModel<SortPolicy>::Search(arma::mat&& querySet,
@@ -533,6 +1121,9 @@ void NSModel<SortPolicy>::Search(arma::mat&& querySet,
                                  arma::Mat<size_t>& neighbors,
                                  arma::mat& distances)
 {
+  // The query trees are built with as many threads as the search uses.
+  util::ScopedThreads scope(NumThreads());
+
   // We may need to map the query set randomly.
   if (randomBasis)
     querySet = q * querySet;
@@ -554,11 +1145,80 @@ void NSModel<SortPolicy>::Search(arma::mat&& querySet,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEST_FIRST_SINGLE_TREE_MODE:
+      Log::Info << "best-first single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
-  BiSearchVisitor<SortPolicy> search(querySet, k, neighbors, distances,
-      leafSize, tau, rho);
-  boost::apply_visitor(search, nSearch);
+  if (!HasUpdates())
+  {
+    BiSearchVisitor<SortPolicy> search(querySet, k, neighbors, distances,
+        leafSize, tau, rho);
+    boost::apply_visitor(search, nSearch);
+
+    // Map the indices of the reference set to ids, if they differ.
+    if (!ids.is_empty())
+    {
+      for (size_t i = 0; i < neighbors.n_elem; ++i)
+        if (neighbors[i] != SIZE_MAX)
+          neighbors[i] = ids[neighbors[i]];
+    }
+
+    return;
+  }
+
+  const size_t numPoints = NumPoints();
+  if (k > numPoints)
+  {
+    std::stringstream ss;
+    ss << "Requested value of k (" << k << ") is greater than the number of "
+        << "points in the model (" << numPoints << ")";
+    throw std::invalid_argument(ss.str());
+  }
+
+  neighbors.set_size(k, querySet.n_cols);
+  neighbors.fill(SIZE_MAX);
+  distances.set_size(k, querySet.n_cols);
+  distances.fill(SortPolicy::WorstDistance());
+
+  // Search the tree of the reference set, then each tree of inserted points,
+  // then the buffer, and keep the best neighbors of them all.
+  SearchPart([this](const arma::mat& queries,
+                    const size_t partK,
+                    arma::Mat<size_t>& partNeighbors,
+                    arma::mat& partDistances)
+      {
+        BiSearchVisitor<SortPolicy> search(queries, partK, partNeighbors,
+            partDistances, leafSize, tau, rho);
+        boost::apply_visitor(search, nSearch);
+      }, Dataset().n_cols, ids, querySet, k, neighbors, distances);
+
+  for (size_t i = 0; i < levels.size(); ++i)
+  {
+    NSType<SortPolicy, tree::KDTree>* level = levels[i];
+    if (level == NULL)
+      continue;
+
+    level->SearchMode() = SearchMode();
+    level->Epsilon() = Epsilon();
+    level->NumThreads() = NumThreads();
+    level->MaxBaseCases() = MaxBaseCases();
+    level->Quantized() = Quantized();
+    level->RerankFactor() = RerankFactor();
+    SearchPart([this, level](const arma::mat& queries,
+                             const size_t partK,
+                             arma::Mat<size_t>& partNeighbors,
+                             arma::mat& partDistances)
+        {
+          BiSearchVisitor<SortPolicy> search(queries, partK, partNeighbors,
+              partDistances, leafSize, tau, rho);
+          search(level);
+        }, level->ReferenceSet().n_cols, levelIds[i], querySet, k, neighbors,
+        distances);
+  }
+
+  SearchBuffer(querySet, neighbors, distances);
 }
 
 //! Perform neighbor search.
@@ -584,14 +1244,33 @@ void NSModel<SortPolicy>::Search(const size_t k,
       Log::Info << "greedy single-tree " << TreeName() << " search..."
           << std::endl;
       break;
+    case BEST_FIRST_SINGLE_TREE_MODE:
+      Log::Info << "best-first single-tree " << TreeName() << " search..."
+          << std::endl;
+      break;
   }
 
   if (Epsilon() != 0 && SearchMode() != NAIVE_MODE)
     Log::Info << "Maximum of " << Epsilon() * 100 << "% relative error."
         << std::endl;
 
+  if (HasUpdates())
+  {
+    Log::Info << "Rebuilding the tree on the inserted and removed points..."
+        << std::endl;
+    Compact();
+  }
+
   MonoSearchVisitor search(k, neighbors, distances);
   boost::apply_visitor(search, nSearch);
+
+  // Map the indices of the reference set to ids, if they differ.
+  if (!ids.is_empty())
+  {
+    for (size_t i = 0; i < neighbors.n_elem; ++i)
+      if (neighbors[i] != SIZE_MAX)
+        neighbors[i] = ids[neighbors[i]];
+  }
 }
 
 //! Get the name of the tree type.
@@ -17,6 +17,7 @@
 #include <mlpack/core/metrics/lmetric.hpp>
 #include <mlpack/core/tree/binary_space_tree.hpp>
 #include "range_search_stat.hpp"
+#include "range_search_rules.hpp"
 
 namespace mlpack {
 namespace range /** Range-search routines. */ {
@@ -185,6 +186,29 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all reference points in the given range for each point in the
+   * query set, returning the results in compressed sparse row form: the
+   * results of query point i are neighbors[offsets[i]] to
+   * neighbors[offsets[i + 1] - 1], and the corresponding elements of
+   * distances.  This holds the results of all query points in three
+   * allocations, instead of two for each query point; the results of each
+   * query point are in the same order as with the other overload.
+   *
+   * @param querySet Set of query points to search with.
+   * @param range Range of distances in which to search.
+   * @param offsets Vector which will hold the index of the first result of
+   *      each query point, followed by the total number of results.
+   * @param neighbors Vector which will hold the index of the reference point
+   *      of each result.
+   * @param distances Vector which will hold the distance of each result.
+   */
+  void Search(const MatType& querySet,
+              const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
   /**
    * Given a pre-built query tree, search for all reference points in the given
    * range for each point in the query set, returning the results in the
@@ -259,6 +283,24 @@ class RangeSearch
               std::vector<std::vector<size_t>>& neighbors,
               std::vector<std::vector<double>>& distances);
 
+  /**
+   * Search for all points in the given range for each point in the reference
+   * set, returning the results in compressed sparse row form: the results of
+   * point i are neighbors[offsets[i]] to neighbors[offsets[i + 1] - 1], and the
+   * corresponding elements of distances.
+   *
+   * @param range Range of distances in which to search.
+   * @param offsets Vector which will hold the index of the first result of
+   *      each point, followed by the total number of results.
+   * @param neighbors Vector which will hold the index of the reference point
+   *      of each result.
+   * @param distances Vector which will hold the distance of each result.
+   */
+  void Search(const math::Range& range,
+              arma::Col<size_t>& offsets,
+              arma::Col<size_t>& neighbors,
+              arma::vec& distances);
+
   //! Get whether single-tree search is being used.
   bool SingleMode() const { return singleMode; }
   //! Modify whether single-tree search is being used.
@@ -269,6 +311,13 @@ class RangeSearch
   //! Modify whether naive search is being used.
   bool& Naive() { return naive; }
 
+  //! Get the number of threads used by Search(); 0 means as many as OpenMP
+  //! would use by default.
+  size_t NumThreads() const { return numThreads; }
+  //! Modify the number of threads used by Search(); 0 means as many as OpenMP
+  //! would use by default.
+  size_t& NumThreads() { return numThreads; }
+
   //! Get the number of base cases during the last search.
   size_t BaseCases() const { return baseCases; }
   //! Get the number of scores during the last search.
@@ -304,11 +353,118 @@ class RangeSearch
   //! Instantiated distance metric.
   MetricType metric;
 
+  //! The number of threads to search with; 0 means the OpenMP default.
+  size_t numThreads;
+
   //! The total number of base cases during the last search.
   size_t baseCases;
   //! The total number of scores during the last search.
   size_t scores;
 
+  //! Number of query points searched by each thread at a time in single-tree
+  //! and naive search.
+  static const size_t QueryBlockSize = 256;
+  //! The number of subtrees the query tree is split into for dual-tree search,
+  //! if it is large enough.
+  static const size_t QuerySubtrees = 256;
+  //! Query trees with at most this many points are not split; neither are
+  //! subtrees split into smaller ones than this.
+  static const size_t QuerySubtreeMinSize = 1024;
+
+  //! Get the number of threads to search with.
+  int SearchThreads() const;
+
+  //! Check the dimensionality of the given query set, and return whether there
+  //! are reference points to search.
+  bool CheckQuerySet(const MatType& querySet) const;
+
+  //! Get the original index of each point of the query tree, if it must be
+  //! mapped (or NULL).
+  const std::vector<size_t>* QueryMapping(
+      const std::vector<size_t>& oldFromNewQueries) const;
+  //! Get the original index of each point of the reference tree, if it must be
+  //! mapped (or NULL).
+  const std::vector<size_t>* ReferenceMapping() const;
+
+  /**
+   * Search for the points in range of each point of the given query set,
+   * building a query tree for dual-tree search.
+   *
+   * @param querySet Set of query points.
+   * @param range Range of distances in which to search.
+   * @param results Object to store the (unmapped) results of each part of the
+   *      search into.
+   * @param oldFromNewQueries Vector to store the original index of each point
+   *      of the query tree into, if one is built.
+   */
+  void SearchResults(const MatType& querySet,
+                     const math::Range& range,
+                     std::vector<RangeSearchResults>& results,
+                     std::vector<size_t>& oldFromNewQueries);
+
+  /**
+   * Search for the points in range of each query point with the search mode of
+   * this object.  Naive and single-tree search split the query points into
+   * blocks, and dual-tree search splits the query tree into subtrees if the
+   * tree type allows it; the parts are searched in parallel, each with its own
+   * rules object and results, and each query point is in one part only.
+   *
+   * @param querySet Set of query points.
+   * @param queryTree Tree built on the query points (only used for dual-tree
+   *      search).
+   * @param range Range of distances in which to search.
+   * @param sameSet Whether the query set is the reference set.
+   * @param results Object to store the (unmapped) results of each part into.
+   */
+  void Compute(const MatType& querySet,
+               Tree* queryTree,
+               const math::Range& range,
+               const bool sameSet,
+               std::vector<RangeSearchResults>& results);
+
+  /**
+   * Gather the results of all parts of a search into one vector of neighbors
+   * and distances for each query point, mapping the indices as given.  The
+   * results of each part are released once gathered.
+   *
+   * @param results Results of each part of the search.
+   * @param numQueries Number of query points.
+   * @param oldFromNewQueries Original index of each query point, or NULL.
+   * @param oldFromNewReferences Original index of each reference point, or
+   *      NULL.
+   * @param neighbors Object to store the neighbors of each query point into.
+   * @param distances Object to store the distances of each query point into.
+   */
+  void GatherResults(std::vector<RangeSearchResults>& results,
+                     const size_t numQueries,
+                     const std::vector<size_t>* oldFromNewQueries,
+                     const std::vector<size_t>* oldFromNewReferences,
+                     std::vector<std::vector<size_t>>& neighbors,
+                     std::vector<std::vector<double>>& distances);
+
+  /**
+   * Gather the results of all parts of a search in compressed sparse row form,
+   * mapping the indices as given.  The results of each part are released once
+   * gathered.
+   *
+   * @param results Results of each part of the search.
+   * @param numQueries Number of query points.
+   * @param oldFromNewQueries Original index of each query point, or NULL.
+   * @param oldFromNewReferences Original index of each reference point, or
+   *      NULL.
+   * @param offsets Vector to store the offset of the results of each query
+   *      point into.
+   * @param neighbors Vector to store the neighbor of each result into.
+   * @param distances Vector to store the distance of each result into.
+   */
+  void GatherResults(std::vector<RangeSearchResults>& results,
+                     const size_t numQueries,
+                     const std::vector<size_t>* oldFromNewQueries,
+                     const std::vector<size_t>* oldFromNewReferences,
+                     arma::Col<size_t>& offsets,
+                     arma::Col<size_t>& neighbors,
+                     arma::vec& distances);
+
   //! For access to mappings when building models.
   friend class TrainVisitor;
 };
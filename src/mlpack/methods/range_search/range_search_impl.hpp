@@ -18,6 +18,8 @@
 // The rules for traversal.
 #include "range_search_rules.hpp"
 
+#include <stack>
+
 namespace mlpack {
 namespace range {
 
@@ -60,6 +62,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     naive(naive),
     singleMode(!naive && singleMode),
     metric(metric),
+    numThreads(0),
     baseCases(0),
     scores(0)
 {
@@ -81,6 +84,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     naive(false),
     singleMode(singleMode),
     metric(metric),
+    numThreads(0),
     baseCases(0),
     scores(0)
 {
@@ -102,6 +106,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     naive(naive),
     singleMode(singleMode),
     metric(metric),
+    numThreads(0),
     baseCases(0),
     scores(0)
 {
@@ -130,6 +135,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(
     naive(other.naive),
     singleMode(other.singleMode),
     metric(other.metric),
+    numThreads(other.numThreads),
     baseCases(other.baseCases),
     scores(other.scores)
 {
@@ -149,6 +155,7 @@ RangeSearch<MetricType, MatType, TreeType>::RangeSearch(RangeSearch&& other) :
     naive(other.naive),
     singleMode(other.singleMode),
     metric(std::move(other.metric)),
+    numThreads(other.numThreads),
     baseCases(other.baseCases),
     scores(other.scores)
 {
@@ -185,6 +192,7 @@ RangeSearch<MetricType, MatType, TreeType>::operator=(RangeSearch other)
   naive = other.naive;
   singleMode = other.singleMode;
   metric = std::move(other.metric);
+  numThreads = other.numThreads;
   baseCases = other.baseCases;
   scores = other.scores;
 
@@ -273,177 +281,341 @@ void RangeSearch<MetricType, MatType, TreeType>::Search(
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances)
 {
-  if (querySet.n_rows != referenceSet->n_rows)
-  {
-    std::ostringstream oss;
-    oss << "RangeSearch::Search(): dimensionalities of query set ("
-        << querySet.n_rows << ") and reference set (" << referenceSet->n_rows
-        << ") do not match!";
-    throw std::invalid_argument(oss.str());
-  }
+  // If there are no points, there is no search to be done.
+  if (!CheckQuerySet(querySet))
+    return;
+
+  std::vector<RangeSearchResults> results;
+  std::vector<size_t> oldFromNewQueries;
+  SearchResults(querySet, range, results, oldFromNewQueries);
+
+  Timer::Start("range_search/computing_neighbors");
+  GatherResults(results, querySet.n_cols, QueryMapping(oldFromNewQueries),
+      ReferenceMapping(), neighbors, distances);
+  Timer::Stop("range_search/computing_neighbors");
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const MatType& querySet,
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  std::vector<RangeSearchResults> results;
+  std::vector<size_t> oldFromNewQueries;
+  if (CheckQuerySet(querySet))
+    SearchResults(querySet, range, results, oldFromNewQueries);
+
+  Timer::Start("range_search/computing_neighbors");
+  GatherResults(results, querySet.n_cols, QueryMapping(oldFromNewQueries),
+      ReferenceMapping(), offsets, neighbors, distances);
+  Timer::Stop("range_search/computing_neighbors");
+}
 
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    Tree* queryTree,
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
   // If there are no points, there is no search to be done.
   if (referenceSet->n_cols == 0)
     return;
 
+  // Make sure we are in dual-tree mode.
+  if (singleMode || naive)
+    throw std::invalid_argument("cannot call RangeSearch::Search() with a "
+        "query tree when naive or singleMode are set to true");
+
   Timer::Start("range_search/computing_neighbors");
 
-  // This will hold mappings for query points, if necessary.
-  std::vector<size_t> oldFromNewQueries;
+  // The query points are not mapped: the results are given in the order of the
+  // dataset of the query tree.
+  std::vector<RangeSearchResults> results;
+  Compute(queryTree->Dataset(), queryTree, range, false, results);
+  GatherResults(results, queryTree->Dataset().n_cols, NULL,
+      ReferenceMapping(), neighbors, distances);
 
-  // If we have built the trees ourselves, then we will have to map all the
-  // indices back to their original indices when this computation is finished.
-  // To avoid extra copies, we will store the unmapped neighbors and distances
-  // in a separate object.
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
-  std::vector<std::vector<double>>* distancePtr = &distances;
+  Timer::Stop("range_search/computing_neighbors");
+}
 
-  // Mapping is only necessary if the tree rearranges points.
-  if (tree::TreeTraits<Tree>::RearrangesDataset)
-  {
-    // Query indices only need to be mapped if we are building the query tree
-    // ourselves.
-    if (!singleMode && !naive)
-    {
-      distancePtr = new std::vector<std::vector<double>>;
-      neighborPtr = new std::vector<std::vector<size_t>>;
-    }
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    std::vector<std::vector<size_t>>& neighbors,
+    std::vector<std::vector<double>>& distances)
+{
+  // If there are no points, there is no search to be done.
+  if (referenceSet->n_cols == 0)
+    return;
 
-    // Reference indices only need to be mapped if we built the reference tree
-    // ourselves.
-    else if (treeOwner)
-      neighborPtr = new std::vector<std::vector<size_t>>;
-  }
+  Timer::Start("range_search/computing_neighbors");
 
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(querySet.n_cols);
-  distancePtr->clear();
-  distancePtr->resize(querySet.n_cols);
+  // Here, we will use the query set as the reference set, so the query points
+  // are mapped like the reference points.
+  std::vector<RangeSearchResults> results;
+  Compute(*referenceSet, referenceTree, range, true, results);
+  GatherResults(results, referenceSet->n_cols, ReferenceMapping(),
+      ReferenceMapping(), neighbors, distances);
 
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
+  Timer::Stop("range_search/computing_neighbors");
+}
 
-  // Reset counts.
-  baseCases = 0;
-  scores = 0;
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Search(
+    const math::Range& range,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
+{
+  Timer::Start("range_search/computing_neighbors");
 
-  if (naive)
-  {
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
+  // Here, we will use the query set as the reference set, so the query points
+  // are mapped like the reference points.
+  std::vector<RangeSearchResults> results;
+  if (referenceSet->n_cols > 0)
+    Compute(*referenceSet, referenceTree, range, true, results);
+  GatherResults(results, referenceSet->n_cols, ReferenceMapping(),
+      ReferenceMapping(), offsets, neighbors, distances);
 
-    // The naive brute-force solution.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
+  Timer::Stop("range_search/computing_neighbors");
+}
 
-    baseCases += (querySet.n_cols * referenceSet->n_cols);
-  }
-  else if (singleMode)
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+int RangeSearch<MetricType, MatType, TreeType>::SearchThreads() const
+{
+#ifdef _OPENMP
+  return (numThreads == 0) ? omp_get_max_threads() : (int) numThreads;
+#else
+  return 1;
+#endif
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+bool RangeSearch<MetricType, MatType, TreeType>::CheckQuerySet(
+    const MatType& querySet) const
+{
+  if (querySet.n_rows != referenceSet->n_rows)
   {
-    // Create the traverser.
-    RuleType rules(*referenceSet, querySet, range, *neighborPtr, *distancePtr,
-        metric);
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+    std::ostringstream oss;
+    oss << "RangeSearch::Search(): dimensionalities of query set ("
+        << querySet.n_rows << ") and reference set (" << referenceSet->n_rows
+        << ") do not match!";
+    throw std::invalid_argument(oss.str());
+  }
 
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < querySet.n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
+  return (referenceSet->n_cols > 0);
+}
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
-  }
-  else // Dual-tree recursion.
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+const std::vector<size_t>*
+RangeSearch<MetricType, MatType, TreeType>::QueryMapping(
+    const std::vector<size_t>& oldFromNewQueries) const
+{
+  // Query indices only need to be mapped if we built the query tree ourselves.
+  return (tree::TreeTraits<Tree>::RearrangesDataset && !singleMode && !naive) ?
+      &oldFromNewQueries : NULL;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+const std::vector<size_t>*
+RangeSearch<MetricType, MatType, TreeType>::ReferenceMapping() const
+{
+  // Reference indices only need to be mapped if we built the reference tree
+  // ourselves.
+  return (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner) ?
+      &oldFromNewReferences : NULL;
+}
+
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::SearchResults(
+    const MatType& querySet,
+    const math::Range& range,
+    std::vector<RangeSearchResults>& results,
+    std::vector<size_t>& oldFromNewQueries)
+{
+  if (naive || singleMode)
   {
-    // Build the query tree.
-    Timer::Stop("range_search/computing_neighbors");
-    Timer::Start("range_search/tree_building");
-    Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
-    Timer::Stop("range_search/tree_building");
     Timer::Start("range_search/computing_neighbors");
+    Compute(querySet, NULL, range, false, results);
+    Timer::Stop("range_search/computing_neighbors");
+    return;
+  }
 
-    // Create the traverser.
-    RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-        *distancePtr, metric);
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+  // Build the query tree.
+  Timer::Start("range_search/tree_building");
+  Tree* queryTree = BuildTree<Tree>(querySet, oldFromNewQueries);
+  Timer::Stop("range_search/tree_building");
 
-    traverser.Traverse(*queryTree, *referenceTree);
+  Timer::Start("range_search/computing_neighbors");
+  Compute(queryTree->Dataset(), queryTree, range, false, results);
+  Timer::Stop("range_search/computing_neighbors");
 
-    baseCases += rules.BaseCases();
-    scores += rules.Scores();
+  // Clean up tree memory.
+  delete queryTree;
+}
 
-    // Clean up tree memory.
-    delete queryTree;
-  }
+template<typename MetricType,
+         typename MatType,
+         template<typename TreeMetricType,
+                  typename TreeStatType,
+                  typename TreeMatType> class TreeType>
+void RangeSearch<MetricType, MatType, TreeType>::Compute(
+    const MatType& querySet,
+    Tree* queryTree,
+    const math::Range& range,
+    const bool sameSet,
+    std::vector<RangeSearchResults>& results)
+{
+  typedef RangeSearchRules<MetricType, Tree> RuleType;
 
-  Timer::Stop("range_search/computing_neighbors");
+  size_t partBaseCases = 0;
+  size_t partScores = 0;
 
-  // Map points back to original indices, if necessary.
-  if (tree::TreeTraits<Tree>::RearrangesDataset)
+  if (naive || singleMode)
   {
-    if (!singleMode && !naive && treeOwner)
+    // The query points are split into blocks that are searched in parallel,
+    // each with its own rules object.  Trees with self-children (i.e. cover
+    // trees) cache base cases in the statistics of the reference nodes during
+    // single-tree search, so the blocks can only be searched one at a time.
+    const bool parallel = naive || !tree::TreeTraits<Tree>::HasSelfChildren;
+    const size_t blocks = (querySet.n_cols + QueryBlockSize - 1) /
+        QueryBlockSize;
+    results.clear();
+    results.resize(blocks);
+
+    #pragma omp parallel for schedule(dynamic) if(parallel) \
+        num_threads(SearchThreads()) reduction(+:partBaseCases, partScores)
+    for (omp_size_t b = 0; b < (omp_size_t) blocks; ++b)
     {
-      // We must map both query and reference indices.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
-      distances.clear();
-      distances.resize(querySet.n_cols);
+      const size_t begin = b * QueryBlockSize;
+      const size_t end = std::min(begin + QueryBlockSize,
+          (size_t) querySet.n_cols);
 
-      for (size_t i = 0; i < distances.size(); ++i)
+      MetricType blockMetric(metric);
+      RuleType rules(*referenceSet, querySet, range, results[b], blockMetric,
+          sameSet);
+
+      if (naive)
       {
-        // Map distances (copy a column).
-        const size_t queryMapping = oldFromNewQueries[i];
-        distances[queryMapping] = (*distancePtr)[i];
-
-        // Copy each neighbor individually, because we need to map it.
-        neighbors[queryMapping].resize(distances[queryMapping].size());
-        for (size_t j = 0; j < distances[queryMapping].size(); ++j)
-          neighbors[queryMapping][j] =
-              oldFromNewReferences[(*neighborPtr)[i][j]];
+        // The naive brute-force solution.
+        for (size_t i = begin; i < end; ++i)
+          for (size_t j = 0; j < referenceSet->n_cols; ++j)
+            rules.BaseCase(i, j);
+
+        partBaseCases += (end - begin) * referenceSet->n_cols;
       }
+      else
+      {
+        // Create the traverser, and have it traverse for each point.
+        typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
+        for (size_t i = begin; i < end; ++i)
+          traverser.Traverse(i, *referenceTree);
 
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
+        partBaseCases += rules.BaseCases();
+        partScores += rules.Scores();
+      }
     }
-    else if (!singleMode && !naive)
+  }
+  else
+  {
+    // Trees that rearrange the dataset hold the descendants of each node
+    // contiguously, so the query tree can be split into subtrees that are
+    // searched in parallel, each with its own rules object, and whose results
+    // hold disjoint sets of query points.  Trees with self-children (cover
+    // trees) are searched whole.
+    std::vector<Tree*> subtrees;
+    const bool splitTree = tree::TreeTraits<Tree>::RearrangesDataset &&
+        !tree::TreeTraits<Tree>::HasSelfChildren;
+    if (splitTree && querySet.n_cols > QuerySubtreeMinSize)
     {
-      // We must map query indices only.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
-      distances.clear();
-      distances.resize(querySet.n_cols);
+      const size_t maxSize = std::max((size_t) QuerySubtreeMinSize,
+          (size_t) querySet.n_cols / QuerySubtrees);
 
-      for (size_t i = 0; i < distances.size(); ++i)
+      std::stack<Tree*> nodes;
+      nodes.push(queryTree);
+      while (!nodes.empty())
       {
-        // Map distances and neighbors (copy a column).
-        const size_t queryMapping = oldFromNewQueries[i];
-        distances[queryMapping] = (*distancePtr)[i];
-        neighbors[queryMapping] = (*neighborPtr)[i];
+        Tree* node = nodes.top();
+        nodes.pop();
+
+        if (node->IsLeaf() || node->NumPoints() > 0 ||
+            node->NumDescendants() <= maxSize)
+        {
+          subtrees.push_back(node);
+        }
+        else
+        {
+          for (size_t i = node->NumChildren(); i > 0; --i)
+            nodes.push(&node->Child(i - 1));
+        }
       }
-
-      // Finished with temporary objects.
-      delete neighborPtr;
-      delete distancePtr;
     }
-    else if (treeOwner)
+    else
     {
-      // We must map reference indices only.
-      neighbors.clear();
-      neighbors.resize(querySet.n_cols);
+      subtrees.push_back(queryTree);
+    }
 
-      for (size_t i = 0; i < neighbors.size(); ++i)
-      {
-        neighbors[i].resize((*neighborPtr)[i].size());
-        for (size_t j = 0; j < neighbors[i].size(); ++j)
-          neighbors[i][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
-      }
+    results.clear();
+    results.resize(subtrees.size());
+
+    #pragma omp parallel for schedule(dynamic) num_threads(SearchThreads()) \
+        reduction(+:partBaseCases, partScores)
+    for (omp_size_t i = 0; i < (omp_size_t) subtrees.size(); ++i)
+    {
+      MetricType subtreeMetric(metric);
+      RuleType rules(*referenceSet, querySet, range, results[i],
+          subtreeMetric, sameSet);
+
+      typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
+      traverser.Traverse(*subtrees[i], *referenceTree);
 
-      // Finished with temporary object.
-      delete neighborPtr;
+      partBaseCases += rules.BaseCases();
+      partScores += rules.Scores();
     }
   }
+
+  baseCases = partBaseCases;
+  scores = partScores;
 }
 
 template<typename MetricType,
@@ -451,69 +623,51 @@ template<typename MetricType,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Search(
-    Tree* queryTree,
-    const math::Range& range,
+void RangeSearch<MetricType, MatType, TreeType>::GatherResults(
+    std::vector<RangeSearchResults>& results,
+    const size_t numQueries,
+    const std::vector<size_t>* oldFromNewQueries,
+    const std::vector<size_t>* oldFromNewReferences,
     std::vector<std::vector<size_t>>& neighbors,
     std::vector<std::vector<double>>& distances)
 {
-  // If there are no points, there is no search to be done.
-  if (referenceSet->n_cols == 0)
-    return;
-
-  Timer::Start("range_search/computing_neighbors");
-
-  // Get a reference to the query set.
-  const MatType& querySet = queryTree->Dataset();
-
-  // Make sure we are in dual-tree mode.
-  if (singleMode || naive)
-    throw std::invalid_argument("cannot call RangeSearch::Search() with a "
-        "query tree when naive or singleMode are set to true");
-
-  // We won't need to map query indices, but will we need to map distances?
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
-
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
-    neighborPtr = new std::vector<std::vector<size_t>>;
-
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(querySet.n_cols);
+  neighbors.clear(); // Just in case there was anything in it.
+  neighbors.resize(numQueries);
   distances.clear();
-  distances.resize(querySet.n_cols);
-
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, queryTree->Dataset(), range, *neighborPtr,
-      distances, metric);
-
-  // Create the traverser.
-  typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
-
-  traverser.Traverse(*queryTree, *referenceTree);
+  distances.resize(numQueries);
 
-  Timer::Stop("range_search/computing_neighbors");
-
-  baseCases = rules.BaseCases();
-  scores = rules.Scores();
-
-  // Do we need to map indices?
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
+  // Each query point has results in one part at most, so the parts can be
+  // gathered in parallel.
+  arma::Col<size_t> counts(numQueries, arma::fill::zeros);
+  #pragma omp parallel for schedule(dynamic) num_threads(SearchThreads())
+  for (omp_size_t p = 0; p < (omp_size_t) results.size(); ++p)
   {
-    // We must map reference indices only.
-    neighbors.clear();
-    neighbors.resize(querySet.n_cols);
+    RangeSearchResults& part = results[p];
+    for (size_t i = 0; i < part.queries.size(); ++i)
+    {
+      const size_t query = oldFromNewQueries ?
+          (*oldFromNewQueries)[part.queries[i]] : part.queries[i];
+      ++counts[query];
+    }
 
-    for (size_t i = 0; i < neighbors.size(); ++i)
+    // Allocate the results of each query point once.
+    for (size_t i = 0; i < part.queries.size(); ++i)
     {
-      neighbors[i].resize((*neighborPtr)[i].size());
-      for (size_t j = 0; j < neighbors[i].size(); ++j)
-        neighbors[i][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
+      const size_t query = oldFromNewQueries ?
+          (*oldFromNewQueries)[part.queries[i]] : part.queries[i];
+      if (neighbors[query].empty())
+      {
+        neighbors[query].reserve(counts[query]);
+        distances[query].reserve(counts[query]);
+      }
+
+      neighbors[query].push_back(oldFromNewReferences ?
+          (*oldFromNewReferences)[part.neighbors[i]] : part.neighbors[i]);
+      distances[query].push_back(part.distances[i]);
     }
 
-    // Finished with temporary object.
-    delete neighborPtr;
+    // Release the memory of the part as soon as possible.
+    part = RangeSearchResults();
   }
 }
 
@@ -522,99 +676,54 @@ template<typename MetricType,
          template<typename TreeMetricType,
                   typename TreeStatType,
                   typename TreeMatType> class TreeType>
-void RangeSearch<MetricType, MatType, TreeType>::Search(
-    const math::Range& range,
-    std::vector<std::vector<size_t>>& neighbors,
-    std::vector<std::vector<double>>& distances)
+void RangeSearch<MetricType, MatType, TreeType>::GatherResults(
+    std::vector<RangeSearchResults>& results,
+    const size_t numQueries,
+    const std::vector<size_t>* oldFromNewQueries,
+    const std::vector<size_t>* oldFromNewReferences,
+    arma::Col<size_t>& offsets,
+    arma::Col<size_t>& neighbors,
+    arma::vec& distances)
 {
-  // If there are no points, there is no search to be done.
-  if (referenceSet->n_cols == 0)
-    return;
-
-  Timer::Start("range_search/computing_neighbors");
-
-  // Here, we will use the query set as the reference set.
-  std::vector<std::vector<size_t>>* neighborPtr = &neighbors;
-  std::vector<std::vector<double>>* distancePtr = &distances;
-
-  if (tree::TreeTraits<Tree>::RearrangesDataset && treeOwner)
-  {
-    // We will always need to rearrange in this case.
-    distancePtr = new std::vector<std::vector<double>>;
-    neighborPtr = new std::vector<std::vector<size_t>>;
-  }
-
-  // Resize each vector.
-  neighborPtr->clear(); // Just in case there was anything in it.
-  neighborPtr->resize(referenceSet->n_cols);
-  distancePtr->clear();
-  distancePtr->resize(referenceSet->n_cols);
-
-  // Create the helper object for the traversal.
-  typedef RangeSearchRules<MetricType, Tree> RuleType;
-  RuleType rules(*referenceSet, *referenceSet, range, *neighborPtr,
-      *distancePtr, metric, true /* don't return the query in the results */);
-
-  if (naive)
-  {
-    // The naive brute-force solution.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      for (size_t j = 0; j < referenceSet->n_cols; ++j)
-        rules.BaseCase(i, j);
-
-    baseCases = (referenceSet->n_cols * referenceSet->n_cols);
-    scores = 0;
-  }
-  else if (singleMode)
+  // Count the results of each query point; each query point has results in one
+  // part at most, so the parts can be counted in parallel.
+  offsets.zeros(numQueries + 1);
+  #pragma omp parallel for schedule(dynamic) num_threads(SearchThreads())
+  for (omp_size_t p = 0; p < (omp_size_t) results.size(); ++p)
   {
-    // Create the traverser.
-    typename Tree::template SingleTreeTraverser<RuleType> traverser(rules);
-
-    // Now have it traverse for each point.
-    for (size_t i = 0; i < referenceSet->n_cols; ++i)
-      traverser.Traverse(i, *referenceTree);
-
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
+    const RangeSearchResults& part = results[p];
+    for (size_t i = 0; i < part.queries.size(); ++i)
+    {
+      const size_t query = oldFromNewQueries ?
+          (*oldFromNewQueries)[part.queries[i]] : part.queries[i];
+      ++offsets[query + 1];
+    }
   }
-  else // Dual-tree recursion.
-  {
-    // Create the traverser.
-    typename Tree::template DualTreeTraverser<RuleType> traverser(rules);
 
-    traverser.Traverse(*referenceTree, *referenceTree);
+  for (size_t i = 1; i <= numQueries; ++i)
+    offsets[i] += offsets[i - 1];
 
-    baseCases = rules.BaseCases();
-    scores = rules.Scores();
-  }
-
-  Timer::Stop("range_search/computing_neighbors");
+  neighbors.set_size(offsets[numQueries]);
+  distances.set_size(offsets[numQueries]);
 
-  // Do we need to map the reference indices?
-  if (treeOwner && tree::TreeTraits<Tree>::RearrangesDataset)
+  // Now scatter the results of each part into the rows of its query points.
+  arma::Col<size_t> next(offsets.memptr(), numQueries);
+  #pragma omp parallel for schedule(dynamic) num_threads(SearchThreads())
+  for (omp_size_t p = 0; p < (omp_size_t) results.size(); ++p)
   {
-    neighbors.clear();
-    neighbors.resize(referenceSet->n_cols);
-    distances.clear();
-    distances.resize(referenceSet->n_cols);
-
-    for (size_t i = 0; i < distances.size(); ++i)
+    RangeSearchResults& part = results[p];
+    for (size_t i = 0; i < part.queries.size(); ++i)
     {
-      // Map distances (copy a column).
-      const size_t refMapping = oldFromNewReferences[i];
-      distances[refMapping] = (*distancePtr)[i];
-
-      // Copy each neighbor individually, because we need to map it.
-      neighbors[refMapping].resize(distances[refMapping].size());
-      for (size_t j = 0; j < distances[refMapping].size(); ++j)
-      {
-        neighbors[refMapping][j] = oldFromNewReferences[(*neighborPtr)[i][j]];
-      }
+      const size_t query = oldFromNewQueries ?
+          (*oldFromNewQueries)[part.queries[i]] : part.queries[i];
+      const size_t index = next[query]++;
+      neighbors[index] = oldFromNewReferences ?
+          (*oldFromNewReferences)[part.neighbors[i]] : part.neighbors[i];
+      distances[index] = part.distances[i];
     }
 
-    // Finished with temporary objects.
-    delete neighborPtr;
-    delete distancePtr;
+    // Release the memory of the part as soon as possible.
+    part = RangeSearchResults();
   }
 }
 
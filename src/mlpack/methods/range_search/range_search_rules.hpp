@@ -13,10 +13,28 @@
 #define MLPACK_METHODS_RANGE_SEARCH_RANGE_SEARCH_RULES_HPP
 
 #include <mlpack/core/tree/traversal_info.hpp>
+#include <mlpack/core/tree/leaf_distances.hpp>
 
 namespace mlpack {
 namespace range {
 
+/**
+ * The results found by one RangeSearchRules object: one (query, neighbor,
+ * distance) triple for each reference point found in range of a query point,
+ * in the order they were found.  Storing them in flat arrays instead of one
+ * vector for each query point avoids a heap allocation for each query point,
+ * and lets each thread of a search collect its results on its own.
+ */
+struct RangeSearchResults
+{
+  //! The index of the query point of each result.
+  std::vector<size_t> queries;
+  //! The index of the reference point of each result.
+  std::vector<size_t> neighbors;
+  //! The distance between the points of each result.
+  std::vector<double> distances;
+};
+
 /**
  * The RangeSearchRules class is a template helper class used by RangeSearch
  * class when performing range searches.
@@ -35,8 +53,7 @@ class RangeSearchRules
    * @param referenceSet Set of reference data.
    * @param querySet Set of query data.
    * @param range Range to search for.
-   * @param neighbors Vector to store resulting neighbors in.
-   * @param distances Vector to store resulting distances in.
+   * @param results Object to append the results to.
    * @param metric Instantiated metric.
    * @param sameSet If true, the query and reference set are taken to be the
    *      same, and a query point will not return itself in the results.
@@ -44,8 +61,7 @@ class RangeSearchRules
   RangeSearchRules(const arma::mat& referenceSet,
                    const arma::mat& querySet,
                    const math::Range& range,
-                   std::vector<std::vector<size_t> >& neighbors,
-                   std::vector<std::vector<double> >& distances,
+                   RangeSearchResults& results,
                    MetricType& metric,
                    const bool sameSet = false);
 
@@ -57,6 +73,21 @@ class RangeSearchRules
    */
   double BaseCase(const size_t queryIndex, const size_t referenceIndex);
 
+  /**
+   * Compute the base cases between the given query point and every point of
+   * the given reference leaf, with the same results as calling BaseCase() for
+   * each of them.  For the Euclidean distance, the distances between the two
+   * leaves are estimated all at once (see tree::LeafDistances), and only the
+   * points that might be in range are evaluated exactly.
+   *
+   * @param queryLeaf Leaf holding the query point.
+   * @param queryIndex Index of query point.
+   * @param referenceLeaf Reference leaf.
+   */
+  void LeafBaseCases(TreeType& queryLeaf,
+                     const size_t queryIndex,
+                     TreeType& referenceLeaf);
+
   /**
    * Get the score for recursion order.  A low score indicates priority for
    * recursion, while DBL_MAX indicates that the node should not be recursed
@@ -127,11 +158,8 @@ class RangeSearchRules
   //! The range of distances for which we are searching.
   const math::Range& range;
 
-  //! The vector the resultant neighbor indices should be stored in.
-  std::vector<std::vector<size_t> >& neighbors;
-
-  //! The vector the resultant neighbor distances should be stored in.
-  std::vector<std::vector<double> >& distances;
+  //! The object the results should be appended to.
+  RangeSearchResults& results;
 
   //! The instantiated metric.
   MetricType& metric;
@@ -150,12 +178,20 @@ class RangeSearchRules
   void AddResult(const size_t queryIndex,
                  TreeType& referenceNode);
 
+  //! Add the given reference point to the results for the given query point.
+  void AddResult(const size_t queryIndex,
+                 const size_t referenceIndex,
+                 const double distance);
+
   TraversalInfoType traversalInfo;
 
   //! The number of base cases.
   size_t baseCases;
   //! THe number of scores.
   size_t scores;
+
+  //! The distances between the points of the last pair of leaves.
+  tree::LeafDistances<arma::mat> leafDistances;
 };
 
 } // namespace range
@@ -23,21 +23,20 @@ RangeSearchRules<MetricType, TreeType>::RangeSearchRules(
     const arma::mat& referenceSet,
     const arma::mat& querySet,
     const math::Range& range,
-    std::vector<std::vector<size_t> >& neighbors,
-    std::vector<std::vector<double> >& distances,
+    RangeSearchResults& results,
     MetricType& metric,
     const bool sameSet) :
     referenceSet(referenceSet),
     querySet(querySet),
     range(range),
-    neighbors(neighbors),
-    distances(distances),
+    results(results),
     metric(metric),
     sameSet(sameSet),
     lastQueryIndex(querySet.n_cols),
     lastReferenceIndex(referenceSet.n_cols),
     baseCases(0),
-    scores(0)
+    scores(0),
+    leafDistances(querySet, referenceSet)
 {
   // Nothing to do.
 }
@@ -67,12 +66,43 @@ double RangeSearchRules<MetricType, TreeType>::BaseCase(
   lastReferenceIndex = referenceIndex;
 
   if (range.Contains(distance))
+    AddResult(queryIndex, referenceIndex, distance);
+
+  return distance;
+}
+
+template<typename MetricType, typename TreeType>
+void RangeSearchRules<MetricType, TreeType>::LeafBaseCases(
+    TreeType& queryLeaf,
+    const size_t queryIndex,
+    TreeType& referenceLeaf)
+{
+  const size_t referenceEnd = referenceLeaf.Begin() + referenceLeaf.Count();
+  if (!tree::LeafDistanceTraits<MetricType>::Supported ||
+      !leafDistances.Compute(queryLeaf, referenceLeaf))
   {
-    neighbors[queryIndex].push_back(referenceIndex);
-    distances[queryIndex].push_back(distance);
+    for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+      BaseCase(queryIndex, r);
+    return;
   }
 
-  return distance;
+  for (size_t r = referenceLeaf.Begin(); r < referenceEnd; ++r)
+  {
+    if ((sameSet && (queryIndex == r)) ||
+        ((lastQueryIndex == queryIndex) && (lastReferenceIndex == r)))
+      continue;
+
+    // Points that are certainly out of range need no exact distance.
+    double lo, hi;
+    leafDistances.template Bounds<MetricType>(queryIndex, r, lo, hi);
+    if (hi < range.Lo() || lo > range.Hi())
+    {
+      ++baseCases;
+      continue;
+    }
+
+    BaseCase(queryIndex, r);
+  }
 }
 
 //! Single-tree scoring function.
@@ -236,14 +266,19 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     baseCaseMod = 1;
   }
 
-  // Resize distances and neighbors vectors appropriately.  We have to use
-  // reserve() and not resize(), because we don't know if we will encounter the
-  // case where the datasets and points are the same (and we skip in that case).
-  const size_t oldSize = neighbors[queryIndex].size();
-  neighbors[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
-  distances[queryIndex].reserve(oldSize + referenceNode.NumDescendants() -
-      baseCaseMod);
+  // Resize the result vectors appropriately.  We have to use reserve() and not
+  // resize(), because we don't know if we will encounter the case where the
+  // datasets and points are the same (and we skip in that case).  The size is
+  // at least doubled, so that the growth stays amortized.
+  const size_t newSize = results.queries.size() +
+      referenceNode.NumDescendants() - baseCaseMod;
+  if (newSize > results.queries.capacity())
+  {
+    const size_t capacity = std::max(newSize, 2 * results.queries.capacity());
+    results.queries.reserve(capacity);
+    results.neighbors.reserve(capacity);
+    results.distances.reserve(capacity);
+  }
 
   for (size_t i = baseCaseMod; i < referenceNode.NumDescendants(); ++i)
   {
@@ -254,11 +289,23 @@ void RangeSearchRules<MetricType, TreeType>::AddResult(const size_t queryIndex,
     const double distance = metric.Evaluate(querySet.unsafe_col(queryIndex),
         referenceNode.Dataset().unsafe_col(referenceNode.Descendant(i)));
 
-    neighbors[queryIndex].push_back(referenceNode.Descendant(i));
-    distances[queryIndex].push_back(distance);
+    AddResult(queryIndex, referenceNode.Descendant(i), distance);
   }
 }
 
+//! Add the given reference point to the results for the given query point.
+template<typename MetricType, typename TreeType>
+inline force_inline
+void RangeSearchRules<MetricType, TreeType>::AddResult(
+    const size_t queryIndex,
+    const size_t referenceIndex,
+    const double distance)
+{
+  results.queries.push_back(queryIndex);
+  results.neighbors.push_back(referenceIndex);
+  results.distances.push_back(distance);
+}
+
 } // namespace range
 } // namespace mlpack
 
@@ -136,6 +136,15 @@ or upgrade Boost to 1.59 or newer.
   #define omp_size_t size_t
 #endif
 
+// The OpenMP functions are available whenever the compiler has OpenMP enabled
+// (for instance through SHLIB_OPENMP_CXXFLAGS).  Code that calls them checks
+// _OPENMP; HAS_OPENMP is still only defined on request, so the methods that
+// check it keep their serial behavior by default.
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+#include <mlpack/core/util/scoped_threads.hpp>
+
 // We need to be able to mark functions deprecated.
 #include <mlpack/core/util/deprecated.hpp>
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/naive_bayes/nbc_main.cpp>
 
 // [[Rcpp::export]]
-void nbc_mlpackMain()
+void nbc_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,33 @@ void nbc_mlpackMain()
 
 // Get the pointer to a NBCModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamNBCModelPtr(const std::string& paramName)
+SEXP IO_GetParamNBCModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<NBCModel>) IO::GetParam<NBCModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<NBCModel>(params, paramName);
 }
 
 // Set the pointer to a NBCModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamNBCModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamNBCModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<NBCModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<NBCModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<NBCModel>(params, paramName, ptr);
 }
 
 // Serialize a NBCModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeNBCModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("NBCModel",
-          *Rcpp::as<Rcpp::XPtr<NBCModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "NBCModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<NBCModel>>(ptr), "NBCModel");
 }
 
 // Deserialize a NBCModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeNBCModelPtr(Rcpp::RawVector str)
 {
-  NBCModel* ptr = new NBCModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("NBCModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<NBCModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<NBCModel>(str, "NBCModel");
 }
 
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/nca/nca_main.cpp>
 
 // [[Rcpp::export]]
-void nca_mlpackMain()
+void nca_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/nmf/nmf_main.cpp>
 
 // [[Rcpp::export]]
-void nmf_mlpackMain()
+void nmf_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/pca/pca_main.cpp>
 
 // [[Rcpp::export]]
-void pca_mlpackMain()
+void pca_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
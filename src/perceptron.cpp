@@ -9,8 +9,10 @@
 #include <mlpack/methods/perceptron/perceptron_main.cpp>
 
 // [[Rcpp::export]]
-void perceptron_mlpackMain()
+void perceptron_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void perceptron_mlpackMain()
 
 // Get the pointer to a PerceptronModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamPerceptronModelPtr(const std::string& paramName)
+SEXP IO_GetParamPerceptronModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<PerceptronModel>) IO::GetParam<PerceptronModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<PerceptronModel>(params, paramName);
 }
 
 // Set the pointer to a PerceptronModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamPerceptronModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamPerceptronModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<PerceptronModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<PerceptronModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<PerceptronModel>(params, paramName, ptr);
 }
 
 // Serialize a PerceptronModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializePerceptronModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("PerceptronModel",
-          *Rcpp::as<Rcpp::XPtr<PerceptronModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "PerceptronModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<PerceptronModel>>(ptr), "PerceptronModel");
 }
 
 // Deserialize a PerceptronModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializePerceptronModelPtr(Rcpp::RawVector str)
 {
-  PerceptronModel* ptr = new PerceptronModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("PerceptronModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<PerceptronModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<PerceptronModel>(str,
+      "PerceptronModel");
 }
 
 
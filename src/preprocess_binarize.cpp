@@ -9,8 +9,10 @@
 #include <mlpack/methods/preprocess/preprocess_binarize_main.cpp>
 
 // [[Rcpp::export]]
-void preprocess_binarize_mlpackMain()
+void preprocess_binarize_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
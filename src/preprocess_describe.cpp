@@ -9,8 +9,10 @@
 #include <mlpack/methods/preprocess/preprocess_describe_main.cpp>
 
 // [[Rcpp::export]]
-void preprocess_describe_mlpackMain()
+void preprocess_describe_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/preprocess/preprocess_scale_main.cpp>
 
 // [[Rcpp::export]]
-void preprocess_scale_mlpackMain()
+void preprocess_scale_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void preprocess_scale_mlpackMain()
 
 // Get the pointer to a ScalingModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamScalingModelPtr(const std::string& paramName)
+SEXP IO_GetParamScalingModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<ScalingModel>) IO::GetParam<ScalingModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<ScalingModel>(params, paramName);
 }
 
 // Set the pointer to a ScalingModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamScalingModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamScalingModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<ScalingModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<ScalingModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<ScalingModel>(params, paramName, ptr);
 }
 
 // Serialize a ScalingModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeScalingModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("ScalingModel",
-          *Rcpp::as<Rcpp::XPtr<ScalingModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "ScalingModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<ScalingModel>>(ptr), "ScalingModel");
 }
 
 // Deserialize a ScalingModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeScalingModelPtr(Rcpp::RawVector str)
 {
-  ScalingModel* ptr = new ScalingModel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("ScalingModel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<ScalingModel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<ScalingModel>(str,
+      "ScalingModel");
 }
 
 
@@ -12,249 +12,335 @@
 #include <rcpp_mlpack.h>
 #include <mlpack/prereqs.hpp>
 #include <mlpack/core/util/io.hpp>
+#include <mlpack/core/data/binary_dataset.hpp>
+#include <mlpack/core/data/load_csv.hpp>
+#include <mlpack/bindings/R/r_matrix.hpp>
+#include <mlpack/bindings/R/r_params.hpp>
 
 using namespace mlpack;
+using namespace mlpack::bindings::r;
 using namespace Rcpp;
 
-template<typename eT>
-bool inline inplace_transpose(arma::Mat<eT>& X)
+// Whether any matrix given to this call held one observation per column; if
+// so, matrix outputs are handed back in that layout too.
+static bool ColMajorCall(util::Params& p)
 {
-  try
-  {
-    X = arma::trans(X);
-    return false;
-  }
-  catch (std::bad_alloc&)
+  std::map<std::string, util::ParamData>::const_iterator it =
+      p.Parameters().begin();
+  for (; it != p.Parameters().end(); ++it)
   {
-    return true;
+    if (it->second.input && it->second.wasPassed && it->second.colMajor)
+      return true;
   }
+
+  return false;
 }
 
-// Call IO::RestoreSettings() for a given program name.
+// Create a new, independent set of parameters for one call to the given
+// program.  R frees it once the returned pointer is garbage collected.
 // [[Rcpp::export]]
-void IO_RestoreSettings(const std::string& programName)
+SEXP IO_MakeParams(const std::string& programName)
 {
- IO::RestoreSettings(programName);
+  return Rcpp::XPtr<util::Params>(new util::Params(
+      IO::MakeParams(programName)));
 }
 
-// Call IO::SetParam<int>().
+// Call Params::Get<int>().
 // [[Rcpp::export]]
-void IO_SetParamInt(const std::string& paramName, int paramValue)
+void IO_SetParamInt(SEXP params, const std::string& paramName, int paramValue)
 {
-  IO::GetParam<int>(paramName) = paramValue;
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<int>(paramName) = paramValue;
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<double>().
+// Call Params::Get<double>().
 // [[Rcpp::export]]
-void IO_SetParamDouble(const std::string& paramName, double paramValue)
+void IO_SetParamDouble(SEXP params,
+                       const std::string& paramName, double paramValue)
 {
-  IO::GetParam<double>(paramName) = paramValue;
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<double>(paramName) = paramValue;
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<std::string>().
+// Call Params::Get<std::string>().
 // [[Rcpp::export]]
-void IO_SetParamString(const std::string& paramName, std::string& paramValue)
+void IO_SetParamString(SEXP params,
+                       const std::string& paramName, std::string& paramValue)
 {
-  IO::GetParam<std::string>(paramName) = paramValue;
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<std::string>(paramName) = paramValue;
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<bool>().
+// Call Params::Get<bool>().
 // [[Rcpp::export]]
-void IO_SetParamBool(const std::string& paramName, bool paramValue)
+void IO_SetParamBool(SEXP params, const std::string& paramName, bool paramValue)
 {
-  IO::GetParam<bool>(paramName) = paramValue;
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<bool>(paramName) = paramValue;
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<std::vector<std::string>>().
+// Call Params::Get<std::vector<std::string>>().
 // [[Rcpp::export]]
-void IO_SetParamVecString(const std::string& paramName,
-                           const std::vector<std::string>& str)
+void IO_SetParamVecString(SEXP params, const std::string& paramName,
+                          const std::vector<std::string>& str)
 {
-  IO::GetParam<std::vector<std::string>>(paramName) = std::move(str);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<std::vector<std::string>>(paramName) = std::move(str);
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<std::vector<int>>().
+// Call Params::Get<std::vector<int>>().
 // [[Rcpp::export]]
-void IO_SetParamVecInt(const std::string& paramName,
-                        const std::vector<int>& ints)
+void IO_SetParamVecInt(SEXP params, const std::string& paramName,
+                       const std::vector<int>& ints)
 {
-  IO::GetParam<std::vector<int>>(paramName) = std::move(ints);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<std::vector<int>>(paramName) = std::move(ints);
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::mat>().
+// Call Params::Get<arma::mat>().  A matrix marked with col_major() already
+// holds one observation per column, so it is not transposed.  mlpack may write
+// into its matrix parameters (trees reorder their dataset, for instance), and
+// the bindings do not say which ones they only read, so the memory of the R
+// matrix is only used in place when no other R object refers to it.  That is
+// rare: the argument of the R wrapper and Rcpp's protection of paramValue
+// both count as references, so in practice a marked matrix is copied once.
+// Only the transpose is saved.
 // [[Rcpp::export]]
-void IO_SetParamMat(const std::string& paramName,
-                     const arma::mat& paramValue)
+void IO_SetParamMat(SEXP params, const std::string& paramName,
+                    const NumericMatrix& paramValue)
 {
-  IO::GetParam<arma::mat>(paramName) = std::move(paramValue.t());
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  arma::mat m(REAL(paramValue), paramValue.nrow(), paramValue.ncol(), false,
+      false);
+  if (!paramValue.hasAttribute("col_major"))
+  {
+    p.Get<arma::mat>(paramName) = m.t();
+  }
+  else if (MAYBE_SHARED(paramValue))
+  {
+    p.Parameters()[paramName].colMajor = true;
+    p.Get<arma::mat>(paramName) = m;
+  }
+  else
+  {
+    // Keep the R matrix alive for as long as the parameters (and any model
+    // made from them) may use its memory.
+    KeepAlive(params, paramValue);
+    p.Parameters()[paramName].colMajor = true;
+
+    p.Get<arma::mat>(paramName) = std::move(m);
+  }
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::Mat<size_t>>().
+// Call Params::Get<arma::Mat<size_t>>().  The matrix may hold integers or
+// doubles; either is converted once, straight into the parameter.
 // [[Rcpp::export]]
-void IO_SetParamUMat(const std::string& paramName,
-                      const arma::Mat<size_t>& paramValue)
+void IO_SetParamUMat(SEXP params, const std::string& paramName,
+                     SEXP paramValue)
 {
-  IO::GetParam<arma::Mat<size_t>>(paramName) = std::move(paramValue.t());
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  const bool colMajor = Rf_getAttrib(paramValue,
+      Rf_install("col_major")) != R_NilValue;
+  const size_t rows = Rf_nrows(paramValue);
+  const size_t cols = Rf_ncols(paramValue);
+
+  arma::Mat<size_t>& m = p.Get<arma::Mat<size_t>>(paramName);
+  if (colMajor)
+  {
+    p.Parameters()[paramName].colMajor = true;
+    m.set_size(rows, cols);
+  }
+  else
+  {
+    m.set_size(cols, rows);
+  }
+  ToArmaIndices(paramValue, !colMajor, m.memptr());
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::rowvec>().
+// Call Params::Get<arma::rowvec>().
 // [[Rcpp::export]]
-void IO_SetParamRow(const std::string& paramName,
-                     const arma::rowvec& paramValue)
+void IO_SetParamRow(SEXP params, const std::string& paramName,
+                    const arma::rowvec& paramValue)
 {
-  IO::GetParam<arma::rowvec>(paramName) = std::move(paramValue);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<arma::rowvec>(paramName) = std::move(paramValue);
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::Row<size_t>>().
+// Call Params::Get<arma::Row<size_t>>().  The labels may be integers or
+// doubles.
 // [[Rcpp::export]]
-void IO_SetParamURow(const std::string& paramName,
-                      const arma::Row<size_t>& paramValue)
+void IO_SetParamURow(SEXP params, const std::string& paramName,
+                     SEXP paramValue)
 {
-  IO::GetParam<arma::Row<size_t>>(paramName) = std::move(paramValue);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  arma::Row<size_t>& r = p.Get<arma::Row<size_t>>(paramName);
+  r.set_size(Rf_xlength(paramValue));
+  ToArmaIndices(paramValue, false, r.memptr());
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::vec>().
+// Call Params::Get<arma::vec>().
 // [[Rcpp::export]]
-void IO_SetParamCol(const std::string& paramName,
-                     const arma::vec& paramValue)
+void IO_SetParamCol(SEXP params, const std::string& paramName,
+                    const arma::vec& paramValue)
 {
-  IO::GetParam<arma::vec>(paramName) = std::move(paramValue);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.Get<arma::vec>(paramName) = std::move(paramValue);
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<arma::Col<size_t>>().
+// Call Params::Get<arma::Col<size_t>>().  The values may be integers or
+// doubles.
 // [[Rcpp::export]]
-void IO_SetParamUCol(const std::string& paramName,
-                      const arma::Col<size_t>& paramValue)
+void IO_SetParamUCol(SEXP params, const std::string& paramName,
+                     SEXP paramValue)
 {
-  IO::GetParam<arma::Col<size_t>>(paramName) = std::move(paramValue);
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  arma::Col<size_t>& c = p.Get<arma::Col<size_t>>(paramName);
+  c.set_size(Rf_xlength(paramValue));
+  ToArmaIndices(paramValue, false, c.memptr());
+  p.SetPassed(paramName);
 }
 
-// Call IO::SetParam<std::tuple<data::DatasetInfo, arma::mat>>().
+// Call Params::Get<std::tuple<data::DatasetInfo, arma::mat>>().
 // [[Rcpp::export]]
-void IO_SetParamMatWithInfo(const std::string& paramName,
-                             const LogicalVector& dimensions,
-                             const arma::mat& paramValue)
+void IO_SetParamMatWithInfo(SEXP params, const std::string& paramName,
+                            const LogicalVector& dimensions,
+                            const arma::mat& paramValue)
 {
+  util::Params& p = GetParams(params);
   data::DatasetInfo d(paramValue.n_cols);
   for (size_t i = 0; i < d.Dimensionality(); ++i)
   {
     d.Type(i) = (dimensions[i]) ? data::Datatype::categorical :
         data::Datatype::numeric;
   }
-  std::get<0>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
+  std::get<0>(p.Get<std::tuple<data::DatasetInfo, arma::mat>>(
       paramName)) = std::move(d);
-  std::get<1>(IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(
+  std::get<1>(p.Get<std::tuple<data::DatasetInfo, arma::mat>>(
       paramName)) = std::move(paramValue.t());
-  IO::SetPassed(paramName);
+  p.SetPassed(paramName);
 }
 
-// Call IO::GetParam<int>().
+// Call Params::Get<int>().
 // [[Rcpp::export]]
-int IO_GetParamInt(const std::string& paramName)
+int IO_GetParamInt(SEXP params, const std::string& paramName)
 {
-  return IO::GetParam<int>(paramName);
+  util::Params& p = GetParams(params);
+  return p.Get<int>(paramName);
 }
 
-// Call IO::GetParam<double>().
+// Call Params::Get<double>().
 // [[Rcpp::export]]
-double IO_GetParamDouble(const std::string& paramName)
+double IO_GetParamDouble(SEXP params, const std::string& paramName)
 {
-  return IO::GetParam<double>(paramName);
+  util::Params& p = GetParams(params);
+  return p.Get<double>(paramName);
 }
 
-// Call IO::GetParam<std::string>().
+// Call Params::Get<std::string>().
 // [[Rcpp::export]]
-std::string& IO_GetParamString(const std::string& paramName)
+std::string& IO_GetParamString(SEXP params, const std::string& paramName)
 {
-  return IO::GetParam<std::string>(paramName);
+  util::Params& p = GetParams(params);
+  return p.Get<std::string>(paramName);
 }
 
-// Call IO::GetParam<bool>().
+// Call Params::Get<bool>().
 // [[Rcpp::export]]
-bool IO_GetParamBool(const std::string& paramName)
+bool IO_GetParamBool(SEXP params, const std::string& paramName)
 {
-  return IO::GetParam<bool>(paramName);
+  util::Params& p = GetParams(params);
+  return p.Get<bool>(paramName);
 }
 
-// Call IO::GetParam<std::vector<std::string>>().
+// Call Params::Get<std::vector<std::string>>().
 // [[Rcpp::export]]
-const std::vector<std::string>& IO_GetParamVecString(const
-                                    std::string& paramName)
+const std::vector<std::string>& IO_GetParamVecString(SEXP params,
+    const std::string& paramName)
 {
-  return std::move(IO::GetParam<std::vector<std::string>>(paramName));
+  util::Params& p = GetParams(params);
+  return std::move(p.Get<std::vector<std::string>>(paramName));
 }
 
-// Call IO::GetParam<std::vector<int>>().
+// Call Params::Get<std::vector<int>>().
 // [[Rcpp::export]]
-const std::vector<int>& IO_GetParamVecInt(const std::string& paramName)
+const std::vector<int>& IO_GetParamVecInt(SEXP params,
+                                          const std::string& paramName)
 {
-  return std::move(IO::GetParam<std::vector<int>>(paramName));
+  util::Params& p = GetParams(params);
+  return std::move(p.Get<std::vector<int>>(paramName));
 }
 
-// Call IO::GetParam<arma::mat>().
+// Call Params::Get<arma::mat>().
 // [[Rcpp::export]]
-const arma::mat& IO_GetParamMat(const std::string& paramName)
+NumericMatrix IO_GetParamMat(SEXP params, const std::string& paramName)
 {
-  inplace_transpose(IO::GetParam<arma::mat>(paramName));
-  return std::move(IO::GetParam<arma::mat>(paramName));
+  util::Params& p = GetParams(params);
+  return ToRMatrix(p.Get<arma::mat>(paramName), ColMajorCall(p));
 }
 
-// Call IO::GetParam<arma::Mat<size_t>>().
+// Call Params::Get<arma::Mat<size_t>>().  The result holds integers, unless
+// options(RcppMLPACK.integer_output = FALSE) is set.
 // [[Rcpp::export]]
-const arma::Mat<size_t>& IO_GetParamUMat(const std::string& paramName)
+SEXP IO_GetParamUMat(SEXP params, const std::string& paramName)
 {
-  inplace_transpose(IO::GetParam<arma::Mat<size_t>>(paramName));
-  return std::move(IO::GetParam<arma::Mat<size_t>>(paramName));
+  util::Params& p = GetParams(params);
+  return ToRIndices(p.Get<arma::Mat<size_t>>(paramName), ColMajorCall(p));
 }
 
-// Call IO::GetParam<arma::rowvec>().
+// Call Params::Get<arma::rowvec>().
 // [[Rcpp::export]]
-const arma::vec IO_GetParamRow(const std::string& paramName)
+const arma::vec IO_GetParamRow(SEXP params, const std::string& paramName)
 {
-  return std::move(IO::GetParam<arma::rowvec>(paramName).t());
+  util::Params& p = GetParams(params);
+  return std::move(p.Get<arma::rowvec>(paramName).t());
 }
 
-// Call IO::GetParam<arma::Row<size_t>>().
+// Call Params::Get<arma::Row<size_t>>().  The result is a column, holding
+// integers unless options(RcppMLPACK.integer_output = FALSE) is set.
 // [[Rcpp::export]]
-const arma::Col<size_t> IO_GetParamURow(const std::string& paramName)
+SEXP IO_GetParamURow(SEXP params, const std::string& paramName)
 {
-  return std::move(IO::GetParam<arma::Row<size_t>>(paramName).t());
+  util::Params& p = GetParams(params);
+  return ToRIndices(p.Get<arma::Row<size_t>>(paramName), false);
 }
 
-// Call IO::GetParam<arma::vec>().
+// Call Params::Get<arma::vec>().
 // [[Rcpp::export]]
-const arma::rowvec IO_GetParamCol(const std::string& paramName)
+const arma::rowvec IO_GetParamCol(SEXP params, const std::string& paramName)
 {
-  return std::move(IO::GetParam<arma::vec>(paramName).t());
+  util::Params& p = GetParams(params);
+  return std::move(p.Get<arma::vec>(paramName).t());
 }
 
-// Call IO::GetParam<arma::Col<size_t>>().
+// Call Params::Get<arma::Col<size_t>>().  The result is a row, holding
+// integers unless options(RcppMLPACK.integer_output = FALSE) is set.
 // [[Rcpp::export]]
-const arma::Row<size_t> IO_GetParamUCol(const std::string& paramName)
+SEXP IO_GetParamUCol(SEXP params, const std::string& paramName)
 {
-  return std::move(IO::GetParam<arma::Col<size_t>>(paramName).t());
+  util::Params& p = GetParams(params);
+  return ToRIndices(p.Get<arma::Col<size_t>>(paramName), false);
 }
 
-// Call IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>().
+// Call Params::Get<std::tuple<data::DatasetInfo, arma::mat>>().
 // [[Rcpp::export]]
-List IO_GetParamMatWithInfo(const std::string& paramName)
+List IO_GetParamMatWithInfo(SEXP params, const std::string& paramName)
 {
+  util::Params& p = GetParams(params);
   const data::DatasetInfo& d = std::get<0>(
-      IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(paramName));
+      p.Get<std::tuple<data::DatasetInfo, arma::mat>>(paramName));
   const arma::mat& m = std::get<1>(
-      IO::GetParam<std::tuple<data::DatasetInfo, arma::mat>>(paramName)).t();
+      p.Get<std::tuple<data::DatasetInfo, arma::mat>>(paramName)).t();
 
   LogicalVector dims(d.Dimensionality());
   for (size_t i = 0; i < d.Dimensionality(); ++i)
@@ -285,16 +371,115 @@ void IO_ResetTimers()
   IO::GetSingleton().timer.Reset();
 }
 
-// Set an argument as passed to the IO object.
+// Enable timing.
+// [[Rcpp::export]]
+void IO_EnableTiming()
+{
+  Timer::EnableTiming();
+}
+
+// Disable timing.
+// [[Rcpp::export]]
+void IO_DisableTiming()
+{
+  Timer::DisableTiming();
+}
+
+// Get the value of all timers, in seconds, summed over all threads.
+// [[Rcpp::export]]
+Rcpp::NumericVector IO_GetTimers()
+{
+  const std::map<std::string, std::chrono::microseconds> timers =
+      IO::GetSingleton().timer.GetAllTimers();
+
+  Rcpp::NumericVector values(timers.size());
+  Rcpp::CharacterVector names(timers.size());
+  size_t i = 0;
+  for (const auto& timer : timers)
+  {
+    names[i] = timer.first;
+    values[i] = timer.second.count() / 1e6;
+    ++i;
+  }
+
+  values.names() = names;
+  return values;
+}
+
+// Write a matrix to a binary dataset file, with one point per column.
+// [[Rcpp::export]]
+void IO_SaveDataset(const Rcpp::NumericMatrix& x, const std::string& filename)
+{
+  data::SaveBinaryDataset(filename, ToArmaMatrix(x));
+}
+
+// Read a binary dataset file.  Files of doubles are copied straight from a
+// mapping of the file.
+// [[Rcpp::export]]
+Rcpp::NumericMatrix IO_LoadDataset(const std::string& filename,
+                                   const bool colMajor)
+{
+  try
+  {
+    data::MappedMatrix<double> mapped(filename);
+    return ToRMatrix(mapped.Matrix(), colMajor);
+  }
+  catch (data::BinaryDatasetTypeError&)
+  {
+    // The elements are of another type; this converts them.
+    arma::mat matrix;
+    data::LoadBinaryDataset(filename, matrix);
+    return ToRMatrix(matrix, colMajor);
+  }
+}
+
+// Load a CSV file with data::LoadCSV, at once or, if maxPoints is not 0, with
+// NextChunk() in chunks of at most maxPoints points that are joined again.
+// The points are returned one per row, with which dimensions are categorical
+// and how many chunks were read.  This is only used by the tests.
+// [[Rcpp::export]]
+List IO_LoadCSV(const std::string& filename, int maxPoints)
+{
+  data::LoadCSV loader(filename);
+  data::DatasetInfo info;
+  arma::mat matrix;
+  int chunks = 0;
+  if (maxPoints <= 0)
+  {
+    loader.Load(matrix, info, true);
+  }
+  else
+  {
+    arma::mat chunk;
+    while (loader.NextChunk(chunk, info, (size_t) maxPoints))
+    {
+      matrix.insert_cols(matrix.n_cols, chunk);
+      ++chunks;
+    }
+  }
+
+  LogicalVector dims(info.Dimensionality());
+  for (size_t i = 0; i < info.Dimensionality(); ++i)
+    dims[i] = (info.Type(i) == data::Datatype::categorical);
+
+  return List::create(Rcpp::Named("Info") = std::move(dims),
+                      Rcpp::Named("Data") = ToRMatrix(matrix, false),
+                      Rcpp::Named("Chunks") = chunks);
+}
+
+// Set an argument as passed.
 // [[Rcpp::export]]
-void IO_SetPassed(const std::string& paramName)
+void IO_SetPassed(SEXP params, const std::string& paramName)
 {
-  IO::SetPassed(paramName);
+  util::Params& p = GetParams(params);
+  p.SetPassed(paramName);
 }
 
-// Clear settings.
+// Clear the parameters of a finished call, freeing their memory without
+// waiting for R to collect them.
 // [[Rcpp::export]]
-void IO_ClearSettings()
+void IO_ClearSettings(SEXP params)
 {
-  IO::ClearSettings();
+  GetParams(params) = util::Params();
+  R_SetExternalPtrProtected(params, R_NilValue);
 }
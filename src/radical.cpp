@@ -9,8 +9,10 @@
 #include <mlpack/methods/radical/radical_main.cpp>
 
 // [[Rcpp::export]]
-void radical_mlpackMain()
+void radical_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
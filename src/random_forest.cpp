@@ -7,10 +7,14 @@
 #include <rcpp_mlpack.h>
 #define BINDING_TYPE BINDING_TYPE_R
 #include <mlpack/methods/random_forest/random_forest_main.cpp>
+#include <mlpack/methods/decision_tree/flat_decision_tree.hpp>
+#include <mlpack/bindings/R/r_search.hpp>
 
 // [[Rcpp::export]]
-void random_forest_mlpackMain()
+void random_forest_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +23,62 @@ void random_forest_mlpackMain()
 
 // Get the pointer to a RandomForestModel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamRandomForestModelPtr(const std::string& paramName)
+SEXP IO_GetParamRandomForestModelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<RandomForestModel>) IO::GetParam<RandomForestModel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<RandomForestModel>(params, paramName);
 }
 
 // Set the pointer to a RandomForestModel parameter.
 // [[Rcpp::export]]
-void IO_SetParamRandomForestModelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamRandomForestModelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<RandomForestModel*>(paramName) =  Rcpp::as<Rcpp::XPtr<RandomForestModel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<RandomForestModel>(params, paramName, ptr);
 }
 
 // Serialize a RandomForestModel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeRandomForestModelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("RandomForestModel",
-          *Rcpp::as<Rcpp::XPtr<RandomForestModel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "RandomForestModel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<RandomForestModel>>(ptr), "RandomForestModel");
 }
 
 // Deserialize a RandomForestModel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeRandomForestModelPtr(Rcpp::RawVector str)
 {
-  RandomForestModel* ptr = new RandomForestModel();
+  // R will be responsible for freeing this.
+  return mlpack::bindings::r::DeserializeModel<RandomForestModel>(str,
+      "RandomForestModel");
+}
 
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("RandomForestModel", *ptr);
-  }
+// Save a RandomForestModel pointer as a flat model file.
+// [[Rcpp::export]]
+void SaveFlatRandomForestModelPtr(SEXP ptr, const std::string& filename)
+{
+  const RandomForest<>& rf = Rcpp::as<Rcpp::XPtr<RandomForestModel>>(ptr)->rf;
 
-  // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<RandomForestModel>)ptr);
+  std::vector<const RandomForest<>::DecisionTreeType*> trees;
+  for (size_t i = 0; i < rf.NumTrees(); ++i)
+    trees.push_back(&rf.Tree(i));
+  FlatDecisionForest::Save(trees, filename, "RandomForestModel");
 }
 
+// Map a flat model file saved from a RandomForestModel.
+// [[Rcpp::export]]
+SEXP LoadFlatRandomForestModelPtr(const std::string& filename)
+{
+  // R will be responsible for freeing this.
+  return Rcpp::XPtr<FlatDecisionForest>(new FlatDecisionForest(filename,
+      "RandomForestModel"));
+}
 
+// Classify the test points with a mapped flat RandomForestModel.
+// [[Rcpp::export]]
+Rcpp::List ClassifyFlatRandomForestModelPtr(SEXP ptr,
+                                            const Rcpp::NumericMatrix& test)
+{
+  return mlpack::bindings::r::ClassifyModel(
+      *Rcpp::as<Rcpp::XPtr<FlatDecisionForest>>(ptr), test);
+}
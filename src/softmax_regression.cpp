@@ -9,8 +9,10 @@
 #include <mlpack/methods/softmax_regression/softmax_regression_main.cpp>
 
 // [[Rcpp::export]]
-void softmax_regression_mlpackMain()
+void softmax_regression_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void softmax_regression_mlpackMain()
 
 // Get the pointer to a SoftmaxRegression parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamSoftmaxRegressionPtr(const std::string& paramName)
+SEXP IO_GetParamSoftmaxRegressionPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<SoftmaxRegression>) IO::GetParam<SoftmaxRegression*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<SoftmaxRegression>(params, paramName);
 }
 
 // Set the pointer to a SoftmaxRegression parameter.
 // [[Rcpp::export]]
-void IO_SetParamSoftmaxRegressionPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamSoftmaxRegressionPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<SoftmaxRegression*>(paramName) =  Rcpp::as<Rcpp::XPtr<SoftmaxRegression>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<SoftmaxRegression>(params, paramName, ptr);
 }
 
 // Serialize a SoftmaxRegression pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeSoftmaxRegressionPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("SoftmaxRegression",
-          *Rcpp::as<Rcpp::XPtr<SoftmaxRegression>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "SoftmaxRegression";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<SoftmaxRegression>>(ptr), "SoftmaxRegression");
 }
 
 // Deserialize a SoftmaxRegression pointer.
 // [[Rcpp::export]]
 SEXP DeserializeSoftmaxRegressionPtr(Rcpp::RawVector str)
 {
-  SoftmaxRegression* ptr = new SoftmaxRegression();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("SoftmaxRegression", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<SoftmaxRegression>)ptr);
+  return mlpack::bindings::r::DeserializeModel<SoftmaxRegression>(str,
+      "SoftmaxRegression");
 }
 
 
@@ -9,8 +9,10 @@
 #include <mlpack/methods/sparse_coding/sparse_coding_main.cpp>
 
 // [[Rcpp::export]]
-void sparse_coding_mlpackMain()
+void sparse_coding_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void sparse_coding_mlpackMain()
 
 // Get the pointer to a SparseCoding parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamSparseCodingPtr(const std::string& paramName)
+SEXP IO_GetParamSparseCodingPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<SparseCoding>) IO::GetParam<SparseCoding*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<SparseCoding>(params, paramName);
 }
 
 // Set the pointer to a SparseCoding parameter.
 // [[Rcpp::export]]
-void IO_SetParamSparseCodingPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamSparseCodingPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<SparseCoding*>(paramName) =  Rcpp::as<Rcpp::XPtr<SparseCoding>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<SparseCoding>(params, paramName, ptr);
 }
 
 // Serialize a SparseCoding pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeSparseCodingPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("SparseCoding",
-          *Rcpp::as<Rcpp::XPtr<SparseCoding>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "SparseCoding";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<SparseCoding>>(ptr), "SparseCoding");
 }
 
 // Deserialize a SparseCoding pointer.
 // [[Rcpp::export]]
 SEXP DeserializeSparseCodingPtr(Rcpp::RawVector str)
 {
-  SparseCoding* ptr = new SparseCoding();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("SparseCoding", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<SparseCoding>)ptr);
+  return mlpack::bindings::r::DeserializeModel<SparseCoding>(str,
+      "SparseCoding");
 }
 
 
@@ -9,8 +9,10 @@
 #include <mlpack/bindings/R/tests/test_r_binding_main.cpp>
 
 // [[Rcpp::export]]
-void test_r_binding_mlpackMain()
+void test_r_binding_mlpackMain(SEXP params)
 {
+  // Run the binding on the parameters of this call.
+  mlpack::ParamsScope scope(mlpack::bindings::r::GetParams(params));
   mlpackMain();
 }
 
@@ -19,53 +21,34 @@ void test_r_binding_mlpackMain()
 
 // Get the pointer to a GaussianKernel parameter.
 // [[Rcpp::export]]
-SEXP IO_GetParamGaussianKernelPtr(const std::string& paramName)
+SEXP IO_GetParamGaussianKernelPtr(SEXP params, const std::string& paramName)
 {
-  return std::move((Rcpp::XPtr<GaussianKernel>) IO::GetParam<GaussianKernel*>(paramName));
+  return mlpack::bindings::r::GetParamPtr<GaussianKernel>(params, paramName);
 }
 
 // Set the pointer to a GaussianKernel parameter.
 // [[Rcpp::export]]
-void IO_SetParamGaussianKernelPtr(const std::string& paramName, SEXP ptr)
+void IO_SetParamGaussianKernelPtr(SEXP params, const std::string& paramName,
+    SEXP ptr)
 {
-  IO::GetParam<GaussianKernel*>(paramName) =  Rcpp::as<Rcpp::XPtr<GaussianKernel>>(ptr);
-  IO::SetPassed(paramName);
+  mlpack::bindings::r::SetParamPtr<GaussianKernel>(params, paramName, ptr);
 }
 
 // Serialize a GaussianKernel pointer.
 // [[Rcpp::export]]
 Rcpp::RawVector SerializeGaussianKernelPtr(SEXP ptr)
 {
-  std::ostringstream oss;
-  {
-    boost::archive::binary_oarchive oa(oss);
-    oa << boost::serialization::make_nvp("GaussianKernel",
-          *Rcpp::as<Rcpp::XPtr<GaussianKernel>>(ptr));
-  }
-
-  Rcpp::RawVector raw_vec(oss.str().size());
-
-  // Copy the string buffer so we can return one that won't get deallocated when
-  // we exit this function.
-  memcpy(&raw_vec[0], oss.str().c_str(), oss.str().size());
-  raw_vec.attr("type") = "GaussianKernel";
-  return raw_vec;
+  return mlpack::bindings::r::SerializeModel(
+      *Rcpp::as<Rcpp::XPtr<GaussianKernel>>(ptr), "GaussianKernel");
 }
 
 // Deserialize a GaussianKernel pointer.
 // [[Rcpp::export]]
 SEXP DeserializeGaussianKernelPtr(Rcpp::RawVector str)
 {
-  GaussianKernel* ptr = new GaussianKernel();
-
-  std::istringstream iss(std::string((char *) &str[0], str.size()));
-  {
-    boost::archive::binary_iarchive ia(iss);
-    ia >> boost::serialization::make_nvp("GaussianKernel", *ptr);
-  }
-
   // R will be responsible for freeing this.
-  return std::move((Rcpp::XPtr<GaussianKernel>)ptr);
+  return mlpack::bindings::r::DeserializeModel<GaussianKernel>(str,
+      "GaussianKernel");
 }
 
 